@@ -0,0 +1,29 @@
+///
+/// \file    FreeRTOS.h
+/// \brief   Host stand-in for the FreeRTOS kernel configuration
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+
+#include "portmacro.h"
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL (pdFALSE)
+#define pdPASS (pdTRUE)
+
+#define configMINIMAL_STACK_SIZE ((uint16_t)128)
+#define configMAX_PRIORITIES (7)
+#define configTICK_RATE_HZ ((TickType_t)1000)
+
+#define pdMS_TO_TICKS(xTimeInMs)                                              \
+    ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / 1000U))
+
+#endif /* INC_FREERTOS_H */
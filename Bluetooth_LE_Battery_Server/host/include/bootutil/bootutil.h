@@ -0,0 +1,26 @@
+///
+/// \file    bootutil.h
+/// \brief   Host stand-in for the MCUboot image state API
+///
+/// \details Marking the secondary slot pending is recorded by the host OTA
+///          library stand-in (see host_platform.hpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef BOOTUTIL_H
+#define BOOTUTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int boot_set_pending(int permanent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTUTIL_H */
@@ -0,0 +1,103 @@
+///
+/// \file    cy_ota_api.h
+/// \brief   Host stand-in for the OTA library API
+///
+/// \details The host agent accepts every command and appends downloaded
+///          data to a host copy of the secondary slot, which the simulation
+///          compares against the image it sent (see host_platform.hpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CY_OTA_API_H
+#define CY_OTA_API_H
+
+#include "cy_result.h"
+
+#include "wiced_bt_gatt.h"
+
+typedef void *cy_ota_context_ptr;
+
+typedef enum {
+    CY_OTA_CONNECTION_UNKNOWN,
+    CY_OTA_CONNECTION_MQTT,
+    CY_OTA_CONNECTION_HTTP,
+    CY_OTA_CONNECTION_HTTPS,
+    CY_OTA_CONNECTION_BLE
+} cy_ota_connection_t;
+
+typedef enum { CY_OTA_JOB_FLOW, CY_OTA_DIRECT_FLOW } cy_ota_update_flow_t;
+
+typedef enum {
+    CY_OTA_STATE_NOT_INITIALIZED,
+    CY_OTA_STATE_EXITING,
+    CY_OTA_STATE_INITIALIZING,
+    CY_OTA_STATE_AGENT_STARTED,
+    CY_OTA_STATE_AGENT_WAITING,
+    CY_OTA_STATE_START_UPDATE,
+    CY_OTA_STATE_STORAGE_OPEN,
+    CY_OTA_STATE_STORAGE_WRITE,
+    CY_OTA_STATE_STORAGE_CLOSE,
+    CY_OTA_STATE_VERIFY,
+    CY_OTA_STATE_RESULT_REDIRECT,
+    CY_OTA_STATE_OTA_COMPLETE
+} cy_ota_agent_state_t;
+
+typedef struct {
+    uint8_t reboot_upon_completion; ///< Reboot once the image is verified
+    uint8_t validate_after_reboot;  ///< New image validates itself
+    uint8_t do_not_send_result;     ///< Skip the result report
+    void *cb_func;                  ///< Application callback
+    void *cb_arg;                   ///< Argument passed to cb_func
+} cy_ota_agent_params_t;
+
+typedef struct {
+    cy_ota_connection_t initial_connection; ///< Transport of the update
+    cy_ota_update_flow_t use_get_job_flow;  ///< Job or direct flow
+} cy_ota_network_params_t;
+
+#define CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD 1
+#define CY_OTA_UPGRADE_COMMAND_DOWNLOAD 2
+#define CY_OTA_UPGRADE_COMMAND_VERIFY 3
+#define CY_OTA_UPGRADE_COMMAND_FINISH 4
+#define CY_OTA_UPGRADE_COMMAND_GET_STATUS 5
+#define CY_OTA_UPGRADE_COMMAND_CLEAR_STATUS 6
+#define CY_OTA_UPGRADE_COMMAND_ABORT 7
+
+#define CY_RSLT_OTA_ERROR_BADARG ((cy_rslt_t)0x02100001U)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cy_ota_agent_start(cy_ota_network_params_t *network_params,
+                             cy_ota_agent_params_t *agent_params,
+                             cy_ota_context_ptr *ctx_ptr);
+cy_rslt_t cy_ota_agent_stop(cy_ota_context_ptr *ctx_ptr);
+cy_rslt_t cy_ota_get_state(cy_ota_context_ptr ctx_ptr,
+                           cy_ota_agent_state_t *state);
+
+cy_rslt_t cy_ota_ble_download_prepare(cy_ota_context_ptr ctx_ptr,
+                                      uint16_t bt_conn_id,
+                                      uint16_t bt_config_descriptor);
+cy_rslt_t cy_ota_ble_download(cy_ota_context_ptr ctx_ptr,
+                              wiced_bt_gatt_event_data_t *p_req,
+                              uint16_t bt_conn_id,
+                              uint16_t bt_config_descriptor);
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ctx_ptr,
+                                    wiced_bt_gatt_event_data_t *p_req);
+cy_rslt_t cy_ota_ble_download_verify(cy_ota_context_ptr ctx_ptr,
+                                     wiced_bt_gatt_event_data_t *p_req,
+                                     uint16_t bt_conn_id);
+cy_rslt_t cy_ota_ble_download_abort(cy_ota_context_ptr ctx_ptr);
+
+void cy_ota_set_log_level(int level);
+cy_rslt_t cy_ota_storage_validated(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CY_OTA_API_H */
@@ -0,0 +1,26 @@
+///
+/// \file    cy_result.h
+/// \brief   Host stand-in for the Cypress result type
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CY_RESULT_H
+#define CY_RESULT_H
+
+#include <stdint.h>
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0x00000000U)
+
+typedef enum {
+    CY_RSLT_TYPE_INFO = 0,
+    CY_RSLT_TYPE_WARNING = 1,
+    CY_RSLT_TYPE_ERROR = 2,
+    CY_RSLT_TYPE_FATAL = 3
+} cy_en_rslt_type_t;
+
+#endif /* CY_RESULT_H */
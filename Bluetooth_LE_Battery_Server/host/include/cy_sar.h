@@ -0,0 +1,26 @@
+///
+/// \file    cy_sar.h
+/// \brief   Host stand-in for the PDL SAR ADC driver
+///
+/// \details Only the count to voltage conversion is modelled. The host ADC
+///          converts against a 3.3 V VDDA at 12 bits (see host_hal.cpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CY_SAR_H
+#define CY_SAR_H
+
+#include <stdint.h>
+
+typedef struct {
+    int32_t vref_microvolts; ///< Reference the counts are relative to
+    int16_t full_scale;      ///< Counts at the reference
+} SAR_Type;
+
+int32_t Cy_SAR_CountsTo_uVolts(const SAR_Type *base, uint32_t chan,
+                               int16_t adcCounts);
+
+#endif /* CY_SAR_H */
@@ -0,0 +1,35 @@
+///
+/// \file    cy_utils.h
+/// \brief   Host stand-in for the PDL assertion macros
+///
+/// \details CY_ASSERT stays live on the host: a failed assertion reports its
+///          location and aborts, so sanitizer and debugger runs stop there.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CY_UTILS_H
+#define CY_UTILS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void host_assert_failed(const char *file, int line, const char *expression);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define CY_ASSERT(x)                                                          \
+    do {                                                                      \
+        if (!(x)) {                                                           \
+            host_assert_failed(__FILE__, __LINE__, #x);                       \
+        }                                                                     \
+    } while (0)
+
+#define CY_UNUSED_PARAMETER(x) ((void)(x))
+
+#endif /* CY_UTILS_H */
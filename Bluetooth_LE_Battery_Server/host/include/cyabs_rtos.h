@@ -0,0 +1,59 @@
+///
+/// \file    cyabs_rtos.h
+/// \brief   Host stand-in for the RTOS abstraction
+///
+/// \details Semaphores, software timers, time and delays used by src/.
+///          Timer callbacks run on the host timer thread, like the FreeRTOS
+///          timer task on target. Defined in host/stand_in/host_rtos.cpp.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYABS_RTOS_H
+#define CYABS_RTOS_H
+
+#include "cy_result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CY_RTOS_NEVER_TIMEOUT ((uint32_t)0xFFFFFFFFUL)
+
+#define CY_RTOS_TIMEOUT ((cy_rslt_t)0x04020002U)
+
+typedef uint32_t cy_time_t;
+
+typedef struct {
+    void *handle;
+} cy_semaphore_t;
+
+typedef struct {
+    void *handle;
+} cy_timer_t;
+
+typedef enum {
+    CY_TIMER_TYPE_PERIODIC,
+    CY_TIMER_TYPE_ONCE
+} cy_timer_trigger_type_t;
+
+typedef void *cy_timer_callback_arg_t;
+typedef void (*cy_timer_callback_t)(cy_timer_callback_arg_t arg);
+
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms);
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval);
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *semaphore, uint32_t maxcount,
+                                 uint32_t initcount);
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *semaphore, cy_time_t timeout_ms,
+                                bool in_isr);
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *semaphore, bool in_isr);
+
+cy_rslt_t cy_rtos_init_timer(cy_timer_t *timer, cy_timer_trigger_type_t type,
+                             cy_timer_callback_t fun,
+                             cy_timer_callback_arg_t arg);
+cy_rslt_t cy_rtos_start_timer(cy_timer_t *timer, cy_time_t num_ms);
+cy_rslt_t cy_rtos_stop_timer(cy_timer_t *timer);
+
+#endif /* CYABS_RTOS_H */
@@ -0,0 +1,61 @@
+///
+/// \file    cybsp.h
+/// \brief   Host stand-in for the board support package
+///
+/// \details Besides cybsp_init(), stands in for the CMSIS core pieces src/
+///          reaches through the BSP:
+///          - the DWT cycle counter, which counts nanoseconds of the host's
+///            monotonic clock (SystemCoreClock is 1 GHz to match), so the
+///            GATT statistics report host time;
+///          - the internal flash, mapped to host_flash at CY_FLASH_BASE with
+///            the flashmap.mk slot offsets the build defines.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYBSP_H
+#define CYBSP_H
+
+#include "cyhal.h"
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t CTRL;   ///< Control
+    volatile uint32_t CYCCNT; ///< Cycle count, refreshed by every DWT access
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR; ///< Debug exception and monitor control
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+DWT_Type *host_dwt(void);
+
+extern CoreDebug_Type host_core_debug;
+extern uint32_t SystemCoreClock;
+
+/// Host copy of the device's internal flash
+extern uint8_t host_flash[];
+
+cy_rslt_t cybsp_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define DWT (host_dwt())
+#define CoreDebug (&host_core_debug)
+
+#define CY_FLASH_BASE ((uintptr_t)host_flash)
+#define CY_FLASH_SIZE (0x100000UL)
+
+#endif /* CYBSP_H */
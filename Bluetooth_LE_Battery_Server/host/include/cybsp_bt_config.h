@@ -0,0 +1,31 @@
+///
+/// \file    cybsp_bt_config.h
+/// \brief   Host stand-in for the BSP Bluetooth transport configuration
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYBSP_BT_CONFIG_H
+#define CYBSP_BT_CONFIG_H
+
+#include "cybt_platform_trace.h"
+
+typedef struct {
+    uint32_t baud_rate; ///< HCI UART rate (no transport on the host)
+} cybt_platform_config_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const cybt_platform_config_t cybsp_bt_platform_cfg;
+
+void cybt_platform_config_init(const cybt_platform_config_t *p_bt_platform_cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYBSP_BT_CONFIG_H */
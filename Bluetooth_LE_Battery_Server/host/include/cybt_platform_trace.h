@@ -0,0 +1,15 @@
+///
+/// \file    cybt_platform_trace.h
+/// \brief   Host stand-in for the Bluetooth platform trace header
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYBT_PLATFORM_TRACE_H
+#define CYBT_PLATFORM_TRACE_H
+
+#include <stdint.h>
+
+#endif /* CYBT_PLATFORM_TRACE_H */
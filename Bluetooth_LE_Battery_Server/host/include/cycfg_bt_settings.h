@@ -0,0 +1,25 @@
+///
+/// \file    cycfg_bt_settings.h
+/// \brief   Host stand-in for the Bluetooth Configurator stack settings
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYCFG_BT_SETTINGS_H
+#define CYCFG_BT_SETTINGS_H
+
+#include "wiced_bt_stack.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const wiced_bt_cfg_settings_t wiced_bt_cfg_settings;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCFG_BT_SETTINGS_H */
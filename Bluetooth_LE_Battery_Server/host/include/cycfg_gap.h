@@ -0,0 +1,31 @@
+///
+/// \file    cycfg_gap.h
+/// \brief   Host stand-in for the Bluetooth Configurator GAP settings
+///
+/// \details The advertising packet of src/app/design.cybt: flags, complete
+///          local name, Battery Service UUID and appearance.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYCFG_GAP_H
+#define CYCFG_GAP_H
+
+#include "wiced_bt_ble.h"
+
+#define CY_BT_ADV_PACKET_DATA_SIZE 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern wiced_bt_device_address_t cy_bt_device_address;
+extern wiced_bt_ble_advert_elem_t cy_bt_adv_packet_data[];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCFG_GAP_H */
@@ -0,0 +1,78 @@
+///
+/// \file    cycfg_gatt_db.h
+/// \brief   Host stand-in for the Bluetooth Configurator GATT database
+///
+/// \details Handles and UUIDs match the layout of src/app/design.cybt; the
+///          value storage is defined in host/stand_in/host_cycfg.cpp.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYCFG_GATT_DB_H
+#define CYCFG_GATT_DB_H
+
+#include "wiced_bt_gatt.h"
+
+#define __UUID_SERVICE_OTA_FW_UPGRADE_SERVICE                                 \
+    0x1F, 0x38, 0xA1, 0x38, 0xAD, 0x82, 0x35, 0x86, 0xA0, 0x43, 0x13, 0x5C,   \
+        0x47, 0x1E, 0x5D, 0xAE
+#define __UUID_CHARACTERISTIC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT \
+    0x1B, 0x66, 0x6C, 0x08, 0x0A, 0x57, 0x8E, 0x83, 0x99, 0x4E, 0xA7, 0xF7,   \
+        0xBF, 0x50, 0xDD, 0xA3
+#define __UUID_CHARACTERISTIC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA         \
+    0x26, 0xFE, 0x2E, 0xE7, 0x09, 0x24, 0x4F, 0xB7, 0x91, 0x40, 0x61, 0xD9,   \
+        0x7A, 0x6C, 0xE8, 0xA2
+
+#define HDLS_GAP 0x0001
+#define HDLC_GAP_DEVICE_NAME 0x0002
+#define HDLC_GAP_DEVICE_NAME_VALUE 0x0003
+#define HDLC_GAP_APPEARANCE 0x0004
+#define HDLC_GAP_APPEARANCE_VALUE 0x0005
+
+#define HDLS_GATT 0x0006
+
+#define HDLS_BAS 0x0007
+#define HDLC_BAS_BATTERY_LEVEL 0x0008
+#define HDLC_BAS_BATTERY_LEVEL_VALUE 0x0009
+#define HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT 0x000A
+#define HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG 0x000B
+
+#define HDLS_OTA_FW_UPGRADE_SERVICE 0x000C
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT 0x000D
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE 0x000E
+#define HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG \
+    0x000F
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA 0x0010
+#define HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE 0x0011
+
+typedef struct {
+    uint16_t handle;  ///< Attribute handle
+    uint16_t max_len; ///< Capacity of p_data
+    uint16_t cur_len; ///< Length of the current value
+    uint8_t *p_data;  ///< Value storage
+} gatt_db_lookup_table_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t app_gap_device_name[];
+extern uint8_t app_gap_appearance[];
+extern uint8_t app_bas_battery_level[];
+extern uint8_t app_bas_battery_level_char_presentation_format[];
+extern uint8_t app_bas_battery_level_client_char_config[];
+extern uint8_t app_ota_fw_upgrade_service_ota_upgrade_control_point[];
+extern uint8_t
+    app_ota_fw_upgrade_service_ota_upgrade_control_point_client_char_config[];
+extern uint8_t app_ota_fw_upgrade_service_ota_upgrade_data[];
+
+extern gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[];
+extern const uint16_t app_gatt_db_ext_attr_tbl_size;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCFG_GATT_DB_H */
@@ -0,0 +1,27 @@
+///
+/// \file    cycfg_peripherals.h
+/// \brief   Host stand-in for the Device Configurator peripherals
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYCFG_PERIPHERALS_H
+#define CYCFG_PERIPHERALS_H
+
+#include "cyhal_pwm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const cyhal_pwm_configurator_t LED1_PWM_hal_config;
+extern const cyhal_pwm_configurator_t LED2_PWM_hal_config;
+extern const cyhal_pwm_configurator_t LED3_PWM_hal_config;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYCFG_PERIPHERALS_H */
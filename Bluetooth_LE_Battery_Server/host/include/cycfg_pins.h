@@ -0,0 +1,24 @@
+///
+/// \file    cycfg_pins.h
+/// \brief   Host stand-in for the Device Configurator pin names
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYCFG_PINS_H
+#define CYCFG_PINS_H
+
+#define CYBSP_DEBUG_UART_TX ((cyhal_gpio_t)1)
+#define CYBSP_DEBUG_UART_RX ((cyhal_gpio_t)2)
+#define CYBSP_USER_BTN ((cyhal_gpio_t)3)
+#define CYBSP_A0 ((cyhal_gpio_t)4)
+#define CYBSP_LED_RGB_RED ((cyhal_gpio_t)5)
+#define CYBSP_LED_RGB_GREEN ((cyhal_gpio_t)6)
+#define CYBSP_LED_RGB_BLUE ((cyhal_gpio_t)7)
+
+/// Level of the user button when released
+#define CYBSP_BTN_OFF (1U)
+
+#endif /* CYCFG_PINS_H */
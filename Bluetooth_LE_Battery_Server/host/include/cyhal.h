@@ -0,0 +1,29 @@
+///
+/// \file    cyhal.h
+/// \brief   Host stand-in for the HAL umbrella header
+///
+/// \details Declares the subset of the PSoC 6 HAL used by src/. Defined in
+///          host/stand_in/host_hal.cpp.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_H
+#define CYHAL_H
+
+#include "cy_result.h"
+#include "cy_sar.h"
+#include "cy_utils.h"
+
+#include "cyhal_hw_types.h"
+
+#include "cyhal_adc.h"
+#include "cyhal_gpio.h"
+#include "cyhal_pwm.h"
+#include "cyhal_system.h"
+#include "cyhal_timer.h"
+#include "cyhal_wdt.h"
+
+#endif /* CYHAL_H */
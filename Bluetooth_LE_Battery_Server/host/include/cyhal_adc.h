@@ -0,0 +1,96 @@
+///
+/// \file    cyhal_adc.h
+/// \brief   Host stand-in for the HAL SAR ADC driver
+///
+/// \details Asynchronous reads complete on the host timer thread, which
+///          stands in for the DMA completion interrupt. Every sample reads
+///          the pin voltage set with host_adc_set_microvolts() (see
+///          host_platform.hpp), in counts from cyhal_adc_read_async() as in
+///          DMA mode.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_ADC_H
+#define CYHAL_ADC_H
+
+#include "cyhal_hw_types.h"
+
+#define CYHAL_ADC_VNEG ((cyhal_gpio_t)-2)
+
+typedef enum {
+    CYHAL_ADC_EOS = 1,
+    CYHAL_ADC_ASYNC_READ_COMPLETE = 2
+} cyhal_adc_event_t;
+
+typedef enum { CYHAL_ASYNC_SW, CYHAL_ASYNC_DMA } cyhal_async_mode_t;
+
+typedef enum {
+    CYHAL_ADC_REF_INTERNAL,
+    CYHAL_ADC_REF_EXTERNAL,
+    CYHAL_ADC_REF_VDDA,
+    CYHAL_ADC_REF_VDDA_DIV_2
+} cyhal_adc_vref_t;
+
+typedef enum {
+    CYHAL_ADC_VNEG_VSSA,
+    CYHAL_ADC_VNEG_VREF
+} cyhal_adc_vneg_t;
+
+typedef struct {
+    bool continuous_scanning;    ///< Scan without a trigger
+    uint8_t resolution;          ///< Bits per sample
+    uint16_t average_count;      ///< Hardware averaging count
+    uint32_t average_mode_flags; ///< Averaging mode
+    uint32_t ext_vref_mv;        ///< External reference in millivolts
+    cyhal_adc_vneg_t vneg;       ///< Negative input of single-ended channels
+    cyhal_adc_vref_t vref;       ///< Reference
+    cyhal_gpio_t ext_vref;       ///< External reference pin
+    bool is_bypassed;            ///< Reference bypass capacitor fitted
+    cyhal_gpio_t bypass_pin;     ///< Bypass capacitor pin
+} cyhal_adc_config_t;
+
+typedef struct {
+    bool enable_averaging;       ///< Use the hardware average
+    uint32_t min_acquisition_ns; ///< Minimum settling time
+    bool enabled;                ///< Channel enabled
+} cyhal_adc_channel_config_t;
+
+typedef void (*cyhal_adc_event_callback_t)(void *callback_arg,
+                                           cyhal_adc_event_t event);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cyhal_adc_init(cyhal_adc_t *obj, cyhal_gpio_t pin, const void *clk);
+void cyhal_adc_free(cyhal_adc_t *obj);
+
+cy_rslt_t cyhal_adc_configure(cyhal_adc_t *obj,
+                              const cyhal_adc_config_t *config);
+cy_rslt_t cyhal_adc_channel_init_diff(cyhal_adc_channel_t *obj,
+                                      cyhal_adc_t *adc, cyhal_gpio_t vplus,
+                                      cyhal_gpio_t vminus,
+                                      const cyhal_adc_channel_config_t *cfg);
+void cyhal_adc_channel_free(cyhal_adc_channel_t *obj);
+
+cy_rslt_t cyhal_adc_set_async_mode(cyhal_adc_t *obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority);
+cy_rslt_t cyhal_adc_read_async(cyhal_adc_t *obj, size_t num_scan,
+                               int32_t *result_list);
+cy_rslt_t cyhal_adc_read_async_uv(cyhal_adc_t *obj, size_t num_scan,
+                                  int32_t *result_list);
+
+void cyhal_adc_register_callback(cyhal_adc_t *obj,
+                                 cyhal_adc_event_callback_t callback,
+                                 void *callback_arg);
+void cyhal_adc_enable_event(cyhal_adc_t *obj, cyhal_adc_event_t event,
+                            uint8_t intr_priority, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_ADC_H */
@@ -0,0 +1,69 @@
+///
+/// \file    cyhal_gpio.h
+/// \brief   Host stand-in for the HAL GPIO driver
+///
+/// \details Pins hold no level; the simulation raises registered pin
+///          events through host_gpio_event() (see host_platform.hpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_GPIO_H
+#define CYHAL_GPIO_H
+
+#include "cyhal_hw_types.h"
+
+typedef enum {
+    CYHAL_GPIO_IRQ_NONE = 0,
+    CYHAL_GPIO_IRQ_RISE = 1,
+    CYHAL_GPIO_IRQ_FALL = 2,
+    CYHAL_GPIO_IRQ_BOTH = 3
+} cyhal_gpio_event_t;
+
+typedef enum {
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum {
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_ANALOG,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESHIGH,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_PULLUPDOWN
+} cyhal_gpio_drive_mode_t;
+
+typedef void (*cyhal_gpio_event_callback_t)(void *callback_arg,
+                                            cyhal_gpio_event_t event);
+
+typedef struct cyhal_gpio_callback_data_s {
+    cyhal_gpio_event_callback_t callback;    ///< Pin event callback
+    void *callback_arg;                      ///< Argument passed to callback
+    struct cyhal_gpio_callback_data_s *next; ///< Used by the driver
+    cyhal_gpio_t pin;                        ///< Used by the driver
+} cyhal_gpio_callback_data_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void cyhal_gpio_free(cyhal_gpio_t pin);
+
+void cyhal_gpio_register_callback(cyhal_gpio_t pin,
+                                  cyhal_gpio_callback_data_t *callback_data);
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event,
+                             uint8_t intr_priority, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_GPIO_H */
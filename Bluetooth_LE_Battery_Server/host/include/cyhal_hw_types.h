@@ -0,0 +1,58 @@
+///
+/// \file    cyhal_hw_types.h
+/// \brief   Host stand-in for the HAL object types
+///
+/// \details The objects carry what the host peripherals need; board pin
+///          names come from cycfg_pins.h.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_HW_TYPES_H
+#define CYHAL_HW_TYPES_H
+
+#include "cy_result.h"
+#include "cy_sar.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int cyhal_gpio_t;
+
+#define NC ((cyhal_gpio_t)-1)
+
+typedef struct {
+    void *host; ///< Host timer state
+} cyhal_timer_t;
+
+typedef struct {
+    float duty_cycle;   ///< Last duty cycle in percent
+    uint32_t frequency; ///< Last frequency in Hz
+    bool running;       ///< Started and not stopped
+} cyhal_pwm_t;
+
+typedef struct {
+    SAR_Type *base; ///< SAR block
+    void *host;     ///< Host ADC state
+} cyhal_adc_t;
+
+typedef struct {
+    cyhal_adc_t *adc;    ///< Owning ADC
+    cyhal_gpio_t vplus;  ///< Positive input
+    uint8_t channel_idx; ///< SAR channel
+} cyhal_adc_channel_t;
+
+typedef struct {
+    uint32_t timeout_ms; ///< Configured timeout
+} cyhal_wdt_t;
+
+typedef struct {
+    uint32_t unused; ///< PWM configuration is not modelled
+} cyhal_pwm_configurator_t;
+
+#include "cycfg_pins.h"
+
+#endif /* CYHAL_HW_TYPES_H */
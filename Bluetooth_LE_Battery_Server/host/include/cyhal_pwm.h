@@ -0,0 +1,34 @@
+///
+/// \file    cyhal_pwm.h
+/// \brief   Host stand-in for the HAL PWM driver
+///
+/// \details The host PWM records its state and drives nothing.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_PWM_H
+#define CYHAL_PWM_H
+
+#include "cyhal_hw_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cyhal_pwm_init_cfg(cyhal_pwm_t *obj,
+                             const cyhal_pwm_configurator_t *cfg);
+void cyhal_pwm_free(cyhal_pwm_t *obj);
+
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle,
+                                   uint32_t frequencyhal_hz);
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj);
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_PWM_H */
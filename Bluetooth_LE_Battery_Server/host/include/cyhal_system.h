@@ -0,0 +1,38 @@
+///
+/// \file    cyhal_system.h
+/// \brief   Host stand-in for the HAL system functions
+///
+/// \details Critical sections take one process-wide recursive lock, which
+///          serializes them against every host thread standing in for a
+///          task or an interrupt.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_SYSTEM_H
+#define CYHAL_SYSTEM_H
+
+#include "cy_result.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t cyhal_system_critical_section_enter(void);
+void cyhal_system_critical_section_exit(uint32_t old_interrupt_state);
+
+cy_rslt_t cyhal_system_delay_ms(uint32_t milliseconds);
+void cyhal_system_delay_us(uint16_t microseconds);
+
+void NVIC_SystemReset(void);
+void __enable_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_SYSTEM_H */
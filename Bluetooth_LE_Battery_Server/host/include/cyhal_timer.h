@@ -0,0 +1,69 @@
+///
+/// \file    cyhal_timer.h
+/// \brief   Host stand-in for the HAL timer/counter driver
+///
+/// \details Periodic timers fire on the host timer thread, which stands in
+///          for the timer interrupt.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_TIMER_H
+#define CYHAL_TIMER_H
+
+#include "cyhal_hw_types.h"
+
+typedef enum {
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN,
+    CYHAL_TIMER_DIR_UP_DOWN
+} cyhal_timer_direction_t;
+
+typedef enum {
+    CYHAL_TIMER_IRQ_NONE = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT = 1,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 2,
+    CYHAL_TIMER_IRQ_ALL = 3
+} cyhal_timer_event_t;
+
+typedef struct {
+    bool is_continuous;                ///< Restart after the period
+    cyhal_timer_direction_t direction; ///< Count direction
+    bool is_compare;                   ///< Compare instead of capture
+    uint32_t period;                   ///< Counts per period, minus one
+    uint32_t compare_value;            ///< Compare value
+    uint32_t value;                    ///< Initial count
+} cyhal_timer_cfg_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void *callback_arg,
+                                             cyhal_timer_event_t event);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin,
+                           const void *clk);
+void cyhal_timer_free(cyhal_timer_t *obj);
+
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg);
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz);
+
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_reset(cyhal_timer_t *obj);
+
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg);
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_TIMER_H */
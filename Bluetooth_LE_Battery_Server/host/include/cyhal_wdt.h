@@ -0,0 +1,28 @@
+///
+/// \file    cyhal_wdt.h
+/// \brief   Host stand-in for the HAL watchdog driver
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef CYHAL_WDT_H
+#define CYHAL_WDT_H
+
+#include "cyhal_hw_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cy_rslt_t cyhal_wdt_init(cyhal_wdt_t *obj, uint32_t timeout_ms);
+void cyhal_wdt_free(cyhal_wdt_t *obj);
+void cyhal_wdt_kick(cyhal_wdt_t *obj);
+uint32_t cyhal_wdt_get_max_timeout_ms(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CYHAL_WDT_H */
@@ -0,0 +1,24 @@
+///
+/// \file    portmacro.h
+/// \brief   Host stand-in for the FreeRTOS port types
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+/// Interrupts are host threads; the woken task runs when the OS schedules it
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#endif /* PORTMACRO_H */
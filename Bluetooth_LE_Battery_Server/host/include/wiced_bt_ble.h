@@ -0,0 +1,93 @@
+///
+/// \file    wiced_bt_ble.h
+/// \brief   Host stand-in for the WICED LE API
+///
+/// \details Advertising, PHY and data length requests are recorded by the
+///          host stack (see host_platform.hpp); none reaches a controller.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_BLE_H
+#define WICED_BT_BLE_H
+
+#include "wiced_bt_types.h"
+
+typedef enum wiced_bt_ble_advert_mode_e {
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW
+} wiced_bt_ble_advert_mode_t;
+
+typedef enum {
+    BTM_BLE_ADVERT_TYPE_FLAG = 0x01,
+    BTM_BLE_ADVERT_TYPE_16SRV_COMPLETE = 0x03,
+    BTM_BLE_ADVERT_TYPE_NAME_COMPLETE = 0x09,
+    BTM_BLE_ADVERT_TYPE_SERVICE_DATA = 0x16,
+    BTM_BLE_ADVERT_TYPE_APPEARANCE = 0x19
+} wiced_bt_ble_advert_type_t;
+
+typedef struct {
+    uint8_t *p_data;                        ///< AD data
+    uint16_t len;                           ///< Length of p_data
+    wiced_bt_ble_advert_type_t advert_type; ///< AD type
+} wiced_bt_ble_advert_elem_t;
+
+typedef struct {
+    uint16_t conn_interval;       ///< Interval in 1.25 ms units
+    uint16_t conn_latency;        ///< Peripheral latency in events
+    uint16_t supervision_timeout; ///< Timeout in 10 ms units
+} wiced_bt_ble_conn_params_t;
+
+typedef uint8_t wiced_bt_ble_host_phy_preferences_t;
+
+#define BTM_BLE_PREFER_1M_PHY 0x01
+#define BTM_BLE_PREFER_2M_PHY 0x02
+#define BTM_BLE_PREFER_LELR_PHY 0x04
+
+typedef struct {
+    wiced_bt_device_address_t remote_bd_addr;    ///< Peer address
+    wiced_bt_ble_host_phy_preferences_t tx_phys; ///< Preferred TX PHYs
+    wiced_bt_ble_host_phy_preferences_t rx_phys; ///< Preferred RX PHYs
+    uint16_t phy_opts;                           ///< Coded PHY options
+} wiced_bt_ble_phy_preferences_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+wiced_result_t
+wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                              wiced_bt_ble_address_type_t directed_addr_type,
+                              wiced_bt_device_address_ptr_t directed_addr);
+
+wiced_result_t
+wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem,
+                                        wiced_bt_ble_advert_elem_t *p_data);
+wiced_result_t
+wiced_bt_ble_set_raw_scan_response_data(uint8_t num_elem,
+                                        wiced_bt_ble_advert_elem_t *p_data);
+
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr,
+                                 uint8_t res);
+
+wiced_result_t
+wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *phy_preferences);
+wiced_result_t
+wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr,
+                                    uint16_t tx_pdu_length,
+                                    uint16_t tx_time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WICED_BT_BLE_H */
@@ -0,0 +1,174 @@
+///
+/// \file    wiced_bt_dev.h
+/// \brief   Host stand-in for the WICED device management API
+///
+/// \details The simulation delivers management events to the callback given
+///          to wiced_bt_stack_init() (see host_platform.hpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_DEV_H
+#define WICED_BT_DEV_H
+
+#include "wiced_bt_ble.h"
+
+typedef enum wiced_bt_management_evt_e {
+    BTM_ENABLED_EVT,
+    BTM_DISABLED_EVT,
+    BTM_USER_CONFIRMATION_REQUEST_EVT,
+    BTM_PASSKEY_NOTIFICATION_EVT,
+    BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,
+    BTM_PAIRING_COMPLETE_EVT,
+    BTM_ENCRYPTION_STATUS_EVT,
+    BTM_SECURITY_REQUEST_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT,
+    BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT,
+    BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT,
+    BTM_BLE_ADVERT_STATE_CHANGED_EVT,
+    BTM_BLE_CONNECTION_PARAM_UPDATE,
+    BTM_BLE_PHY_UPDATE_EVT,
+    BTM_BLE_DATA_LENGTH_UPDATE_EVENT
+} wiced_bt_management_evt_t;
+
+typedef enum wiced_bt_dev_io_cap_e {
+    BTM_IO_CAPABILITIES_DISPLAY_ONLY,
+    BTM_IO_CAPABILITIES_DISPLAY_AND_YES_NO_INPUT,
+    BTM_IO_CAPABILITIES_KEYBOARD_ONLY,
+    BTM_IO_CAPABILITIES_NONE,
+    BTM_IO_CAPABILITIES_BLE_DISPLAY_AND_KEYBOARD_INPUT
+} wiced_bt_dev_io_cap_t;
+
+typedef enum wiced_bt_dev_oob_data_e {
+    BTM_OOB_NONE,
+    BTM_OOB_PRESENT_192,
+    BTM_OOB_PRESENT_256,
+    BTM_OOB_PRESENT_192_256
+} wiced_bt_dev_oob_data_t;
+
+enum wiced_bt_dev_le_auth_req_e {
+    BTM_LE_AUTH_REQ_NO_BOND = 0x00,
+    BTM_LE_AUTH_REQ_BOND = 0x01,
+    BTM_LE_AUTH_REQ_MITM = 0x04,
+    BTM_LE_AUTH_REQ_SC = 0x08
+};
+
+enum wiced_bt_dev_le_key_type_e {
+    BTM_LE_KEY_PENC = 0x01,
+    BTM_LE_KEY_PID = 0x02,
+    BTM_LE_KEY_PCSRK = 0x04,
+    BTM_LE_KEY_PLK = 0x08
+};
+
+typedef struct {
+    wiced_bt_device_address_t bd_addr; ///< Peer address
+    uint8_t local_io_cap;              ///< Local IO capabilities
+    uint8_t oob_data;                  ///< OOB data present
+    uint8_t auth_req;                  ///< Authentication requirements
+    uint8_t max_key_size;              ///< Largest key size
+    uint8_t init_keys;                 ///< Keys the initiator distributes
+    uint8_t resp_keys;                 ///< Keys the responder distributes
+} wiced_bt_dev_ble_io_caps_req_t;
+
+typedef struct {
+    uint8_t *bd_addr;               ///< Peer address
+    wiced_bt_transport_t transport; ///< Transport
+    void *p_ref_data;               ///< Encryption reference data
+    wiced_result_t result;          ///< Encryption result
+} wiced_bt_dev_encryption_status_t;
+
+typedef struct {
+    wiced_result_t status;                             ///< Pairing result
+    uint8_t reason;                                    ///< SMP failure reason
+    uint8_t sec_level;                                 ///< Security level
+    wiced_bool_t is_pair_cancel;                       ///< Cancelled by user
+    wiced_bt_device_address_t resolved_bd_addr;        ///< Identity address
+    wiced_bt_ble_address_type_t resolved_bd_addr_type; ///< Its type
+} wiced_bt_dev_ble_pairing_info_t;
+
+typedef union {
+    wiced_bt_dev_ble_pairing_info_t ble; ///< LE pairing result
+} wiced_bt_dev_pairing_info_t;
+
+typedef struct {
+    uint8_t *bd_addr;                                  ///< Peer address
+    wiced_bt_transport_t transport;                    ///< Transport
+    wiced_bt_dev_pairing_info_t pairing_complete_info; ///< Pairing result
+    wiced_result_t bonding_status;                     ///< Bonding result
+} wiced_bt_dev_pairing_cplt_t;
+
+typedef struct {
+    wiced_result_t status;             ///< Update result
+    wiced_bt_device_address_t bd_addr; ///< Peer address
+    uint16_t conn_interval;            ///< Interval in 1.25 ms units
+    uint16_t conn_latency;             ///< Peripheral latency in events
+    uint16_t supervision_timeout;      ///< Timeout in 10 ms units
+} wiced_bt_ble_connection_param_update_t;
+
+typedef struct {
+    wiced_result_t status;                ///< Update result
+    wiced_bt_device_address_t bd_address; ///< Peer address
+    uint8_t tx_phy;                       ///< Transmit PHY
+    uint8_t rx_phy;                       ///< Receive PHY
+} wiced_bt_ble_phy_update_t;
+
+typedef struct {
+    wiced_bt_device_address_t bd_address; ///< Peer address
+    uint16_t max_tx_octets;               ///< Largest LL payload sent
+    uint16_t max_tx_time;                 ///< Longest LL packet sent, in us
+    uint16_t max_rx_octets;               ///< Largest LL payload received
+    uint16_t max_rx_time;                 ///< Longest LL packet received
+} wiced_bt_ble_data_length_update_t;
+
+typedef struct {
+    wiced_result_t status; ///< Stack start-up result
+} wiced_bt_dev_enabled_t;
+
+typedef struct {
+    wiced_bt_device_address_t bd_addr; ///< Peer address
+    uint32_t numeric_value;            ///< Value to compare
+    wiced_bool_t just_works;           ///< No user confirmation required
+} wiced_bt_dev_user_cfm_req_t;
+
+typedef struct {
+    wiced_bt_device_address_t bd_addr; ///< Peer address
+} wiced_bt_dev_security_request_t;
+
+typedef union {
+    wiced_bt_dev_enabled_t enabled;
+    wiced_bt_dev_user_cfm_req_t user_confirmation_request;
+    wiced_bt_dev_ble_io_caps_req_t pairing_io_capabilities_ble_request;
+    wiced_bt_dev_pairing_cplt_t pairing_complete;
+    wiced_bt_dev_encryption_status_t encryption_status;
+    wiced_bt_dev_security_request_t security_request;
+    wiced_bt_ble_advert_mode_t ble_advert_state_changed;
+    wiced_bt_ble_connection_param_update_t ble_connection_param_update;
+    wiced_bt_ble_phy_update_t ble_phy_update_event;
+    wiced_bt_ble_data_length_update_t ble_data_length_update_event;
+} wiced_bt_management_evt_data_t;
+
+typedef wiced_result_t(wiced_bt_management_cback_t)(
+    wiced_bt_management_evt_t event,
+    wiced_bt_management_evt_data_t *p_event_data);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+wiced_result_t wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr,
+                                         wiced_bt_ble_address_type_t type);
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr);
+
+void wiced_bt_dev_confirm_req_reply(wiced_result_t res,
+                                    wiced_bt_device_address_t bd_addr);
+void wiced_bt_set_pairable_mode(uint8_t allow_pairing,
+                                uint8_t connectable_only);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WICED_BT_DEV_H */
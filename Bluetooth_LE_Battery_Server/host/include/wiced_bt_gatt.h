@@ -0,0 +1,300 @@
+///
+/// \file    wiced_bt_gatt.h
+/// \brief   Host stand-in for the WICED GATT server API
+///
+/// \details Responses, notifications and indications are recorded by the
+///          host stack, which hands application buffers back through
+///          GATT_APP_BUFFER_TRANSMITTED_EVT when the simulation transmits
+///          them (see host_platform.hpp).
+///
+///          The attribute macros emit one record per attribute: handle
+///          (little endian), permission, UUID length, UUID (little endian),
+///          value length and value. Only declarations carry values; the
+///          characteristic values and descriptors are served from application
+///          storage. wiced_bt_gatt_find_handle_by_type() walks these records.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_GATT_H
+#define WICED_BT_GATT_H
+
+#include "wiced_bt_types.h"
+#include "wiced_bt_uuid.h"
+
+enum wiced_bt_gatt_status_e {
+    WICED_BT_GATT_SUCCESS = 0x00,
+    WICED_BT_GATT_INVALID_HANDLE = 0x01,
+    WICED_BT_GATT_READ_NOT_PERMIT = 0x02,
+    WICED_BT_GATT_WRITE_NOT_PERMIT = 0x03,
+    WICED_BT_GATT_INVALID_PDU = 0x04,
+    WICED_BT_GATT_INSUF_AUTHENTICATION = 0x05,
+    WICED_BT_GATT_REQ_NOT_SUPPORTED = 0x06,
+    WICED_BT_GATT_INVALID_OFFSET = 0x07,
+    WICED_BT_GATT_INSUF_AUTHORIZATION = 0x08,
+    WICED_BT_GATT_PREPARE_Q_FULL = 0x09,
+    WICED_BT_GATT_ATTRIBUTE_NOT_FOUND = 0x0A,
+    WICED_BT_GATT_NOT_LONG = 0x0B,
+    WICED_BT_GATT_INSUF_KEY_SIZE = 0x0C,
+    WICED_BT_GATT_INVALID_ATTR_LEN = 0x0D,
+    WICED_BT_GATT_ERR_UNLIKELY = 0x0E,
+    WICED_BT_GATT_INSUF_ENCRYPTION = 0x0F,
+    WICED_BT_GATT_UNSUPPORT_GRP_TYPE = 0x10,
+    WICED_BT_GATT_INSUF_RESOURCE = 0x11,
+    WICED_BT_GATT_BUSY = 0x84,
+    WICED_BT_GATT_ERROR = 0x85,
+    WICED_BT_GATT_PENDING = 0x88,
+    WICED_BT_GATT_CONGESTED = 0x8F,
+    WICED_BT_GATT_PRC_IN_PROGRESS = 0xFE
+};
+
+typedef uint8_t wiced_bt_gatt_status_t;
+
+typedef enum wiced_bt_gatt_opcode_e {
+    GATT_RSP_ERROR = 0x01,
+    GATT_REQ_MTU = 0x02,
+    GATT_REQ_READ_BY_TYPE = 0x08,
+    GATT_REQ_READ = 0x0A,
+    GATT_REQ_READ_BLOB = 0x0C,
+    GATT_REQ_READ_MULTI = 0x0E,
+    GATT_REQ_WRITE = 0x12,
+    GATT_REQ_PREPARE_WRITE = 0x16,
+    GATT_REQ_EXECUTE_WRITE = 0x18,
+    GATT_HANDLE_VALUE_NOTIF = 0x1B,
+    GATT_HANDLE_VALUE_IND = 0x1D,
+    GATT_HANDLE_VALUE_CONF = 0x1E,
+    GATT_REQ_READ_MULTI_VAR_LENGTH = 0x20,
+    GATT_CMD_WRITE = 0x52,
+    GATT_CMD_SIGNED_WRITE = 0xD2
+} wiced_bt_gatt_opcode_t;
+
+typedef enum wiced_bt_gatt_evt_t {
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT
+} wiced_bt_gatt_evt_t;
+
+enum wiced_bt_gatt_client_char_config_e {
+    GATT_CLIENT_CONFIG_NONE = 0x0000,
+    GATT_CLIENT_CONFIG_NOTIFICATION = 0x0001,
+    GATT_CLIENT_CONFIG_INDICATION = 0x0002
+};
+
+typedef enum {
+    GATT_PREPARE_WRITE_CANCEL = 0x00,
+    GATT_PREPARE_WRITE_EXEC = 0x01
+} wiced_bt_gatt_exec_flag_t;
+
+#define LEN_UUID_16 2
+#define LEN_UUID_128 16
+
+typedef struct {
+    uint16_t len; ///< LEN_UUID_16 or LEN_UUID_128
+    union {
+        uint16_t uuid16;
+        uint8_t uuid128[LEN_UUID_128];
+    } uu; ///< UUID value
+} wiced_bt_uuid_t;
+
+typedef struct {
+    uint16_t handle; ///< Attribute handle
+    uint16_t offset; ///< Offset of a blob read
+} wiced_bt_gatt_read_t;
+
+typedef struct {
+    uint16_t s_handle;    ///< First handle of the range
+    uint16_t e_handle;    ///< Last handle of the range
+    wiced_bt_uuid_t uuid; ///< Attribute type
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct {
+    int num_handles;          ///< Handles in p_handle_stream
+    uint8_t *p_handle_stream; ///< Handles, little endian
+} wiced_bt_gatt_read_multiple_req_t;
+
+typedef struct {
+    uint16_t handle;  ///< Attribute handle
+    uint16_t offset;  ///< Offset of a prepared write
+    uint16_t val_len; ///< Length of p_val
+    uint8_t *p_val;   ///< Value
+} wiced_bt_gatt_write_req_t;
+
+typedef struct {
+    wiced_bt_gatt_exec_flag_t exec_write; ///< Execute or cancel
+} wiced_bt_gatt_execute_write_req_t;
+
+typedef union {
+    wiced_bt_gatt_read_t read_req;
+    wiced_bt_gatt_read_by_type_t read_by_type;
+    wiced_bt_gatt_read_multiple_req_t read_multiple_req;
+    wiced_bt_gatt_write_req_t write_req;
+    wiced_bt_gatt_execute_write_req_t exec_write_req;
+    uint16_t remote_mtu;
+    uint16_t confirm;
+    uint16_t handle;
+} wiced_bt_gatt_request_data_t;
+
+typedef struct {
+    uint16_t conn_id;                  ///< Requesting connection
+    wiced_bt_gatt_opcode_t opcode;     ///< ATT opcode
+    wiced_bt_gatt_request_data_t data; ///< Request parameters
+    uint16_t len_requested;            ///< Room in the response
+} wiced_bt_gatt_attribute_request_t;
+
+typedef struct {
+    uint8_t *bd_addr;                      ///< Peer address
+    uint16_t conn_id;                      ///< Connection
+    wiced_bool_t connected;                ///< Connected or disconnected
+    uint8_t reason;                        ///< Disconnection reason
+    wiced_bt_transport_t transport;        ///< Transport
+    uint8_t link_role;                     ///< Local role
+    wiced_bt_ble_address_type_t addr_type; ///< Peer address type
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct {
+    uint8_t *p_app_rsp_buffer; ///< Buffer for the stack to fill
+    void *p_app_ctxt;          ///< Returned on transmission
+} wiced_bt_gatt_buffer_t;
+
+typedef struct {
+    uint16_t len_requested;        ///< Bytes the stack needs
+    wiced_bt_gatt_buffer_t buffer; ///< Buffer handed to the stack
+} wiced_bt_gatt_buffer_request_t;
+
+typedef struct {
+    uint8_t *p_app_data; ///< Transmitted application buffer
+    void *p_app_ctxt;    ///< Context given with it
+} wiced_bt_gatt_buffer_transmitted_t;
+
+typedef struct {
+    uint16_t conn_id;       ///< Connection
+    wiced_bool_t congested; ///< Congestion state
+} wiced_bt_gatt_congestion_event_t;
+
+typedef union {
+    wiced_bt_gatt_connection_status_t connection_status;
+    wiced_bt_gatt_attribute_request_t attribute_request;
+    wiced_bt_gatt_buffer_request_t buffer_request;
+    wiced_bt_gatt_buffer_transmitted_t buffer_xmitted;
+    wiced_bt_gatt_congestion_event_t congestion;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t(wiced_bt_gatt_cback_t)(
+    wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_event_data);
+
+typedef void *wiced_bt_gatt_app_context_t;
+
+#define GATTDB_PERM_NONE 0x00
+#define GATTDB_PERM_VARIABLE_LENGTH 0x01
+#define GATTDB_PERM_READABLE 0x02
+#define GATTDB_PERM_WRITE_CMD 0x04
+#define GATTDB_PERM_WRITE_REQ 0x08
+#define GATTDB_PERM_AUTH_READABLE 0x10
+#define GATTDB_PERM_RELIABLE_WRITE 0x20
+#define GATTDB_PERM_AUTH_WRITABLE 0x40
+
+#define GATTDB_CHAR_PROP_BROADCAST 0x01
+#define GATTDB_CHAR_PROP_READ 0x02
+#define GATTDB_CHAR_PROP_WRITE_NO_RESPONSE 0x04
+#define GATTDB_CHAR_PROP_WRITE 0x08
+#define GATTDB_CHAR_PROP_NOTIFY 0x10
+#define GATTDB_CHAR_PROP_INDICATE 0x20
+
+#define GATTDB_LE16(x) (uint8_t)((x) & 0xFF), (uint8_t)(((x) >> 8) & 0xFF)
+
+#define PRIMARY_SERVICE_UUID16(handle, service)                               \
+    GATTDB_LE16(handle), GATTDB_PERM_READABLE, LEN_UUID_16,                   \
+        GATTDB_LE16(GATT_UUID_PRI_SERVICE), LEN_UUID_16, GATTDB_LE16(service)
+
+#define PRIMARY_SERVICE_UUID128(handle, service)                              \
+    GATTDB_LE16(handle), GATTDB_PERM_READABLE, LEN_UUID_16,                   \
+        GATTDB_LE16(GATT_UUID_PRI_SERVICE), LEN_UUID_128, service
+
+#define CHARACTERISTIC_UUID16(handle, handle_value, uuid, properties,         \
+                              permission)                                     \
+    GATTDB_LE16(handle), GATTDB_PERM_READABLE, LEN_UUID_16,                   \
+        GATTDB_LE16(GATT_UUID_CHAR_DECLARE), 5, (uint8_t)(properties),        \
+        GATTDB_LE16(handle_value), GATTDB_LE16(uuid),                         \
+        GATTDB_LE16(handle_value), (uint8_t)(permission), LEN_UUID_16,        \
+        GATTDB_LE16(uuid), 0
+
+#define CHARACTERISTIC_UUID16_WRITABLE CHARACTERISTIC_UUID16
+
+#define CHARACTERISTIC_UUID128_WRITABLE(handle, handle_value, uuid,           \
+                                        properties, permission)               \
+    GATTDB_LE16(handle), GATTDB_PERM_READABLE, LEN_UUID_16,                   \
+        GATTDB_LE16(GATT_UUID_CHAR_DECLARE), 19, (uint8_t)(properties),       \
+        GATTDB_LE16(handle_value), uuid, GATTDB_LE16(handle_value),           \
+        (uint8_t)(permission), LEN_UUID_128, uuid, 0
+
+#define CHAR_DESCRIPTOR_UUID16(handle, uuid, permission)                      \
+    GATTDB_LE16(handle), (uint8_t)(permission), LEN_UUID_16,                  \
+        GATTDB_LE16(uuid), 0
+
+#define CHAR_DESCRIPTOR_UUID16_WRITABLE CHAR_DESCRIPTOR_UUID16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback);
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db,
+                                             uint32_t gatt_db_size,
+                                             void *hash);
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle,
+                                           wiced_bt_uuid_t *p_uuid);
+uint16_t wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream,
+                                              uint16_t handle_index);
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id,
+                                    wiced_bt_gatt_opcode_t opcode,
+                                    uint16_t handle,
+                                    wiced_bt_gatt_status_t status);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+    uint8_t *p_attr, wiced_bt_gatt_app_context_t p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+    uint16_t data_len, uint8_t *p_data, wiced_bt_gatt_app_context_t p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t data_len,
+    uint8_t *p_data, wiced_bt_gatt_app_context_t p_app_ctx);
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id,
+                                    wiced_bt_gatt_opcode_t opcode,
+                                    uint16_t handle);
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id,
+                                            wiced_bt_gatt_opcode_t opcode,
+                                            wiced_bt_gatt_write_req_t *p_req);
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id,
+                                            wiced_bt_gatt_opcode_t opcode);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id,
+                                                         uint16_t remote_mtu,
+                                                         uint16_t my_mtu);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(
+    uint16_t conn_id, uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+    wiced_bt_gatt_app_context_t p_app_ctx);
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(
+    uint16_t conn_id, uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+    wiced_bt_gatt_app_context_t p_app_ctx);
+
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WICED_BT_GATT_H */
@@ -0,0 +1,86 @@
+///
+/// \file    wiced_bt_l2c.h
+/// \brief   Host stand-in for the WICED L2CAP API
+///
+/// \details The host stack keeps the LE credit-based callbacks registered
+///          for a PSM so the simulation can open channels and deliver SDUs
+///          (see host_platform.hpp).
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_L2C_H
+#define WICED_BT_L2C_H
+
+#include "wiced_bt_types.h"
+
+#define L2CAP_LE_RESULT_CONN_OK 0x0000
+#define L2CAP_LE_RESULT_NO_PSM 0x0002
+#define L2CAP_LE_RESULT_NO_RESOURCES 0x0004
+
+typedef void(wiced_bt_l2cap_le_connected_indication_cback_t)(
+    void *context, wiced_bt_device_address_t bd_addr, uint16_t local_cid,
+    uint16_t psm, uint8_t id, uint16_t mtu_peer);
+typedef void(wiced_bt_l2cap_le_connected_confirm_cback_t)(void *context,
+                                                          uint16_t local_cid,
+                                                          uint16_t result,
+                                                          uint16_t mtu_peer);
+typedef void(wiced_bt_l2cap_le_disconnect_indication_cback_t)(
+    void *context, uint16_t local_cid, wiced_bool_t ack);
+typedef void(wiced_bt_l2cap_le_disconnect_confirm_cback_t)(void *context,
+                                                           uint16_t local_cid,
+                                                           uint16_t result);
+typedef void(wiced_bt_l2cap_le_data_indication_cback_t)(void *context,
+                                                        uint16_t local_cid,
+                                                        uint8_t *p_data,
+                                                        uint16_t buf_len);
+typedef void(wiced_bt_l2cap_le_congestion_status_cback_t)(
+    void *context, uint16_t local_cid, wiced_bool_t congested);
+typedef void(wiced_bt_l2cap_le_tx_complete_cback_t)(void *context,
+                                                    uint16_t local_cid,
+                                                    uint16_t buf_count);
+
+typedef struct {
+    wiced_bt_l2cap_le_connected_indication_cback_t
+        *le_connected_indication_cback; ///< Peer opened a channel
+    wiced_bt_l2cap_le_connected_confirm_cback_t
+        *le_connected_confirm_cback; ///< Local open completed
+    wiced_bt_l2cap_le_disconnect_indication_cback_t
+        *le_disconnect_indication_cback; ///< Peer closed a channel
+    wiced_bt_l2cap_le_disconnect_confirm_cback_t
+        *le_disconnect_confirm_cback; ///< Local close completed
+    wiced_bt_l2cap_le_data_indication_cback_t
+        *le_data_indication_cback; ///< SDU received
+    wiced_bt_l2cap_le_congestion_status_cback_t
+        *le_congestion_status_cback; ///< Congestion changed
+    wiced_bt_l2cap_le_tx_complete_cback_t
+        *le_tx_complete_cback; ///< SDUs transmitted
+    uint16_t le_mps;           ///< Largest PDU payload received
+} wiced_bt_l2cap_le_appl_information_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm,
+                                    wiced_bt_l2cap_le_appl_information_t *p_cb,
+                                    void *context);
+wiced_bool_t wiced_bt_l2cap_le_deregister(uint16_t psm);
+
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr,
+                                           uint8_t id, uint16_t lcid,
+                                           uint16_t result, uint16_t mtu);
+wiced_bool_t wiced_bt_l2cap_le_disconnect_req(uint16_t lcid);
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid);
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(
+    wiced_bt_device_address_t rem_bdRa, uint16_t min_int, uint16_t max_int,
+    uint16_t latency, uint16_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WICED_BT_L2C_H */
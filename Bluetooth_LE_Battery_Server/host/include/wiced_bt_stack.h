@@ -0,0 +1,38 @@
+///
+/// \file    wiced_bt_stack.h
+/// \brief   Host stand-in for the WICED stack start-up API
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_STACK_H
+#define WICED_BT_STACK_H
+
+#include "wiced_bt_dev.h"
+
+typedef struct {
+    uint16_t ble_max_simultaneous_links; ///< Connections the stack accepts
+    uint16_t ble_max_rx_pdu_size;        ///< Largest ATT MTU received
+} wiced_bt_cfg_ble_t;
+
+typedef struct {
+    const uint8_t *device_name;          ///< Local name
+    const wiced_bt_cfg_ble_t *p_ble_cfg; ///< LE configuration
+} wiced_bt_cfg_settings_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+wiced_result_t
+wiced_bt_stack_init(wiced_bt_management_cback_t *p_bt_management_cback,
+                    const wiced_bt_cfg_settings_t *p_bt_cfg_settings);
+wiced_result_t wiced_bt_stack_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WICED_BT_STACK_H */
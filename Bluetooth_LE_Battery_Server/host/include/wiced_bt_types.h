@@ -0,0 +1,43 @@
+///
+/// \file    wiced_bt_types.h
+/// \brief   Host stand-in for the WICED Bluetooth base types
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_TYPES_H
+#define WICED_BT_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t wiced_bool_t;
+
+#define WICED_TRUE ((wiced_bool_t)1)
+#define WICED_FALSE ((wiced_bool_t)0)
+
+#define BD_ADDR_LEN 6
+
+typedef uint8_t wiced_bt_device_address_t[BD_ADDR_LEN];
+typedef uint8_t *wiced_bt_device_address_ptr_t;
+
+typedef uint8_t wiced_bt_ble_address_type_t;
+
+#define BLE_ADDR_PUBLIC 0x00
+#define BLE_ADDR_RANDOM 0x01
+
+typedef uint8_t wiced_bt_transport_t;
+
+#define BT_TRANSPORT_BR_EDR 1
+#define BT_TRANSPORT_LE 2
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#include "wiced_result.h"
+
+#endif /* WICED_BT_TYPES_H */
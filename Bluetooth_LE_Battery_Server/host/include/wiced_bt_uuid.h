@@ -0,0 +1,27 @@
+///
+/// \file    wiced_bt_uuid.h
+/// \brief   Host stand-in for the assigned UUID numbers
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_BT_UUID_H
+#define WICED_BT_UUID_H
+
+#define UUID_SERVICE_GAP 0x1800
+#define UUID_SERVICE_GATT 0x1801
+#define UUID_SERVICE_BATTERY 0x180F
+
+#define UUID_CHARACTERISTIC_DEVICE_NAME 0x2A00
+#define UUID_CHARACTERISTIC_APPEARANCE 0x2A01
+#define UUID_CHARACTERISTIC_BATTERY_LEVEL 0x2A19
+
+#define UUID_DESCRIPTOR_CHARACTERISTIC_PRESENTATION_FORMAT 0x2904
+#define UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION 0x2902
+
+#define GATT_UUID_PRI_SERVICE 0x2800
+#define GATT_UUID_CHAR_DECLARE 0x2803
+
+#endif /* WICED_BT_UUID_H */
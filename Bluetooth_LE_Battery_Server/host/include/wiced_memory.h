@@ -0,0 +1,17 @@
+///
+/// \file    wiced_memory.h
+/// \brief   Host stand-in for the WICED memory header
+///
+/// \details src/ allocates nothing from the stack's pools.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_MEMORY_H
+#define WICED_MEMORY_H
+
+#include "wiced_bt_types.h"
+
+#endif /* WICED_MEMORY_H */
@@ -0,0 +1,25 @@
+///
+/// \file    wiced_result.h
+/// \brief   Host stand-in for the WICED result codes
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef WICED_RESULT_H
+#define WICED_RESULT_H
+
+typedef enum wiced_result_t {
+    WICED_BT_SUCCESS = 0,
+    WICED_BT_PENDING = 1,
+    WICED_BT_ERROR = 2,
+    WICED_BT_BUSY = 3,
+    WICED_BT_NO_RESOURCES = 4,
+    WICED_BT_ILLEGAL_VALUE = 5,
+    WICED_BT_UNSUPPORTED = 6
+} wiced_result_t;
+
+typedef wiced_result_t wiced_bt_dev_status_t;
+
+#endif /* WICED_RESULT_H */
@@ -0,0 +1,2311 @@
+///
+/// \file    battery_server_sim.cpp
+/// \brief   Scripted host simulation of the Battery Server
+///
+/// \details Starts the firmware as main.cpp does, then plays a peer: each
+///          scenario delivers GATT and management events to the real
+///          ble_gatt_event_callback() and connection handler and checks what
+///          the firmware sends back. A failed check makes the process exit
+///          non-zero, so every scenario is a CTest test, and the same binary
+///          runs under perf or the sanitizers.
+///
+///          battery_server_sim <scenario> [iterations]
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cybsp.h"
+#include "cycfg_gatt_db.h"
+
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include "app_event_task.hpp"
+#include "battery_gauge.hpp"
+#include "battery_service_task.hpp"
+#include "ble_advertising_schedule.hpp"
+#include "ble_context.hpp"
+#include "ble_gatt.hpp"
+#include "ble_gatt_db.hpp"
+#include "ble_gatt_statistics.hpp"
+#include "ble_link_optimizer.hpp"
+#include "crc32.hpp"
+#include "delta_patch.hpp"
+#include "ota_image_decoder.hpp"
+#include "ota_l2cap_channel.hpp"
+#include "ota_staging.hpp"
+#include "ota_writer_task.hpp"
+#include "resource.hpp"
+
+#include "host_platform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+/// Longest time a check waits for the firmware's tasks
+constexpr auto SIM_WAIT = std::chrono::milliseconds{3000};
+
+/// ATT MTU the simulated peers negotiate
+constexpr auto SIM_MTU = uint16_t{247};
+
+auto failures = 0;
+
+#define SIM_CHECK(condition)                                                  \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__,       \
+                         __LINE__, #condition);                               \
+            ++failures;                                                       \
+        }                                                                     \
+    } while (false)
+
+using records = std::vector<host::bt_record>;
+using bytes = std::vector<uint8_t>;
+
+///
+/// \brief Find the first record of a kind
+///
+const host::bt_record *find(const records &sent, host::bt_kind kind) {
+    auto it = std::find_if(
+        sent.begin(), sent.end(),
+        [kind](const host::bt_record &record) { return record.kind == kind; });
+
+    return (it != sent.end()) ? &*it : nullptr;
+}
+
+///
+/// \brief Find the last record of a kind
+///
+const host::bt_record *find_last(const records &sent, host::bt_kind kind) {
+    auto it = std::find_if(
+        sent.rbegin(), sent.rend(),
+        [kind](const host::bt_record &record) { return record.kind == kind; });
+
+    return (it != sent.rend()) ? &*it : nullptr;
+}
+
+///
+/// \brief Collect what the tasks send until a matching record shows up
+///
+/// \return records Everything sent meanwhile; ends with the record if it
+///         arrived in time
+///
+template <typename predicate_type>
+records wait_until(predicate_type &&matches,
+                   std::chrono::milliseconds timeout = SIM_WAIT) {
+    auto sent = records{};
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        host::bt_transmit();
+
+        for (auto &record : host::bt_take()) {
+            const auto match = matches(record);
+
+            sent.push_back(std::move(record));
+
+            if (match) {
+                return sent;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    return sent;
+}
+
+///
+/// \brief Collect what the tasks send until a record of a kind shows up
+///
+records wait_for(host::bt_kind kind, uint16_t conn_id,
+                 std::chrono::milliseconds timeout = SIM_WAIT) {
+    return wait_until(
+        [kind, conn_id](const host::bt_record &record) {
+            return record.kind == kind && record.conn_id == conn_id;
+        },
+        timeout);
+}
+
+///
+/// \brief Add what the tasks send until a notification to a connection,
+///        unless \p sent already holds one
+///
+records until_notified(records sent, uint16_t conn_id) {
+    const auto notified = std::any_of(
+        sent.begin(), sent.end(), [conn_id](const host::bt_record &record) {
+            return record.kind == host::bt_kind::notification &&
+                   record.conn_id == conn_id;
+        });
+
+    if (!notified) {
+        const auto later = wait_for(host::bt_kind::notification, conn_id);
+        sent.insert(sent.end(), later.begin(), later.end());
+    }
+
+    return sent;
+}
+
+///
+/// \brief Connections notified, in order
+///
+std::vector<uint16_t> notified(const records &sent) {
+    auto connection_ids = std::vector<uint16_t>{};
+
+    for (const auto &record : sent) {
+        if (record.kind == host::bt_kind::notification) {
+            connection_ids.push_back(record.conn_id);
+        }
+    }
+
+    return connection_ids;
+}
+
+///
+/// \brief Deliver an event on the stack thread and transmit the responses
+///
+records deliver(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t &data) {
+    host::bt_gatt(event, &data);
+    host::bt_transmit();
+
+    return host::bt_take();
+}
+
+records connect(uint16_t conn_id) {
+    wiced_bt_device_address_t address = {0x00, 0x50, 0xC2, 0x00, 0x00,
+                                         static_cast<uint8_t>(conn_id)};
+    auto event = wiced_bt_gatt_event_data_t{};
+
+    event.connection_status.bd_addr = address;
+    event.connection_status.conn_id = conn_id;
+    event.connection_status.connected = WICED_TRUE;
+    event.connection_status.transport = BT_TRANSPORT_LE;
+    event.connection_status.addr_type = BLE_ADDR_PUBLIC;
+
+    return deliver(GATT_CONNECTION_STATUS_EVT, event);
+}
+
+records disconnect(uint16_t conn_id) {
+    wiced_bt_device_address_t address = {0x00, 0x50, 0xC2, 0x00, 0x00,
+                                         static_cast<uint8_t>(conn_id)};
+    auto event = wiced_bt_gatt_event_data_t{};
+
+    event.connection_status.bd_addr = address;
+    event.connection_status.conn_id = conn_id;
+    event.connection_status.connected = WICED_FALSE;
+    event.connection_status.reason = 0x13;
+    event.connection_status.transport = BT_TRANSPORT_LE;
+
+    return deliver(GATT_CONNECTION_STATUS_EVT, event);
+}
+
+///
+/// \brief Start an attribute request
+///
+wiced_bt_gatt_event_data_t request(uint16_t conn_id,
+                                   wiced_bt_gatt_opcode_t opcode) {
+    auto event = wiced_bt_gatt_event_data_t{};
+
+    event.attribute_request.conn_id = conn_id;
+    event.attribute_request.opcode = opcode;
+    event.attribute_request.len_requested = SIM_MTU - 1;
+
+    return event;
+}
+
+records exchange_mtu(uint16_t conn_id, uint16_t mtu) {
+    auto event = request(conn_id, GATT_REQ_MTU);
+    event.attribute_request.data.remote_mtu = mtu;
+
+    return deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+}
+
+records read(uint16_t conn_id, uint16_t handle, uint16_t offset = 0) {
+    auto event =
+        request(conn_id, (offset == 0) ? GATT_REQ_READ : GATT_REQ_READ_BLOB);
+    event.attribute_request.data.read_req.handle = handle;
+    event.attribute_request.data.read_req.offset = offset;
+
+    return deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+}
+
+records read_by_type(uint16_t conn_id, uint16_t uuid16) {
+    auto event = request(conn_id, GATT_REQ_READ_BY_TYPE);
+    auto &read_by_type = event.attribute_request.data.read_by_type;
+
+    read_by_type.s_handle = 0x0001;
+    read_by_type.e_handle = 0xFFFF;
+    read_by_type.uuid.len = LEN_UUID_16;
+    read_by_type.uuid.uu.uuid16 = uuid16;
+
+    return deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+}
+
+records read_multiple(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                      std::vector<uint16_t> handles) {
+    auto stream = bytes{};
+
+    for (auto handle : handles) {
+        stream.push_back(static_cast<uint8_t>(handle));
+        stream.push_back(static_cast<uint8_t>(handle >> 8));
+    }
+
+    auto event = request(conn_id, opcode);
+    event.attribute_request.data.read_multiple_req.num_handles =
+        static_cast<int>(handles.size());
+    event.attribute_request.data.read_multiple_req.p_handle_stream =
+        stream.data();
+
+    return deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+}
+
+///
+/// \brief Whether a record answers a write request on a connection
+///
+bool answers_write(const host::bt_record &record, uint16_t conn_id) {
+    return (record.kind == host::bt_kind::write_rsp ||
+            record.kind == host::bt_kind::error_rsp) &&
+           record.conn_id == conn_id;
+}
+
+///
+/// \brief Write a value, waiting for the response of a write request the
+///        server holds back
+///
+records write(uint16_t conn_id, uint16_t handle, bytes value,
+              wiced_bt_gatt_opcode_t opcode = GATT_REQ_WRITE,
+              uint16_t offset = 0) {
+    auto event = request(conn_id, opcode);
+    auto &write_request = event.attribute_request.data.write_req;
+
+    write_request.handle = handle;
+    write_request.offset = offset;
+    write_request.val_len = static_cast<uint16_t>(value.size());
+    write_request.p_val = value.data();
+
+    auto sent = deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+
+    const auto answered =
+        std::any_of(sent.begin(), sent.end(), [conn_id](const auto &record) {
+            return answers_write(record, conn_id);
+        });
+
+    if (opcode == GATT_REQ_WRITE && !answered) {
+        // OTA data waiting for a staging buffer, or a verify waiting for
+        // flash: the application task answers once the writer catches up
+        const auto later = wait_until([conn_id](const auto &record) {
+            return answers_write(record, conn_id);
+        });
+        sent.insert(sent.end(), later.begin(), later.end());
+    }
+
+    return sent;
+}
+
+records execute(uint16_t conn_id, wiced_bt_gatt_exec_flag_t flag) {
+    auto event = request(conn_id, GATT_REQ_EXECUTE_WRITE);
+    event.attribute_request.data.exec_write_req.exec_write = flag;
+
+    return deliver(GATT_ATTRIBUTE_REQUEST_EVT, event);
+}
+
+///
+/// \brief Status of an error response, or success if there was none
+///
+uint8_t error_of(const records &sent) {
+    const auto *error = find(sent, host::bt_kind::error_rsp);
+    return (error != nullptr) ? error->status : uint8_t{WICED_BT_GATT_SUCCESS};
+}
+
+bytes text(const char *value) {
+    return bytes(value, value + std::strlen(value));
+}
+
+bytes le32(uint8_t command, uint32_t value) {
+    return {command, static_cast<uint8_t>(value),
+            static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 24)};
+}
+
+///
+/// \brief Bytes of heap in use
+///
+/// Zero where the allocator does not say, as under the sanitizers.
+///
+std::size_t heap_in_use() {
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+///
+/// \brief Mixed Read Multiple requests from two connections, checking the
+///        heap and the response pool do not grow
+///
+/// Connection 1 must be open. Lists mix values sent in place, per-connection
+/// values built in the scratch buffers, unknown and unreadable handles, and
+/// now and then a send the stack refuses.
+///
+void stress_read_multiple(long requests) {
+    const std::vector<uint16_t> lists[] = {
+        {HDLC_GAP_APPEARANCE_VALUE, HDLC_BAS_BATTERY_LEVEL_VALUE},
+        {HDLC_GAP_DEVICE_NAME_VALUE, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+         HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT},
+        {HDLC_BAS_BATTERY_LEVEL_VALUE, 0x0040},
+        {HDLC_GAP_APPEARANCE_VALUE,
+         HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE},
+    };
+
+    connect(2);
+    exchange_mtu(2, SIM_MTU);
+
+    const auto pool_before = ble_gatt_response_pool_stats();
+    auto heap_low = SIZE_MAX;
+    auto heap_high = std::size_t{};
+    auto errors = long{};
+
+    for (auto i = long{}; i < requests; i++) {
+        const auto &handles = lists[i % 4];
+        const auto opcode = ((i / 4) % 2 == 0)
+                                ? GATT_REQ_READ_MULTI
+                                : GATT_REQ_READ_MULTI_VAR_LENGTH;
+
+        if (i % 97 == 0) {
+            host::bt_fail_sends(1);
+        }
+
+        const auto sent =
+            read_multiple(static_cast<uint16_t>(1 + i % 2), opcode, handles);
+        errors += (error_of(sent) != WICED_BT_GATT_SUCCESS) ? 1 : 0;
+
+        // Sampled once the first requests have bound every buffer
+        if (i >= 1000 && i % 10000 == 0) {
+            heap_low = std::min(heap_low, heap_in_use());
+            heap_high = std::max(heap_high, heap_in_use());
+        }
+    }
+
+    host::bt_fail_sends(0);
+
+    const auto pool_after = ble_gatt_response_pool_stats();
+
+    SIM_CHECK(errors >= requests / 2);
+    SIM_CHECK(heap_high - heap_low <= 1024);
+    SIM_CHECK(pool_after.in_use == 0);
+    SIM_CHECK(pool_after.high_water_mark == pool_before.high_water_mark);
+
+    std::printf("{\"sim_read_multiple\":{\"requests\":%ld,\"errors\":%ld,"
+                "\"heap_low\":%zu,\"heap_high\":%zu,"
+                "\"pool_high_water_mark\":%u}}\n",
+                requests, errors, heap_low, heap_high,
+                static_cast<unsigned>(pool_after.high_water_mark));
+
+    disconnect(2);
+}
+
+///
+/// \brief Reads of every kind the GATT server answers
+///
+void scenario_gatt_reads() {
+    SIM_CHECK(ble_gatt_db_matches_configurator());
+
+    connect(1);
+
+    auto sent = exchange_mtu(1, SIM_MTU);
+    SIM_CHECK(find(sent, host::bt_kind::mtu_rsp) != nullptr);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(sent.size() == 1 && sent[0].kind == host::bt_kind::read_rsp);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Server"));
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE, 8);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Server"));
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE, 14);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_OFFSET);
+
+    sent = read(1, HDLC_BAS_BATTERY_LEVEL_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data.size() == 1 &&
+              sent[0].data[0] == app_bas_battery_level[0]);
+
+    sent = read(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG);
+    SIM_CHECK(!sent.empty() && sent[0].data == (bytes{0x00, 0x00}));
+
+    sent = read_by_type(1, UUID_CHARACTERISTIC_BATTERY_LEVEL);
+    SIM_CHECK(!sent.empty() &&
+              sent[0].kind == host::bt_kind::read_by_type_rsp &&
+              sent[0].data == (bytes{0x09, 0x00, app_bas_battery_level[0]}));
+
+    sent = read_multiple(1, GATT_REQ_READ_MULTI,
+                         {HDLC_GAP_APPEARANCE_VALUE,
+                          HDLC_BAS_BATTERY_LEVEL_VALUE});
+    SIM_CHECK(!sent.empty() && sent[0].kind == host::bt_kind::read_multi_rsp &&
+              sent[0].data ==
+                  (bytes{0x00, 0x00, app_bas_battery_level[0]}));
+
+    sent = read_multiple(1, GATT_REQ_READ_MULTI_VAR_LENGTH,
+                         {HDLC_GAP_APPEARANCE_VALUE,
+                          HDLC_BAS_BATTERY_LEVEL_VALUE});
+    SIM_CHECK(!sent.empty() &&
+              sent[0].data == (bytes{0x02, 0x00, 0x00, 0x00, 0x01, 0x00,
+                                     app_bas_battery_level[0]}));
+
+    // A refused send is reported to the peer, and frees what it held
+    for (const auto opcode : {GATT_REQ_READ_MULTI,
+                              GATT_REQ_READ_MULTI_VAR_LENGTH}) {
+        for (auto attempt = 0; attempt < 3; attempt++) {
+            host::bt_fail_sends(1);
+            sent = read_multiple(1, opcode, {HDLC_BAS_BATTERY_LEVEL_VALUE});
+            SIM_CHECK(error_of(sent) == WICED_BT_GATT_BUSY);
+        }
+
+        sent = read_multiple(1, opcode, {HDLC_BAS_BATTERY_LEVEL_VALUE});
+        SIM_CHECK(!sent.empty() &&
+                  sent[0].kind == host::bt_kind::read_multi_rsp);
+    }
+
+    sent = read(1, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_READ_NOT_PERMIT);
+
+    sent = read(1, 0x0040);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_HANDLE);
+
+    stress_read_multiple(1000000);
+
+    disconnect(1);
+}
+
+///
+/// \brief Writes, prepared writes and the first battery notification
+///
+void scenario_gatt_writes() {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    auto sent = write(1, HDLC_GAP_APPEARANCE_VALUE, {0xC1, 0x03});
+    SIM_CHECK(find(sent, host::bt_kind::write_rsp) != nullptr);
+
+    sent = read(1, HDLC_GAP_APPEARANCE_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == (bytes{0xC1, 0x03}));
+
+    // A long write in two fragments, applied on execute
+    sent = write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Cli"),
+                 GATT_REQ_PREPARE_WRITE, 8);
+    SIM_CHECK(find(sent, host::bt_kind::prepare_write_rsp) != nullptr);
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("ent"), GATT_REQ_PREPARE_WRITE,
+          11);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Server"));
+
+    sent = execute(1, GATT_PREPARE_WRITE_EXEC);
+    SIM_CHECK(find(sent, host::bt_kind::execute_write_rsp) != nullptr);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Client"));
+
+    // Cancelled fragments are never applied
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Server"),
+          GATT_REQ_PREPARE_WRITE, 8);
+    sent = execute(1, GATT_PREPARE_WRITE_CANCEL);
+    SIM_CHECK(find(sent, host::bt_kind::execute_write_rsp) != nullptr);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Client"));
+
+    // Fragments past the end of the value fail as a whole
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Servers"),
+          GATT_REQ_PREPARE_WRITE, 8);
+    sent = execute(1, GATT_PREPARE_WRITE_EXEC);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Client"));
+
+    // A value its attribute refuses fails the queue before anything is
+    // written: the CCCD takes exactly two bytes
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Server"),
+          GATT_REQ_PREPARE_WRITE, 8);
+    write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x01},
+          GATT_REQ_PREPARE_WRITE, 0);
+    sent = execute(1, GATT_PREPARE_WRITE_EXEC);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+    SIM_CHECK(find(sent, host::bt_kind::error_rsp) != nullptr &&
+              find(sent, host::bt_kind::error_rsp)->handle ==
+                  HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Client"));
+
+    // So does the OTA CCCD, written or prepared
+    constexpr auto ota_cccd =
+        HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG;
+
+    sent = write(1, ota_cccd, {});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+
+    sent = write(1, ota_cccd, {0x01, 0x00, 0x00});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+
+    write(1, ota_cccd, {0x01}, GATT_REQ_PREPARE_WRITE, 0);
+    sent = execute(1, GATT_PREPARE_WRITE_EXEC);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+
+    // And an unknown OTA command
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Server"),
+          GATT_REQ_PREPARE_WRITE, 8);
+    write(1, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+          {0x7F}, GATT_REQ_PREPARE_WRITE, 0);
+    sent = execute(1, GATT_PREPARE_WRITE_EXEC);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_REQ_NOT_SUPPORTED);
+
+    sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == text("Battery Client"));
+
+    write(1, HDLC_GAP_DEVICE_NAME_VALUE, text("Battery Server"));
+
+    // A new subscriber is sent the current level at once
+    sent = write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x01, 0x00});
+    SIM_CHECK(find(sent, host::bt_kind::write_rsp) != nullptr);
+
+    // The battery task may have sent it before the write response was taken
+    sent = until_notified(sent, 1);
+
+    const auto *notification = find(sent, host::bt_kind::notification);
+    SIM_CHECK(notification != nullptr &&
+              notification->handle == HDLC_BAS_BATTERY_LEVEL_VALUE &&
+              notification->data == (bytes{app_bas_battery_level[0]}));
+
+    sent = read(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG);
+    SIM_CHECK(!sent.empty() && sent[0].data == (bytes{0x01, 0x00}));
+
+    disconnect(1);
+}
+
+///
+/// \brief A battery level change fanned out to a full table of subscribers
+///
+void check_fan_out() {
+    for (auto conn_id = uint16_t{1}; conn_id <= BLE_MAX_CONNECTIONS;
+         ++conn_id) {
+        connect(conn_id);
+        exchange_mtu(conn_id, SIM_MTU);
+
+        const auto sent =
+            write(conn_id, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+                  {0x01, 0x00});
+        SIM_CHECK(notified(until_notified(sent, conn_id)) ==
+                  std::vector<uint16_t>{conn_id});
+    }
+
+    // Peers past the table are refused, up to twice its size
+    for (auto conn_id = uint16_t{BLE_MAX_CONNECTIONS + 1};
+         conn_id <= 2 * BLE_MAX_CONNECTIONS; ++conn_id) {
+        const auto sent = connect(conn_id);
+        const auto *refused = find(sent, host::bt_kind::disconnect);
+        SIM_CHECK(refused != nullptr && refused->conn_id == conn_id);
+    }
+
+    const auto before = app_bas_battery_level[0];
+
+    // A charged cell, measured on the next battery update period
+    host::adc_set_microvolts(4'100'000 / 2);
+    host::advance_time(std::chrono::seconds{10});
+
+    auto sent = records{};
+    const auto deadline = std::chrono::steady_clock::now() + SIM_WAIT;
+
+    while (notified(sent).size() < BLE_MAX_CONNECTIONS &&
+           std::chrono::steady_clock::now() < deadline) {
+        const auto later =
+            wait_for(host::bt_kind::notification, BLE_MAX_CONNECTIONS,
+                     std::chrono::milliseconds{100});
+        sent.insert(sent.end(), later.begin(), later.end());
+    }
+
+    // One pass, in table order, all carrying the same new level
+    auto expected = std::vector<uint16_t>{};
+
+    for (auto conn_id = uint16_t{1}; conn_id <= BLE_MAX_CONNECTIONS;
+         ++conn_id) {
+        expected.push_back(conn_id);
+    }
+
+    SIM_CHECK(notified(sent) == expected);
+
+    for (const auto &record : sent) {
+        if (record.kind == host::bt_kind::notification) {
+            SIM_CHECK(record.data == bytes{app_bas_battery_level[0]});
+            SIM_CHECK(record.data != bytes{before});
+        }
+    }
+
+    host::adc_set_microvolts(3'700'000 / 2);
+
+    for (auto conn_id = uint16_t{1}; conn_id <= BLE_MAX_CONNECTIONS;
+         ++conn_id) {
+        disconnect(conn_id);
+    }
+
+    SIM_CHECK(!ble_context_object.connected());
+}
+
+///
+/// \brief Wait for the application event task to empty its queue
+///
+app_event_queue_type::statistics app_events_drained() {
+    auto stats = app_event_queue_stats();
+    const auto deadline = std::chrono::steady_clock::now() + SIM_WAIT;
+
+    while (stats.depth != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        stats = app_event_queue_stats();
+    }
+
+    return stats;
+}
+
+///
+/// \brief Connection churn at link pace never drops deferred work
+///
+void check_deferred_events() {
+    // A peer that stays keeps the statistics from being printed and reset
+    connect(1);
+
+    auto before = app_events_drained();
+
+    // Connection events are at least a connection interval apart on air
+    for (auto cycle = 0; cycle < 200; ++cycle) {
+        connect(2);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        disconnect(2);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    auto after = app_events_drained();
+
+    // Each connection event defers at least an LED update, all serviced
+    SIM_CHECK(after.depth == 0);
+    SIM_CHECK(after.pushed - before.pushed >= 2 * 200);
+    SIM_CHECK(after.dropped == before.dropped);
+
+    std::printf("sim_app_events paced pushed=%lu dropped=%lu "
+                "high_water=%lu\n",
+                static_cast<unsigned long>(after.pushed - before.pushed),
+                static_cast<unsigned long>(after.dropped - before.dropped),
+                static_cast<unsigned long>(after.high_water_mark));
+
+    // Far faster than any link: a full queue drops and counts, then drains
+    before = after;
+
+    for (auto cycle = 0; cycle < 200; ++cycle) {
+        connect(2);
+        disconnect(2);
+    }
+
+    after = app_events_drained();
+
+    SIM_CHECK(after.depth == 0);
+    SIM_CHECK(after.high_water_mark <= APP_EVENT_QUEUE_CAPACITY);
+
+    std::printf("sim_app_events burst pushed=%lu dropped=%lu "
+                "high_water=%lu\n",
+                static_cast<unsigned long>(after.pushed - before.pushed),
+                static_cast<unsigned long>(after.dropped - before.dropped),
+                static_cast<unsigned long>(after.high_water_mark));
+
+    disconnect(1);
+}
+
+///
+/// \brief Connection parameters as the stack records a request for them
+///
+bytes parameters_of(const ble_link_parameters &parameters) {
+    const auto le16 = [](bytes &out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    };
+
+    auto out = bytes{};
+
+    le16(out, parameters.min_interval);
+    le16(out, parameters.max_interval);
+    le16(out, parameters.latency);
+    le16(out, parameters.supervision_timeout);
+
+    return out;
+}
+
+///
+/// \brief Kinds of the link requests among \p sent, in order
+///
+std::vector<host::bt_kind> link_requests(const records &sent) {
+    auto kinds = std::vector<host::bt_kind>{};
+
+    for (const auto &record : sent) {
+        if (record.kind == host::bt_kind::phy ||
+            record.kind == host::bt_kind::data_length ||
+            record.kind == host::bt_kind::connection_params) {
+            kinds.push_back(record.kind);
+        }
+    }
+
+    return kinds;
+}
+
+///
+/// \brief Skip simulated time in steps until the link optimizer asks for
+///        connection parameters
+///
+/// The policy timer only posts an event, so each step leaves the
+/// application event task time to evaluate before the next.
+///
+records skip_until_parameters() {
+    constexpr auto step = std::chrono::milliseconds{100};
+    constexpr auto limit = std::chrono::milliseconds{
+        2 * (BLE_TRAFFIC_DISCOVERY_MS + BLE_TRAFFIC_DWELL_MS)};
+
+    auto sent = records{};
+
+    for (auto skipped = std::chrono::milliseconds{}; skipped < limit;
+         skipped += step) {
+        host::advance_time(step);
+
+        const auto later = wait_for(host::bt_kind::connection_params, 0,
+                                    std::chrono::milliseconds{2});
+        sent.insert(sent.end(), later.begin(), later.end());
+
+        if (find(sent, host::bt_kind::connection_params) != nullptr) {
+            break;
+        }
+    }
+
+    return sent;
+}
+
+///
+/// \brief The link optimizer's requests over one connection: bulk while
+///        discovering, idle once it is over, bulk again for a download
+///
+void check_link_requests() {
+    using kinds = std::vector<host::bt_kind>;
+    using milliseconds = std::chrono::milliseconds;
+
+    constexpr auto control_point =
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE;
+
+    // Discovery is bulk: 2M PHY, the longest LL packets and the shortest
+    // interval, in that order
+    auto since = host::uptime();
+    auto sent = connect(1);
+    SIM_CHECK(link_requests(sent) == (kinds{host::bt_kind::phy,
+                                            host::bt_kind::data_length,
+                                            host::bt_kind::connection_params}));
+
+    const auto *phy = find(sent, host::bt_kind::phy);
+    SIM_CHECK(phy != nullptr &&
+              phy->data == (bytes{BTM_BLE_PREFER_2M_PHY,
+                                  BTM_BLE_PREFER_2M_PHY}));
+
+    const auto *data_length = find(sent, host::bt_kind::data_length);
+    SIM_CHECK(data_length != nullptr &&
+              data_length->handle == BLE_LINK_MAX_TX_OCTETS);
+
+    const auto *parameters = find(sent, host::bt_kind::connection_params);
+    SIM_CHECK(parameters != nullptr &&
+              parameters->data == parameters_of(BLE_LINK_BULK_PARAMETERS));
+
+    // Discovery over and the dwell waited out, only the interval changes
+    sent = skip_until_parameters();
+    SIM_CHECK(host::uptime() - since >=
+              milliseconds{BLE_TRAFFIC_DISCOVERY_MS + BLE_TRAFFIC_DWELL_MS});
+    SIM_CHECK(link_requests(sent) == kinds{host::bt_kind::connection_params});
+    SIM_CHECK(sent.back().data == parameters_of(BLE_LINK_IDLE_PARAMETERS));
+
+    // A download asks for the bulk interval again, and nothing else
+    sent = write(1, control_point, {CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(link_requests(sent) == kinds{host::bt_kind::connection_params});
+
+    parameters = find(sent, host::bt_kind::connection_params);
+    SIM_CHECK(parameters != nullptr &&
+              parameters->data == parameters_of(BLE_LINK_BULK_PARAMETERS));
+
+    // And gives it up a dwell after it ends
+    since = host::uptime();
+    sent = write(1, control_point, {CY_OTA_UPGRADE_COMMAND_ABORT});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+
+    sent = skip_until_parameters();
+    SIM_CHECK(host::uptime() - since >= milliseconds{BLE_TRAFFIC_DWELL_MS});
+    SIM_CHECK(link_requests(sent) == kinds{host::bt_kind::connection_params});
+    SIM_CHECK(sent.back().data == parameters_of(BLE_LINK_IDLE_PARAMETERS));
+
+    disconnect(1);
+}
+
+///
+/// \brief Skip simulated time in steps until advertising changes
+///
+/// As with the link optimizer, the step timer only posts an event. Sets
+/// \p stepped_at to the uptime before the step the change showed up in,
+/// which is no later than the change itself.
+///
+/// \param expected Time the current step should last
+///
+records skip_until_advertising(std::chrono::milliseconds expected,
+                               std::chrono::nanoseconds &stepped_at) {
+    const auto step = std::max(expected / 20, std::chrono::milliseconds{10});
+    const auto limit = 2 * expected;
+
+    auto sent = records{};
+
+    for (auto skipped = std::chrono::milliseconds{}; skipped < limit;
+         skipped += step) {
+        stepped_at = host::uptime();
+        host::advance_time(step);
+
+        const auto later = wait_for(host::bt_kind::advertising, 0,
+                                    std::chrono::milliseconds{2});
+        sent.insert(sent.end(), later.begin(), later.end());
+
+        if (find(sent, host::bt_kind::advertising) != nullptr) {
+            break;
+        }
+    }
+
+    return sent;
+}
+
+///
+/// \brief The advertising schedule on the simulated clock: directed at a
+///        bonded peer, then fast, slow and the repeating tail, and the
+///        restart when a peer leaves
+///
+void check_advertising_schedule() {
+    using milliseconds = std::chrono::milliseconds;
+
+    wiced_bt_device_address_t peer = {0x00, 0x50, 0xC2, 0x00, 0x00, 0x01};
+    const auto directed_at = bytes(peer, peer + BD_ADDR_LEN);
+
+    // Bond with the first peer
+    connect(1);
+
+    auto pairing = wiced_bt_management_evt_data_t{};
+    auto &info = pairing.pairing_complete.pairing_complete_info.ble;
+
+    pairing.pairing_complete.bd_addr = peer;
+    pairing.pairing_complete.transport = BT_TRANSPORT_LE;
+    info.status = WICED_BT_SUCCESS;
+    info.resolved_bd_addr_type = BLE_ADDR_PUBLIC;
+    std::copy_n(peer, BD_ADDR_LEN, info.resolved_bd_addr);
+
+    SIM_CHECK(host::bt_management(BTM_PAIRING_COMPLETE_EVT, &pairing) ==
+              WICED_BT_SUCCESS);
+
+    // Once it leaves, advertising is directed at it
+    auto since = host::uptime();
+    auto sent = disconnect(1);
+
+    const auto *advertising = find_last(sent, host::bt_kind::advertising);
+    SIM_CHECK(advertising != nullptr &&
+              advertising->handle == BTM_BLE_ADVERT_DIRECTED_HIGH &&
+              advertising->data == directed_at);
+
+    // Then each step in turn, none before its time is up; the tail
+    // repeats from its first step
+    struct expected_step {
+        std::size_t step;              ///< Step that should be ending
+        wiced_bt_ble_advert_mode_t to; ///< Mode of the step after it
+    };
+
+    constexpr expected_step steps[] = {
+        {0, BTM_BLE_ADVERT_UNDIRECTED_HIGH},
+        {1, BTM_BLE_ADVERT_UNDIRECTED_LOW},
+        {2, BTM_BLE_ADVERT_UNDIRECTED_LOW},
+        {3, BTM_BLE_ADVERT_OFF},
+        {4, BTM_BLE_ADVERT_UNDIRECTED_LOW},
+    };
+
+    for (const auto &expected : steps) {
+        const auto duration =
+            milliseconds{BLE_ADVERTISING_SCHEDULE[expected.step].duration_ms};
+        auto stepped_at = std::chrono::nanoseconds{};
+
+        sent = skip_until_advertising(duration, stepped_at);
+        advertising = find(sent, host::bt_kind::advertising);
+
+        SIM_CHECK(advertising != nullptr && advertising->handle == expected.to);
+        SIM_CHECK(host::uptime() - since >= duration);
+
+        since = stepped_at;
+    }
+
+    // A peer connecting while the bonded one is away needs no directed
+    // advertising; leaving restarts it at the bonded peer
+    sent = connect(2);
+    advertising = find_last(sent, host::bt_kind::advertising);
+    SIM_CHECK(advertising != nullptr &&
+              advertising->handle == BTM_BLE_ADVERT_UNDIRECTED_HIGH);
+
+    sent = disconnect(2);
+    advertising = find_last(sent, host::bt_kind::advertising);
+    SIM_CHECK(advertising != nullptr &&
+              advertising->handle == BTM_BLE_ADVERT_DIRECTED_HIGH &&
+              advertising->data == directed_at);
+}
+
+///
+/// \brief Connection table limits and advertising across connections
+///
+void scenario_connections() {
+    for (auto conn_id = uint16_t{1}; conn_id <= BLE_MAX_CONNECTIONS;
+         ++conn_id) {
+        const auto sent = connect(conn_id);
+        SIM_CHECK(find(sent, host::bt_kind::disconnect) == nullptr);
+    }
+
+    SIM_CHECK(ble_context_object.connection_count() == BLE_MAX_CONNECTIONS);
+
+    // The table is full: the next peer is refused
+    auto sent = connect(BLE_MAX_CONNECTIONS + 1);
+    const auto *refused = find(sent, host::bt_kind::disconnect);
+    SIM_CHECK(refused != nullptr &&
+              refused->conn_id == BLE_MAX_CONNECTIONS + 1);
+
+    // Per-connection CCCDs: only the writer's changes
+    auto subscribed =
+        write(2, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x01, 0x00});
+    sent = read(3, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG);
+    SIM_CHECK(!sent.empty() && sent[0].data == (bytes{0x00, 0x00}));
+
+    subscribed.insert(subscribed.end(), sent.begin(), sent.end());
+    SIM_CHECK(notified(until_notified(subscribed, 2)) ==
+              std::vector<uint16_t>{2});
+
+    // Only a new subscriber is sent the current level
+    sent = write(3, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x01, 0x00});
+    SIM_CHECK(notified(until_notified(sent, 3)) == std::vector<uint16_t>{3});
+
+    // Unsubscribing and subscribing again before the task wakes still
+    // counts as a new subscription
+    sent = write(2, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x00, 0x00});
+    subscribed =
+        write(2, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x01, 0x00});
+    sent.insert(sent.end(), subscribed.begin(), subscribed.end());
+    SIM_CHECK(notified(until_notified(sent, 2)) == std::vector<uint16_t>{2});
+
+    disconnect(2);
+    SIM_CHECK(ble_context_object.connection_count() == BLE_MAX_CONNECTIONS - 1);
+
+    sent = connect(BLE_MAX_CONNECTIONS + 2);
+    SIM_CHECK(find(sent, host::bt_kind::disconnect) == nullptr);
+
+    sent.clear();
+
+    for (auto conn_id :
+         {uint16_t{1}, uint16_t{3}, uint16_t{4},
+          static_cast<uint16_t>(BLE_MAX_CONNECTIONS + 2)}) {
+        const auto closed = disconnect(conn_id);
+        sent.insert(sent.end(), closed.begin(), closed.end());
+    }
+
+    SIM_CHECK(!ble_context_object.connected());
+
+    // Advertising resumes once the last peer has gone
+    const auto later = wait_for(host::bt_kind::advertising, 0,
+                                std::chrono::milliseconds{200});
+    sent.insert(sent.end(), later.begin(), later.end());
+
+    const auto *advertising = find_last(sent, host::bt_kind::advertising);
+    SIM_CHECK(advertising != nullptr &&
+              advertising->handle != BTM_BLE_ADVERT_OFF);
+
+    check_fan_out();
+    check_deferred_events();
+    check_link_requests();
+    check_advertising_schedule();
+}
+
+///
+/// \brief Test image of a given size
+///
+bytes image_of(std::size_t size, uint8_t seed) {
+    auto image = bytes(size);
+
+    for (auto i = std::size_t{}; i < size; ++i) {
+        image[i] = static_cast<uint8_t>((i * 31 + seed) ^ (i >> 9));
+    }
+
+    return image;
+}
+
+///
+/// \brief Encode \p image as a delta against \p base of the same size
+///
+/// Each block seeks to its own offset, replaces its first four bytes and
+/// copies the rest from the base.
+///
+bytes delta_of(const bytes &base, const bytes &image, uint32_t base_crc) {
+    const auto le16 = [](bytes &out, std::size_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    };
+    const auto le32_of = [](bytes &out, std::size_t value) {
+        for (auto shift = 0; shift < 32; shift += 8) {
+            out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    };
+
+    auto delta = bytes(OTA_IMAGE_DELTA_MAGIC.begin(),
+                       OTA_IMAGE_DELTA_MAGIC.end());
+    le32_of(delta, image.size());
+    le16(delta, OTA_STAGING_BUFFER_SIZE);
+    le16(delta, OTA_IMAGE_FORMAT_VERSION);
+    le32_of(delta, base.size());
+    le32_of(delta, base_crc);
+
+    for (auto block = std::size_t{}; block < image.size();
+         block += OTA_STAGING_BUFFER_SIZE) {
+        const auto length =
+            std::min(OTA_STAGING_BUFFER_SIZE, image.size() - block);
+
+        delta.push_back(
+            static_cast<uint8_t>(util::delta_patcher::opcode::seek));
+        le32_of(delta, block);
+
+        delta.push_back(
+            static_cast<uint8_t>(util::delta_patcher::opcode::modify));
+        le16(delta, 4);
+        const auto first =
+            image.begin() + static_cast<std::ptrdiff_t>(block);
+        delta.insert(delta.end(), first, first + 4);
+
+        delta.push_back(
+            static_cast<uint8_t>(util::delta_patcher::opcode::copy));
+        le16(delta, length - 4);
+    }
+
+    return delta;
+}
+
+///
+/// \brief Test image that compresses roughly as firmware does
+///
+/// Instructions drawn from a small set of opcodes, sequences that recur
+/// within a kilobyte, and erased (0xFF) padding at the end of each
+/// kilobyte.
+///
+bytes firmware_of(std::size_t size) {
+    auto image = bytes{};
+    auto state = uint32_t{7};
+
+    const auto next = [&state](uint32_t bound) {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % bound;
+    };
+
+    while (image.size() < size) {
+        const auto at = image.size();
+
+        if (at % 1024 >= 960) {
+            image.push_back(0xFF);
+        } else if (at >= 64 && next(8) < 3) {
+            // A sequence seen earlier in the window
+            const auto distance = 1 + next(static_cast<uint32_t>(
+                                          std::min<std::size_t>(at, 1024)));
+            const auto length = 4 + next(24);
+
+            for (auto i = std::size_t{}; i < length; i++) {
+                image.push_back(image[image.size() - distance]);
+            }
+        } else {
+            for (auto i = 0; i < 4; i++) {
+                image.push_back(static_cast<uint8_t>(0x40 | next(32)));
+            }
+        }
+    }
+
+    image.resize(size);
+
+    return image;
+}
+
+///
+/// \brief Compress \p image as scripts/compress-ota-image.py does
+///
+/// Greedy longest match over the whole window, block by block.
+///
+bytes lzss_of(const bytes &image) {
+    constexpr auto max_match = util::lzss_decoder::MIN_MATCH + 63;
+
+    auto stream = bytes(OTA_IMAGE_LZSS_MAGIC.begin(),
+                        OTA_IMAGE_LZSS_MAGIC.end());
+
+    for (auto shift = 0; shift < 32; shift += 8) {
+        stream.push_back(static_cast<uint8_t>(image.size() >> shift));
+    }
+
+    stream.push_back(static_cast<uint8_t>(OTA_STAGING_BUFFER_SIZE));
+    stream.push_back(static_cast<uint8_t>(OTA_STAGING_BUFFER_SIZE >> 8));
+    stream.push_back(static_cast<uint8_t>(OTA_IMAGE_FORMAT_VERSION));
+    stream.push_back(static_cast<uint8_t>(OTA_IMAGE_FORMAT_VERSION >> 8));
+
+    for (auto block = std::size_t{}; block < image.size();
+         block += OTA_STAGING_BUFFER_SIZE) {
+        const auto end = std::min(block + OTA_STAGING_BUFFER_SIZE,
+                                  image.size());
+        auto position = block;
+
+        while (position < end) {
+            const auto flag_index = stream.size();
+            stream.push_back(0);
+
+            for (auto bit = 0; bit < 8 && position < end; bit++) {
+                const auto limit = std::min(max_match, end - position);
+                const auto window_start =
+                    (position - block > util::lzss_decoder::WINDOW_SIZE)
+                        ? position - util::lzss_decoder::WINDOW_SIZE
+                        : block;
+                auto best_length = std::size_t{};
+                auto best_distance = std::size_t{};
+
+                for (auto candidate = window_start; candidate < position;
+                     candidate++) {
+                    auto length = std::size_t{};
+
+                    while (length < limit &&
+                           image[candidate + length] ==
+                               image[position + length]) {
+                        length++;
+                    }
+
+                    if (length > best_length) {
+                        best_length = length;
+                        best_distance = position - candidate;
+                    }
+                }
+
+                if (best_length < util::lzss_decoder::MIN_MATCH) {
+                    stream[flag_index] |= static_cast<uint8_t>(1 << bit);
+                    stream.push_back(image[position]);
+                    position++;
+                    continue;
+                }
+
+                const auto token = static_cast<uint16_t>(
+                    (best_distance - 1) << 6 |
+                    (best_length - util::lzss_decoder::MIN_MATCH));
+
+                stream.push_back(static_cast<uint8_t>(token >> 8));
+                stream.push_back(static_cast<uint8_t>(token));
+                position += best_length;
+            }
+        }
+    }
+
+    return stream;
+}
+
+///
+/// \brief Open an OTA session on the control point
+///
+/// \return records What the download command sent
+///
+records ota_begin(uint16_t conn_id, uint32_t image_size) {
+    write(conn_id,
+          HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG,
+          {0x01, 0x00});
+
+    auto sent = write(
+        conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+        {CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+
+    // Busy while the writer drops the buffers of an aborted image
+    const auto deadline = std::chrono::steady_clock::now() + SIM_WAIT;
+
+    do {
+        sent = write(
+            conn_id,
+            HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+            le32(CY_OTA_UPGRADE_COMMAND_DOWNLOAD, image_size));
+    } while (error_of(sent) == WICED_BT_GATT_BUSY &&
+             std::chrono::steady_clock::now() < deadline);
+
+    return sent;
+}
+
+///
+/// \brief Send part of an image through the OTA data characteristic
+///
+void ota_send(uint16_t conn_id, const bytes &image, std::size_t begin,
+              std::size_t end, uint16_t mtu = SIM_MTU) {
+    const auto chunk = std::size_t{mtu - 3u};
+
+    for (auto offset = begin; offset < end; offset += chunk) {
+        const auto length = std::min(chunk, end - offset);
+        const auto sent =
+            write(conn_id, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE,
+                  bytes(image.begin() + static_cast<std::ptrdiff_t>(offset),
+                        image.begin() +
+                            static_cast<std::ptrdiff_t>(offset + length)));
+
+        SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    }
+}
+
+///
+/// \brief OTA data writes needed for a payload
+///
+std::size_t ota_writes(std::size_t size) {
+    constexpr auto chunk = std::size_t{SIM_MTU - 3};
+    return (size + chunk - 1) / chunk;
+}
+
+///
+/// \brief Bytes a payload puts on air as OTA data writes, each carrying
+///        its 3-byte ATT opcode and handle
+///
+std::size_t ota_on_air(std::size_t size) { return size + 3 * ota_writes(size); }
+
+records ota_verify(uint16_t conn_id, const bytes &image) {
+    return write(conn_id,
+                 HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+                 le32(CY_OTA_UPGRADE_COMMAND_VERIFY,
+                      util::crc32::of(image.data(), image.size())));
+}
+
+///
+/// \brief Hold the next SDU back while the server holds one
+///
+/// Credits pace a real peer; the server closes the channel on an SDU that
+/// arrives while another is still held.
+///
+void ota_l2cap_paced() {
+    const auto deadline = std::chrono::steady_clock::now() + SIM_WAIT;
+
+    while (ble_context_object.ota_deferred() &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+}
+
+///
+/// \brief A download on connection 2 that loses its link at random points
+///
+/// Each time the peer reconnects and continues from the offset the server
+/// sends, which is the end of the last buffer handed to flash; the partial
+/// buffer dropped with the link is sent again.
+///
+void check_random_drops() {
+    const auto image = image_of(6 * OTA_STAGING_BUFFER_SIZE + 1234, 17);
+    const auto image_size = static_cast<uint32_t>(image.size());
+
+    auto random_state = uint32_t{12345};
+    auto position = std::size_t{};
+    auto sent_bytes = std::size_t{};
+    auto retransmitted = std::size_t{};
+    auto drops = 0;
+
+    ota_begin(2, image_size);
+
+    while (position < image.size()) {
+        random_state = random_state * 1664525u + 1013904223u;
+
+        const auto run =
+            1 + (random_state >> 8) % (2 * OTA_STAGING_BUFFER_SIZE);
+        const auto end = std::min(image.size(), position + run);
+
+        ota_send(2, image, position, end);
+        sent_bytes += end - position;
+
+        if (end == image.size()) {
+            break;
+        }
+
+        disconnect(2);
+        SIM_CHECK(ota_staging_object.suspended());
+
+        connect(2);
+        exchange_mtu(2, SIM_MTU);
+
+        const auto resent = ota_begin(2, image_size);
+        const auto *resume = find(resent, host::bt_kind::notification);
+
+        SIM_CHECK(resume != nullptr && resume->data.size() == 5);
+
+        if (resume == nullptr || resume->data.size() != 5) {
+            return;
+        }
+
+        const auto offset = std::size_t{resume->data[1]} |
+                            std::size_t{resume->data[2]} << 8 |
+                            std::size_t{resume->data[3]} << 16 |
+                            std::size_t{resume->data[4]} << 24;
+
+        // Only the partial buffer is lost
+        SIM_CHECK(offset <= end && end - offset < OTA_STAGING_BUFFER_SIZE);
+        SIM_CHECK(offset % OTA_STAGING_BUFFER_SIZE == 0);
+
+        retransmitted += end - offset;
+        position = offset;
+        ++drops;
+    }
+
+    SIM_CHECK(drops > 0);
+    SIM_CHECK(error_of(ota_verify(2, image)) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == image);
+
+    std::printf("{\"sim_ota_resume\":{\"image_bytes\":%zu,\"drops\":%d,"
+                "\"bytes_sent\":%zu,\"bytes_retransmitted\":%zu}}\n",
+                image.size(), drops, sent_bytes, retransmitted);
+}
+
+///
+/// \brief The same image raw and compressed on connection 2, comparing the
+///        bytes each puts on air
+///
+void check_compressed() {
+    const auto image = firmware_of(4 * OTA_STAGING_BUFFER_SIZE + 2000);
+    const auto compressed = lzss_of(image);
+    const auto image_size = static_cast<uint32_t>(image.size());
+
+    ota_begin(2, image_size);
+    ota_send(2, image, 0, image.size());
+    SIM_CHECK(error_of(ota_verify(2, image)) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == image);
+
+    ota_begin(2, image_size);
+    ota_send(2, compressed, 0, compressed.size());
+    SIM_CHECK(error_of(ota_verify(2, image)) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == image);
+
+    SIM_CHECK(compressed.size() < image.size());
+
+    std::printf("{\"sim_ota_compressed\":{\"image_bytes\":%zu,"
+                "\"compressed_bytes\":%zu,\"raw_writes\":%zu,"
+                "\"compressed_writes\":%zu,\"raw_on_air\":%zu,"
+                "\"compressed_on_air\":%zu,\"saving_percent\":%.1f}}\n",
+                image.size(), compressed.size(), ota_writes(image.size()),
+                ota_writes(compressed.size()), ota_on_air(image.size()),
+                ota_on_air(compressed.size()),
+                100.0 *
+                    (1.0 - static_cast<double>(ota_on_air(compressed.size())) /
+                               static_cast<double>(ota_on_air(image.size()))));
+}
+
+///
+/// \brief Raw download, a download resumed after a lost link and a
+///        download over the L2CAP channel
+///
+void scenario_ota() {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    const auto image = image_of(3 * OTA_STAGING_BUFFER_SIZE + 1000, 7);
+
+    auto sent = ota_begin(1, static_cast<uint32_t>(image.size()));
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+
+    ota_send(1, image, 0, OTA_STAGING_BUFFER_SIZE);
+
+    // Another peer can neither take over nor feed the session
+    connect(3);
+
+    sent = write(3, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+                 {CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_PRC_IN_PROGRESS);
+
+    sent = write(3, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+                 {CY_OTA_UPGRADE_COMMAND_ABORT});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_PRC_IN_PROGRESS);
+
+    sent = write(3, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE,
+                 {0x00, 0x01, 0x02});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_PRC_IN_PROGRESS);
+
+    disconnect(3);
+
+    ota_send(1, image, OTA_STAGING_BUFFER_SIZE, image.size());
+
+    // A verify without the image CRC-32 is refused and keeps the session
+    sent = write(1, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+                 {CY_OTA_UPGRADE_COMMAND_VERIFY});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_INVALID_ATTR_LEN);
+
+    sent = ota_verify(1, image);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == image);
+
+    // The streamed digest matched, so the slot is marked for the bootloader
+    // without the library's own verify
+    SIM_CHECK(host::ota_image_pending());
+
+    // The link drops after two full buffers and part of a third
+    const auto resumed = image_of(5 * OTA_STAGING_BUFFER_SIZE + 300, 11);
+    const auto dropped_at = 2 * OTA_STAGING_BUFFER_SIZE + 500;
+
+    ota_begin(1, static_cast<uint32_t>(resumed.size()));
+    ota_send(1, resumed, 0, dropped_at);
+    disconnect(1);
+
+    SIM_CHECK(ota_staging_object.suspended());
+
+    connect(2);
+    exchange_mtu(2, SIM_MTU);
+
+    // The peer is told to continue from the first chunk not in flash
+    sent = ota_begin(2, static_cast<uint32_t>(resumed.size()));
+    const auto *resume = find(sent, host::bt_kind::notification);
+    const auto offset = uint32_t{2 * OTA_STAGING_BUFFER_SIZE};
+
+    SIM_CHECK(resume != nullptr && resume->conn_id == 2 &&
+              resume->handle ==
+                  HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE &&
+              resume->data == le32(0x80, offset));
+
+    ota_send(2, resumed, offset, resumed.size());
+
+    sent = ota_verify(2, resumed);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == resumed);
+
+    check_random_drops();
+
+    // An abandoned image never reaches the next one
+    const auto abandoned = image_of(2 * OTA_STAGING_BUFFER_SIZE + 900, 5);
+
+    ota_begin(2, static_cast<uint32_t>(abandoned.size()));
+    ota_send(2, abandoned, 0, abandoned.size() - 100);
+
+    sent = write(2, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+                 {CY_OTA_UPGRADE_COMMAND_ABORT});
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+
+    // Image data as SDUs of the credit-based channel
+    const auto streamed = image_of(2 * OTA_STAGING_BUFFER_SIZE + 77, 3);
+    wiced_bt_device_address_t address = {0x00, 0x50, 0xC2, 0x00, 0x00, 2};
+    constexpr auto local_cid = uint16_t{0x0040};
+
+    ota_begin(2, static_cast<uint32_t>(streamed.size()));
+    SIM_CHECK(host::l2cap_open(address, local_cid, OTA_L2CAP_MTU));
+
+    sent = host::bt_take();
+    const auto *accepted = find(sent, host::bt_kind::l2cap_connect_rsp);
+    SIM_CHECK(accepted != nullptr &&
+              accepted->handle == L2CAP_LE_RESULT_CONN_OK);
+
+    for (auto position = std::size_t{}; position < streamed.size();
+         position += OTA_L2CAP_MTU) {
+        const auto length = std::min<std::size_t>(OTA_L2CAP_MTU,
+                                                  streamed.size() - position);
+        host::l2cap_data(local_cid, &streamed[position],
+                         static_cast<uint16_t>(length));
+        ota_l2cap_paced();
+    }
+
+    SIM_CHECK(find(host::bt_take(), host::bt_kind::l2cap_disconnect) ==
+              nullptr);
+
+    sent = ota_verify(2, streamed);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == streamed);
+
+    host::l2cap_close(local_cid);
+
+    check_compressed();
+
+    // A delta against the running image, which the writer task checks
+    auto *primary = host_flash + FLASH_AREA_IMG_1_PRIMARY_START;
+    const auto base = image_of(2 * OTA_STAGING_BUFFER_SIZE + 100, 9);
+    std::copy(base.begin(), base.end(), primary);
+
+    auto patched = base;
+
+    for (auto block = std::size_t{}; block < patched.size();
+         block += OTA_STAGING_BUFFER_SIZE) {
+        std::fill_n(patched.begin() + static_cast<std::ptrdiff_t>(block), 4,
+                    uint8_t{0xA5});
+    }
+
+    const auto base_crc = util::crc32::of(base.data(), base.size());
+    const auto delta = delta_of(base, patched, base_crc);
+
+    ota_begin(2, static_cast<uint32_t>(patched.size()));
+    ota_send(2, delta, 0, delta.size());
+
+    sent = ota_verify(2, patched);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_SUCCESS);
+    SIM_CHECK(host::ota_image() == patched);
+
+    SIM_CHECK(delta.size() < patched.size());
+
+    std::printf("{\"sim_ota_delta\":{\"image_bytes\":%zu,"
+                "\"delta_bytes\":%zu,\"raw_on_air\":%zu,"
+                "\"delta_on_air\":%zu,\"saving_percent\":%.1f}}\n",
+                patched.size(), delta.size(), ota_on_air(patched.size()),
+                ota_on_air(delta.size()),
+                100.0 * (1.0 - static_cast<double>(ota_on_air(delta.size())) /
+                                   static_cast<double>(
+                                       ota_on_air(patched.size()))));
+
+    // Against any other image nothing reaches the OTA library, and the
+    // verify fails
+    const auto mismatched = delta_of(base, patched, base_crc ^ 1);
+
+    ota_begin(2, static_cast<uint32_t>(patched.size()));
+
+    for (auto offset = std::size_t{}; offset < mismatched.size();
+         offset += SIM_MTU - 3) {
+        const auto length =
+            std::min<std::size_t>(SIM_MTU - 3, mismatched.size() - offset);
+        const auto first = mismatched.begin() +
+                           static_cast<std::ptrdiff_t>(offset);
+
+        write(2, HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE,
+              bytes(first, first + static_cast<std::ptrdiff_t>(length)));
+    }
+
+    sent = ota_verify(2, patched);
+    SIM_CHECK(error_of(sent) == WICED_BT_GATT_ERROR);
+    SIM_CHECK(host::ota_image().empty());
+    SIM_CHECK(!host::ota_image_pending());
+
+    disconnect(2);
+}
+
+///
+/// \brief Wall-clock seconds a piece of work takes
+///
+template <typename work_type> double timed(work_type &&work) {
+    const auto start = std::chrono::steady_clock::now();
+
+    work();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+///
+/// \brief Nanoseconds per unit of work
+///
+double nanoseconds_per(double seconds, std::size_t count) {
+    return (count != 0) ? seconds * 1e9 / static_cast<double>(count) : 0.0;
+}
+
+/// Slot of a handle without an attribute in the lookup benchmark
+constexpr auto LOOKUP_NO_SLOT = uint16_t{0xFFFF};
+
+///
+/// \brief Handle lookups in a table of \p count attributes, walking the
+///        table as the Configurator's lookup did and indexing a slot map as
+///        gatt_db::slot_of() does
+///
+void benchmark_lookup(std::size_t count, long iterations) {
+    // A declaration, a value and a descriptor per characteristic
+    auto handles = std::vector<uint16_t>(count);
+
+    for (auto i = std::size_t{}; i < count; i++) {
+        handles[i] = static_cast<uint16_t>(3 * i + 2);
+    }
+
+    auto slot_map =
+        std::vector<uint16_t>(handles.back() + 1u, LOOKUP_NO_SLOT);
+
+    for (auto i = std::size_t{}; i < count; i++) {
+        slot_map[handles[i]] = static_cast<uint16_t>(i);
+    }
+
+    // Every handle of the database and a few past it, in a scrambled order
+    auto probes = std::vector<uint16_t>(1024);
+    auto state = uint32_t{1};
+
+    for (auto &probe : probes) {
+        state = state * 1664525u + 1013904223u;
+        probe = static_cast<uint16_t>((state >> 8) % (slot_map.size() + 16));
+    }
+
+    const auto lookups = static_cast<std::size_t>(iterations) * 10;
+    auto linear_sum = uint64_t{};
+    auto indexed_sum = uint64_t{};
+
+    const auto linear = timed([&] {
+        for (auto i = std::size_t{}; i < lookups; i++) {
+            const auto handle = probes[i % probes.size()];
+            auto slot = LOOKUP_NO_SLOT;
+
+            for (auto j = std::size_t{}; j < count; j++) {
+                if (handles[j] == handle) {
+                    slot = static_cast<uint16_t>(j);
+                    break;
+                }
+            }
+
+            linear_sum += slot;
+        }
+    });
+
+    const auto indexed = timed([&] {
+        for (auto i = std::size_t{}; i < lookups; i++) {
+            const auto handle = probes[i % probes.size()];
+
+            indexed_sum += (handle < slot_map.size()) ? slot_map[handle]
+                                                      : LOOKUP_NO_SLOT;
+        }
+    });
+
+    SIM_CHECK(linear_sum == indexed_sum);
+
+    std::printf("{\"sim_benchmark_lookup\":{\"attributes\":%zu,"
+                "\"lookups\":%zu,\"linear_ns\":%.1f,"
+                "\"slot_map_ns\":%.1f}}\n",
+                count, lookups, nanoseconds_per(linear, lookups),
+                nanoseconds_per(indexed, lookups));
+}
+
+///
+/// \brief Attribute of a generated database, as the stack's flat table
+///        lists it
+///
+struct discovery_attribute {
+    uint16_t handle; ///< Attribute handle
+    uint16_t uuid16; ///< Attribute type
+    bool stored;     ///< Has application storage, so is in the type index
+};
+
+///
+/// \brief Read By Type discovery of every value type in a generated
+///        database of \p count attributes, searching the flat table then
+///        the attribute table as the handler did, and through a type index
+///        as gatt_db::find_type() does
+///
+void benchmark_discovery(std::size_t count, long iterations) {
+    // Eight characteristic types, each a declaration and a value, and a
+    // client configuration descriptor on every other one
+    constexpr auto TYPES = uint16_t{8};
+    constexpr auto BASE_UUID = uint16_t{0x2A00};
+
+    auto database = std::vector<discovery_attribute>{};
+    auto stored = std::vector<uint16_t>{};
+    auto index = std::vector<gatt_db::type_entry>{};
+
+    for (auto i = std::size_t{}; database.size() < count; i++) {
+        const auto handle = static_cast<uint16_t>(database.size() + 1);
+        const auto uuid16 = static_cast<uint16_t>(BASE_UUID + i % TYPES);
+
+        database.push_back({handle, GATT_UUID_CHAR_DECLARE, false});
+        database.push_back({static_cast<uint16_t>(handle + 1), uuid16, true});
+
+        if (i % 2 == 0) {
+            database.push_back(
+                {static_cast<uint16_t>(handle + 2),
+                 UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION, true});
+        }
+    }
+
+    for (const auto &attribute : database) {
+        if (attribute.stored) {
+            // The slot is not looked at here
+            index.push_back({attribute.uuid16, attribute.handle, 0});
+            stored.push_back(attribute.handle);
+        }
+    }
+
+    const auto by_type_then_handle = [](const gatt_db::type_entry &lhs,
+                                        const gatt_db::type_entry &rhs) {
+        return (lhs.uuid16 != rhs.uuid16) ? lhs.uuid16 < rhs.uuid16
+                                          : lhs.handle < rhs.handle;
+    };
+
+    std::sort(index.begin(), index.end(), by_type_then_handle);
+
+    // Two-byte values: as many handle-value pairs as an MTU response holds
+    constexpr auto PAIRS = std::size_t{(SIM_MTU - 2) / 4};
+
+    // One discovery: a request per response until a type runs out, for
+    // every type, as a client walks the database
+    const auto discover = [&](auto &&next) {
+        auto found = uint64_t{};
+
+        for (auto type = uint16_t{}; type < TYPES; type++) {
+            const auto uuid16 = static_cast<uint16_t>(BASE_UUID + type);
+            auto start = uint16_t{1};
+
+            while (true) {
+                auto pairs = std::size_t{};
+                auto handle = uint16_t{};
+
+                while (pairs < PAIRS && (handle = next(uuid16, start)) != 0) {
+                    found += handle;
+                    start = static_cast<uint16_t>(handle + 1);
+                    pairs++;
+                }
+
+                if (pairs < PAIRS) {
+                    break;
+                }
+            }
+        }
+
+        return found;
+    };
+
+    // The stack's search of the flat table, then the attribute table
+    const auto linear_next = [&](uint16_t uuid16, uint16_t start) {
+        for (const auto &attribute : database) {
+            if (attribute.handle < start || attribute.uuid16 != uuid16) {
+                continue;
+            }
+
+            for (const auto handle : stored) {
+                if (handle == attribute.handle) {
+                    return handle;
+                }
+            }
+        }
+
+        return uint16_t{};
+    };
+
+    const auto indexed_next = [&](uint16_t uuid16, uint16_t start) {
+        const auto entry =
+            std::lower_bound(index.begin(), index.end(),
+                             gatt_db::type_entry{uuid16, start, 0},
+                             by_type_then_handle);
+
+        return (entry != index.end() && entry->uuid16 == uuid16)
+                   ? entry->handle
+                   : uint16_t{};
+    };
+
+    const auto discoveries = static_cast<std::size_t>(iterations);
+    auto linear_sum = uint64_t{};
+    auto indexed_sum = uint64_t{};
+
+    const auto linear = timed([&] {
+        for (auto i = std::size_t{}; i < discoveries; i++) {
+            linear_sum += discover(linear_next);
+        }
+    });
+
+    const auto indexed = timed([&] {
+        for (auto i = std::size_t{}; i < discoveries; i++) {
+            indexed_sum += discover(indexed_next);
+        }
+    });
+
+    SIM_CHECK(linear_sum == indexed_sum && linear_sum != 0);
+
+    std::printf("{\"sim_benchmark_discovery\":{\"attributes\":%zu,"
+                "\"discoveries\":%zu,\"linear_us\":%.2f,"
+                "\"type_index_us\":%.2f}}\n",
+                database.size(), discoveries,
+                nanoseconds_per(linear, discoveries) / 1000.0,
+                nanoseconds_per(indexed, discoveries) / 1000.0);
+}
+
+///
+/// \brief Time from a Battery Level CCCD write to the first notification,
+///        for profiling
+///
+/// Polls without sleeping, so the figure is the tasks' latency rather than
+/// the poll interval of wait_until().
+///
+void benchmark_first_notification(long iterations) {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    const auto subscriptions = std::min(iterations, long{100});
+    auto total = 0.0;
+    auto worst = 0.0;
+
+    for (auto i = long{}; i < subscriptions; i++) {
+        write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x00, 0x00});
+
+        const auto start = std::chrono::steady_clock::now();
+        auto sent = write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+                          {0x01, 0x00});
+
+        while (find(sent, host::bt_kind::notification) == nullptr &&
+               std::chrono::steady_clock::now() - start < SIM_WAIT) {
+            host::bt_transmit();
+
+            const auto later = host::bt_take();
+            sent.insert(sent.end(), later.begin(), later.end());
+            std::this_thread::yield();
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+        SIM_CHECK(find(sent, host::bt_kind::notification) != nullptr);
+
+        total += elapsed;
+        worst = std::max(worst, elapsed);
+    }
+
+    write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, {0x00, 0x00});
+
+    std::printf("{\"sim_benchmark_first_notification\":{\"subscriptions\":"
+                "%ld,\"mean_ms\":%.3f,\"max_ms\":%.3f}}\n",
+                subscriptions, total / static_cast<double>(subscriptions),
+                worst);
+
+    disconnect(1);
+}
+
+///
+/// \brief Cycles per sample of the battery voltage filter and per state of
+///        charge lookup, on a discharge curve with noise and spikes
+///
+/// Counted with ble_gatt_statistics::cycles() as the battery service task
+/// counts them; on the host the counter ticks in nanoseconds.
+///
+void benchmark_battery_filter(long iterations) {
+    // Samples per timed block; long enough to hide the counter read
+    constexpr auto BLOCK = std::size_t{1024};
+
+    const auto blocks = static_cast<std::size_t>(std::max(iterations, 1L));
+    auto input = std::vector<int32_t>(BLOCK * blocks);
+    auto state = uint32_t{1};
+
+    // 4.2 V down to 3.0 V, +-8 mV of noise and a 300 mV dip every 97
+    for (auto i = std::size_t{}; i < input.size(); i++) {
+        state = state * 1664525u + 1013904223u;
+
+        const auto noise = static_cast<int32_t>((state >> 8) % 17) - 8;
+        const auto dip = (i % 97 == 0) ? 300 : 0;
+
+        input[i] = static_cast<int32_t>(
+            4200 - (1200 * static_cast<int64_t>(i)) /
+                       static_cast<int64_t>(input.size())) +
+                   noise - dip;
+    }
+
+    auto filter = util::battery_voltage_filter<5, 3>{};
+    auto filtered = std::vector<int32_t>(input.size());
+    auto filter_cycles = uint64_t{};
+
+    for (auto block = std::size_t{}; block < blocks; block++) {
+        const auto start = ble_gatt_statistics::cycles();
+
+        for (auto i = block * BLOCK; i < (block + 1) * BLOCK; i++) {
+            filtered[i] = filter.update(input[i]);
+        }
+
+        filter_cycles += ble_gatt_statistics::cycles() - start;
+    }
+
+    auto level_sum = uint64_t{};
+    auto lookup_cycles = uint64_t{};
+
+    for (auto block = std::size_t{}; block < blocks; block++) {
+        const auto start = ble_gatt_statistics::cycles();
+
+        for (auto i = block * BLOCK; i < (block + 1) * BLOCK; i++) {
+            level_sum +=
+                util::state_of_charge(util::liion_ocv_table, filtered[i]);
+        }
+
+        lookup_cycles += ble_gatt_statistics::cycles() - start;
+    }
+
+    // The dips never reach the output, and the curve ends near empty
+    SIM_CHECK(*std::max_element(filtered.begin(), filtered.end()) <= 4208);
+    SIM_CHECK(filtered.back() < 3100 && level_sum != 0);
+
+    const auto samples = static_cast<double>(input.size());
+
+    std::printf("{\"sim_benchmark_battery_filter\":{\"samples\":%zu,"
+                "\"filter_cycles_per_sample\":%.1f,"
+                "\"soc_cycles_per_sample\":%.1f}}\n",
+                input.size(), static_cast<double>(filter_cycles) / samples,
+                static_cast<double>(lookup_cycles) / samples);
+}
+
+///
+/// \brief Bytes copied into read responses so far
+///
+uint32_t read_copied_bytes() {
+    auto copied = uint32_t{};
+
+    for (const auto operation :
+         {gatt_operation::read, gatt_operation::read_blob,
+          gatt_operation::read_by_type, gatt_operation::read_multi}) {
+        copied += ble_gatt_statistics_object.copied_bytes(operation);
+    }
+
+    return copied;
+}
+
+///
+/// \brief Value bytes of the responses among \p sent
+///
+std::size_t response_bytes(const records &sent) {
+    auto total = std::size_t{};
+
+    for (const auto &record : sent) {
+        if (record.kind != host::bt_kind::error_rsp) {
+            total += record.data.size();
+        }
+    }
+
+    return total;
+}
+
+///
+/// \brief Request throughput of the GATT server, for profiling
+///
+void benchmark_requests(long iterations) {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    // Every response byte was copied into a fresh buffer before responses
+    // were built from attribute storage
+    const auto copied_before = read_copied_bytes();
+    auto responded = std::size_t{};
+
+    const auto elapsed = timed([&] {
+        for (auto i = long{}; i < iterations; ++i) {
+            responded += response_bytes(read(1, HDLC_GAP_DEVICE_NAME_VALUE));
+            responded +=
+                response_bytes(read(1, HDLC_GAP_DEVICE_NAME_VALUE, 8));
+            responded +=
+                response_bytes(read(1, HDLC_BAS_BATTERY_LEVEL_VALUE));
+            responded += response_bytes(
+                read_by_type(1, UUID_CHARACTERISTIC_BATTERY_LEVEL));
+            responded += response_bytes(read_multiple(
+                1, GATT_REQ_READ_MULTI_VAR_LENGTH,
+                {HDLC_GAP_APPEARANCE_VALUE, HDLC_BAS_BATTERY_LEVEL_VALUE}));
+            write(1, HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+                  {static_cast<uint8_t>(i & 1), 0x00});
+            write(1, HDLC_GAP_APPEARANCE_VALUE, {0x00, 0x00},
+                  GATT_CMD_WRITE);
+        }
+    });
+
+    const auto requests = iterations * 7;
+    const auto reads = static_cast<double>(iterations * 5);
+    const auto copied = read_copied_bytes() - copied_before;
+
+    SIM_CHECK(copied < responded);
+
+    std::printf("{\"sim_benchmark\":{\"requests\":%ld,\"seconds\":%.3f,"
+                "\"requests_per_second\":%.0f,"
+                "\"read_bytes_copied_per_request\":{\"before\":%.1f,"
+                "\"after\":%.1f}}}\n",
+                requests, elapsed,
+                (elapsed > 0) ? static_cast<double>(requests) / elapsed
+                              : 0.0,
+                static_cast<double>(responded) / reads,
+                static_cast<double>(copied) / reads);
+
+    disconnect(1);
+}
+
+///
+/// \brief Long writes of the device name, two prepared fragments and an
+///        execute each, against single writes of the same value
+///
+void benchmark_long_write(long iterations) {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    const auto name = text("Battery Server");
+    const auto head = bytes(name.begin(), name.begin() + 8);
+    const auto tail = bytes(name.begin() + 8, name.end());
+
+    const auto single = timed([&] {
+        for (auto i = long{}; i < iterations; ++i) {
+            write(1, HDLC_GAP_DEVICE_NAME_VALUE, name);
+        }
+    });
+
+    const auto prepared = timed([&] {
+        for (auto i = long{}; i < iterations; ++i) {
+            write(1, HDLC_GAP_DEVICE_NAME_VALUE, head, GATT_REQ_PREPARE_WRITE,
+                  0);
+            write(1, HDLC_GAP_DEVICE_NAME_VALUE, tail, GATT_REQ_PREPARE_WRITE,
+                  8);
+            execute(1, GATT_PREPARE_WRITE_EXEC);
+        }
+    });
+
+    const auto sent = read(1, HDLC_GAP_DEVICE_NAME_VALUE);
+    SIM_CHECK(!sent.empty() && sent[0].data == name);
+
+    const auto count = static_cast<std::size_t>(iterations);
+
+    std::printf("{\"sim_benchmark_long_write\":{\"writes\":%ld,"
+                "\"single_write_ns\":%.1f,\"long_write_ns\":%.1f}}\n",
+                iterations, nanoseconds_per(single, count),
+                nanoseconds_per(prepared, count));
+
+    disconnect(1);
+}
+
+/// Air time of one OTA data write: a write request and its response in one
+/// 7.5 ms connection event
+constexpr auto SIM_OTA_WRITE_INTERVAL = std::chrono::microseconds{7500};
+
+/// LL payload of one data PDU at the 251-byte data length
+constexpr auto SIM_LL_PAYLOAD = std::size_t{251};
+
+/// Air time of one full LL data PDU on the 2M PHY, with the inter-frame
+/// spaces and the empty PDU that acknowledges it
+constexpr auto SIM_LL_PDU_TIME = std::chrono::microseconds{1400};
+
+///
+/// \brief Air time of an L2CAP PDU of \p length bytes, headers included
+///
+std::chrono::microseconds ll_air_time(std::size_t length) {
+    const auto pdus = (length + SIM_LL_PAYLOAD - 1) / SIM_LL_PAYLOAD;
+    return SIM_LL_PDU_TIME * static_cast<long>(pdus);
+}
+
+///
+/// \brief OTA download throughput with flash programmed in line with the
+///        writes, as before the staging ring, and overlapped with them;
+///        then through GATT writes against SDUs of the L2CAP channel, at
+///        MTU 247 and 517
+///
+/// Writes are paced at the air time of a write request; the host OTA
+/// library takes as long as PSoC 6 flash to erase and program. A write
+/// request waits for its response, at best one connection event later, so
+/// it takes at least SIM_OTA_WRITE_INTERVAL. An SDU takes only its air
+/// time, and waits while the server holds the one before.
+///
+void benchmark_ota() {
+    connect(1);
+    exchange_mtu(1, SIM_MTU);
+
+    const auto image = image_of(8 * OTA_STAGING_BUFFER_SIZE, 13);
+
+    const auto download = [&](bool serial) {
+        return timed([&] {
+            ota_begin(1, static_cast<uint32_t>(image.size()));
+
+            constexpr auto chunk = std::size_t{SIM_MTU - 3};
+            auto next = std::chrono::steady_clock::now();
+
+            for (auto offset = std::size_t{}; offset < image.size();
+                 offset += chunk) {
+                std::this_thread::sleep_until(next);
+                next += SIM_OTA_WRITE_INTERVAL;
+
+                ota_send(1, image, offset,
+                         std::min(offset + chunk, image.size()));
+
+                // Each full buffer reaches flash before the next write
+                while (serial && !ota_staging_object.idle()) {
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                }
+
+                if (serial) {
+                    // The next write only goes on air once acknowledged
+                    next = std::chrono::steady_clock::now() +
+                           SIM_OTA_WRITE_INTERVAL;
+                }
+            }
+
+            SIM_CHECK(error_of(ota_verify(1, image)) ==
+                      WICED_BT_GATT_SUCCESS);
+        });
+    };
+
+    const auto serial = download(true);
+    const auto pipelined = download(false);
+
+    SIM_CHECK(host::ota_image() == image);
+
+    const auto kilobytes = static_cast<double>(image.size()) / 1024.0;
+
+    std::printf("{\"sim_benchmark_ota\":{\"bytes\":%zu,"
+                "\"serial_kbps\":%.1f,\"pipelined_kbps\":%.1f,"
+                "\"stalls\":%u}}\n",
+                image.size(), (serial > 0) ? kilobytes / serial : 0.0,
+                (pipelined > 0) ? kilobytes / pipelined : 0.0,
+                ota_staging_object.stats().stalls);
+
+    constexpr auto local_cid = uint16_t{0x0041};
+    wiced_bt_device_address_t address = {0x00, 0x50, 0xC2, 0x00, 0x00, 1};
+
+    const auto transfer = [&](uint16_t mtu, bool l2cap) {
+        return timed([&] {
+            ota_begin(1, static_cast<uint32_t>(image.size()));
+
+            if (l2cap) {
+                SIM_CHECK(host::l2cap_open(address, local_cid, mtu));
+                SIM_CHECK(find(host::bt_take(),
+                               host::bt_kind::l2cap_connect_rsp) != nullptr);
+            }
+
+            // SDUs carry the channel MTU, writes the ATT MTU less the
+            // opcode and handle
+            const auto chunk = std::size_t{l2cap ? mtu : mtu - 3u};
+
+            // Basic L2CAP header, and the SDU length of a first K-frame
+            const auto overhead = std::size_t{l2cap ? 4u + 2u : 4u + 3u};
+            auto next = std::chrono::steady_clock::now();
+
+            for (auto offset = std::size_t{}; offset < image.size();
+                 offset += chunk) {
+                const auto length = std::min(chunk, image.size() - offset);
+                const auto air = ll_air_time(overhead + length);
+
+                std::this_thread::sleep_until(next);
+
+                if (l2cap) {
+                    host::l2cap_data(local_cid, &image[offset],
+                                     static_cast<uint16_t>(length));
+                    ota_l2cap_paced();
+                    next += air;
+                } else {
+                    ota_send(1, image, offset, offset + length, mtu);
+                    next += std::max<std::chrono::microseconds>(
+                        air, SIM_OTA_WRITE_INTERVAL);
+                }
+
+                // Held data stalls the peer until it is staged
+                next = std::max(next, std::chrono::steady_clock::now());
+            }
+
+            SIM_CHECK(error_of(ota_verify(1, image)) ==
+                      WICED_BT_GATT_SUCCESS);
+
+            if (l2cap) {
+                host::l2cap_close(local_cid);
+            }
+        });
+    };
+
+    for (const auto mtu : {uint16_t{247}, uint16_t{517}}) {
+        exchange_mtu(1, mtu);
+
+        const auto gatt = transfer(mtu, false);
+        SIM_CHECK(host::ota_image() == image);
+
+        const auto l2cap = transfer(mtu, true);
+        SIM_CHECK(host::ota_image() == image);
+
+        std::printf("{\"sim_benchmark_ota_transport\":{\"mtu\":%u,"
+                    "\"bytes\":%zu,\"gatt_kbps\":%.1f,"
+                    "\"l2cap_kbps\":%.1f}}\n",
+                    static_cast<unsigned>(mtu), image.size(),
+                    (gatt > 0) ? kilobytes / gatt : 0.0,
+                    (l2cap > 0) ? kilobytes / l2cap : 0.0);
+    }
+
+    host::bt_take();
+    disconnect(1);
+}
+
+///
+/// \brief Request throughput and the building blocks behind it, for
+///        profiling
+///
+void scenario_benchmark(long iterations) {
+    benchmark_requests(iterations);
+    benchmark_long_write(iterations);
+    benchmark_first_notification(iterations);
+    benchmark_battery_filter(iterations);
+    benchmark_ota();
+
+    for (const auto count : {std::size_t{10}, std::size_t{100},
+                             std::size_t{1000}}) {
+        benchmark_lookup(count, iterations);
+    }
+
+    for (const auto count : {std::size_t{50}, std::size_t{300},
+                             std::size_t{600}}) {
+        benchmark_discovery(count, iterations);
+    }
+}
+
+///
+/// \brief Start the firmware as main() does on target
+///
+void start_firmware() {
+    cybsp_init();
+    resource::peripheral_initialize();
+
+    SIM_CHECK(ble_context_object.stack_initialize() == WICED_BT_SUCCESS);
+
+    SIM_CHECK(battery_service_task_create() == pdPASS);
+    SIM_CHECK(app_event_task_create() == pdPASS);
+    SIM_CHECK(ota_writer_task_create() == pdPASS);
+
+    vTaskStartScheduler();
+
+    // Returns here; this thread is the Bluetooth stack thread from now on
+    host::bt_enable();
+    host::bt_transmit();
+
+    const auto sent = host::bt_take();
+    SIM_CHECK(find(sent, host::bt_kind::advertising_data) != nullptr);
+    SIM_CHECK(find(sent, host::bt_kind::advertising) != nullptr);
+
+    // First battery measurement
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const auto scenario = std::string{(argc > 1) ? argv[1] : "all"};
+
+    start_firmware();
+
+    if (scenario == "gatt_reads" || scenario == "all") {
+        scenario_gatt_reads();
+    }
+
+    if (scenario == "gatt_writes" || scenario == "all") {
+        scenario_gatt_writes();
+    }
+
+    if (scenario == "connections" || scenario == "all") {
+        scenario_connections();
+    }
+
+    if (scenario == "ota" || scenario == "all") {
+        scenario_ota();
+    }
+
+    if (scenario == "benchmark") {
+        scenario_benchmark((argc > 2) ? std::strtol(argv[2], nullptr, 10)
+                                      : 100000);
+    }
+
+    std::printf("{\"sim\":{\"scenario\":\"%s\",\"failures\":%d}}\n",
+                scenario.c_str(), failures);
+    std::fflush(stdout);
+
+    // The firmware's tasks never return
+    std::_Exit((failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
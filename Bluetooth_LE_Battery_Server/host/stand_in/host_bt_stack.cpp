@@ -0,0 +1,531 @@
+///
+/// \file    host_bt_stack.cpp
+/// \brief   Host stand-in for the WICED Bluetooth stack
+///
+/// \details Everything the firmware hands to the stack becomes a
+///          host::bt_record. Sends with a transmit context stay pending
+///          until host::bt_transmit(), which captures their bytes and
+///          returns the buffer through GATT_APP_BUFFER_TRANSMITTED_EVT, so a
+///          buffer released or rewritten too early shows up in the record.
+///          Advertising state changes are delivered the same way, as the
+///          stack reports them after the call that caused them.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_bt_stack.h"
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+///
+/// \brief A send whose buffer the stack still holds
+///
+struct pending_send {
+    std::size_t record; ///< Index into records
+    uint8_t *data;      ///< Buffer handed over
+    uint16_t length;    ///< Bytes to transmit
+    void *context;      ///< Transmit context
+};
+
+std::mutex stack_mutex{};
+std::vector<host::bt_record> records{};
+std::vector<pending_send> pending{};
+std::vector<wiced_bt_ble_advert_mode_t> advert_changes{};
+std::size_t failing_sends = 0;
+
+wiced_bt_management_cback_t *management_callback = nullptr;
+wiced_bt_gatt_cback_t *gatt_callback = nullptr;
+
+const uint8_t *database = nullptr;
+uint32_t database_size = 0;
+
+wiced_bt_device_address_t local_address{};
+
+uint16_t l2cap_psm = 0;
+wiced_bt_l2cap_le_appl_information_t l2cap_callbacks{};
+void *l2cap_context = nullptr;
+
+///
+/// \brief Record a send
+///
+/// \return wiced_bt_gatt_status_t WICED_BT_GATT_BUSY if a failure was
+///         requested with host::bt_fail_sends(), otherwise success
+///
+wiced_bt_gatt_status_t send(host::bt_kind kind, uint16_t conn_id,
+                            uint8_t opcode, uint16_t handle, uint8_t status,
+                            uint8_t *data, uint16_t length, void *context) {
+    auto lock = std::lock_guard<std::mutex>{stack_mutex};
+
+    if (failing_sends != 0) {
+        --failing_sends;
+        return WICED_BT_GATT_BUSY;
+    }
+
+    records.push_back(host::bt_record{kind, conn_id, opcode, handle, status,
+                                      {}});
+
+    if (context != nullptr) {
+        pending.push_back(
+            pending_send{records.size() - 1, data, length, context});
+    } else if (data != nullptr) {
+        records.back().data.assign(data, data + length);
+    }
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+///
+/// \brief Record something that is not a GATT send
+///
+void note(host::bt_kind kind, uint16_t conn_id, uint16_t handle,
+          const uint8_t *data = nullptr, std::size_t length = 0) {
+    auto lock = std::lock_guard<std::mutex>{stack_mutex};
+
+    records.push_back(host::bt_record{kind, conn_id, 0, handle, 0, {}});
+
+    if (data != nullptr) {
+        records.back().data.assign(data, data + length);
+    }
+}
+
+///
+/// \brief Flatten AD elements into their over-the-air form
+///
+std::vector<uint8_t> flatten(uint8_t num_elem,
+                             const wiced_bt_ble_advert_elem_t *elements) {
+    auto bytes = std::vector<uint8_t>{};
+
+    for (auto i = 0; i < num_elem; ++i) {
+        bytes.push_back(static_cast<uint8_t>(elements[i].len + 1));
+        bytes.push_back(static_cast<uint8_t>(elements[i].advert_type));
+        bytes.insert(bytes.end(), elements[i].p_data,
+                     elements[i].p_data + elements[i].len);
+    }
+
+    return bytes;
+}
+
+} // namespace
+
+namespace host {
+
+std::vector<bt_record> bt_take() {
+    auto lock = std::lock_guard<std::mutex>{stack_mutex};
+    auto taken = std::vector<bt_record>{};
+
+    // Records still pending are kept, with every record after them
+    const auto kept = pending.empty() ? records.size() : pending.front().record;
+
+    taken.assign(records.begin(),
+                 records.begin() + static_cast<std::ptrdiff_t>(kept));
+    records.erase(records.begin(),
+                  records.begin() + static_cast<std::ptrdiff_t>(kept));
+
+    for (auto &send : pending) {
+        send.record -= kept;
+    }
+
+    return taken;
+}
+
+void bt_transmit() {
+    auto transmitted = std::vector<pending_send>{};
+    auto changes = std::vector<wiced_bt_ble_advert_mode_t>{};
+
+    {
+        auto lock = std::lock_guard<std::mutex>{stack_mutex};
+
+        for (const auto &send : pending) {
+            records[send.record].data.assign(send.data,
+                                             send.data + send.length);
+        }
+
+        transmitted.swap(pending);
+        changes.swap(advert_changes);
+    }
+
+    for (const auto &send : transmitted) {
+        auto event = wiced_bt_gatt_event_data_t{};
+        event.buffer_xmitted.p_app_data = send.data;
+        event.buffer_xmitted.p_app_ctxt = send.context;
+
+        bt_gatt(GATT_APP_BUFFER_TRANSMITTED_EVT, &event);
+    }
+
+    for (auto mode : changes) {
+        auto event = wiced_bt_management_evt_data_t{};
+        event.ble_advert_state_changed = mode;
+
+        bt_management(BTM_BLE_ADVERT_STATE_CHANGED_EVT, &event);
+    }
+}
+
+void bt_fail_sends(std::size_t count) {
+    auto lock = std::lock_guard<std::mutex>{stack_mutex};
+    failing_sends = count;
+}
+
+void bt_enable() {
+    auto event = wiced_bt_management_evt_data_t{};
+    event.enabled.status = WICED_BT_SUCCESS;
+
+    bt_management(BTM_ENABLED_EVT, &event);
+}
+
+wiced_result_t bt_management(wiced_bt_management_evt_t event,
+                             wiced_bt_management_evt_data_t *data) {
+    return management_callback(event, data);
+}
+
+wiced_bt_gatt_status_t bt_gatt(wiced_bt_gatt_evt_t event,
+                               wiced_bt_gatt_event_data_t *data) {
+    return gatt_callback(event, data);
+}
+
+bool l2cap_open(wiced_bt_device_address_t address, uint16_t local_cid,
+                uint16_t mtu) {
+    if (l2cap_psm == 0) {
+        return false;
+    }
+
+    l2cap_callbacks.le_connected_indication_cback(
+        l2cap_context, address, local_cid, l2cap_psm, 1, mtu);
+
+    return true;
+}
+
+void l2cap_data(uint16_t local_cid, const uint8_t *data, uint16_t length) {
+    // The stack hands over its own receive buffer
+    auto sdu = std::vector<uint8_t>(data, data + length);
+
+    l2cap_callbacks.le_data_indication_cback(l2cap_context, local_cid,
+                                             sdu.data(), length);
+}
+
+void l2cap_close(uint16_t local_cid) {
+    l2cap_callbacks.le_disconnect_indication_cback(l2cap_context, local_cid,
+                                                   WICED_TRUE);
+}
+
+} // namespace host
+
+extern "C" {
+
+wiced_result_t
+wiced_bt_stack_init(wiced_bt_management_cback_t *p_bt_management_cback,
+                    const wiced_bt_cfg_settings_t *p_bt_cfg_settings) {
+    static_cast<void>(p_bt_cfg_settings);
+    management_callback = p_bt_management_cback;
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t wiced_bt_stack_deinit(void) { return WICED_BT_SUCCESS; }
+
+wiced_result_t
+wiced_bt_set_local_bdaddr(wiced_bt_device_address_t bd_addr,
+                          wiced_bt_ble_address_type_t addr_type) {
+    static_cast<void>(addr_type);
+    std::memcpy(local_address, bd_addr, BD_ADDR_LEN);
+    return WICED_BT_SUCCESS;
+}
+
+void wiced_bt_dev_read_local_addr(wiced_bt_device_address_t bd_addr) {
+    std::memcpy(bd_addr, local_address, BD_ADDR_LEN);
+}
+
+void wiced_bt_dev_confirm_req_reply(wiced_result_t res,
+                                    wiced_bt_device_address_t bd_addr) {
+    static_cast<void>(res);
+    static_cast<void>(bd_addr);
+}
+
+void wiced_bt_set_pairable_mode(uint8_t allow_pairing,
+                                uint8_t connect_only_paired) {
+    static_cast<void>(allow_pairing);
+    static_cast<void>(connect_only_paired);
+}
+
+void wiced_bt_ble_security_grant(wiced_bt_device_address_t bd_addr,
+                                 uint8_t res) {
+    static_cast<void>(bd_addr);
+    static_cast<void>(res);
+}
+
+wiced_result_t
+wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                              wiced_bt_ble_address_type_t directed_addr_type,
+                              wiced_bt_device_address_ptr_t directed_addr) {
+    static_cast<void>(directed_addr_type);
+
+    note(host::bt_kind::advertising, 0, static_cast<uint16_t>(advert_mode),
+         directed_addr, (directed_addr != nullptr) ? BD_ADDR_LEN : 0);
+
+    auto lock = std::lock_guard<std::mutex>{stack_mutex};
+    advert_changes.push_back(advert_mode);
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t
+wiced_bt_ble_set_raw_advertisement_data(uint8_t num_elem,
+                                        wiced_bt_ble_advert_elem_t *p_data) {
+    const auto bytes = flatten(num_elem, p_data);
+
+    if (bytes.size() > 31) {
+        return WICED_BT_ILLEGAL_VALUE;
+    }
+
+    note(host::bt_kind::advertising_data, 0, num_elem, bytes.data(),
+         bytes.size());
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t
+wiced_bt_ble_set_raw_scan_response_data(uint8_t num_elem,
+                                        wiced_bt_ble_advert_elem_t *p_data) {
+    const auto bytes = flatten(num_elem, p_data);
+
+    if (bytes.size() > 31) {
+        return WICED_BT_ILLEGAL_VALUE;
+    }
+
+    note(host::bt_kind::scan_response_data, 0, num_elem, bytes.data(),
+         bytes.size());
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t
+wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *phy_preferences) {
+    const uint8_t phys[] = {phy_preferences->tx_phys,
+                            phy_preferences->rx_phys};
+
+    note(host::bt_kind::phy, 0, 0, phys, sizeof(phys));
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t
+wiced_bt_ble_set_data_packet_length(wiced_bt_device_address_t bd_addr,
+                                    uint16_t tx_pdu_length,
+                                    uint16_t tx_time) {
+    static_cast<void>(bd_addr);
+    static_cast<void>(tx_time);
+
+    note(host::bt_kind::data_length, 0, tx_pdu_length);
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback) {
+    gatt_callback = p_gatt_cback;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db,
+                                             uint32_t size, void *hash) {
+    static_cast<void>(hash);
+    database = p_gatt_db;
+    database_size = size;
+    return WICED_BT_GATT_SUCCESS;
+}
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle,
+                                           wiced_bt_uuid_t *p_uuid) {
+    auto offset = uint32_t{};
+
+    // Records: handle (LE16), permission, UUID length, UUID, value length,
+    // value
+    while (offset + 4 <= database_size) {
+        const auto handle = static_cast<uint16_t>(
+            database[offset] | (database[offset + 1] << 8));
+        const auto uuid_length = database[offset + 3];
+        const auto *uuid = &database[offset + 4];
+        const auto value_length = database[offset + 4 + uuid_length];
+
+        if (handle >= s_handle && handle <= e_handle &&
+            uuid_length == p_uuid->len) {
+            const auto match =
+                (uuid_length == LEN_UUID_16)
+                    ? (uuid[0] | (uuid[1] << 8)) == p_uuid->uu.uuid16
+                    : std::equal(uuid, uuid + LEN_UUID_128,
+                                 p_uuid->uu.uuid128);
+
+            if (match) {
+                return handle;
+            }
+        }
+
+        offset += 4 + uuid_length + 1 + value_length;
+    }
+
+    return 0;
+}
+
+uint16_t wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream,
+                                              uint16_t index) {
+    return static_cast<uint16_t>(p_handle_stream[index * 2] |
+                                 (p_handle_stream[index * 2 + 1] << 8));
+}
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id,
+                                    wiced_bt_gatt_opcode_t opcode,
+                                    uint16_t handle,
+                                    wiced_bt_gatt_status_t status) {
+    return send(host::bt_kind::error_rsp, conn_id, opcode, handle, status,
+                nullptr, 0, nullptr);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t len,
+    uint8_t *p_attr, wiced_bt_gatt_app_context_t p_app_ctx) {
+    return send(host::bt_kind::read_rsp, conn_id, opcode, 0, 0, p_attr, len,
+                p_app_ctx);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint8_t type_len,
+    uint16_t data_len, uint8_t *p_data, wiced_bt_gatt_app_context_t p_app_ctx) {
+    return send(host::bt_kind::read_by_type_rsp, conn_id, opcode, type_len, 0,
+                p_data, data_len, p_app_ctx);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(
+    uint16_t conn_id, wiced_bt_gatt_opcode_t opcode, uint16_t data_len,
+    uint8_t *p_data, wiced_bt_gatt_app_context_t p_app_ctx) {
+    return send(host::bt_kind::read_multi_rsp, conn_id, opcode, 0, 0, p_data,
+                data_len, p_app_ctx);
+}
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id,
+                                    wiced_bt_gatt_opcode_t opcode,
+                                    uint16_t handle) {
+    return send(host::bt_kind::write_rsp, conn_id, opcode, handle, 0, nullptr,
+                0, nullptr);
+}
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_prepare_write_rsp(uint16_t conn_id,
+                                            wiced_bt_gatt_opcode_t opcode,
+                                            wiced_bt_gatt_write_req_t *p_req) {
+    return send(host::bt_kind::prepare_write_rsp, conn_id, opcode,
+                p_req->handle, 0, p_req->p_val, p_req->val_len, nullptr);
+}
+
+wiced_bt_gatt_status_t
+wiced_bt_gatt_server_send_execute_write_rsp(uint16_t conn_id,
+                                            wiced_bt_gatt_opcode_t opcode) {
+    return send(host::bt_kind::execute_write_rsp, conn_id, opcode, 0, 0,
+                nullptr, 0, nullptr);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id,
+                                                         uint16_t remote_mtu,
+                                                         uint16_t local_mtu) {
+    static_cast<void>(remote_mtu);
+    return send(host::bt_kind::mtu_rsp, conn_id, GATT_REQ_MTU, local_mtu, 0,
+                nullptr, 0, nullptr);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_notification(
+    uint16_t conn_id, uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+    wiced_bt_gatt_app_context_t p_app_ctx) {
+    return send(host::bt_kind::notification, conn_id, GATT_HANDLE_VALUE_NOTIF,
+                attr_handle, 0, p_val, val_len, p_app_ctx);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_indication(
+    uint16_t conn_id, uint16_t attr_handle, uint16_t val_len, uint8_t *p_val,
+    wiced_bt_gatt_app_context_t p_app_ctx) {
+    return send(host::bt_kind::indication, conn_id, GATT_HANDLE_VALUE_IND,
+                attr_handle, 0, p_val, val_len, p_app_ctx);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_disconnect(uint16_t conn_id) {
+    note(host::bt_kind::disconnect, conn_id, 0);
+    return WICED_BT_GATT_SUCCESS;
+}
+
+uint16_t wiced_bt_l2cap_le_register(uint16_t le_psm,
+                                    wiced_bt_l2cap_le_appl_information_t *p_cb,
+                                    void *context) {
+    l2cap_psm = le_psm;
+    l2cap_callbacks = *p_cb;
+    l2cap_context = context;
+    return le_psm;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_deregister(uint16_t psm) {
+    static_cast<void>(psm);
+    l2cap_psm = 0;
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_connect_rsp(wiced_bt_device_address_t p_bd_addr,
+                                           uint8_t id, uint16_t lcid,
+                                           uint16_t result,
+                                           uint16_t mtu_local) {
+    static_cast<void>(p_bd_addr);
+    static_cast<void>(id);
+    static_cast<void>(mtu_local);
+
+    const uint8_t result_bytes[] = {static_cast<uint8_t>(result),
+                                    static_cast<uint8_t>(result >> 8)};
+
+    note(host::bt_kind::l2cap_connect_rsp, lcid, result, result_bytes,
+         sizeof(result_bytes));
+
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_req(uint16_t lcid) {
+    note(host::bt_kind::l2cap_disconnect, lcid, 0);
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_le_disconnect_rsp(uint16_t lcid) {
+    note(host::bt_kind::l2cap_disconnect, lcid, 0);
+    return WICED_TRUE;
+}
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(
+    wiced_bt_device_address_t rem_bdRa, uint16_t min_int, uint16_t max_int,
+    uint16_t latency, uint16_t timeout) {
+    static_cast<void>(rem_bdRa);
+
+    const uint8_t parameters[] = {
+        static_cast<uint8_t>(min_int), static_cast<uint8_t>(min_int >> 8),
+        static_cast<uint8_t>(max_int), static_cast<uint8_t>(max_int >> 8),
+        static_cast<uint8_t>(latency), static_cast<uint8_t>(latency >> 8),
+        static_cast<uint8_t>(timeout), static_cast<uint8_t>(timeout >> 8)};
+
+    note(host::bt_kind::connection_params, 0, min_int, parameters,
+         sizeof(parameters));
+
+    return WICED_TRUE;
+}
+
+} // extern "C"
@@ -0,0 +1,99 @@
+///
+/// \file    host_cycfg.cpp
+/// \brief   Host stand-in for the configurator-generated sources
+///
+/// \details The values the Bluetooth Configurator and the Device
+///          Configurator generate from src/app/design.cybt and the BSP:
+///          GATT value storage and its lookup table, stack settings,
+///          advertising data and the LED PWM configurations.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cybsp_bt_config.h"
+#include "cycfg_bt_settings.h"
+#include "cycfg_gap.h"
+#include "cycfg_gatt_db.h"
+#include "cycfg_peripherals.h"
+}
+#pragma GCC diagnostic pop
+
+#include <cstdint>
+
+extern "C" {
+
+uint8_t app_gap_device_name[] = {'B', 'a', 't', 't', 'e', 'r', 'y',
+                                 ' ', 'S', 'e', 'r', 'v', 'e', 'r'};
+uint8_t app_gap_appearance[] = {0x00, 0x00};
+uint8_t app_bas_battery_level[] = {0x00};
+uint8_t app_bas_battery_level_char_presentation_format[] = {
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00};
+uint8_t app_bas_battery_level_client_char_config[] = {0x00, 0x00};
+uint8_t app_ota_fw_upgrade_service_ota_upgrade_control_point[] = {0x00};
+uint8_t
+    app_ota_fw_upgrade_service_ota_upgrade_control_point_client_char_config[] =
+        {0x00, 0x00};
+uint8_t app_ota_fw_upgrade_service_ota_upgrade_data[] = {0x00};
+
+gatt_db_lookup_table_t app_gatt_db_ext_attr_tbl[] = {
+    {HDLC_GAP_DEVICE_NAME_VALUE, 14, 14, app_gap_device_name},
+    {HDLC_GAP_APPEARANCE_VALUE, 2, 2, app_gap_appearance},
+    {HDLC_BAS_BATTERY_LEVEL_VALUE, 1, 1, app_bas_battery_level},
+    {HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT, 7, 7,
+     app_bas_battery_level_char_presentation_format},
+    {HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG, 2, 2,
+     app_bas_battery_level_client_char_config},
+    {HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, 1, 0,
+     app_ota_fw_upgrade_service_ota_upgrade_control_point},
+    {HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG,
+     2, 2,
+     app_ota_fw_upgrade_service_ota_upgrade_control_point_client_char_config},
+    {HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE, 1, 0,
+     app_ota_fw_upgrade_service_ota_upgrade_data},
+};
+
+const uint16_t app_gatt_db_ext_attr_tbl_size =
+    sizeof(app_gatt_db_ext_attr_tbl) / sizeof(app_gatt_db_ext_attr_tbl[0]);
+
+static const wiced_bt_cfg_ble_t wiced_bt_cfg_ble = {
+    4,   // ble_max_simultaneous_links
+    517, // ble_max_rx_pdu_size
+};
+
+const wiced_bt_cfg_settings_t wiced_bt_cfg_settings = {
+    app_gap_device_name, // device_name
+    &wiced_bt_cfg_ble,   // p_ble_cfg
+};
+
+wiced_bt_device_address_t cy_bt_device_address = {0x00, 0xA0, 0x50,
+                                                  0x00, 0x00, 0x00};
+
+static uint8_t cy_bt_adv_packet_elem_0[] = {0x06};
+static uint8_t cy_bt_adv_packet_elem_1[] = {'B', 'a', 't', 't', 'e', 'r', 'y',
+                                            ' ', 'S', 'e', 'r', 'v', 'e', 'r'};
+static uint8_t cy_bt_adv_packet_elem_2[] = {0x0F, 0x18};
+static uint8_t cy_bt_adv_packet_elem_3[] = {0x00, 0x00};
+
+wiced_bt_ble_advert_elem_t cy_bt_adv_packet_data[] = {
+    {cy_bt_adv_packet_elem_0, sizeof(cy_bt_adv_packet_elem_0),
+     BTM_BLE_ADVERT_TYPE_FLAG},
+    {cy_bt_adv_packet_elem_1, sizeof(cy_bt_adv_packet_elem_1),
+     BTM_BLE_ADVERT_TYPE_NAME_COMPLETE},
+    {cy_bt_adv_packet_elem_2, sizeof(cy_bt_adv_packet_elem_2),
+     BTM_BLE_ADVERT_TYPE_16SRV_COMPLETE},
+    {cy_bt_adv_packet_elem_3, sizeof(cy_bt_adv_packet_elem_3),
+     BTM_BLE_ADVERT_TYPE_APPEARANCE},
+};
+
+const cyhal_pwm_configurator_t LED1_PWM_hal_config = {0};
+const cyhal_pwm_configurator_t LED2_PWM_hal_config = {0};
+const cyhal_pwm_configurator_t LED3_PWM_hal_config = {0};
+
+const cybt_platform_config_t cybsp_bt_platform_cfg = {115200};
+
+} // extern "C"
@@ -0,0 +1,243 @@
+///
+/// \file    host_freertos.cpp
+/// \brief   Host stand-in for the FreeRTOS tasks and task notifications
+///
+/// \details Each task is a thread that waits for vTaskStartScheduler()
+///          before running its function. Priorities are not modelled; the
+///          notification value and its pending state follow the FreeRTOS
+///          semantics, so tasks block and wake as they do on target.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include <FreeRTOS.h>
+#include <task.h>
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+///
+/// \brief Notification state of one task
+///
+struct host_task {
+    std::mutex mutex{};
+    std::condition_variable notified{};
+    uint32_t value{};   ///< Notification value
+    bool pending{};     ///< Notified since the last wait
+    const char *name{}; ///< Name given at creation
+};
+
+std::mutex scheduler_mutex{};
+std::condition_variable scheduler_started{};
+bool scheduler_running = false;
+
+thread_local host_task *current_task = nullptr;
+
+///
+/// \brief Block until the notification is pending or the wait times out
+///
+/// \return bool true if a notification is pending
+///
+bool wait_pending(host_task &task, std::unique_lock<std::mutex> &lock,
+                  TickType_t ticks) {
+    if (ticks == portMAX_DELAY) {
+        task.notified.wait(lock, [&task] { return task.pending; });
+        return true;
+    }
+
+    return task.notified.wait_for(lock, std::chrono::milliseconds{ticks},
+                                  [&task] { return task.pending; });
+}
+
+///
+/// \brief Apply a notify action
+///
+/// \return BaseType_t pdFAIL if eSetValueWithoutOverwrite found a pending
+///         notification, otherwise pdPASS
+///
+BaseType_t notify(TaskHandle_t handle, uint32_t value, eNotifyAction action) {
+    auto *task = static_cast<host_task *>(handle);
+
+    if (task == nullptr) {
+        return pdFAIL;
+    }
+
+    {
+        auto lock = std::lock_guard<std::mutex>{task->mutex};
+
+        switch (action) {
+        case eSetBits:
+            task->value |= value;
+            break;
+        case eIncrement:
+            ++task->value;
+            break;
+        case eSetValueWithOverwrite:
+            task->value = value;
+            break;
+        case eSetValueWithoutOverwrite:
+            if (task->pending) {
+                return pdFAIL;
+            }
+            task->value = value;
+            break;
+        case eNoAction:
+        default:
+            break;
+        }
+
+        task->pending = true;
+    }
+
+    task->notified.notify_one();
+
+    return pdPASS;
+}
+
+} // namespace
+
+extern "C" {
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName,
+                       uint32_t usStackDepth, void *pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask) {
+    static_cast<void>(usStackDepth);
+    static_cast<void>(uxPriority);
+
+    // Tasks live as long as the process
+    auto *task = new host_task{};
+    task->name = pcName;
+
+    // The handle is published before the task can use it
+    if (pxCreatedTask != nullptr) {
+        *pxCreatedTask = task;
+    }
+
+    std::thread([task, pxTaskCode, pvParameters] {
+        {
+            auto lock = std::unique_lock<std::mutex>{scheduler_mutex};
+            scheduler_started.wait(lock, [] { return scheduler_running; });
+        }
+
+        current_task = task;
+        pxTaskCode(pvParameters);
+    }).detach();
+
+    return pdPASS;
+}
+
+void vTaskStartScheduler(void) {
+    {
+        auto lock = std::lock_guard<std::mutex>{scheduler_mutex};
+        scheduler_running = true;
+    }
+
+    // Unlike the target, returns: the caller goes on as the stack thread
+    scheduler_started.notify_all();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{xTicksToDelay});
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(host::uptime())
+            .count());
+}
+
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                       eNotifyAction eAction) {
+    return notify(xTaskToNotify, ulValue, eAction);
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue,
+                              eNotifyAction eAction,
+                              BaseType_t *pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+
+    return notify(xTaskToNotify, ulValue, eAction);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry,
+                           uint32_t ulBitsToClearOnExit,
+                           uint32_t *pulNotificationValue,
+                           TickType_t xTicksToWait) {
+    auto &task = *current_task;
+    auto lock = std::unique_lock<std::mutex>{task.mutex};
+
+    if (!task.pending) {
+        task.value &= ~ulBitsToClearOnEntry;
+    }
+
+    const auto received = wait_pending(task, lock, xTicksToWait);
+
+    if (pulNotificationValue != nullptr) {
+        *pulNotificationValue = task.value;
+    }
+
+    if (!received) {
+        return pdFALSE;
+    }
+
+    task.value &= ~ulBitsToClearOnExit;
+    task.pending = false;
+
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    return notify(xTaskToNotify, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify,
+                            BaseType_t *pxHigherPriorityTaskWoken) {
+    xTaskNotifyFromISR(xTaskToNotify, 0, eIncrement,
+                       pxHigherPriorityTaskWoken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit,
+                          TickType_t xTicksToWait) {
+    auto &task = *current_task;
+    auto lock = std::unique_lock<std::mutex>{task.mutex};
+
+    // Waits for a non-zero count rather than for the pending state
+    const auto counted = [&task] { return task.value != 0; };
+
+    if (xTicksToWait == portMAX_DELAY) {
+        task.notified.wait(lock, counted);
+    } else {
+        task.notified.wait_for(lock, std::chrono::milliseconds{xTicksToWait},
+                               counted);
+    }
+
+    const auto value = task.value;
+
+    if (value != 0) {
+        task.value = (xClearCountOnExit != pdFALSE) ? 0 : value - 1;
+    }
+
+    task.pending = false;
+
+    return value;
+}
+
+} // extern "C"
@@ -0,0 +1,392 @@
+///
+/// \file    host_hal.cpp
+/// \brief   Host stand-in for the HAL, the BSP and the core debug unit
+///
+/// \details Critical sections are one recursive mutex shared by every
+///          thread, which gives the mutual exclusion the firmware relies on
+///          from masked interrupts. Timer and ADC interrupts are timer
+///          service callbacks; the ADC converts the voltage set with
+///          host::adc_set_microvolts() against a 3.3 V VDDA at 12 bits. The
+///          cycle counter counts
+///          nanoseconds, so SystemCoreClock is 1 GHz.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cybsp.h"
+#include "cybsp_bt_config.h"
+#include "cyhal.h"
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+std::recursive_mutex critical_section{};
+
+std::atomic<int32_t> adc_input_microvolts{3'700'000 / 2};
+std::atomic<bool> system_reset{false};
+
+cyhal_gpio_callback_data_t *button_callback = nullptr;
+
+/// Time the host ADC takes for one asynchronous read
+constexpr auto ADC_CONVERSION_TIME = std::chrono::microseconds{1000};
+
+/// The one SAR block: VDDA reference, 12-bit single-ended results
+SAR_Type sar{3'300'000, 4095};
+
+///
+/// \brief Host timer
+///
+struct host_timer {
+    host::timer_id id{};
+    uint32_t frequency{};                           ///< Counter clock in Hz
+    uint32_t period{};                              ///< Counts per period - 1
+    cyhal_timer_event_callback_t callback{nullptr}; ///< Terminal count event
+    void *callback_arg{nullptr};                    ///< Passed to callback
+};
+
+///
+/// \brief Host ADC
+///
+struct host_adc {
+    host::timer_id id{};
+    cyhal_adc_event_callback_t callback{nullptr}; ///< Read complete event
+    void *callback_arg{nullptr};                  ///< Passed to callback
+    int32_t *results{nullptr};                    ///< Buffer being filled
+    std::size_t count{};                          ///< Samples requested
+    bool microvolts{false};                       ///< Scale, or raw counts
+};
+
+} // namespace
+
+namespace host {
+
+void adc_set_microvolts(int32_t microvolts) {
+    adc_input_microvolts.store(microvolts, std::memory_order_relaxed);
+}
+
+void gpio_event(int pin, int event) {
+    if (button_callback != nullptr && button_callback->pin == pin) {
+        button_callback->callback(button_callback->callback_arg,
+                                  static_cast<cyhal_gpio_event_t>(event));
+    }
+}
+
+bool reset_requested() { return system_reset.load(); }
+
+} // namespace host
+
+extern "C" {
+
+CoreDebug_Type host_core_debug{};
+uint32_t SystemCoreClock = 1'000'000'000UL;
+uint8_t host_flash[CY_FLASH_SIZE]{};
+
+void host_assert_failed(const char *file, int line, const char *expression) {
+    std::fprintf(stderr, "%s:%d: CY_ASSERT(%s) failed\n", file, line,
+                 expression);
+    std::fflush(stdout);
+    std::abort();
+}
+
+DWT_Type *host_dwt(void) {
+    thread_local auto dwt = DWT_Type{};
+
+    dwt.CYCCNT = static_cast<uint32_t>(host::uptime().count());
+
+    return &dwt;
+}
+
+cy_rslt_t cybsp_init(void) { return CY_RSLT_SUCCESS; }
+
+void cybt_platform_config_init(
+    const cybt_platform_config_t *p_bt_platform_cfg) {
+    static_cast<void>(p_bt_platform_cfg);
+}
+
+uint32_t cyhal_system_critical_section_enter(void) {
+    critical_section.lock();
+    return 0;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_interrupt_state) {
+    static_cast<void>(old_interrupt_state);
+    critical_section.unlock();
+}
+
+cy_rslt_t cyhal_system_delay_ms(uint32_t milliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{milliseconds});
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_system_delay_us(uint16_t microseconds) {
+    std::this_thread::sleep_for(std::chrono::microseconds{microseconds});
+}
+
+void NVIC_SystemReset(void) { system_reset.store(true); }
+
+void __enable_irq(void) {}
+
+cy_rslt_t cyhal_pwm_init_cfg(cyhal_pwm_t *obj,
+                             const cyhal_pwm_configurator_t *cfg) {
+    static_cast<void>(cfg);
+    *obj = cyhal_pwm_t{};
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_pwm_free(cyhal_pwm_t *obj) { obj->running = false; }
+
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle,
+                                   uint32_t frequencyhal_hz) {
+    obj->duty_cycle = duty_cycle;
+    obj->frequency = frequencyhal_hz;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj) {
+    obj->running = true;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj) {
+    obj->running = false;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val) {
+    static_cast<void>(pin);
+    static_cast<void>(direction);
+    static_cast<void>(drive_mode);
+    static_cast<void>(init_val);
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_gpio_free(cyhal_gpio_t pin) { static_cast<void>(pin); }
+
+void cyhal_gpio_register_callback(cyhal_gpio_t pin,
+                                  cyhal_gpio_callback_data_t *callback_data) {
+    callback_data->pin = pin;
+    button_callback = callback_data;
+}
+
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event,
+                             uint8_t intr_priority, bool enable) {
+    static_cast<void>(pin);
+    static_cast<void>(event);
+    static_cast<void>(intr_priority);
+    static_cast<void>(enable);
+}
+
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin,
+                           const void *clk) {
+    static_cast<void>(pin);
+    static_cast<void>(clk);
+
+    auto *timer = new host_timer{};
+
+    timer->id = host::timer_create([timer] {
+        if (timer->callback != nullptr) {
+            timer->callback(timer->callback_arg,
+                            CYHAL_TIMER_IRQ_TERMINAL_COUNT);
+        }
+    });
+
+    obj->host = timer;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_timer_free(cyhal_timer_t *obj) {
+    // The timer service keeps the entry; only stop it
+    host::timer_stop(static_cast<host_timer *>(obj->host)->id);
+}
+
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg) {
+    static_cast<host_timer *>(obj->host)->period = cfg->period;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz) {
+    static_cast<host_timer *>(obj->host)->frequency = hz;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj) {
+    const auto &timer = *static_cast<host_timer *>(obj->host);
+    const auto period = std::chrono::microseconds{
+        (uint64_t{timer.period} + 1) * 1'000'000 / timer.frequency};
+
+    host::timer_start(timer.id, period, period);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj) {
+    host::timer_stop(static_cast<host_timer *>(obj->host)->id);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_reset(cyhal_timer_t *obj) {
+    static_cast<void>(obj);
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg) {
+    auto &timer = *static_cast<host_timer *>(obj->host);
+    timer.callback = callback;
+    timer.callback_arg = callback_arg;
+}
+
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable) {
+    static_cast<void>(obj);
+    static_cast<void>(event);
+    static_cast<void>(intr_priority);
+    static_cast<void>(enable);
+}
+
+cy_rslt_t cyhal_adc_init(cyhal_adc_t *obj, cyhal_gpio_t pin, const void *clk) {
+    static_cast<void>(pin);
+    static_cast<void>(clk);
+
+    auto *adc = new host_adc{};
+
+    adc->id = host::timer_create([adc] {
+        const auto microvolts = std::clamp(
+            adc_input_microvolts.load(std::memory_order_relaxed), int32_t{},
+            sar.vref_microvolts);
+
+        const auto counts = static_cast<int32_t>(
+            int64_t{microvolts} * sar.full_scale / sar.vref_microvolts);
+
+        for (auto i = std::size_t{}; i < adc->count; ++i) {
+            adc->results[i] = adc->microvolts ? microvolts : counts;
+        }
+
+        if (adc->callback != nullptr) {
+            adc->callback(adc->callback_arg, CYHAL_ADC_ASYNC_READ_COMPLETE);
+        }
+    });
+
+    obj->base = &sar;
+    obj->host = adc;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_adc_free(cyhal_adc_t *obj) {
+    host::timer_stop(static_cast<host_adc *>(obj->host)->id);
+}
+
+cy_rslt_t cyhal_adc_configure(cyhal_adc_t *obj,
+                              const cyhal_adc_config_t *config) {
+    static_cast<void>(obj);
+    static_cast<void>(config);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_adc_channel_init_diff(cyhal_adc_channel_t *obj,
+                                      cyhal_adc_t *adc, cyhal_gpio_t vplus,
+                                      cyhal_gpio_t vminus,
+                                      const cyhal_adc_channel_config_t *cfg) {
+    static_cast<void>(vminus);
+    static_cast<void>(cfg);
+
+    obj->adc = adc;
+    obj->vplus = vplus;
+    obj->channel_idx = 0;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_adc_channel_free(cyhal_adc_channel_t *obj) { obj->adc = nullptr; }
+
+cy_rslt_t cyhal_adc_set_async_mode(cyhal_adc_t *obj, cyhal_async_mode_t mode,
+                                   uint8_t dma_priority) {
+    static_cast<void>(obj);
+    static_cast<void>(mode);
+    static_cast<void>(dma_priority);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_adc_read_async(cyhal_adc_t *obj, size_t num_scan,
+                               int32_t *result_list) {
+    auto &adc = *static_cast<host_adc *>(obj->host);
+
+    adc.results = result_list;
+    adc.count = num_scan;
+    adc.microvolts = false;
+
+    host::timer_start(adc.id, ADC_CONVERSION_TIME, {});
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_adc_read_async_uv(cyhal_adc_t *obj, size_t num_scan,
+                                  int32_t *result_list) {
+    auto &adc = *static_cast<host_adc *>(obj->host);
+
+    adc.results = result_list;
+    adc.count = num_scan;
+    adc.microvolts = true;
+
+    host::timer_start(adc.id, ADC_CONVERSION_TIME, {});
+
+    return CY_RSLT_SUCCESS;
+}
+
+int32_t Cy_SAR_CountsTo_uVolts(const SAR_Type *base, uint32_t chan,
+                               int16_t adcCounts) {
+    static_cast<void>(chan);
+
+    return static_cast<int32_t>(int64_t{adcCounts} * base->vref_microvolts /
+                                base->full_scale);
+}
+
+void cyhal_adc_register_callback(cyhal_adc_t *obj,
+                                 cyhal_adc_event_callback_t callback,
+                                 void *callback_arg) {
+    auto &adc = *static_cast<host_adc *>(obj->host);
+    adc.callback = callback;
+    adc.callback_arg = callback_arg;
+}
+
+void cyhal_adc_enable_event(cyhal_adc_t *obj, cyhal_adc_event_t event,
+                            uint8_t intr_priority, bool enable) {
+    static_cast<void>(obj);
+    static_cast<void>(event);
+    static_cast<void>(intr_priority);
+    static_cast<void>(enable);
+}
+
+cy_rslt_t cyhal_wdt_init(cyhal_wdt_t *obj, uint32_t timeout_ms) {
+    obj->timeout_ms = timeout_ms;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_wdt_free(cyhal_wdt_t *obj) { static_cast<void>(obj); }
+
+void cyhal_wdt_kick(cyhal_wdt_t *obj) { static_cast<void>(obj); }
+
+uint32_t cyhal_wdt_get_max_timeout_ms(void) { return 6000; }
+
+} // extern "C"
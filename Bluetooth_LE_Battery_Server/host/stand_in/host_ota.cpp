@@ -0,0 +1,208 @@
+///
+/// \file    host_ota.cpp
+/// \brief   Host stand-in for the OTA library
+///
+/// \details Data writes are appended to an in-memory secondary slot, as the
+///          library programs flash sequentially from the start of the
+///          download, and take as long as erasing and programming PSoC 6
+///          flash would. Verification only records completion, and marking
+///          the slot pending for MCUboot is recorded beside the image.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "bootutil/bootutil.h"
+#include "cy_ota_api.h"
+#include "cy_result.h"
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// PSoC 6 flash subsector, erased before its first row is programmed
+constexpr auto FLASH_SUBSECTOR_SIZE = std::size_t{4096};
+
+/// PSoC 6 flash row, the unit of programming
+constexpr auto FLASH_ROW_SIZE = std::size_t{512};
+
+/// Subsector erase time (PSoC 6 datasheet)
+constexpr auto FLASH_ERASE_TIME = std::chrono::milliseconds{15};
+
+/// Row program time after an erase (PSoC 6 datasheet)
+constexpr auto FLASH_PROGRAM_TIME = std::chrono::milliseconds{5};
+
+std::mutex ota_mutex{};
+std::vector<uint8_t> secondary_slot{};
+auto ota_state = CY_OTA_STATE_NOT_INITIALIZED;
+auto image_pending = false;
+
+/// Non-null context handed to the application
+int ota_context_storage = 0;
+
+} // namespace
+
+namespace host {
+
+const std::vector<uint8_t> &ota_image() { return secondary_slot; }
+
+bool ota_image_pending() {
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+    return image_pending;
+}
+
+} // namespace host
+
+extern "C" {
+
+cy_rslt_t cy_ota_agent_start(cy_ota_network_params_t *network_params,
+                             cy_ota_agent_params_t *agent_params,
+                             cy_ota_context_ptr *ctx_ptr) {
+    static_cast<void>(network_params);
+    static_cast<void>(agent_params);
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+
+    ota_state = CY_OTA_STATE_AGENT_WAITING;
+    *ctx_ptr = &ota_context_storage;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_agent_stop(cy_ota_context_ptr *ctx_ptr) {
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+
+    ota_state = CY_OTA_STATE_NOT_INITIALIZED;
+    *ctx_ptr = nullptr;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_get_state(cy_ota_context_ptr ctx_ptr,
+                           cy_ota_agent_state_t *state) {
+    static_cast<void>(ctx_ptr);
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+    *state = ota_state;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_prepare(cy_ota_context_ptr ctx_ptr,
+                                      uint16_t bt_conn_id,
+                                      uint16_t bt_config_descriptor) {
+    static_cast<void>(bt_conn_id);
+    static_cast<void>(bt_config_descriptor);
+
+    return (ctx_ptr != nullptr) ? CY_RSLT_SUCCESS : CY_RSLT_OTA_ERROR_BADARG;
+}
+
+cy_rslt_t cy_ota_ble_download(cy_ota_context_ptr ctx_ptr,
+                              wiced_bt_gatt_event_data_t *p_req,
+                              uint16_t bt_conn_id,
+                              uint16_t bt_config_descriptor) {
+    static_cast<void>(p_req);
+    static_cast<void>(bt_conn_id);
+    static_cast<void>(bt_config_descriptor);
+
+    if (ctx_ptr == nullptr) {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+
+    secondary_slot.clear();
+    image_pending = false;
+    ota_state = CY_OTA_STATE_STORAGE_WRITE;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_write(cy_ota_context_ptr ctx_ptr,
+                                    wiced_bt_gatt_event_data_t *p_req) {
+    if (ctx_ptr == nullptr) {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    const auto &request = p_req->attribute_request.data.write_req;
+    auto offset = std::size_t{};
+
+    {
+        auto lock = std::lock_guard<std::mutex>{ota_mutex};
+
+        offset = secondary_slot.size();
+        secondary_slot.insert(secondary_slot.end(), request.p_val,
+                              request.p_val + request.val_len);
+    }
+
+    // Subsectors started and rows touched by this write; the caller waits
+    // as it would for flash, without holding up the rest of the library
+    const auto end = offset + request.val_len;
+    const auto subsector = [](std::size_t position) {
+        return (position + FLASH_SUBSECTOR_SIZE - 1) / FLASH_SUBSECTOR_SIZE;
+    };
+    const auto erases = subsector(end) - subsector(offset);
+    const auto rows = (end + FLASH_ROW_SIZE - 1) / FLASH_ROW_SIZE -
+                      offset / FLASH_ROW_SIZE;
+
+    std::this_thread::sleep_for(static_cast<long>(erases) * FLASH_ERASE_TIME +
+                                static_cast<long>(rows) * FLASH_PROGRAM_TIME);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_verify(cy_ota_context_ptr ctx_ptr,
+                                     wiced_bt_gatt_event_data_t *p_req,
+                                     uint16_t bt_conn_id) {
+    static_cast<void>(p_req);
+    static_cast<void>(bt_conn_id);
+
+    if (ctx_ptr == nullptr) {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+    ota_state = CY_OTA_STATE_OTA_COMPLETE;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_ota_ble_download_abort(cy_ota_context_ptr ctx_ptr) {
+    static_cast<void>(ctx_ptr);
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+
+    secondary_slot.clear();
+    image_pending = false;
+    ota_state = CY_OTA_STATE_AGENT_WAITING;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void cy_ota_set_log_level(int level) { static_cast<void>(level); }
+
+cy_rslt_t cy_ota_storage_validated(void) { return CY_RSLT_SUCCESS; }
+
+int boot_set_pending(int permanent) {
+    static_cast<void>(permanent);
+
+    auto lock = std::lock_guard<std::mutex>{ota_mutex};
+    image_pending = !secondary_slot.empty();
+
+    return image_pending ? 0 : -1;
+}
+
+} // extern "C"
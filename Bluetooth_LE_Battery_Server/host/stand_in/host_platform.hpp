@@ -0,0 +1,230 @@
+///
+/// \file    host_platform.hpp
+/// \brief   Control surface of the host stand-ins
+///
+/// \details The stand-ins in this directory replace the WICED Bluetooth
+///          stack, the HAL, FreeRTOS and the OTA library so the firmware in
+///          src/ runs as a Linux process. This header is what the
+///          simulation uses to play the peer: it delivers stack events,
+///          takes what the firmware sent over the air and sets the analog
+///          input. The calling thread stands in for the Bluetooth stack
+///          thread.
+///
+///          The timer service is shared by the RTOS timers, the HAL timers
+///          and the ADC; its callbacks run on one thread, as interrupts and
+///          the RTOS timer task would.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef HOST_PLATFORM_HPP
+#define HOST_PLATFORM_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace host {
+
+///
+/// \brief Kind of an over-the-air record
+///
+enum class bt_kind : uint8_t {
+    error_rsp,          ///< ATT error response
+    read_rsp,           ///< Read or read blob response
+    read_by_type_rsp,   ///< Read by type response
+    read_multi_rsp,     ///< Read multiple (variable length) response
+    write_rsp,          ///< Write response
+    prepare_write_rsp,  ///< Prepare write response
+    execute_write_rsp,  ///< Execute write response
+    mtu_rsp,            ///< Exchange MTU response
+    notification,       ///< Handle value notification
+    indication,         ///< Handle value indication
+    disconnect,         ///< Local disconnect
+    advertising,        ///< Advertising mode change
+    advertising_data,   ///< Raw advertising data
+    scan_response_data, ///< Raw scan response data
+    phy,                ///< PHY preference
+    data_length,        ///< LL data length request
+    connection_params,  ///< Connection parameter update request
+    l2cap_connect_rsp,  ///< L2CAP credit-based channel accepted or refused
+    l2cap_disconnect    ///< L2CAP channel closed locally
+};
+
+///
+/// \brief One thing the firmware handed to the stack
+///
+struct bt_record {
+    bt_kind kind;              ///< What was sent
+    uint16_t conn_id;          ///< Connection or L2CAP channel
+    uint8_t opcode;            ///< ATT opcode, if any
+    uint16_t handle;           ///< Attribute handle, mode or parameter
+    uint8_t status;            ///< Error code, if any
+    std::vector<uint8_t> data; ///< Payload as transmitted
+};
+
+///
+/// \brief Take every record sent so far
+///
+/// Responses that carry a transmit context are captured when bt_transmit()
+/// runs, as the controller would read the buffer; everything else is copied
+/// when sent.
+///
+/// \return std::vector<bt_record> Records in send order
+///
+std::vector<bt_record> bt_take();
+
+///
+/// \brief Transmit pending responses
+///
+/// Delivers GATT_APP_BUFFER_TRANSMITTED_EVT for every buffer sent with a
+/// context since the last call.
+///
+void bt_transmit();
+
+///
+/// \brief Make the next sends of the stack fail
+///
+/// \param count Number of sends to refuse with WICED_BT_GATT_BUSY
+///
+void bt_fail_sends(std::size_t count);
+
+///
+/// \brief Deliver BTM_ENABLED_EVT to the management callback
+///
+void bt_enable();
+
+///
+/// \brief Deliver a management event
+///
+/// \param event Event
+/// \param data Event data
+///
+/// \return wiced_result_t Result of the management callback
+///
+wiced_result_t bt_management(wiced_bt_management_evt_t event,
+                             wiced_bt_management_evt_data_t *data);
+
+///
+/// \brief Deliver a GATT event to the registered callback
+///
+/// \param event Event
+/// \param data Event data
+///
+/// \return wiced_bt_gatt_status_t Result of the GATT callback
+///
+wiced_bt_gatt_status_t bt_gatt(wiced_bt_gatt_evt_t event,
+                               wiced_bt_gatt_event_data_t *data);
+
+///
+/// \brief Open an L2CAP credit-based channel from the peer
+///
+/// \param address Peer address
+/// \param local_cid Channel identifier
+/// \param mtu Peer MTU
+///
+/// \return bool true if a service was registered for the PSM
+///
+bool l2cap_open(wiced_bt_device_address_t address, uint16_t local_cid,
+                uint16_t mtu);
+
+///
+/// \brief Deliver an SDU on an L2CAP channel
+///
+void l2cap_data(uint16_t local_cid, const uint8_t *data, uint16_t length);
+
+///
+/// \brief Close an L2CAP channel from the peer
+///
+void l2cap_close(uint16_t local_cid);
+
+///
+/// \brief Set the voltage the ADC converts
+///
+/// \param microvolts Input voltage in microvolts
+///
+void adc_set_microvolts(int32_t microvolts);
+
+///
+/// \brief Raise a GPIO event as the pin interrupt would
+///
+/// \param pin Pin
+/// \param event cyhal_gpio_event_t value
+///
+void gpio_event(int pin, int event);
+
+///
+/// \brief Get the image the OTA library wrote to the secondary slot
+///
+const std::vector<uint8_t> &ota_image();
+
+///
+/// \brief Whether the secondary slot was marked pending for MCUboot
+///
+bool ota_image_pending();
+
+///
+/// \brief Whether the firmware asked for a system reset
+///
+bool reset_requested();
+
+///
+/// \brief Identifier of a timer-service entry
+///
+using timer_id = std::size_t;
+
+///
+/// \brief Create a timer-service entry
+///
+/// \param callback Function run on the timer thread when the entry expires
+///
+/// \return timer_id Identifier of the new, stopped entry
+///
+timer_id timer_create(std::function<void()> callback);
+
+///
+/// \brief Start or restart a timer-service entry
+///
+/// \param id Entry
+/// \param delay Time until the first expiry
+/// \param period Time between later expiries; zero for one expiry
+///
+void timer_start(timer_id id, std::chrono::microseconds delay,
+                 std::chrono::microseconds period);
+
+///
+/// \brief Stop a timer-service entry
+///
+void timer_stop(timer_id id);
+
+///
+/// \brief Move the simulated clock forward
+///
+/// uptime(), the RTOS tick count and every timer-service entry see \p skip
+/// pass at once. Expiries that fall in it run, in order, before this
+/// returns; blocking waits in the tasks still take real time.
+///
+/// \param skip Time to skip
+///
+void advance_time(std::chrono::microseconds skip);
+
+///
+/// \brief Time since the process started, including skipped time
+///
+std::chrono::nanoseconds uptime();
+
+} // namespace host
+
+#endif /* HOST_PLATFORM_HPP */
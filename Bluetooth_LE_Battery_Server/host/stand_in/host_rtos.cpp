@@ -0,0 +1,319 @@
+///
+/// \file    host_rtos.cpp
+/// \brief   Host stand-in for the RTOS abstraction and the timer service
+///
+/// \details Semaphores are counting semaphores on a mutex and condition
+///          variable. Every timer, whether an RTOS timer, a HAL timer or a
+///          pending ADC conversion, is an entry of one timer service whose
+///          callbacks run on a single thread, outside its lock, so a
+///          callback may start or stop any entry. The service keeps the
+///          simulated clock: host::advance_time() moves it forward for the
+///          service, uptime() and the tick count at once.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+const auto process_start = clock_type::now();
+
+/// Time skipped by host::advance_time(), in nanoseconds
+std::atomic<int64_t> skipped_ns{0};
+
+///
+/// \brief Simulated time: real time plus the time skipped
+///
+clock_type::time_point simulated_now() {
+    return clock_type::now() +
+           std::chrono::nanoseconds{skipped_ns.load(std::memory_order_acquire)};
+}
+
+///
+/// \brief One entry of the timer service
+///
+struct timer_entry {
+    std::function<void()> callback{};   ///< Run on expiry
+    clock_type::time_point due{};       ///< Next expiry
+    std::chrono::microseconds period{}; ///< Zero for one expiry
+    bool active{};                      ///< Started and not stopped
+};
+
+///
+/// \brief Timer service thread and its entries
+///
+class timer_service final {
+public:
+    static timer_service &instance() {
+        static auto service = timer_service{};
+        return service;
+    }
+
+    host::timer_id create(std::function<void()> callback) {
+        auto lock = std::lock_guard<std::mutex>{m_mutex};
+
+        if (!m_started) {
+            std::thread([this] { run(); }).detach();
+            m_started = true;
+        }
+
+        m_entries.push_back(timer_entry{std::move(callback), {}, {}, false});
+
+        return m_entries.size() - 1;
+    }
+
+    void start(host::timer_id id, std::chrono::microseconds delay,
+               std::chrono::microseconds period) {
+        {
+            auto lock = std::lock_guard<std::mutex>{m_mutex};
+            auto &entry = m_entries[id];
+
+            entry.due = simulated_now() + delay;
+            entry.period = period;
+            entry.active = true;
+        }
+
+        m_changed.notify_one();
+    }
+
+    void stop(host::timer_id id) {
+        auto lock = std::lock_guard<std::mutex>{m_mutex};
+        m_entries[id].active = false;
+    }
+
+    void advance(std::chrono::microseconds skip) {
+        auto lock = std::unique_lock<std::mutex>{m_mutex};
+
+        skipped_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(skip).count(),
+            std::memory_order_acq_rel);
+        m_changed.notify_one();
+
+        // Every expiry up to the new time runs before the caller goes on
+        m_idle.wait(lock, [this] { return !m_running && !expired(); });
+    }
+
+private:
+    timer_service() = default;
+
+    ///
+    /// \brief Whether an active entry is due; call with the lock held
+    ///
+    bool expired() const {
+        const auto now = simulated_now();
+
+        for (const auto &entry : m_entries) {
+            if (entry.active && entry.due <= now) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[noreturn]] void run() {
+        auto lock = std::unique_lock<std::mutex>{m_mutex};
+
+        while (true) {
+            timer_entry *next = nullptr;
+
+            for (auto &entry : m_entries) {
+                if (entry.active &&
+                    (next == nullptr || entry.due < next->due)) {
+                    next = &entry;
+                }
+            }
+
+            if (next == nullptr) {
+                m_idle.notify_all();
+                m_changed.wait(lock);
+                continue;
+            }
+
+            if (const auto now = simulated_now(); now < next->due) {
+                // Woken early by a start() or advance(); pick the earliest
+                // entry again
+                m_idle.notify_all();
+                m_changed.wait_for(lock, next->due - now);
+                continue;
+            }
+
+            if (next->period.count() != 0) {
+                next->due += next->period;
+            } else {
+                next->active = false;
+            }
+
+            // A copy, so the callback may restart its own entry
+            auto callback = next->callback;
+
+            m_running = true;
+            lock.unlock();
+            callback();
+            lock.lock();
+            m_running = false;
+        }
+    }
+
+    std::mutex m_mutex{};
+    std::condition_variable m_changed{};
+    std::condition_variable m_idle{};    ///< Nothing due and nothing running
+    std::deque<timer_entry> m_entries{}; ///< Stable addresses as it grows
+    bool m_started{false};
+    bool m_running{false}; ///< A callback runs outside the lock
+};
+
+///
+/// \brief Counting semaphore
+///
+struct host_semaphore {
+    std::mutex mutex{};
+    std::condition_variable available{};
+    uint32_t count{};
+    uint32_t max_count{};
+};
+
+///
+/// \brief RTOS timer
+///
+struct host_rtos_timer {
+    host::timer_id id{};
+    bool periodic{};
+};
+
+} // namespace
+
+namespace host {
+
+timer_id timer_create(std::function<void()> callback) {
+    return timer_service::instance().create(std::move(callback));
+}
+
+void timer_start(timer_id id, std::chrono::microseconds delay,
+                 std::chrono::microseconds period) {
+    timer_service::instance().start(id, delay, period);
+}
+
+void timer_stop(timer_id id) { timer_service::instance().stop(id); }
+
+void advance_time(std::chrono::microseconds skip) {
+    timer_service::instance().advance(skip);
+}
+
+std::chrono::nanoseconds uptime() { return simulated_now() - process_start; }
+
+} // namespace host
+
+extern "C" {
+
+cy_rslt_t cy_rtos_delay_milliseconds(cy_time_t num_ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{num_ms});
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_get_time(cy_time_t *tval) {
+    *tval = static_cast<cy_time_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(host::uptime())
+            .count());
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_init_semaphore(cy_semaphore_t *semaphore, uint32_t maxcount,
+                                 uint32_t initcount) {
+    auto *state = new host_semaphore{};
+    state->count = initcount;
+    state->max_count = maxcount;
+
+    semaphore->handle = state;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_get_semaphore(cy_semaphore_t *semaphore, cy_time_t timeout_ms,
+                                bool in_isr) {
+    static_cast<void>(in_isr);
+
+    auto &state = *static_cast<host_semaphore *>(semaphore->handle);
+    auto lock = std::unique_lock<std::mutex>{state.mutex};
+    const auto available = [&state] { return state.count != 0; };
+
+    if (timeout_ms == CY_RTOS_NEVER_TIMEOUT) {
+        state.available.wait(lock, available);
+    } else if (!state.available.wait_for(
+                   lock, std::chrono::milliseconds{timeout_ms}, available)) {
+        return CY_RTOS_TIMEOUT;
+    }
+
+    --state.count;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_set_semaphore(cy_semaphore_t *semaphore, bool in_isr) {
+    static_cast<void>(in_isr);
+
+    auto &state = *static_cast<host_semaphore *>(semaphore->handle);
+
+    {
+        auto lock = std::lock_guard<std::mutex>{state.mutex};
+
+        if (state.count < state.max_count) {
+            ++state.count;
+        }
+    }
+
+    state.available.notify_one();
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_init_timer(cy_timer_t *timer, cy_timer_trigger_type_t type,
+                             cy_timer_callback_t fun,
+                             cy_timer_callback_arg_t arg) {
+    auto *state = new host_rtos_timer{};
+    state->id = host::timer_create([fun, arg] { fun(arg); });
+    state->periodic = (type == CY_TIMER_TYPE_PERIODIC);
+
+    timer->handle = state;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_start_timer(cy_timer_t *timer, cy_time_t num_ms) {
+    const auto &state = *static_cast<host_rtos_timer *>(timer->handle);
+    const auto period = std::chrono::milliseconds{num_ms};
+
+    host::timer_start(state.id, period,
+                      state.periodic ? period : std::chrono::milliseconds{});
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_rtos_stop_timer(cy_timer_t *timer) {
+    host::timer_stop(static_cast<host_rtos_timer *>(timer->handle)->id);
+    return CY_RSLT_SUCCESS;
+}
+
+} // extern "C"
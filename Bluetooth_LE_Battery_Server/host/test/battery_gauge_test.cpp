@@ -0,0 +1,151 @@
+///
+/// \file    battery_gauge_test.cpp
+/// \brief   Checks of the battery voltage filter and state-of-charge map
+///
+/// \details Checks at compile time that the OCV table validation refuses
+///          bad tables and that state_of_charge() clamps, hits every table
+///          point, rounds between them and never decreases; and at run time
+///          that the filter primes on its first sample, rejects single
+///          spikes, settles on a step and keeps a 1 mV change.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "battery_gauge.hpp"
+#include "test_check.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using util::liion_ocv_table;
+using util::ocv_point;
+using util::state_of_charge;
+
+// Tables that cannot be interpolated
+static_assert(!util::ocv_table_valid(std::array<ocv_point, 1>{{{3000, 0}}}));
+static_assert(!util::ocv_table_valid(
+    std::array<ocv_point, 2>{{{3000, 0}, {3000, 100}}}));
+static_assert(!util::ocv_table_valid(
+    std::array<ocv_point, 2>{{{3000, 50}, {4200, 10}}}));
+static_assert(!util::ocv_table_valid(
+    std::array<ocv_point, 2>{{{3000, 0}, {4200, 101}}}));
+
+// Voltages outside the table clamp
+static_assert(state_of_charge(liion_ocv_table, 0) == 0);
+static_assert(state_of_charge(liion_ocv_table, 2999) == 0);
+static_assert(state_of_charge(liion_ocv_table, 4201) == 100);
+static_assert(state_of_charge(liion_ocv_table, INT32_MAX) == 100);
+
+///
+/// \brief Check every table point maps to its own percentage
+///
+constexpr bool points_exact() {
+    for (const auto &point : liion_ocv_table) {
+        if (state_of_charge(liion_ocv_table, point.millivolts) !=
+            point.percent) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// \brief Check the estimate never drops as the voltage rises
+///
+constexpr bool monotonic() {
+    auto previous = state_of_charge(liion_ocv_table, 2900);
+
+    for (auto millivolts = int32_t{2901}; millivolts <= 4300; millivolts++) {
+        const auto percent = state_of_charge(liion_ocv_table, millivolts);
+
+        if (percent < previous) {
+            return false;
+        }
+
+        previous = percent;
+    }
+
+    return true;
+}
+
+static_assert(points_exact());
+static_assert(monotonic());
+
+// Between points: nearest percent, halves rounding up
+static_assert(state_of_charge(liion_ocv_table, 3845) == 55);
+static_assert(state_of_charge(liion_ocv_table, 3149) == 1);
+static_assert(state_of_charge(liion_ocv_table, 3075) == 1);
+static_assert(state_of_charge(liion_ocv_table, 3074) == 0);
+static_assert(state_of_charge(liion_ocv_table, 4140) == 95);
+
+/// Filter as configured by the battery service task
+using filter = util::battery_voltage_filter<5, 3>;
+
+void check_priming() {
+    auto voltage = filter{};
+
+    TEST_CHECK(voltage.value() == 0);
+    TEST_CHECK(voltage.update(3700) == 3700);
+
+    voltage.reset();
+    TEST_CHECK(voltage.value() == 0);
+    TEST_CHECK(voltage.update(4100) == 4100);
+}
+
+void check_spikes() {
+    auto voltage = filter{};
+
+    for (auto i = 0; i < 5; i++) {
+        voltage.update(3700);
+    }
+
+    // A single sample either way never reaches the low-pass
+    TEST_CHECK(voltage.update(4200) == 3700);
+    TEST_CHECK(voltage.update(3700) == 3700);
+    TEST_CHECK(voltage.update(0) == 3700);
+    TEST_CHECK(voltage.update(3700) == 3700);
+}
+
+void check_step() {
+    auto voltage = filter{};
+    auto previous = voltage.update(3700);
+
+    // A sustained step is followed without overshoot
+    for (auto i = 0; i < 100; i++) {
+        const auto output = voltage.update(3800);
+
+        TEST_CHECK(output >= previous && output <= 3800);
+        previous = output;
+    }
+
+    TEST_CHECK(previous == 3800);
+}
+
+void check_small_step() {
+    auto voltage = filter{};
+    voltage.update(3700);
+
+    // Q8 state keeps a step below the shift from truncating away
+    for (auto i = 0; i < 100; i++) {
+        voltage.update(3701);
+    }
+
+    TEST_CHECK(voltage.value() == 3701);
+}
+
+} // namespace
+
+int main() {
+    check_priming();
+    check_spikes();
+    check_step();
+    check_small_step();
+
+    return test_result();
+}
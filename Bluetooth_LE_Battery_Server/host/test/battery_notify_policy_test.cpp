@@ -0,0 +1,98 @@
+///
+/// \file    battery_notify_policy_test.cpp
+/// \brief   Compile-time checks of the battery notification policy
+///
+/// \details Drives battery_notify_policy through timed samples and checks
+///          that the first sample is always sent, that a change must leave
+///          the hysteresis band and wait out the minimum interval, that the
+///          heartbeat sends a flat level, and that the tick counter may wrap.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "battery_notify_policy.hpp"
+
+#include <cstdint>
+
+namespace {
+
+/// Band of 5 percent, at most every 100 ticks, at least every 1000
+constexpr auto CONFIG = battery_notify_policy_config{5, 100, 1000};
+
+///
+/// \brief Policy that last sent a level at a tick
+///
+constexpr battery_notify_policy sent(uint8_t level, uint32_t now_ticks) {
+    auto policy = battery_notify_policy{CONFIG};
+    policy.mark_sent(level, now_ticks);
+
+    return policy;
+}
+
+// Nothing sent yet: any sample goes out, whatever the time
+static_assert(battery_notify_policy{CONFIG}.should_notify(50, 0));
+static_assert(battery_notify_policy{CONFIG}.should_notify(0, UINT32_MAX));
+
+// Inside the band nothing is sent before the heartbeat
+static_assert(!sent(50, 0).should_notify(50, 500));
+static_assert(!sent(50, 0).should_notify(55, 500));
+static_assert(!sent(50, 0).should_notify(45, 500));
+
+// Leaving the band, in either direction, once the minimum interval is over
+static_assert(sent(50, 0).should_notify(56, 100));
+static_assert(sent(50, 0).should_notify(44, 100));
+static_assert(sent(50, 0).should_notify(0, 999));
+
+// A change inside the minimum interval waits, however large
+static_assert(!sent(50, 0).should_notify(56, 99));
+static_assert(!sent(50, 0).should_notify(100, 1));
+static_assert(!sent(50, 0).should_notify(0, 0));
+
+// The heartbeat sends a flat level, and a change without the minimum wait
+static_assert(sent(50, 0).should_notify(50, 1000));
+static_assert(sent(50, 0).should_notify(50, 5000));
+
+///
+/// \brief The band and intervals restart from each notification
+///
+constexpr bool restarts_from_last_sent() {
+    auto policy = sent(50, 0);
+
+    if (!policy.should_notify(60, 200)) {
+        return false;
+    }
+
+    policy.mark_sent(60, 200);
+
+    // Measured from 60 at tick 200 now, not from 50 at tick 0
+    return !policy.should_notify(56, 400) && policy.should_notify(54, 400) &&
+           !policy.should_notify(70, 299) && !policy.should_notify(60, 1199) &&
+           policy.should_notify(60, 1200);
+}
+
+static_assert(restarts_from_last_sent());
+
+///
+/// \brief The intervals span the tick counter wrapping
+///
+constexpr bool survives_wrap() {
+    constexpr auto start = uint32_t{UINT32_MAX - 50};
+    const auto policy = sent(50, start);
+
+    return !policy.should_notify(60, start + 99) &&
+           policy.should_notify(60, start + 100) &&
+           !policy.should_notify(50, start + 999) &&
+           policy.should_notify(50, start + 1000);
+}
+
+static_assert(survives_wrap());
+
+// The tunables are kept as given
+static_assert(sent(0, 0).configuration().hysteresis_percent == 5);
+static_assert(sent(0, 0).configuration().max_interval_ticks == 1000);
+
+} // namespace
+
+int main() { return 0; }
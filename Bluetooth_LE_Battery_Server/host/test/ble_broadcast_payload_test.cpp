@@ -0,0 +1,127 @@
+///
+/// \file    ble_broadcast_payload_test.cpp
+/// \brief   Compile-time checks of the battery broadcast payload
+///
+/// \details Encodes the Battery Service data with and without the sequence
+///          number and packs the design.cybt advertising elements around it,
+///          including structures that overflow the 31-byte advertising data.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_broadcast_payload.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+///
+/// \brief The members of wiced_bt_ble_advert_elem_t the packer reads
+///
+struct element {
+    std::size_t len;
+    uint8_t advert_type;
+};
+
+constexpr auto AD_FLAGS = BLE_AD_TYPE_FLAGS;
+constexpr auto AD_NAME_COMPLETE = uint8_t{0x09};
+constexpr auto AD_16SRV_COMPLETE = uint8_t{0x03};
+constexpr auto AD_APPEARANCE = uint8_t{0x19};
+
+// UUID 0x180F little endian, then the level, then the sequence number
+constexpr auto with_sequence = ble_battery_service_data_encode<true>(87, 5);
+static_assert(with_sequence.size() == 4);
+static_assert(with_sequence[0] == 0x0F && with_sequence[1] == 0x18);
+static_assert(with_sequence[2] == 87 && with_sequence[3] == 5);
+
+constexpr auto without_sequence =
+    ble_battery_service_data_encode<false>(42, 5);
+static_assert(without_sequence.size() == 3);
+static_assert(without_sequence[0] == 0x0F && without_sequence[1] == 0x18);
+static_assert(without_sequence[2] == 42);
+
+// Levels above 100 % are clamped
+static_assert(ble_battery_service_data_encode<true>(250, 0)[2] == 100);
+static_assert(ble_battery_service_data_encode<false>(100, 0)[2] == 100);
+static_assert(ble_battery_service_data_encode<true>(0, 255)[3] == 255);
+
+static_assert(ble_battery_service_data_encode(1, 0).size() ==
+              ble_battery_service_data{}.size());
+
+static_assert(ble_ad_structure_size(0) == 2);
+static_assert(ble_ad_structure_size(29) == BLE_ADVERTISING_DATA_MAX);
+
+/// Service data of the sequence variant
+constexpr auto service_data = element{4, BLE_AD_TYPE_SERVICE_DATA_16};
+
+// design.cybt: flags, complete name "Battery Server", Battery Service UUID
+// and appearance
+constexpr element design[] = {
+    {1, AD_FLAGS},
+    {14, AD_NAME_COMPLETE},
+    {2, AD_16SRV_COMPLETE},
+    {2, AD_APPEARANCE},
+};
+
+constexpr auto packed = ble_advertising_pack<5>(design, 4, service_data);
+
+// Flags, service data, name and UUID fill 29 bytes; the appearance moves
+static_assert(packed.advertising_count == 4);
+static_assert(packed.advertising[0].advert_type == AD_FLAGS);
+static_assert(packed.advertising[1].advert_type ==
+              BLE_AD_TYPE_SERVICE_DATA_16);
+static_assert(packed.advertising[2].advert_type == AD_NAME_COMPLETE);
+static_assert(packed.advertising[3].advert_type == AD_16SRV_COMPLETE);
+static_assert(packed.advertising_bytes == 3 + 6 + 16 + 4);
+static_assert(packed.scan_response_count == 1);
+static_assert(packed.scan_response[0].advert_type == AD_APPEARANCE);
+static_assert(packed.scan_response_bytes == 4);
+static_assert(packed.dropped == 0);
+
+// Flags are placed first wherever they appear
+constexpr element flags_last[] = {
+    {2, AD_APPEARANCE},
+    {1, AD_FLAGS},
+};
+
+constexpr auto reordered = ble_advertising_pack<3>(flags_last, 2,
+                                                   service_data);
+static_assert(reordered.advertising[0].advert_type == AD_FLAGS);
+static_assert(reordered.advertising[1].advert_type ==
+              BLE_AD_TYPE_SERVICE_DATA_16);
+static_assert(reordered.advertising[2].advert_type == AD_APPEARANCE);
+
+// A 32-byte structure fits neither payload and is dropped; the rest fill
+// the advertising data to exactly 31 bytes, then the scan response
+constexpr element overflow[] = {
+    {1, AD_FLAGS},
+    {30, AD_NAME_COMPLETE},
+    {20, AD_NAME_COMPLETE},
+    {20, AD_APPEARANCE},
+    {2, AD_16SRV_COMPLETE},
+};
+
+constexpr auto overflowed = ble_advertising_pack<6>(overflow, 5,
+                                                    service_data);
+static_assert(overflowed.dropped == 1);
+static_assert(overflowed.advertising_count == 3);
+static_assert(overflowed.advertising_bytes == BLE_ADVERTISING_DATA_MAX);
+static_assert(overflowed.advertising[2].len == 20);
+static_assert(overflowed.scan_response_count == 2);
+static_assert(overflowed.scan_response_bytes == 22 + 4);
+static_assert(overflowed.scan_response[0].advert_type == AD_APPEARANCE);
+static_assert(overflowed.scan_response[1].advert_type == AD_16SRV_COMPLETE);
+
+// Without the sequence number the service data is a byte shorter
+constexpr auto short_service_data = element{3, BLE_AD_TYPE_SERVICE_DATA_16};
+constexpr auto shorter = ble_advertising_pack<5>(design, 4,
+                                                 short_service_data);
+static_assert(shorter.advertising_bytes == 3 + 5 + 16 + 4);
+static_assert(shorter.scan_response_count == 1);
+
+} // namespace
+
+int main() { return 0; }
@@ -0,0 +1,275 @@
+///
+/// \file    ble_gatt_prepare_queue_test.cpp
+/// \brief   Checks of the prepared write queue, alone and behind the GATT
+///          callback
+///
+/// \details Replays fragments that overlap and that arrive out of offset
+///          order through validate() and assemble(), and fills the arena and
+///          the fragment table to check a full queue refuses without
+///          touching what it holds. Then plays Prepare Write and Execute
+///          Write requests through ble_gatt_event_callback() and checks an
+///          overlapping long write of the device name, and that a full
+///          arena or fragment table answers Prepare Queue Full until the
+///          queue is executed or cancelled.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gatt_db.h"
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_gatt.hpp"
+#include "ble_gatt_prepare_queue.hpp"
+#include "host_platform.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using bytes = std::vector<uint8_t>;
+using small_queue = prepare_write_queue<32, 4>;
+using check = small_queue::check;
+
+bytes text(const char *value) {
+    return bytes(value, value + std::strlen(value));
+}
+
+///
+/// \brief Queue a fragment of text
+///
+bool push(small_queue &queue, uint16_t handle, uint16_t offset,
+          const char *value) {
+    const auto data = text(value);
+
+    return queue.push(handle, offset, data.data(),
+                      static_cast<uint16_t>(data.size()));
+}
+
+///
+/// \brief Final value of a handle, starting from \p current
+///
+bytes assembled(const small_queue &queue, uint16_t handle,
+                const char *current) {
+    auto value = bytes(32);
+    const auto length = static_cast<uint16_t>(std::strlen(current));
+
+    std::memcpy(value.data(), current, length);
+    value.resize(queue.assemble(handle, value.data(), length));
+
+    return value;
+}
+
+void check_overlapping() {
+    auto queue = small_queue{};
+
+    // A later fragment overwrites where it overlaps an earlier one
+    TEST_CHECK(push(queue, 1, 0, "aaaaaa"));
+    TEST_CHECK(push(queue, 1, 3, "bbbbbb"));
+    TEST_CHECK(push(queue, 1, 1, "cc"));
+
+    TEST_CHECK(queue.validate(1, 0, 32) == check::ok);
+
+    // The value ends where the last fragment ends
+    TEST_CHECK(assembled(queue, 1, "") == text("acc"));
+
+    // An earlier fragment reaching past a later one's end is cut there
+    queue.clear();
+    TEST_CHECK(push(queue, 1, 0, "aaaaaa"));
+    TEST_CHECK(push(queue, 1, 0, "bb"));
+    TEST_CHECK(assembled(queue, 1, "") == text("bb"));
+
+    // Fragments of other handles are left out
+    queue.clear();
+    TEST_CHECK(push(queue, 1, 4, "xy"));
+    TEST_CHECK(push(queue, 2, 0, "zz"));
+    TEST_CHECK(push(queue, 1, 6, "!"));
+    TEST_CHECK(assembled(queue, 1, "name") == text("namexy!"));
+    TEST_CHECK(assembled(queue, 2, "") == text("zz"));
+    TEST_CHECK(queue.first_of_handle(0) && queue.first_of_handle(1) &&
+               !queue.first_of_handle(2));
+}
+
+void check_out_of_order() {
+    auto queue = small_queue{};
+
+    // Arrival order decides: the second half first leaves a gap
+    TEST_CHECK(push(queue, 1, 3, "def"));
+    TEST_CHECK(push(queue, 1, 0, "abc"));
+    TEST_CHECK(queue.validate(1, 0, 32) == check::invalid_offset);
+
+    // Within the current value any order applies
+    TEST_CHECK(queue.validate(1, 3, 32) == check::ok);
+    TEST_CHECK(assembled(queue, 1, "xyz") == text("abc"));
+
+    // In offset order the same fragments rebuild the whole value
+    queue.clear();
+    TEST_CHECK(push(queue, 1, 0, "abc"));
+    TEST_CHECK(push(queue, 1, 3, "def"));
+    TEST_CHECK(queue.validate(1, 0, 32) == check::ok);
+    TEST_CHECK(assembled(queue, 1, "") == text("abcdef"));
+
+    // Past the capacity of the attribute
+    TEST_CHECK(queue.validate(1, 0, 5) == check::invalid_length);
+}
+
+void check_exhaustion() {
+    auto queue = small_queue{};
+
+    // The arena: 30 of 32 bytes, then a fragment of 3 does not fit
+    TEST_CHECK(push(queue, 1, 0, "0123456789abcdef"));
+    TEST_CHECK(push(queue, 1, 16, "0123456789abcd"));
+    TEST_CHECK(!push(queue, 1, 30, "xyz"));
+    TEST_CHECK(queue.size() == 2 && queue.bytes_used() == 30);
+
+    // What is held is untouched, and what still fits is taken
+    TEST_CHECK(push(queue, 1, 30, "xy"));
+    TEST_CHECK(assembled(queue, 1, "") ==
+               text("0123456789abcdef0123456789abcdxy"));
+
+    // The fragment table: four entries, whatever their size
+    queue.clear();
+
+    for (auto i = 0; i < 4; i++) {
+        TEST_CHECK(push(queue, 1, static_cast<uint16_t>(i), "a"));
+    }
+
+    TEST_CHECK(!push(queue, 1, 4, "a"));
+    TEST_CHECK(!push(queue, 1, 4, ""));
+    TEST_CHECK(queue.size() == 4 && queue.bytes_used() == 4);
+
+    queue.clear();
+    TEST_CHECK(queue.size() == 0 && queue.bytes_used() == 0);
+    TEST_CHECK(push(queue, 1, 0, "a"));
+}
+
+///
+/// \brief Deliver an attribute request and collect what it sent
+///
+std::vector<host::bt_record> deliver(wiced_bt_gatt_event_data_t &event) {
+    host::bt_gatt(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+    host::bt_transmit();
+
+    return host::bt_take();
+}
+
+wiced_bt_gatt_event_data_t request(wiced_bt_gatt_opcode_t opcode) {
+    auto event = wiced_bt_gatt_event_data_t{};
+
+    event.attribute_request.conn_id = 1;
+    event.attribute_request.opcode = opcode;
+    event.attribute_request.len_requested = 246;
+
+    return event;
+}
+
+///
+/// \brief Kind and status of the one record a request sent
+///
+bool answered(const std::vector<host::bt_record> &sent, host::bt_kind kind,
+              uint8_t status = WICED_BT_GATT_SUCCESS) {
+    return sent.size() == 1 && sent[0].kind == kind &&
+           (kind != host::bt_kind::error_rsp || sent[0].status == status);
+}
+
+std::vector<host::bt_record> prepare(uint16_t offset, bytes value) {
+    auto event = request(GATT_REQ_PREPARE_WRITE);
+    auto &write_request = event.attribute_request.data.write_req;
+
+    write_request.handle = HDLC_GAP_DEVICE_NAME_VALUE;
+    write_request.offset = offset;
+    write_request.val_len = static_cast<uint16_t>(value.size());
+    write_request.p_val = value.data();
+
+    return deliver(event);
+}
+
+std::vector<host::bt_record> execute(wiced_bt_gatt_exec_flag_t flag) {
+    auto event = request(GATT_REQ_EXECUTE_WRITE);
+    event.attribute_request.data.exec_write_req.exec_write = flag;
+
+    return deliver(event);
+}
+
+bytes device_name() {
+    auto event = request(GATT_REQ_READ);
+    event.attribute_request.data.read_req.handle = HDLC_GAP_DEVICE_NAME_VALUE;
+
+    const auto sent = deliver(event);
+
+    return (answered(sent, host::bt_kind::read_rsp)) ? sent[0].data
+                                                     : bytes{};
+}
+
+void check_through_callback() {
+    const auto original = device_name();
+    TEST_CHECK(original == text("Battery Server"));
+
+    // Overlapping fragments, the later one winning
+    TEST_CHECK(answered(prepare(8, text("Clxxxx")),
+                        host::bt_kind::prepare_write_rsp));
+    TEST_CHECK(answered(prepare(10, text("ient")),
+                        host::bt_kind::prepare_write_rsp));
+    TEST_CHECK(answered(execute(GATT_PREPARE_WRITE_EXEC),
+                        host::bt_kind::execute_write_rsp));
+    TEST_CHECK(device_name() == text("Battery Client"));
+
+    // The arena holds BLE_GATT_PREPARE_ARENA_SIZE bytes
+    const auto half = bytes(BLE_GATT_PREPARE_ARENA_SIZE / 2, 'x');
+
+    TEST_CHECK(answered(prepare(0, half), host::bt_kind::prepare_write_rsp));
+    TEST_CHECK(answered(prepare(0, half), host::bt_kind::prepare_write_rsp));
+    TEST_CHECK(answered(prepare(0, text("x")), host::bt_kind::error_rsp,
+                        WICED_BT_GATT_PREPARE_Q_FULL));
+
+    // Cancelling empties it, and nothing was applied
+    TEST_CHECK(answered(execute(GATT_PREPARE_WRITE_CANCEL),
+                        host::bt_kind::execute_write_rsp));
+    TEST_CHECK(device_name() == text("Battery Client"));
+
+    // The fragment table holds BLE_GATT_PREPARE_MAX_FRAGMENTS entries
+    for (auto i = std::size_t{}; i < BLE_GATT_PREPARE_MAX_FRAGMENTS; i++) {
+        TEST_CHECK(answered(prepare(static_cast<uint16_t>(i % 8), text("S")),
+                            host::bt_kind::prepare_write_rsp));
+    }
+
+    TEST_CHECK(answered(prepare(0, text("S")), host::bt_kind::error_rsp,
+                        WICED_BT_GATT_PREPARE_Q_FULL));
+
+    // The queue that filled up still executes as it was; the last fragment
+    // ends at 8
+    TEST_CHECK(answered(execute(GATT_PREPARE_WRITE_EXEC),
+                        host::bt_kind::execute_write_rsp));
+    TEST_CHECK(device_name() == text("SSSSSSSS"));
+
+    // And takes fragments again once executed
+    TEST_CHECK(answered(prepare(0, original),
+                        host::bt_kind::prepare_write_rsp));
+    TEST_CHECK(answered(execute(GATT_PREPARE_WRITE_EXEC),
+                        host::bt_kind::execute_write_rsp));
+    TEST_CHECK(device_name() == original);
+}
+
+} // namespace
+
+int main() {
+    check_overlapping();
+    check_out_of_order();
+    check_exhaustion();
+
+    wiced_bt_gatt_register(ble_gatt_event_callback);
+
+    check_through_callback();
+
+    return test_result();
+}
@@ -0,0 +1,253 @@
+///
+/// \file    ble_gatt_response_pool_test.cpp
+/// \brief   Replay of GATT request and transmit sequences against the pool
+///
+/// \details Registers ble_gatt_event_callback() with the host stack and plays
+///          a scrambled sequence of stack buffer requests, reads and Read By
+///          Type requests, with the stack transmitting its buffers in any
+///          order. Whenever nothing is left in flight the pool must have
+///          every block back, a full pool must refuse without counting a
+///          block, and a stack buffer must keep its bytes until transmitted.
+///          A response the stack refuses to send must free its block.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gatt_db.h"
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_gatt.hpp"
+#include "host_platform.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+///
+/// \brief Buffer the stack asked for and has not transmitted yet
+///
+struct stack_buffer {
+    uint8_t *data;   ///< Block handed to the stack
+    void *context;   ///< Context to transmit it with
+    uint16_t length; ///< Bytes the stack filled
+    uint8_t fill;    ///< Byte the stack filled it with
+};
+
+std::vector<stack_buffer> held{};
+
+auto random_state = uint32_t{1};
+
+///
+/// \brief Next value of a fixed pseudo-random sequence, below \p bound
+///
+uint32_t next_random(uint32_t bound) {
+    random_state = random_state * 1664525u + 1013904223u;
+    return (random_state >> 8) % bound;
+}
+
+uint32_t in_use() { return ble_gatt_response_pool_stats().in_use; }
+
+void request_buffer(uint16_t length) {
+    const auto before = ble_gatt_response_pool_stats();
+
+    auto event = wiced_bt_gatt_event_data_t{};
+    event.buffer_request.len_requested = length;
+
+    const auto status = host::bt_gatt(GATT_GET_RESPONSE_BUFFER_EVT, &event);
+    auto *data = event.buffer_request.buffer.p_app_rsp_buffer;
+
+    if (length > BLE_GATT_RESPONSE_BLOCK_SIZE ||
+        before.in_use == BLE_GATT_RESPONSE_BLOCK_COUNT) {
+        TEST_CHECK(status == WICED_BT_GATT_INSUF_RESOURCE);
+        TEST_CHECK(data == nullptr);
+        TEST_CHECK(in_use() == before.in_use);
+        return;
+    }
+
+    TEST_CHECK(status == WICED_BT_GATT_SUCCESS && data != nullptr);
+
+    if (data == nullptr) {
+        return;
+    }
+
+    const auto fill = static_cast<uint8_t>(next_random(256));
+
+    for (auto i = uint16_t{}; i < length; i++) {
+        data[i] = fill;
+    }
+
+    held.push_back({data, event.buffer_request.buffer.p_app_ctxt, length,
+                    fill});
+    TEST_CHECK(in_use() == before.in_use + 1);
+}
+
+void transmit_held(std::size_t index) {
+    const auto buffer = held[index];
+
+    // Nothing else wrote into the block while the stack held it
+    for (auto i = uint16_t{}; i < buffer.length; i++) {
+        TEST_CHECK(buffer.data[i] == buffer.fill);
+    }
+
+    auto event = wiced_bt_gatt_event_data_t{};
+    event.buffer_xmitted.p_app_data = buffer.data;
+    event.buffer_xmitted.p_app_ctxt = buffer.context;
+
+    host::bt_gatt(GATT_APP_BUFFER_TRANSMITTED_EVT, &event);
+    held.erase(held.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+///
+/// \brief Start an attribute request from a peer without a connection entry
+///
+wiced_bt_gatt_event_data_t request(wiced_bt_gatt_opcode_t opcode) {
+    auto event = wiced_bt_gatt_event_data_t{};
+
+    event.attribute_request.conn_id = 1;
+    event.attribute_request.opcode = opcode;
+    event.attribute_request.len_requested = 246;
+
+    return event;
+}
+
+void read(uint16_t handle) {
+    auto event = request(GATT_REQ_READ);
+    event.attribute_request.data.read_req.handle = handle;
+
+    host::bt_gatt(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+}
+
+void read_by_type(uint16_t uuid16) {
+    auto event = request(GATT_REQ_READ_BY_TYPE);
+    auto &read_by_type = event.attribute_request.data.read_by_type;
+
+    read_by_type.s_handle = 0x0001;
+    read_by_type.e_handle = 0xFFFF;
+    read_by_type.uuid.len = LEN_UUID_16;
+    read_by_type.uuid.uu.uuid16 = uuid16;
+
+    host::bt_gatt(GATT_ATTRIBUTE_REQUEST_EVT, &event);
+}
+
+///
+/// \brief Transmit every response and check only held buffers remain
+///
+void transmit_responses() {
+    host::bt_transmit();
+    host::bt_take();
+
+    TEST_CHECK(in_use() == held.size());
+}
+
+void check_replay() {
+    for (auto step = 0; step < 20000; step++) {
+        switch (next_random(6)) {
+        case 0:
+            request_buffer(static_cast<uint16_t>(
+                1 + next_random(BLE_GATT_RESPONSE_BLOCK_SIZE + 16)));
+            break;
+
+        case 1:
+            if (!held.empty()) {
+                transmit_held(next_random(static_cast<uint32_t>(held.size())));
+            }
+
+            break;
+
+        case 2:
+            // In place while a pin record is free, copied otherwise
+            read(HDLC_GAP_DEVICE_NAME_VALUE);
+            break;
+
+        case 3:
+            read_by_type(UUID_CHARACTERISTIC_BATTERY_LEVEL);
+            break;
+
+        case 4:
+            read(HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT);
+            break;
+
+        default:
+            transmit_responses();
+            break;
+        }
+
+        TEST_CHECK(in_use() <= BLE_GATT_RESPONSE_BLOCK_COUNT);
+    }
+
+    transmit_responses();
+
+    while (!held.empty()) {
+        transmit_held(held.size() - 1);
+    }
+
+    const auto stats = ble_gatt_response_pool_stats();
+
+    TEST_CHECK(stats.in_use == 0);
+    TEST_CHECK(stats.high_water_mark == BLE_GATT_RESPONSE_BLOCK_COUNT);
+    TEST_CHECK(stats.allocations > 0 && stats.exhaustions > 0);
+}
+
+void check_refill() {
+    // Every block comes back usable after the replay
+    for (auto i = std::size_t{}; i < BLE_GATT_RESPONSE_BLOCK_COUNT; i++) {
+        request_buffer(BLE_GATT_RESPONSE_BLOCK_SIZE);
+    }
+
+    TEST_CHECK(held.size() == BLE_GATT_RESPONSE_BLOCK_COUNT);
+
+    // A full pool turns a copied response into an error, not a leak
+    read_by_type(UUID_CHARACTERISTIC_BATTERY_LEVEL);
+    host::bt_transmit();
+
+    const auto sent = host::bt_take();
+    TEST_CHECK(sent.size() == 1 && sent[0].kind == host::bt_kind::error_rsp &&
+               sent[0].status == WICED_BT_GATT_INSUF_RESOURCE);
+
+    while (!held.empty()) {
+        transmit_held(0);
+    }
+
+    TEST_CHECK(in_use() == 0);
+}
+
+void check_refused_send() {
+    // A response the stack refuses gives its block back at once
+    host::bt_fail_sends(1);
+    read_by_type(UUID_CHARACTERISTIC_BATTERY_LEVEL);
+
+    TEST_CHECK(in_use() == 0);
+
+    host::bt_transmit();
+    const auto sent = host::bt_take();
+    TEST_CHECK(sent.size() == 1 && sent[0].kind == host::bt_kind::error_rsp &&
+               sent[0].status == WICED_BT_GATT_BUSY);
+
+    // And the next one goes out as usual
+    read_by_type(UUID_CHARACTERISTIC_BATTERY_LEVEL);
+    host::bt_transmit();
+
+    TEST_CHECK(host::bt_take().size() == 1 && in_use() == 0);
+}
+
+} // namespace
+
+int main() {
+    wiced_bt_gatt_register(ble_gatt_event_callback);
+
+    check_replay();
+    check_refill();
+    check_refused_send();
+
+    return test_result();
+}
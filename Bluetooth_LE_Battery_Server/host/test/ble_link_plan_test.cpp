@@ -0,0 +1,123 @@
+///
+/// \file    ble_link_plan_test.cpp
+/// \brief   Compile-time checks of the link optimizer request plan
+///
+/// \details Builds link states for each traffic class and checks which of
+///          the PHY, data length and connection parameter requests
+///          ble_link_plan() sends: PHY and data length only for bulk links
+///          that have not been asked and are not there yet, and parameters
+///          whenever the class differs from the one last requested.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_link_optimizer.hpp"
+
+#include <cstdint>
+
+namespace {
+
+///
+/// \brief Link whose policy has settled on the class of some inputs
+///
+constexpr ble_link link_for(ble_traffic_inputs inputs) {
+    auto link = ble_link{};
+
+    link.connection_id = 1;
+    link.policy.update(inputs, 0);
+
+    return link;
+}
+
+constexpr auto bulk = link_for({true, false});
+constexpr auto notify = link_for({false, true});
+constexpr auto idle = link_for({false, false});
+
+///
+/// \brief Whether a plan is exactly the given requests
+///
+constexpr bool plans(const ble_link &link, bool phy, bool data_length,
+                     bool parameters) {
+    const auto requests = ble_link_plan(link);
+
+    return requests.phy == phy && requests.data_length == data_length &&
+           requests.parameters == parameters;
+}
+
+// A link not evaluated yet asks for nothing
+static_assert(plans(ble_link{}, false, false, false));
+
+// A new bulk link asks for everything
+static_assert(plans(bulk, true, true, true));
+
+///
+/// \brief Bulk link with some of its requests already sent or met
+///
+constexpr ble_link bulk_with(bool phy_requested, bool data_length_requested,
+                             uint8_t tx_phy, uint8_t rx_phy,
+                             uint16_t tx_octets,
+                             ble_traffic_class requested) {
+    auto link = bulk;
+
+    link.phy_requested = phy_requested;
+    link.data_length_requested = data_length_requested;
+    link.tx_phy = tx_phy;
+    link.rx_phy = rx_phy;
+    link.tx_octets = tx_octets;
+    link.requested = requested;
+
+    return link;
+}
+
+constexpr auto PHY_1M = uint8_t{1};
+
+// PHY and data length are asked once, accepted or not
+static_assert(plans(bulk_with(true, false, PHY_1M, PHY_1M, 27,
+                              ble_traffic_class::none),
+                    false, true, true));
+static_assert(plans(bulk_with(false, true, PHY_1M, PHY_1M, 27,
+                              ble_traffic_class::none),
+                    true, false, true));
+
+// Nor asked when already negotiated, in both directions for the PHY
+static_assert(plans(bulk_with(false, false, BLE_LINK_PHY_2M,
+                              BLE_LINK_PHY_2M, BLE_LINK_MAX_TX_OCTETS,
+                              ble_traffic_class::none),
+                    false, false, true));
+static_assert(plans(bulk_with(false, false, BLE_LINK_PHY_2M, PHY_1M,
+                              BLE_LINK_MAX_TX_OCTETS,
+                              ble_traffic_class::none),
+                    true, false, true));
+
+// Parameters of the class already requested are not asked again
+static_assert(plans(bulk_with(true, true, PHY_1M, PHY_1M, 27,
+                              ble_traffic_class::bulk),
+                    false, false, false));
+
+///
+/// \brief Link of a class with some class already requested
+///
+constexpr ble_link requested_as(ble_link link,
+                                ble_traffic_class requested) {
+    link.requested = requested;
+
+    return link;
+}
+
+// Lighter classes only ever change parameters
+static_assert(plans(notify, false, false, true));
+static_assert(plans(requested_as(notify, ble_traffic_class::bulk), false,
+                    false, true));
+static_assert(plans(requested_as(notify, ble_traffic_class::notify), false,
+                    false, false));
+static_assert(plans(idle, false, false, true));
+static_assert(plans(requested_as(idle, ble_traffic_class::notify), false,
+                    false, true));
+static_assert(plans(requested_as(idle, ble_traffic_class::idle), false,
+                    false, false));
+
+} // namespace
+
+int main() { return 0; }
@@ -0,0 +1,189 @@
+///
+/// \file    ble_traffic_policy_test.cpp
+/// \brief   Compile-time checks of the traffic class hysteresis
+///
+/// \details Drives ble_traffic_policy::update() through timed input
+///          sequences and checks that busier classes apply at once, lighter
+///          ones only after BLE_TRAFFIC_DWELL_MS of being wanted, that a
+///          change of mind restarts or cancels the wait, that pending_ms()
+///          reports the time left, and that the millisecond clock may wrap.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_traffic_policy.hpp"
+
+#include <cstdint>
+
+namespace {
+
+constexpr auto BULK = ble_traffic_inputs{true, false};
+constexpr auto NOTIFY = ble_traffic_inputs{false, true};
+constexpr auto IDLE = ble_traffic_inputs{false, false};
+
+///
+/// \brief Policy after its first evaluation
+///
+constexpr ble_traffic_policy policy_in(ble_traffic_inputs inputs,
+                                       uint32_t now_ms = 0) {
+    auto policy = ble_traffic_policy{};
+    policy.update(inputs, now_ms);
+
+    return policy;
+}
+
+// Not evaluated yet
+static_assert(ble_traffic_policy{}.current() == ble_traffic_class::none);
+static_assert(ble_traffic_policy{}.pending_ms(0) == 0);
+
+// The first evaluation applies at once, whatever the class
+static_assert(policy_in(BULK).current() == ble_traffic_class::bulk);
+static_assert(policy_in(NOTIFY).current() == ble_traffic_class::notify);
+static_assert(policy_in(IDLE).current() == ble_traffic_class::idle);
+static_assert(policy_in(IDLE).transitions() == 1);
+
+// Bulk wins over a subscription
+static_assert(policy_in({true, true}).current() == ble_traffic_class::bulk);
+
+///
+/// \brief Busier classes apply at once
+///
+constexpr bool upgrades_at_once() {
+    auto policy = policy_in(IDLE);
+
+    if (!policy.update(NOTIFY, 1) ||
+        policy.current() != ble_traffic_class::notify) {
+        return false;
+    }
+
+    if (!policy.update(BULK, 2) ||
+        policy.current() != ble_traffic_class::bulk) {
+        return false;
+    }
+
+    // The same class again is no change
+    return !policy.update(BULK, 3) && policy.transitions() == 3 &&
+           policy.pending_ms(3) == 0;
+}
+
+static_assert(upgrades_at_once());
+
+///
+/// \brief A lighter class applies after the dwell time
+///
+constexpr bool downgrades_after_dwell() {
+    auto policy = policy_in(BULK, 1000);
+
+    if (policy.update(NOTIFY, 1000) ||
+        policy.pending_ms(1000) != BLE_TRAFFIC_DWELL_MS ||
+        policy.pending_ms(3000) != BLE_TRAFFIC_DWELL_MS - 2000) {
+        return false;
+    }
+
+    if (policy.update(NOTIFY, 1000 + BLE_TRAFFIC_DWELL_MS - 1) ||
+        policy.current() != ble_traffic_class::bulk) {
+        return false;
+    }
+
+    return policy.update(NOTIFY, 1000 + BLE_TRAFFIC_DWELL_MS) &&
+           policy.current() == ble_traffic_class::notify &&
+           policy.pending_ms(1000 + BLE_TRAFFIC_DWELL_MS) == 0 &&
+           policy.transitions() == 2;
+}
+
+static_assert(downgrades_after_dwell());
+
+///
+/// \brief A different lighter class restarts the wait
+///
+constexpr bool restarts_on_new_class() {
+    auto policy = policy_in(BULK);
+
+    policy.update(NOTIFY, 0);
+    policy.update(IDLE, 1000);
+
+    if (policy.update(IDLE, BLE_TRAFFIC_DWELL_MS) ||
+        policy.pending_ms(BLE_TRAFFIC_DWELL_MS) != 1000) {
+        return false;
+    }
+
+    return policy.update(IDLE, 1000 + BLE_TRAFFIC_DWELL_MS) &&
+           policy.current() == ble_traffic_class::idle;
+}
+
+static_assert(restarts_on_new_class());
+
+///
+/// \brief Wanting the current class again cancels the wait
+///
+constexpr bool cancels_on_return() {
+    auto policy = policy_in(BULK);
+
+    policy.update(IDLE, 0);
+
+    if (policy.update(BULK, 1000) || policy.pending_ms(1000) != 0) {
+        return false;
+    }
+
+    // The next lighter request waits the full dwell time again
+    policy.update(IDLE, 2000);
+
+    return !policy.update(IDLE, BLE_TRAFFIC_DWELL_MS) &&
+           policy.current() == ble_traffic_class::bulk &&
+           policy.pending_ms(BLE_TRAFFIC_DWELL_MS) == 2000;
+}
+
+static_assert(cancels_on_return());
+
+///
+/// \brief An overdue move asks to be evaluated at once
+///
+constexpr bool overdue_is_one() {
+    auto policy = policy_in(BULK);
+    policy.update(IDLE, 0);
+
+    return policy.pending_ms(BLE_TRAFFIC_DWELL_MS) == 1 &&
+           policy.pending_ms(10 * BLE_TRAFFIC_DWELL_MS) == 1;
+}
+
+static_assert(overdue_is_one());
+
+///
+/// \brief The dwell time spans the millisecond clock wrapping
+///
+constexpr bool survives_wrap() {
+    constexpr auto start = uint32_t{UINT32_MAX - 1000};
+
+    auto policy = policy_in(BULK, start);
+    policy.update(NOTIFY, start);
+
+    if (policy.pending_ms(start + 2000) != BLE_TRAFFIC_DWELL_MS - 2000 ||
+        policy.update(NOTIFY, start + 2000)) {
+        return false;
+    }
+
+    return policy.update(NOTIFY, start + BLE_TRAFFIC_DWELL_MS) &&
+           policy.current() == ble_traffic_class::notify;
+}
+
+static_assert(survives_wrap());
+
+// Each class maps to its own parameters
+static_assert(&ble_traffic_parameters(ble_traffic_class::bulk) ==
+              &BLE_LINK_BULK_PARAMETERS);
+static_assert(&ble_traffic_parameters(ble_traffic_class::notify) ==
+              &BLE_LINK_NOTIFY_PARAMETERS);
+static_assert(&ble_traffic_parameters(ble_traffic_class::idle) ==
+              &BLE_LINK_IDLE_PARAMETERS);
+
+// The validation refuses what centrals reject
+static_assert(!ble_link_parameters_valid({5, 12, 0, 300}));
+static_assert(!ble_link_parameters_valid({12, 6, 0, 300}));
+static_assert(!ble_link_parameters_valid({800, 1600, 1, 600}));
+static_assert(!ble_link_parameters_valid({80, 160, 4, 70}));
+
+} // namespace
+
+int main() { return 0; }
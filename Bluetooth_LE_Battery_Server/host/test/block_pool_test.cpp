@@ -0,0 +1,192 @@
+///
+/// \file    block_pool_test.cpp
+/// \brief   Checks of the fixed-block pool
+///
+/// \details Fills and drains pools of a few blocks and of the full 32, and
+///          checks that blocks are distinct, aligned and owned, that sizes
+///          above the block and a full pool fail without touching the
+///          occupancy, and that the counters follow.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "block_pool.hpp"
+#include "test_check.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+using small_pool = block_pool<24, 3>;
+using full_pool = block_pool<8, 32>;
+
+static_assert(small_pool::block_size == 24 && small_pool::block_count == 3);
+
+small_pool small{};
+full_pool full{};
+
+///
+/// \brief Blocks are distinct, aligned, owned and do not overlap
+///
+void check_allocation() {
+    auto blocks = std::array<uint8_t *, small_pool::block_count>{};
+
+    for (auto i = std::size_t{}; i < blocks.size(); i++) {
+        blocks[i] = small.allocate(small_pool::block_size - i);
+
+        TEST_CHECK(blocks[i] != nullptr);
+        TEST_CHECK(small.owns(blocks[i]));
+
+        // A whole block is usable without reaching into the next
+        std::memset(blocks[i], static_cast<int>(i + 1),
+                    small_pool::block_size);
+    }
+
+    // The storage is aligned for any type; the lowest free block is taken
+    // first
+    TEST_CHECK(reinterpret_cast<uintptr_t>(blocks[0]) %
+                   alignof(std::max_align_t) ==
+               0);
+    TEST_CHECK(blocks[1] == blocks[0] + small_pool::block_size);
+    TEST_CHECK(blocks[2] == blocks[1] + small_pool::block_size);
+
+    for (auto i = std::size_t{}; i < blocks.size(); i++) {
+        for (auto j = std::size_t{}; j < small_pool::block_size; j++) {
+            TEST_CHECK(blocks[i][j] == i + 1);
+        }
+    }
+
+    auto counters = small.stats();
+    TEST_CHECK(counters.in_use == 3);
+    TEST_CHECK(counters.high_water_mark == 3);
+    TEST_CHECK(counters.allocations == 3);
+    TEST_CHECK(counters.exhaustions == 0);
+
+    // Full: fails and is counted, occupancy unchanged
+    TEST_CHECK(small.allocate(1) == nullptr);
+
+    counters = small.stats();
+    TEST_CHECK(counters.in_use == 3 && counters.exhaustions == 1);
+
+    // A freed block is the one handed out next
+    small.deallocate(blocks[1]);
+    TEST_CHECK(small.stats().in_use == 2);
+    TEST_CHECK(small.allocate(small_pool::block_size) == blocks[1]);
+
+    for (auto *block : blocks) {
+        small.deallocate(block);
+    }
+
+    counters = small.stats();
+    TEST_CHECK(counters.in_use == 0);
+    TEST_CHECK(counters.high_water_mark == 3);
+    TEST_CHECK(counters.allocations == 4);
+}
+
+///
+/// \brief Oversized requests fail without taking a block
+///
+void check_oversized() {
+    small.reset_stats();
+
+    TEST_CHECK(small.allocate(small_pool::block_size + 1) == nullptr);
+
+    const auto counters = small.stats();
+    TEST_CHECK(counters.in_use == 0);
+    TEST_CHECK(counters.allocations == 0);
+    TEST_CHECK(counters.exhaustions == 1);
+
+    // Zero bytes still takes a block
+    auto *block = small.allocate(0);
+    TEST_CHECK(block != nullptr && small.stats().in_use == 1);
+    small.deallocate(block);
+}
+
+///
+/// \brief Only block starts inside the pool are owned and released
+///
+void check_ownership() {
+    auto *block = small.allocate(1);
+    auto foreign = std::array<uint8_t, small_pool::block_size>{};
+
+    TEST_CHECK(!small.owns(nullptr));
+    TEST_CHECK(!small.owns(foreign.data()));
+    TEST_CHECK(!small.owns(block + 1));
+    TEST_CHECK(!small.owns(block - 1));
+    TEST_CHECK(
+        !small.owns(block + small_pool::block_size * small_pool::block_count));
+
+    // Ignored: none of them may free the allocated block
+    small.deallocate(nullptr);
+    small.deallocate(foreign.data());
+    small.deallocate(block + 1);
+    TEST_CHECK(small.stats().in_use == 1);
+
+    small.deallocate(block);
+    TEST_CHECK(small.stats().in_use == 0);
+
+    // Releasing twice leaves the pool as it was
+    small.deallocate(block);
+    TEST_CHECK(small.stats().in_use == 0);
+}
+
+///
+/// \brief Counters reset without releasing anything
+///
+void check_reset() {
+    auto *block = small.allocate(1);
+
+    small.reset_stats();
+
+    const auto counters = small.stats();
+    TEST_CHECK(counters.in_use == 1);
+    TEST_CHECK(counters.high_water_mark == 0);
+    TEST_CHECK(counters.allocations == 0);
+    TEST_CHECK(counters.exhaustions == 0);
+
+    small.deallocate(block);
+}
+
+///
+/// \brief A 32-block pool uses every bit of the occupancy bitmap
+///
+void check_full_bitmap() {
+    auto blocks = std::array<uint8_t *, full_pool::block_count>{};
+
+    for (auto &block : blocks) {
+        block = full.allocate(full_pool::block_size);
+        TEST_CHECK(block != nullptr);
+    }
+
+    TEST_CHECK(blocks[31] == blocks[0] + 31 * full_pool::block_size);
+    TEST_CHECK(full.allocate(1) == nullptr);
+    TEST_CHECK(full.stats().in_use == 32);
+
+    // The top bit frees and reallocates like any other
+    full.deallocate(blocks[31]);
+    TEST_CHECK(full.allocate(1) == blocks[31]);
+
+    for (auto *block : blocks) {
+        full.deallocate(block);
+    }
+
+    TEST_CHECK(full.stats().in_use == 0);
+    TEST_CHECK(full.stats().high_water_mark == 32);
+}
+
+} // namespace
+
+int main() {
+    check_allocation();
+    check_oversized();
+    check_ownership();
+    check_reset();
+    check_full_bitmap();
+
+    return test_result();
+}
@@ -0,0 +1,113 @@
+///
+/// \file    connection_buffers_test.cpp
+/// \brief   Checks of the per-connection read-multiple buffers
+///
+/// \details Binds buffers to connections the way read-multiple requests
+///          do, and checks that a connection keeps its buffer, cannot claim
+///          it again while a response is in flight, and gives it up when it
+///          closes.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "connection_buffers.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using scratch_table = connection_buffers<16, 2>;
+
+static_assert(scratch_table::buffer_size == 16);
+static_assert(scratch_table::buffer_count == 2);
+
+///
+/// \brief A connection keeps the buffer it first bound
+///
+void check_binding() {
+    auto table = scratch_table{};
+
+    auto *first = table.acquire(7);
+    TEST_CHECK(first != nullptr);
+
+    // One request per bearer: the buffer is busy until transmitted
+    TEST_CHECK(table.acquire(7) == nullptr);
+
+    table.release(first);
+    TEST_CHECK(table.acquire(7) == first);
+    table.release(first);
+
+    // Another connection binds the other buffer
+    auto *second = table.acquire(9);
+    TEST_CHECK(second != nullptr && second != first);
+
+    // Buffers do not overlap
+    TEST_CHECK(second >= first + scratch_table::buffer_size ||
+               first >= second + scratch_table::buffer_size);
+
+    // Every buffer is bound: a third connection gets none, in flight or not
+    table.release(second);
+    TEST_CHECK(table.acquire(11) == nullptr);
+
+    // Connection ID 0 marks an unbound buffer and is never handed one
+    TEST_CHECK(table.acquire(0) == nullptr);
+}
+
+///
+/// \brief A closed connection's buffer goes to the next connection
+///
+void check_unbind() {
+    auto table = scratch_table{};
+
+    auto *first = table.acquire(1);
+    auto *second = table.acquire(2);
+    TEST_CHECK(first != nullptr && second != nullptr);
+
+    // Closed with the response still in flight
+    table.unbind(1);
+
+    auto *third = table.acquire(3);
+    TEST_CHECK(third == first);
+
+    // The other connection's claim is untouched
+    TEST_CHECK(table.acquire(2) == nullptr);
+
+    // A reconnecting ID has no buffer left to find
+    TEST_CHECK(table.acquire(1) == nullptr);
+
+    // Unbinding an unknown connection changes nothing
+    table.unbind(42);
+    TEST_CHECK(table.acquire(3) == nullptr);
+}
+
+///
+/// \brief Only buffers of the table are released
+///
+void check_release() {
+    auto table = scratch_table{};
+    uint8_t foreign[scratch_table::buffer_size]{};
+
+    auto *buffer = table.acquire(5);
+
+    table.release(foreign);
+    table.release(nullptr);
+    table.release(buffer + 1);
+    TEST_CHECK(table.acquire(5) == nullptr);
+
+    table.release(buffer);
+    TEST_CHECK(table.acquire(5) == buffer);
+}
+
+} // namespace
+
+int main() {
+    check_binding();
+    check_unbind();
+    check_release();
+
+    return test_result();
+}
@@ -0,0 +1,122 @@
+///
+/// \file    crc32_test.cpp
+/// \brief   Checks of the streaming CRC-32 against a one-shot pass
+///
+/// \details Feeds buffers of several sizes to util::crc32 in random
+///          chunkings, empty chunks included, and checks each digest against
+///          crc32::of() over the whole buffer, against a bit-by-bit reference
+///          and across a reset().
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "crc32.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+auto random_state = uint32_t{1};
+
+///
+/// \brief Next value of a fixed pseudo-random sequence, below \p bound
+///
+uint32_t next_random(uint32_t bound) {
+    random_state = random_state * 1664525u + 1013904223u;
+    return (random_state >> 8) % bound;
+}
+
+std::vector<uint8_t> random_bytes(std::size_t size) {
+    auto data = std::vector<uint8_t>(size);
+
+    for (auto &byte : data) {
+        byte = static_cast<uint8_t>(next_random(256));
+    }
+
+    return data;
+}
+
+///
+/// \brief CRC-32 computed a bit at a time, without the lookup table
+///
+uint32_t reference_crc32(const std::vector<uint8_t> &data) {
+    auto state = uint32_t{0xFFFFFFFF};
+
+    for (const auto byte : data) {
+        state ^= byte;
+
+        for (auto bit = 0; bit < 8; bit++) {
+            state = (state & 1) ? (state >> 1) ^ 0xEDB88320 : state >> 1;
+        }
+    }
+
+    return state ^ 0xFFFFFFFF;
+}
+
+///
+/// \brief Digest of \p data fed in chunks of random length
+///
+uint32_t chunked_crc32(const std::vector<uint8_t> &data,
+                       uint32_t max_chunk) {
+    auto engine = util::crc32{};
+    auto offset = std::size_t{};
+
+    while (offset < data.size()) {
+        const auto left = data.size() - offset;
+        auto length = static_cast<std::size_t>(next_random(max_chunk + 1));
+
+        length = (length < left) ? length : left;
+
+        engine.update(data.data() + offset, length);
+        offset += length;
+    }
+
+    return engine.value();
+}
+
+void check_chunkings() {
+    for (const auto size : {std::size_t{0}, std::size_t{1}, std::size_t{3},
+                            std::size_t{244}, std::size_t{4096},
+                            std::size_t{4096 * 3 + 777}}) {
+        const auto data = random_bytes(size);
+        const auto one_shot = util::crc32::of(data.data(), data.size());
+
+        TEST_CHECK(one_shot == reference_crc32(data));
+
+        // Byte by byte, ATT-sized and staging-buffer-sized chunks
+        for (const auto max_chunk : {1u, 7u, 244u, 509u, 4096u}) {
+            for (auto round = 0; round < 20; round++) {
+                TEST_CHECK(chunked_crc32(data, max_chunk) == one_shot);
+            }
+        }
+    }
+}
+
+void check_reset() {
+    const auto data = random_bytes(1000);
+    auto engine = util::crc32{};
+
+    engine.update(data.data(), 600);
+    engine.reset();
+    engine.update(data.data(), data.size());
+
+    TEST_CHECK(engine.value() == util::crc32::of(data.data(), data.size()));
+
+    // Nothing fed is the digest of nothing
+    engine.reset();
+    TEST_CHECK(engine.value() == 0);
+}
+
+} // namespace
+
+int main() {
+    check_chunkings();
+    check_reset();
+
+    return test_result();
+}
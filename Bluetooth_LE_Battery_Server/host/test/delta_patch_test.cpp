@@ -0,0 +1,263 @@
+///
+/// \file    delta_patch_test.cpp
+/// \brief   Checks of the sequential delta patcher on small vectors
+///
+/// \details Applies hand-assembled patches to a short base image, whole,
+///          one byte at a time and through a sink that refuses every other
+///          delivery, including block restarts, and checks that
+///          out-of-range operations, a patch that never seeks, unknown
+///          opcodes and a rejecting sink are reported.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "delta_patch.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace {
+
+using bytes = std::vector<uint8_t>;
+using opcode = util::delta_patcher::opcode;
+using status = util::delta_patcher::status;
+
+const bytes base = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+util::delta_patcher patcher{};
+
+///
+/// \brief Encode a SEEK
+///
+bytes seek(uint32_t position) {
+    return {static_cast<uint8_t>(opcode::seek),
+            static_cast<uint8_t>(position),
+            static_cast<uint8_t>(position >> 8),
+            static_cast<uint8_t>(position >> 16),
+            static_cast<uint8_t>(position >> 24)};
+}
+
+///
+/// \brief Encode a COPY, MODIFY or INSERT header
+///
+bytes operation(opcode code, uint16_t count) {
+    return {static_cast<uint8_t>(code), static_cast<uint8_t>(count),
+            static_cast<uint8_t>(count >> 8)};
+}
+
+///
+/// \brief Join encoded operations and payloads into one patch
+///
+bytes patch(std::initializer_list<bytes> parts) {
+    auto joined = bytes{};
+
+    for (const auto &part : parts) {
+        joined.insert(joined.end(), part.begin(), part.end());
+    }
+
+    return joined;
+}
+
+///
+/// \brief Apply a whole patch, optionally one byte at a time
+///
+status apply(const bytes &stream, uint32_t block_size, uint32_t total_size,
+             bytes &output, bool bytewise = false) {
+    auto sink = [&output](const uint8_t *data, std::size_t length) {
+        output.insert(output.end(), data, data + length);
+        return true;
+    };
+
+    output.clear();
+    patcher.reset(base.data(), static_cast<uint32_t>(base.size()), block_size,
+                  total_size);
+
+    if (!bytewise) {
+        return patcher.decode(stream.data(), stream.size(), sink);
+    }
+
+    for (const auto byte : stream) {
+        if (const auto result = patcher.decode(&byte, 1, sink);
+            result != status::ok) {
+            return result;
+        }
+    }
+
+    return status::ok;
+}
+
+///
+/// \brief Decode a whole stream with a sink that refuses every other
+///        delivery, passing the input again from where it stopped
+///
+bytes apply_refused(const bytes &stream, uint32_t block_size,
+                    uint32_t total_size) {
+    auto output = bytes{};
+    auto refuse = false;
+
+    auto sink = [&output, &refuse](const uint8_t *data, std::size_t length) {
+        refuse = !refuse;
+
+        if (!refuse) {
+            output.insert(output.end(), data, data + length);
+        }
+
+        return !refuse;
+    };
+
+    patcher.reset(base.data(), static_cast<uint32_t>(base.size()), block_size,
+                  total_size);
+
+    auto offset = std::size_t{};
+
+    for (auto attempt = 0; attempt < 10000; attempt++) {
+        const auto result = patcher.decode(stream.data() + offset,
+                                           stream.size() - offset, sink);
+        offset += patcher.consumed();
+
+        if (result != status::sink) {
+            TEST_CHECK(result == status::ok);
+            break;
+        }
+    }
+
+    return output;
+}
+
+///
+/// \brief Check a patch rebuilds the expected bytes, whole, bytewise and
+///        through a refusing sink
+///
+void check_applies(const bytes &stream, uint32_t block_size,
+                   const bytes &expected) {
+    const auto total = static_cast<uint32_t>(expected.size());
+    auto output = bytes{};
+
+    TEST_CHECK(apply(stream, block_size, total, output) == status::ok);
+    TEST_CHECK(output == expected);
+    TEST_CHECK(patcher.produced() == total);
+
+    TEST_CHECK(apply(stream, block_size, total, output, true) == status::ok);
+    TEST_CHECK(output == expected);
+    TEST_CHECK(apply_refused(stream, block_size, total) == expected);
+}
+
+///
+/// \brief Check a patch is refused as corrupt
+///
+void check_refused(const bytes &stream, uint32_t block_size,
+                   uint32_t total_size) {
+    auto output = bytes{};
+
+    TEST_CHECK(apply(stream, block_size, total_size, output) ==
+               status::corrupt);
+}
+
+constexpr auto NO_BLOCKS = uint32_t{1u << 20};
+
+void check_operations() {
+    // "012", "34" replaced by "ab", "X" added, "56", then "9" after a SEEK
+    check_applies(patch({seek(0), operation(opcode::copy, 3),
+                         operation(opcode::modify, 2), {'a', 'b'},
+                         operation(opcode::insert, 1), {'X'},
+                         operation(opcode::copy, 2), seek(9),
+                         operation(opcode::copy, 1)}),
+                  NO_BLOCKS, {'0', '1', '2', 'a', 'b', 'X', '5', '6', '9'});
+
+    // A SEEK back reuses base bytes already copied
+    check_applies(patch({seek(0), operation(opcode::copy, 2), seek(0),
+                         operation(opcode::copy, 2)}),
+                  NO_BLOCKS, {'0', '1', '0', '1'});
+
+    // The whole base, up to its last byte
+    check_applies(patch({seek(0), operation(opcode::copy, 10)}), NO_BLOCKS,
+                  base);
+}
+
+const auto first_block = patch({seek(0), operation(opcode::copy, 4)});
+const auto second_block =
+    patch({seek(6), operation(opcode::copy, 2), operation(opcode::insert, 2),
+           {'z', 'z'}});
+const auto last_block = patch({seek(0), operation(opcode::copy, 1)});
+
+void check_blocks() {
+    // Blocks of 4, the last one short: each starts with its own SEEK
+    check_applies(patch({first_block, second_block, last_block}), 4,
+                  {'0', '1', '2', '3', '6', '7', 'z', 'z', '0'});
+
+    // Resuming at the second block applies the rest alone
+    auto output = bytes{};
+    auto sink = [&output](const uint8_t *data, std::size_t length) {
+        output.insert(output.end(), data, data + length);
+        return true;
+    };
+
+    const auto rest = patch({second_block, last_block});
+    patcher.reset(base.data(), static_cast<uint32_t>(base.size()), 4, 9, 4);
+
+    TEST_CHECK(patcher.decode(rest.data(), rest.size(), sink) == status::ok);
+    TEST_CHECK((output == bytes{'6', '7', 'z', 'z', '0'}));
+    TEST_CHECK(patcher.produced() == 9);
+}
+
+void check_corrupt() {
+    // Walking the base before any SEEK
+    check_refused(operation(opcode::copy, 1), NO_BLOCKS, 1);
+    check_refused(patch({operation(opcode::modify, 1), {'a'}}), NO_BLOCKS, 1);
+
+    // Seeking past the end of the base
+    check_refused(seek(11), NO_BLOCKS, 1);
+
+    // Copying past the end of the base
+    check_refused(patch({seek(8), operation(opcode::copy, 3)}), NO_BLOCKS, 3);
+
+    // Empty operations, and operations crossing a block or the image end
+    check_refused(patch({seek(0), operation(opcode::copy, 0)}), NO_BLOCKS, 1);
+    check_refused(patch({seek(0), operation(opcode::copy, 5)}), 4, 8);
+    check_refused(patch({operation(opcode::insert, 3), {'a', 'b', 'c'}}),
+                  NO_BLOCKS, 2);
+
+    // An unknown opcode
+    check_refused({0x07}, NO_BLOCKS, 1);
+}
+
+void check_end_of_image() {
+    // Bytes after the last decoded byte are ignored
+    auto output = bytes{};
+
+    TEST_CHECK(apply(patch({seek(0), operation(opcode::copy, 2), {0x07}}),
+                     NO_BLOCKS, 2, output) == status::ok);
+    TEST_CHECK((output == bytes{'0', '1'}));
+}
+
+void check_sink() {
+    const auto stream = patch({seek(0), operation(opcode::copy, 2)});
+    auto calls = 0;
+
+    patcher.reset(base.data(), static_cast<uint32_t>(base.size()), NO_BLOCKS,
+                  2);
+
+    TEST_CHECK(patcher.decode(stream.data(), stream.size(),
+                              [&calls](const uint8_t *, std::size_t) {
+                                  ++calls;
+                                  return false;
+                              }) == status::sink);
+    TEST_CHECK(calls == 1);
+}
+
+} // namespace
+
+int main() {
+    check_operations();
+    check_blocks();
+    check_corrupt();
+    check_end_of_image();
+    check_sink();
+
+    return test_result();
+}
@@ -0,0 +1,74 @@
+///
+/// \file    gatt_db_configurator_test.cpp
+/// \brief   Checks of the GATT attribute description against the
+///          configurator lookup table
+///
+/// \details Runs ble_gatt_db_matches_configurator() against the lookup table
+///          the Bluetooth Configurator generates next to the value storage,
+///          then changes one field of one row at a time and checks the
+///          comparison notices, so a capacity or initial length that drifts
+///          from design.cybt fails the build's tests rather than only a
+///          debug assertion on target.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gatt_db.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_gatt.hpp"
+#include "ble_gatt_db.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+void check_matches() {
+    TEST_CHECK(app_gatt_db_ext_attr_tbl_size == gatt_db::attribute_count);
+    TEST_CHECK(ble_gatt_db_matches_configurator());
+}
+
+void check_each_field() {
+    for (auto i = std::size_t{}; i < app_gatt_db_ext_attr_tbl_size; i++) {
+        auto &row = app_gatt_db_ext_attr_tbl[i];
+        const auto saved = row;
+
+        row.max_len = static_cast<uint16_t>(row.max_len + 1);
+        TEST_CHECK(!ble_gatt_db_matches_configurator());
+        row = saved;
+
+        row.cur_len = static_cast<uint16_t>(row.cur_len + 1);
+        TEST_CHECK(!ble_gatt_db_matches_configurator());
+        row = saved;
+
+        row.p_data = app_gatt_db_ext_attr_tbl[(i + 1) %
+                                              app_gatt_db_ext_attr_tbl_size]
+                         .p_data;
+        TEST_CHECK(!ble_gatt_db_matches_configurator());
+        row = saved;
+
+        // A handle without application storage
+        row.handle = HDLS_GAP;
+        TEST_CHECK(!ble_gatt_db_matches_configurator());
+        row = saved;
+    }
+
+    TEST_CHECK(ble_gatt_db_matches_configurator());
+}
+
+} // namespace
+
+int main() {
+    check_matches();
+    check_each_field();
+
+    return test_result();
+}
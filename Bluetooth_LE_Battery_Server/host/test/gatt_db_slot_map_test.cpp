@@ -0,0 +1,74 @@
+///
+/// \file    gatt_db_slot_map_test.cpp
+/// \brief   Compile-time checks of the GATT handle to slot index
+///
+/// \details Resolves every handle up to and past the largest one with
+///          application storage, and checks that each lands on the slot of
+///          its attribute, or on no_slot when the handle is a declaration
+///          the stack serves itself.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_gatt_db.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+///
+/// \brief Find the slot of a handle by walking the attributes
+///
+constexpr std::size_t linear_slot(uint16_t handle) {
+    for (auto i = std::size_t{}; i < gatt_db::attribute_count; i++) {
+        if (gatt_db::attributes[i].handle == handle) {
+            return i;
+        }
+    }
+
+    return gatt_db::no_slot;
+}
+
+///
+/// \brief Check the index against the walk for every handle
+///
+/// \param last Largest handle to resolve
+///
+constexpr bool index_matches_walk(uint16_t last) {
+    for (auto handle = uint16_t{}; handle <= last; handle++) {
+        if (gatt_db::slot_of(handle) != linear_slot(handle)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(index_matches_walk(gatt_db::max_handle + 16));
+
+// Every attribute resolves to its own slot
+static_assert(gatt_db::slot_of(HDLC_GAP_DEVICE_NAME_VALUE) == 0);
+static_assert(gatt_db::slot_of(HDLC_BAS_BATTERY_LEVEL_VALUE) == 2);
+static_assert(gatt_db::slot_of(
+                  HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE) ==
+              gatt_db::attribute_count - 1);
+
+// Handle 0 and service and characteristic declarations have no storage
+static_assert(gatt_db::slot_of(0) == gatt_db::no_slot);
+static_assert(gatt_db::slot_of(HDLS_GAP) == gatt_db::no_slot);
+static_assert(gatt_db::slot_of(HDLC_GAP_DEVICE_NAME) == gatt_db::no_slot);
+static_assert(gatt_db::slot_of(HDLS_BAS) == gatt_db::no_slot);
+
+// Past the map, and the largest handle the stack can pass
+static_assert(gatt_db::slot_of(gatt_db::max_handle + 1) == gatt_db::no_slot);
+static_assert(gatt_db::slot_of(UINT16_MAX) == gatt_db::no_slot);
+
+// The map is no longer than the largest handle needs
+static_assert(gatt_db::slot_map.size() == gatt_db::max_handle + 1u);
+
+} // namespace
+
+int main() { return 0; }
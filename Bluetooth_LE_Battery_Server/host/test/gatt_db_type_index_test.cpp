@@ -0,0 +1,159 @@
+///
+/// \file    gatt_db_type_index_test.cpp
+/// \brief   Checks of the GATT type index against an attribute walk
+///
+/// \details Checks at compile time that the index holds every attribute with
+///          a 16-bit type, sorted by type then handle, and at run time that
+///          the walk Read By Type does from find_type() visits the same
+///          attributes as a filter over the attribute table, for every type
+///          and handle range.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_gatt_db.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+///
+/// \brief Check the index is sorted by type, then handle
+///
+constexpr bool index_sorted() {
+    for (auto i = std::size_t{1}; i < gatt_db::type_count; i++) {
+        const auto &previous = gatt_db::type_index[i - 1];
+        const auto &entry = gatt_db::type_index[i];
+
+        if (previous.uuid16 > entry.uuid16 ||
+            (previous.uuid16 == entry.uuid16 &&
+             previous.handle >= entry.handle)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+///
+/// \brief Check every entry names the slot of its attribute
+///
+constexpr bool index_slots_match() {
+    for (const auto &entry : gatt_db::type_index) {
+        const auto &attribute = gatt_db::attributes[entry.slot];
+
+        if (attribute.handle != entry.handle ||
+            attribute.uuid16 != entry.uuid16 ||
+            attribute.uuid16 == gatt_db::no_uuid16) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(index_sorted());
+static_assert(index_slots_match());
+
+// Two 128-bit OTA characteristics stay out of the index
+static_assert(gatt_db::type_count == gatt_db::attribute_count - 2);
+
+// Both CCCDs share a type, in handle order
+static_assert(gatt_db::type_index[0].uuid16 ==
+              UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION);
+static_assert(gatt_db::type_index[0].handle ==
+              HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG);
+static_assert(
+    gatt_db::type_index[1].handle ==
+    HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG);
+
+/// Types of attributes with storage, and types the stack serves itself
+constexpr uint16_t types[] = {
+    UUID_CHARACTERISTIC_DEVICE_NAME,
+    UUID_CHARACTERISTIC_APPEARANCE,
+    UUID_CHARACTERISTIC_BATTERY_LEVEL,
+    UUID_DESCRIPTOR_CHARACTERISTIC_PRESENTATION_FORMAT,
+    UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+    GATT_UUID_PRI_SERVICE,
+    GATT_UUID_CHAR_DECLARE,
+    0xFFFF,
+};
+
+///
+/// \brief Slots of a type in a handle range, walking the index
+///
+std::vector<std::size_t> indexed(uint16_t uuid16, uint16_t start_handle,
+                                 uint16_t end_handle) {
+    auto slots = std::vector<std::size_t>{};
+
+    for (const auto *entry = gatt_db::find_type(uuid16, start_handle);
+         entry != gatt_db::type_index.end() && entry->uuid16 == uuid16 &&
+         entry->handle <= end_handle;
+         ++entry) {
+        slots.push_back(entry->slot);
+    }
+
+    return slots;
+}
+
+///
+/// \brief Slots of a type in a handle range, filtering the attributes
+///
+std::vector<std::size_t> filtered(uint16_t uuid16, uint16_t start_handle,
+                                  uint16_t end_handle) {
+    auto slots = std::vector<std::size_t>{};
+
+    for (auto i = std::size_t{}; i < gatt_db::attribute_count; i++) {
+        const auto &attribute = gatt_db::attributes[i];
+
+        if (attribute.uuid16 == uuid16 && attribute.handle >= start_handle &&
+            attribute.handle <= end_handle) {
+            slots.push_back(i);
+        }
+    }
+
+    return slots;
+}
+
+void check_ranges() {
+    const auto last = static_cast<uint16_t>(gatt_db::max_handle + 2);
+
+    for (const auto uuid16 : types) {
+        for (auto start = uint16_t{1}; start <= last; start++) {
+            for (auto end = start; end <= last; end++) {
+                TEST_CHECK(indexed(uuid16, start, end) ==
+                           filtered(uuid16, start, end));
+            }
+
+            TEST_CHECK(indexed(uuid16, start, UINT16_MAX) ==
+                       filtered(uuid16, start, UINT16_MAX));
+        }
+    }
+}
+
+void check_has_type() {
+    TEST_CHECK(gatt_db::has_type(UUID_CHARACTERISTIC_DEVICE_NAME));
+    TEST_CHECK(gatt_db::has_type(UUID_CHARACTERISTIC_BATTERY_LEVEL));
+    TEST_CHECK(
+        gatt_db::has_type(UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION));
+
+    // Declarations are the stack's, and 128-bit types are not indexed
+    TEST_CHECK(!gatt_db::has_type(GATT_UUID_PRI_SERVICE));
+    TEST_CHECK(!gatt_db::has_type(GATT_UUID_CHAR_DECLARE));
+    TEST_CHECK(!gatt_db::has_type(gatt_db::no_uuid16));
+    TEST_CHECK(!gatt_db::has_type(0xFFFF));
+}
+
+} // namespace
+
+int main() {
+    check_ranges();
+    check_has_type();
+
+    return test_result();
+}
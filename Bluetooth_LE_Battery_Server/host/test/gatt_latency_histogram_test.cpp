@@ -0,0 +1,117 @@
+///
+/// \file    gatt_latency_histogram_test.cpp
+/// \brief   Compile-time checks of the GATT latency histogram
+///
+/// \details Places latencies at the edges of the power-of-two buckets and
+///          reads percentiles back from small histograms, including the
+///          interpolation within a bucket, the rank rounding and the top
+///          bucket.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "ble_gatt_statistics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using statistics = ble_gatt_statistics;
+using histogram = statistics::latency_histogram;
+
+// Bucket n holds [2^n, 2^(n+1)); 0 and 1 cycle share bucket 0
+static_assert(statistics::latency_bucket(0) == 0);
+static_assert(statistics::latency_bucket(1) == 0);
+static_assert(statistics::latency_bucket(2) == 1);
+static_assert(statistics::latency_bucket(3) == 1);
+static_assert(statistics::latency_bucket(4) == 2);
+static_assert(statistics::latency_bucket(1023) == 9);
+static_assert(statistics::latency_bucket(1024) == 10);
+static_assert(statistics::latency_bucket(UINT32_MAX) ==
+              statistics::LATENCY_BUCKETS - 1);
+
+///
+/// \brief Build a histogram from latencies
+///
+template <std::size_t Count>
+constexpr histogram histogram_of(const uint32_t (&latencies)[Count]) {
+    auto result = histogram{};
+
+    for (const auto latency : latencies) {
+        ++result[statistics::latency_bucket(latency)];
+    }
+
+    return result;
+}
+
+// Nothing recorded
+static_assert(statistics::latency_percentile(histogram{}, 0, 500) == 0);
+
+// 90 fast operations (100 cycles) and 10 slow ones (5000 cycles)
+constexpr histogram mixed_of() {
+    auto result = histogram{};
+
+    result[statistics::latency_bucket(100)] = 90;
+    result[statistics::latency_bucket(5000)] = 10;
+
+    return result;
+}
+
+constexpr auto mixed = mixed_of();
+
+// Interpolated within the bucket: 100 is in [64, 128), and the 50th of 90
+// samples sits at 64 + 64 * 49.5 / 90
+static_assert(statistics::latency_percentile(mixed, 100, 500) == 99);
+static_assert(statistics::latency_percentile(mixed, 100, 10) == 64);
+static_assert(statistics::latency_percentile(mixed, 100, 900) == 127);
+
+// The 91st sample is the first slow one: 5000 is in [4096, 8192)
+static_assert(statistics::latency_percentile(mixed, 100, 901) == 4300);
+static_assert(statistics::latency_percentile(mixed, 100, 990) == 7577);
+static_assert(statistics::latency_percentile(mixed, 100, 999) == 7987);
+
+// The rank rounds up: p50 of two samples is the first, p50.1 the second;
+// a lone sample sits in the middle of its bucket
+constexpr uint32_t pair_latencies[] = {10, 1000};
+constexpr auto pair = histogram_of(pair_latencies);
+static_assert(statistics::latency_percentile(pair, 2, 500) == 12);
+static_assert(statistics::latency_percentile(pair, 2, 501) == 768);
+
+// A single sample is every percentile
+constexpr uint32_t single_latency[] = {1};
+constexpr auto single = histogram_of(single_latency);
+static_assert(statistics::latency_percentile(single, 1, 1) == 1);
+static_assert(statistics::latency_percentile(single, 1, 999) == 1);
+
+// The top bucket is [2^31, 2^32)
+constexpr uint32_t slowest_latency[] = {UINT32_MAX};
+constexpr auto slowest = histogram_of(slowest_latency);
+static_assert(statistics::latency_percentile(slowest, 1, 500) ==
+              (uint32_t{3} << 30));
+
+///
+/// \brief Check every percentile stays within the bucket of its sample
+///
+constexpr bool within_buckets() {
+    for (auto per_mille = uint32_t{1}; per_mille <= 1000; per_mille++) {
+        const auto estimate =
+            statistics::latency_percentile(mixed, 100, per_mille);
+        const auto expected = (per_mille <= 900) ? 100u : 5000u;
+
+        if (statistics::latency_bucket(estimate) !=
+            statistics::latency_bucket(expected)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(within_buckets());
+
+} // namespace
+
+int main() { return 0; }
@@ -0,0 +1,243 @@
+///
+/// \file    lzss_decoder_test.cpp
+/// \brief   Checks of the streaming LZSS decoder on small vectors
+///
+/// \details Decodes hand-assembled streams (literals, references, runs that
+///          overlap their source, block restarts) whole, one byte at a time
+///          and through a sink that refuses every other delivery, and checks
+///          that corrupt references, a rejecting sink and padding after the
+///          end are handled.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "lzss_decoder.hpp"
+#include "test_check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using bytes = std::vector<uint8_t>;
+using status = util::lzss_decoder::status;
+
+///
+/// \brief Encode a reference as its two stream bytes
+///
+constexpr uint16_t reference(std::size_t distance, std::size_t length) {
+    return static_cast<uint16_t>((distance - 1) << 6 |
+                                 (length - util::lzss_decoder::MIN_MATCH));
+}
+
+constexpr uint8_t high(uint16_t token) { return token >> 8; }
+constexpr uint8_t low(uint16_t token) { return token & 0xFF; }
+
+util::lzss_decoder decoder{};
+
+///
+/// \brief Decode a whole stream, optionally one byte at a time
+///
+status decode(const bytes &stream, uint32_t block_size, uint32_t total_size,
+              bytes &output, bool bytewise = false) {
+    auto sink = [&output](const uint8_t *data, std::size_t length) {
+        output.insert(output.end(), data, data + length);
+        return true;
+    };
+
+    output.clear();
+    decoder.reset(block_size, total_size);
+
+    if (!bytewise) {
+        return decoder.decode(stream.data(), stream.size(), sink);
+    }
+
+    for (const auto byte : stream) {
+        if (const auto result = decoder.decode(&byte, 1, sink);
+            result != status::ok) {
+            return result;
+        }
+    }
+
+    return status::ok;
+}
+
+///
+/// \brief Decode a whole stream with a sink that refuses every other
+///        delivery, passing the input again from where it stopped
+///
+bytes decode_refused(const bytes &stream, uint32_t block_size,
+                     uint32_t total_size) {
+    auto output = bytes{};
+    auto refuse = false;
+
+    auto sink = [&output, &refuse](const uint8_t *data, std::size_t length) {
+        refuse = !refuse;
+
+        if (!refuse) {
+            output.insert(output.end(), data, data + length);
+        }
+
+        return !refuse;
+    };
+
+    decoder.reset(block_size, total_size);
+
+    auto offset = std::size_t{};
+
+    for (auto attempt = 0; attempt < 10000; attempt++) {
+        const auto result = decoder.decode(stream.data() + offset,
+                                           stream.size() - offset, sink);
+        offset += decoder.consumed();
+
+        if (result != status::sink) {
+            TEST_CHECK(result == status::ok);
+            break;
+        }
+    }
+
+    return output;
+}
+
+///
+/// \brief Check a stream decodes to the expected bytes, whole, bytewise and
+///        through a refusing sink
+///
+void check_decodes(const bytes &stream, uint32_t block_size,
+                   const bytes &expected) {
+    const auto total = static_cast<uint32_t>(expected.size());
+    auto output = bytes{};
+
+    TEST_CHECK(decode(stream, block_size, total, output) == status::ok);
+    TEST_CHECK(output == expected);
+    TEST_CHECK(decoder.produced() == total);
+
+    TEST_CHECK(decode(stream, block_size, total, output, true) == status::ok);
+    TEST_CHECK(output == expected);
+    TEST_CHECK(decode_refused(stream, block_size, total) == expected);
+}
+
+constexpr auto NO_BLOCKS = uint32_t{1u << 20};
+
+void check_literals() {
+    // Eight literals under one flag byte, then one under the next
+    check_decodes({0xFF, 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 0x01, 'I'},
+                  NO_BLOCKS, {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I'});
+}
+
+void check_references() {
+    // "abc" then a copy of it twice over: distance 3, length 6
+    const auto copy = reference(3, 6);
+    check_decodes({0x07, 'a', 'b', 'c', high(copy), low(copy)}, NO_BLOCKS,
+                  {'a', 'b', 'c', 'a', 'b', 'c', 'a', 'b', 'c'});
+
+    // A run overlaps its own output: distance 1, length 10
+    const auto run = reference(1, 10);
+    check_decodes({0x01, 'x', high(run), low(run)}, NO_BLOCKS, bytes(11, 'x'));
+
+    // Longest references, past the 128-byte output buffer
+    const auto longest = reference(1, 66);
+    check_decodes({0x01, 'z', high(longest), low(longest), high(longest),
+                   low(longest), high(longest), low(longest)},
+                  NO_BLOCKS, bytes(1 + 3 * 66, 'z'));
+
+    // Farthest reference: the whole 1024-byte window back
+    auto stream = bytes{};
+    auto expected = bytes{};
+
+    for (auto i = 0; i < 1024; i++) {
+        if (i % 8 == 0) {
+            stream.push_back(0xFF);
+        }
+
+        stream.push_back(static_cast<uint8_t>(i * 13));
+        expected.push_back(static_cast<uint8_t>(i * 13));
+    }
+
+    const auto farthest = reference(1024, 3);
+    stream.insert(stream.end(), {0x00, high(farthest), low(farthest)});
+    expected.insert(expected.end(), {expected[0], expected[1], expected[2]});
+
+    check_decodes(stream, NO_BLOCKS, expected);
+}
+
+void check_blocks() {
+    // Blocks of 5: every block restarts with a flag byte and an empty window
+    const auto repeat = reference(2, 3);
+    check_decodes({0x1F, 'a', 'b', 'c', 'd', 'e', 0x03, 'f', 'g', high(repeat),
+                   low(repeat), 0x01, 'h'},
+                  5, {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'f', 'g', 'f', 'h'});
+
+    // Resuming at the second block decodes it alone
+    auto output = bytes{};
+    auto sink = [&output](const uint8_t *data, std::size_t length) {
+        output.insert(output.end(), data, data + length);
+        return true;
+    };
+
+    const bytes second_block = {0x03, 'f', 'g', high(repeat), low(repeat)};
+    decoder.reset(5, 11, 5);
+
+    TEST_CHECK(decoder.decode(second_block.data(), second_block.size(),
+                              sink) == status::ok);
+    TEST_CHECK((output == bytes{'f', 'g', 'f', 'g', 'f'}));
+    TEST_CHECK(decoder.produced() == 10);
+}
+
+void check_corrupt() {
+    auto output = bytes{};
+
+    // A reference before any output
+    const auto early = reference(1, 3);
+    TEST_CHECK(decode({0x00, high(early), low(early)}, NO_BLOCKS, 3,
+                      output) == status::corrupt);
+
+    // A reference into the previous block
+    const auto back = reference(2, 3);
+    TEST_CHECK(decode({0x03, 'a', 'b', 0x00, high(back), low(back)}, 2, 5,
+                      output) == status::corrupt);
+
+    // A reference running past the end of its block
+    const auto across = reference(1, 4);
+    TEST_CHECK(decode({0x01, 'a', high(across), low(across)}, 4, 8, output) ==
+               status::corrupt);
+}
+
+void check_end_of_stream() {
+    // Flag bits and bytes after the last decoded byte are padding
+    auto output = bytes{};
+
+    TEST_CHECK(decode({0xFF, 'a', 'b', 0x55, 0xAA}, NO_BLOCKS, 2, output) ==
+               status::ok);
+    TEST_CHECK((output == bytes{'a', 'b'}));
+}
+
+void check_sink() {
+    const bytes stream = {0x03, 'a', 'b'};
+    auto calls = 0;
+
+    decoder.reset(NO_BLOCKS, 2);
+
+    TEST_CHECK(decoder.decode(stream.data(), stream.size(),
+                              [&calls](const uint8_t *, std::size_t) {
+                                  ++calls;
+                                  return false;
+                              }) == status::sink);
+    TEST_CHECK(calls == 1);
+}
+
+} // namespace
+
+int main() {
+    check_literals();
+    check_references();
+    check_blocks();
+    check_corrupt();
+    check_end_of_stream();
+    check_sink();
+
+    return test_result();
+}
@@ -0,0 +1,156 @@
+///
+/// \file    mpsc_queue_test.cpp
+/// \brief   Checks of the lock-free MPSC queue, alone and under contention
+///
+/// \details Fills and drains a small queue past the wrap of its positions
+///          and checks FIFO order, that a full queue rejects and counts
+///          without losing what it holds, and the counters. Then several
+///          producer threads push numbered elements into a queue far
+///          smaller than their output, retrying when it is full, while the
+///          main thread consumes: nothing may be lost or duplicated, and
+///          each producer's elements must arrive in the order it pushed
+///          them.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#include "mpsc_queue.hpp"
+#include "test_check.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+///
+/// \brief Element tagged with its producer and its place in that stream
+///
+struct item {
+    uint32_t producer; ///< Thread that pushed it
+    uint32_t sequence; ///< Position in that thread's stream
+};
+
+using small_queue = mpsc_queue<item, 8>;
+using contended_queue = mpsc_queue<item, 16>;
+
+/// Producer threads in the contended check
+constexpr auto PRODUCERS = uint32_t{4};
+
+/// Elements each producer pushes
+constexpr auto PER_PRODUCER = uint32_t{50000};
+
+void check_fifo_and_full() {
+    auto queue = small_queue{};
+    auto value = item{};
+
+    TEST_CHECK(!queue.try_pop(value));
+
+    // Many rounds, so the positions wrap the slots several times
+    auto next_in = uint32_t{};
+    auto next_out = uint32_t{};
+
+    for (auto round = 0; round < 100; round++) {
+        while (queue.try_push({0, next_in})) {
+            next_in++;
+        }
+
+        // Full: the rejected element is counted, nothing held is lost
+        TEST_CHECK(queue.stats().depth == 8);
+        TEST_CHECK(queue.stats().high_water_mark == 8);
+
+        // Take back a few and leave the rest for the next round
+        for (auto i = 0; i < 3 + round % 5; i++) {
+            TEST_CHECK(queue.try_pop(value));
+            TEST_CHECK(value.sequence == next_out);
+            next_out++;
+        }
+    }
+
+    while (queue.try_pop(value)) {
+        TEST_CHECK(value.sequence == next_out);
+        next_out++;
+    }
+
+    TEST_CHECK(next_out == next_in);
+
+    const auto stats = queue.stats();
+    TEST_CHECK(stats.depth == 0);
+    TEST_CHECK(stats.pushed == next_in);
+    TEST_CHECK(stats.dropped == 100);
+
+    queue.reset_stats();
+    TEST_CHECK(queue.stats().pushed == 0 && queue.stats().dropped == 0 &&
+               queue.stats().high_water_mark == 0);
+}
+
+void check_producers() {
+    static auto queue = contended_queue{};
+
+    auto producers = std::vector<std::thread>{};
+
+    for (auto producer = uint32_t{}; producer < PRODUCERS; producer++) {
+        producers.emplace_back([producer] {
+            for (auto sequence = uint32_t{}; sequence < PER_PRODUCER;) {
+                if (queue.try_push({producer, sequence})) {
+                    sequence++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Next sequence expected from each producer
+    auto expected = std::array<uint32_t, PRODUCERS>{};
+    auto received = uint32_t{};
+    auto out_of_order = uint32_t{};
+    auto value = item{};
+
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (value.producer >= PRODUCERS ||
+            value.sequence != expected[value.producer]) {
+            out_of_order++;
+        } else {
+            expected[value.producer]++;
+        }
+
+        received++;
+    }
+
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    // A lost, duplicated or reordered element breaks a producer's count
+    TEST_CHECK(out_of_order == 0);
+
+    for (const auto count : expected) {
+        TEST_CHECK(count == PER_PRODUCER);
+    }
+
+    TEST_CHECK(!queue.try_pop(value));
+
+    const auto stats = queue.stats();
+    TEST_CHECK(stats.depth == 0);
+    TEST_CHECK(stats.pushed == PRODUCERS * PER_PRODUCER);
+    TEST_CHECK(stats.high_water_mark <= 16);
+}
+
+} // namespace
+
+int main() {
+    check_fifo_and_full();
+    check_producers();
+
+    return test_result();
+}
@@ -0,0 +1,235 @@
+///
+/// \file    ota_l2cap_channel_test.cpp
+/// \brief   Checks of the OTA L2CAP channel against the host stack
+///
+/// \details Plays the peer through the host stack's L2CAP entry points and
+///          checks that only one channel is accepted at a time, that SDUs
+///          on it reach the OTA library intact, that SDUs on other channels
+///          are ignored, and that an SDU outside a download is refused by
+///          closing the channel. The calling thread stands in for the
+///          Bluetooth stack thread and a second thread for the OTA writer.
+///          SDUs reach the decoder through ble_context, which holds one back
+///          while the staging buffers are full; the calling thread then
+///          also stands in for the application event task, and paces the
+///          peer as the specification asks of it.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_ota_api.h"
+#include "cy_result.h"
+#include "wiced_bt_l2c.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_context.hpp"
+#include "host_platform.hpp"
+#include "ota_image_decoder.hpp"
+#include "ota_l2cap_channel.hpp"
+#include "ota_staging.hpp"
+#include "test_check.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Channels the peer opens
+constexpr auto FIRST_CID = uint16_t{0x0040};
+constexpr auto SECOND_CID = uint16_t{0x0041};
+
+/// Any non-null context; the host OTA library only checks for null
+int ota_context_storage = 0;
+const auto ota_context = cy_ota_context_ptr{&ota_context_storage};
+
+wiced_bt_device_address_t peer = {0x00, 0xA0, 0x50, 0x11, 0x22, 0x33};
+
+auto &channel = ota_l2cap_channel_object;
+
+///
+/// \brief Build an image that matches no encoded-image magic
+///
+std::vector<uint8_t> image_of(std::size_t size) {
+    auto image = std::vector<uint8_t>(size);
+
+    for (auto i = std::size_t{}; i < size; i++) {
+        image[i] = static_cast<uint8_t>(i * 11 + i / 256);
+    }
+
+    return image;
+}
+
+///
+/// \brief Find the first record of a kind on a channel
+///
+const host::bt_record *find(const std::vector<host::bt_record> &records,
+                            host::bt_kind kind, uint16_t local_cid) {
+    const auto found =
+        std::find_if(records.begin(), records.end(), [&](const auto &record) {
+            return record.kind == kind && record.conn_id == local_cid;
+        });
+
+    return (found != records.end()) ? &*found : nullptr;
+}
+
+///
+/// \brief Start a download as the control point would
+///
+bool start(std::size_t size) {
+    for (auto attempt = 0; attempt < 200; attempt++) {
+        if (ota_staging_object.start(ota_context, 1,
+                                     static_cast<uint32_t>(size))) {
+            // Clear the slot as a new download would
+            cy_ota_ble_download(ota_context, nullptr, 1, 0);
+            ota_image_decoder_object.reset(static_cast<uint32_t>(size));
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    return false;
+}
+
+///
+/// \brief Send part of an image as SDUs of the channel MTU
+///
+void send(uint16_t local_cid, const std::vector<uint8_t> &image) {
+    for (auto offset = std::size_t{}; offset < image.size();
+         offset += OTA_L2CAP_MTU) {
+        const auto length =
+            std::min<std::size_t>(OTA_L2CAP_MTU, image.size() - offset);
+
+        host::l2cap_data(local_cid, image.data() + offset,
+                         static_cast<uint16_t>(length));
+
+        // Stage a held SDU once the writer frees a buffer, before the next
+        while (ble_context_object.ota_deferred()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            ble_context_object.ota_staging_ready_handler();
+        }
+    }
+}
+
+///
+/// \brief Flush the image and wait for the writer to commit all of it
+///
+/// \return cy_rslt_t Outcome of the image
+///
+cy_rslt_t finish() {
+    ota_staging_object.flush();
+
+    while (!ota_staging_object.idle()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    return ota_staging_object.result();
+}
+
+void check_one_channel() {
+    TEST_CHECK(host::l2cap_open(peer, FIRST_CID, OTA_L2CAP_MTU));
+    TEST_CHECK(channel.open());
+
+    auto sent = host::bt_take();
+    const auto *accepted =
+        find(sent, host::bt_kind::l2cap_connect_rsp, FIRST_CID);
+    TEST_CHECK(accepted != nullptr &&
+               accepted->handle == L2CAP_LE_RESULT_CONN_OK);
+
+    // A second channel is refused while the first is open
+    TEST_CHECK(host::l2cap_open(peer, SECOND_CID, OTA_L2CAP_MTU));
+
+    sent = host::bt_take();
+    const auto *refused =
+        find(sent, host::bt_kind::l2cap_connect_rsp, SECOND_CID);
+    TEST_CHECK(refused != nullptr &&
+               refused->handle == L2CAP_LE_RESULT_NO_RESOURCES);
+    TEST_CHECK(channel.open());
+}
+
+void check_stream() {
+    const auto image = image_of(2 * OTA_STAGING_BUFFER_SIZE + 700);
+
+    TEST_CHECK(start(image.size()));
+    send(FIRST_CID, image);
+
+    // SDUs on a channel that was never accepted are not counted
+    send(SECOND_CID, image_of(10));
+
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+    TEST_CHECK(host::ota_image() == image);
+
+    const auto counters = channel.stats();
+    const auto sdus = (image.size() + OTA_L2CAP_MTU - 1) / OTA_L2CAP_MTU;
+
+    TEST_CHECK(counters.bytes == image.size());
+    TEST_CHECK(counters.sdus == sdus);
+    TEST_CHECK(counters.rejected == 0);
+
+    TEST_CHECK(find(host::bt_take(), host::bt_kind::l2cap_disconnect,
+                    FIRST_CID) == nullptr);
+}
+
+void check_refused() {
+    // The download was flushed, so the next SDU has nowhere to go
+    send(FIRST_CID, image_of(10));
+
+    TEST_CHECK(channel.stats().rejected == 1);
+    TEST_CHECK(find(host::bt_take(), host::bt_kind::l2cap_disconnect,
+                    FIRST_CID) != nullptr);
+}
+
+void check_reopen() {
+    host::l2cap_close(FIRST_CID);
+    TEST_CHECK(!channel.open());
+    host::bt_take();
+
+    // A new channel starts its counters over
+    TEST_CHECK(host::l2cap_open(peer, SECOND_CID, OTA_L2CAP_MTU));
+    TEST_CHECK(channel.open());
+
+    const auto counters = channel.stats();
+    TEST_CHECK(counters.bytes == 0 && counters.sdus == 0 &&
+               counters.rejected == 0);
+
+    const auto image = image_of(300);
+
+    TEST_CHECK(start(image.size()));
+    send(SECOND_CID, image);
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+    TEST_CHECK(host::ota_image() == image);
+
+    host::l2cap_close(SECOND_CID);
+    TEST_CHECK(!channel.open());
+}
+
+} // namespace
+
+int main() {
+    // Nothing is accepted before the PSM is registered
+    TEST_CHECK(!host::l2cap_open(peer, FIRST_CID, OTA_L2CAP_MTU));
+
+    TEST_CHECK(channel.initialize());
+    TEST_CHECK(ota_staging_object.initialize() == CY_RSLT_SUCCESS);
+
+    // The OTA writer task
+    std::thread{[] { ota_staging_object.run_writer(); }}.detach();
+
+    check_one_channel();
+    check_stream();
+    check_refused();
+    check_reopen();
+
+    // The writer never returns
+    std::_Exit(test_result());
+}
@@ -0,0 +1,243 @@
+///
+/// \file    ota_staging_test.cpp
+/// \brief   Checks of the OTA staging ring against the host OTA library
+///
+/// \details Streams small images through the staging buffers with a writer
+///          thread standing in for the OTA writer task, and checks the
+///          image the host OTA library received: whole and partial last
+///          buffers, data outside a session, a session suspended by a lost
+///          connection and resumed on another, and a restart after an abort.
+///          The stack thread never waits, so chunks are only appended once
+///          fits() says a buffer is free, and a flushed image is checked once
+///          idle() says the writer is done, as the application task would.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_ota_api.h"
+#include "cy_result.h"
+}
+#pragma GCC diagnostic pop
+
+#include "host_platform.hpp"
+#include "ota_staging.hpp"
+#include "test_check.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// ATT payload of one OTA data write at the largest MTU
+constexpr auto CHUNK_SIZE = std::size_t{512 - 3};
+
+/// Any non-null context; the host OTA library only checks for null
+int ota_context_storage = 0;
+const auto ota_context = cy_ota_context_ptr{&ota_context_storage};
+
+ota_staging staging{};
+
+///
+/// \brief Build an image whose bytes differ from buffer to buffer
+///
+std::vector<uint8_t> image_of(std::size_t size, uint8_t seed) {
+    auto image = std::vector<uint8_t>(size);
+
+    for (auto i = std::size_t{}; i < size; i++) {
+        image[i] = static_cast<uint8_t>(seed + i * 7 + i / 4096);
+    }
+
+    return image;
+}
+
+///
+/// \brief Append part of an image in ATT-sized chunks
+///
+/// Holds each chunk back until it fits, as the application task holds a
+/// chunk until the writer reports a free buffer.
+///
+/// \return cy_rslt_t Result of the first failed append, or CY_RSLT_SUCCESS
+///
+cy_rslt_t append(const std::vector<uint8_t> &image, std::size_t from,
+                 std::size_t to) {
+    for (auto offset = from; offset < to; offset += CHUNK_SIZE) {
+        const auto length = std::min(CHUNK_SIZE, to - offset);
+
+        while (!staging.fits(length)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+
+        const auto result = staging.append(image.data() + offset,
+                                           static_cast<uint16_t>(length));
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+///
+/// \brief Flush the image and wait for the writer to commit all of it
+///
+/// \return cy_rslt_t Outcome of the image
+///
+cy_rslt_t finish() {
+    staging.flush();
+
+    while (!staging.idle()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    return staging.result();
+}
+
+///
+/// \brief Start an image once the writer has dropped older buffers
+///
+bool start(uint16_t connection_id, std::size_t size) {
+    for (auto attempt = 0; attempt < 200; attempt++) {
+        if (staging.start(ota_context, connection_id,
+                          static_cast<uint32_t>(size))) {
+            // The writer is idle: clear the slot as a new download would
+            cy_ota_ble_download(ota_context, nullptr, connection_id, 0);
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+
+    return false;
+}
+
+///
+/// \brief A whole image, the last buffer partial, arrives intact
+///
+void check_stream() {
+    const auto image = image_of(2 * OTA_STAGING_BUFFER_SIZE + 1808, 1);
+
+    TEST_CHECK(start(1, image.size()));
+    TEST_CHECK(append(image, 0, image.size()) == CY_RSLT_SUCCESS);
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+
+    TEST_CHECK(host::ota_image() == image);
+
+    const auto counters = staging.stats();
+    TEST_CHECK(counters.bytes_committed == image.size());
+    TEST_CHECK(counters.commits == 3);
+}
+
+///
+/// \brief An image of whole buffers leaves nothing partial to commit
+///
+/// The image is larger than the ring, so chunks are held back until flash
+/// frees a buffer.
+///
+void check_whole_buffers() {
+    constexpr auto buffers = OTA_STAGING_BUFFER_COUNT + 2;
+    const auto image = image_of(buffers * OTA_STAGING_BUFFER_SIZE, 2);
+
+    TEST_CHECK(start(1, image.size()));
+    TEST_CHECK(append(image, 0, image.size()) == CY_RSLT_SUCCESS);
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+
+    TEST_CHECK(host::ota_image() == image);
+    TEST_CHECK(staging.stats().commits == buffers);
+    TEST_CHECK(staging.stats().stalls > 0);
+}
+
+///
+/// \brief Data outside a session is refused
+///
+void check_no_session() {
+    const uint8_t data[] = {1, 2, 3};
+
+    // The previous image was flushed, which ends its session
+    TEST_CHECK(staging.append(data, sizeof(data)) ==
+               CY_RSLT_OTA_ERROR_BADARG);
+}
+
+///
+/// \brief A lost connection suspends the image until its peer resumes it
+///
+void check_resume() {
+    const auto image = image_of(3 * OTA_STAGING_BUFFER_SIZE, 3);
+
+    TEST_CHECK(start(1, image.size()));
+    TEST_CHECK(append(image, 0, OTA_STAGING_BUFFER_SIZE + 1000) ==
+               CY_RSLT_SUCCESS);
+
+    // Another connection closing leaves the session alone
+    staging.connection_lost(2);
+    TEST_CHECK(!staging.suspended());
+
+    staging.connection_lost(1);
+    TEST_CHECK(staging.suspended());
+
+    // The partial buffer is dropped; the first buffer was handed over
+    TEST_CHECK(staging.resume_offset() == OTA_STAGING_BUFFER_SIZE);
+    TEST_CHECK(staging.resumable(static_cast<uint32_t>(image.size())));
+    TEST_CHECK(!staging.resumable(static_cast<uint32_t>(image.size() + 1)));
+
+    // Nothing is staged while suspended
+    TEST_CHECK(append(image, OTA_STAGING_BUFFER_SIZE, image.size()) ==
+               CY_RSLT_OTA_ERROR_BADARG);
+
+    const auto offset = staging.resume(3);
+    TEST_CHECK(offset == OTA_STAGING_BUFFER_SIZE);
+
+    TEST_CHECK(append(image, offset, image.size()) == CY_RSLT_SUCCESS);
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+
+    TEST_CHECK(host::ota_image() == image);
+}
+
+///
+/// \brief An aborted image never reaches the library after a restart
+///
+void check_abort() {
+    const auto aborted = image_of(2 * OTA_STAGING_BUFFER_SIZE, 4);
+    const auto image = image_of(OTA_STAGING_BUFFER_SIZE + 10, 5);
+
+    TEST_CHECK(start(1, aborted.size()));
+    TEST_CHECK(append(aborted, 0, aborted.size()) == CY_RSLT_SUCCESS);
+
+    staging.abort();
+    TEST_CHECK(!staging.suspended());
+
+    // Refused until the writer has dropped the aborted buffers
+    TEST_CHECK(start(1, image.size()));
+    TEST_CHECK(append(image, 0, image.size()) == CY_RSLT_SUCCESS);
+    TEST_CHECK(finish() == CY_RSLT_SUCCESS);
+
+    TEST_CHECK(host::ota_image() == image);
+}
+
+} // namespace
+
+int main() {
+    TEST_CHECK(staging.initialize() == CY_RSLT_SUCCESS);
+
+    // The OTA writer task
+    std::thread{[] { staging.run_writer(); }}.detach();
+
+    check_stream();
+    check_whole_buffers();
+    check_no_session();
+    check_resume();
+    check_abort();
+
+    // The writer never returns
+    std::_Exit(test_result());
+}
@@ -0,0 +1,39 @@
+///
+/// \file    test_check.hpp
+/// \brief   Run-time checks for the host tests
+///
+/// \details For the checks that cannot be static_asserts. A failed check
+///          prints its location and expression and is counted; main()
+///          returns test_result() so ctest sees the failure.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Host simulation
+///
+
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+
+#include <cstdio>
+#include <cstdlib>
+
+/// Checks failed so far
+inline int test_failures = 0;
+
+#define TEST_CHECK(condition)                                                 \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__,       \
+                         __LINE__, #condition);                               \
+            ++test_failures;                                                  \
+        }                                                                     \
+    } while (false)
+
+///
+/// \brief Get the exit status of a test executable
+///
+inline int test_result() {
+    return (test_failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* TEST_CHECK_HPP */
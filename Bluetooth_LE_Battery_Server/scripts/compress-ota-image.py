@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+
+##
+## USAGE:
+## Invoke while in the Bluetooth_LE_Battery_Server directory.
+##
+## % pwd
+## /path/to/mtb-bluetooth-le-battery-server/Bluetooth_LE_Battery_Server
+##
+## # Compress an MCUboot-signed OTA image for the OTA data characteristic
+## % ./scripts/compress-ota-image.py build/APP_CY8CPROTO-062-4343W/Debug/mtb-example-btstack-freertos-battery-server.bin
+##
+## # Choose the output file and the throughput used for the estimate
+## % ./scripts/compress-ota-image.py -o image.lzss --kbps 8 image.bin
+##
+## The compressed image is decoded again with the same block-by-block
+## streaming algorithm as src/utilities/lzss_decoder.hpp before it is written,
+## and the size and transfer-time saving are reported. The download command
+## must still announce the uncompressed size, and the verify command the
+## CRC-32 of the uncompressed image; both are printed.
+##
+## To resume an interrupted download from uncompressed offset N, resend the
+## compressed image from the offset listed for block N / 4096.
+##
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b"LZSS"
+VERSION = 1
+BLOCK_SIZE = 4096  # OTA_STAGING_BUFFER_SIZE
+WINDOW_SIZE = 1024
+MIN_MATCH = 3
+MAX_MATCH = MIN_MATCH + 63
+MAX_CHAIN = 64
+
+
+def compress_block(block):
+    out = bytearray()
+    chains = {}
+    position = 0
+
+    while position < len(block):
+        flag_index = len(out)
+        out.append(0)
+        flags = 0
+
+        for bit in range(8):
+            if position >= len(block):
+                break
+
+            best_length, best_distance = 0, 0
+            key = bytes(block[position:position + MIN_MATCH])
+
+            if len(key) == MIN_MATCH:
+                limit = min(MAX_MATCH, len(block) - position)
+
+                for candidate in reversed(chains.get(key, [])[-MAX_CHAIN:]):
+                    distance = position - candidate
+
+                    if distance > WINDOW_SIZE:
+                        break
+
+                    length = MIN_MATCH
+                    while (length < limit and block[candidate + length] ==
+                           block[position + length]):
+                        length += 1
+
+                    if length > best_length:
+                        best_length, best_distance = length, distance
+
+                        if length == limit:
+                            break
+
+            step = best_length if best_length >= MIN_MATCH else 1
+
+            if step == 1:
+                flags |= 1 << bit
+                out.append(block[position])
+            else:
+                token = ((best_distance - 1) << 6) | (best_length - MIN_MATCH)
+                out += struct.pack(">H", token)
+
+            for i in range(position, position + step):
+                chains.setdefault(bytes(block[i:i + MIN_MATCH]), []).append(i)
+
+            position += step
+
+        out[flag_index] = flags
+
+    return bytes(out)
+
+
+def compress(image):
+    header = MAGIC + struct.pack("<IHH", len(image), BLOCK_SIZE, VERSION)
+    out = bytearray(header)
+    offsets = []
+
+    for start in range(0, len(image), BLOCK_SIZE):
+        offsets.append(len(out))
+        out += compress_block(image[start:start + BLOCK_SIZE])
+
+    return bytes(out), offsets
+
+
+def decompress(stream, chunk=244):
+    """Streaming decoder mirroring src/utilities/lzss_decoder.hpp."""
+    if stream[:4] != MAGIC:
+        raise ValueError("missing LZSS magic")
+
+    total, block_size, version = struct.unpack("<IHH", stream[4:12])
+
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    out = bytearray()
+    window = bytearray()
+    flags, flag_bits, high = 0, 0, None
+
+    # Feed the payload in characteristic-sized pieces like the peer would
+    for piece_start in range(12, len(stream), chunk):
+        for byte in stream[piece_start:piece_start + chunk]:
+            if len(out) >= total:
+                break
+
+            if flag_bits == 0:
+                flags, flag_bits = byte, 8
+                continue
+
+            if flags & 1:
+                out.append(byte)
+                window.append(byte)
+            elif high is None:
+                high = byte
+                continue
+            else:
+                token = (high << 8) | byte
+                high = None
+                distance = (token >> 6) + 1
+                length = (token & 0x3F) + MIN_MATCH
+                in_block = block_size - len(out) % block_size
+
+                if distance > len(window) or length > min(in_block,
+                                                          total - len(out)):
+                    raise ValueError("corrupt reference at %d" % len(out))
+
+                for _ in range(length):
+                    value = window[-distance]
+                    out.append(value)
+                    window.append(value)
+
+            flags >>= 1
+            flag_bits -= 1
+
+            if len(out) % block_size == 0 or len(out) == total:
+                window, flag_bits, high = bytearray(), 0, None
+
+    return bytes(out[:total])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compress an OTA image for streaming decompression")
+    parser.add_argument("image", help="uncompressed (signed) OTA image")
+    parser.add_argument("-o", "--output",
+                        help="compressed image (default: <image>.lzss)")
+    parser.add_argument("--kbps", type=float, default=6.0,
+                        help="OTA throughput in KB/s for the estimate")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    compressed, offsets = compress(image)
+
+    if decompress(compressed) != image:
+        sys.exit("round trip through the streaming decoder failed")
+
+    output = args.output or args.image + ".lzss"
+
+    with open(output, "wb") as f:
+        f.write(compressed)
+
+    raw_seconds = len(image) / (args.kbps * 1000)
+    compressed_seconds = len(compressed) / (args.kbps * 1000)
+
+    print("image:            %s" % args.image)
+    print("uncompressed:     %d bytes" % len(image))
+    print("compressed:       %d bytes (%.1f%%)" %
+          (len(compressed), 100.0 * len(compressed) / max(len(image), 1)))
+    print("transfer at %.1f KB/s: %.1f s -> %.1f s (%.1f s saved)" %
+          (args.kbps, raw_seconds, compressed_seconds,
+           raw_seconds - compressed_seconds))
+    print("download size:    %d (uncompressed)" % len(image))
+    print("verify CRC-32:    0x%08x (uncompressed)" %
+          (zlib.crc32(image) & 0xFFFFFFFF))
+    print("block offsets:    %s" % " ".join("%d" % o for o in offsets))
+    print("written:          %s" % output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+
+##
+## USAGE:
+## Invoke while in the Bluetooth_LE_Battery_Server directory.
+##
+## % pwd
+## /path/to/mtb-bluetooth-le-battery-server/Bluetooth_LE_Battery_Server
+##
+## # Make a delta OTA image from the image running on the device (old) to
+## # the new build output (both MCUboot-signed .bin files)
+## % ./scripts/make-ota-delta.py old.bin new.bin -o update.dlta
+##
+## # Apply synthetic old/new images and compare bytes on air without a build
+## % ./scripts/make-ota-delta.py --self-test
+##
+## The patch is applied again with the same block-by-block streaming
+## algorithm as src/utilities/delta_patch.hpp before it is written, and the
+## bytes on air of the raw, compressed and delta images are reported. The
+## download command must still announce the new image size, and the verify
+## command the CRC-32 of the new image; both are printed.
+##
+## The device rejects a delta whose base size and CRC-32 do not match the
+## image in its primary slot. To resume an interrupted download from new
+## image offset N, resend the delta image from the offset listed for block
+## N / 4096.
+##
+
+import argparse
+import importlib.util
+import os
+import random
+import struct
+import sys
+import zlib
+
+MAGIC = b"DLTA"
+VERSION = 1
+BLOCK_SIZE = 4096  # OTA_STAGING_BUFFER_SIZE
+HEADER_SIZE = 20
+
+COPY, MODIFY, INSERT, SEEK = 0x00, 0x01, 0x02, 0x03
+
+KEY_SIZE = 8       # Bytes hashed to find a base position
+MIN_COPY = 4       # Shorter matches are cheaper as MODIFY/INSERT
+MAX_MODIFY = 16    # Longest mismatch bridged without a SEEK
+MAX_CANDIDATES = 16
+
+
+def match_length(new, p, old, o, end):
+    length = 0
+    while p + length < end and o + length < len(old) and \
+            new[p + length] == old[o + length]:
+        length += 1
+    return length
+
+
+def build_index(old):
+    index = {}
+    for i in range(0, len(old) - KEY_SIZE + 1):
+        positions = index.setdefault(old[i:i + KEY_SIZE], [])
+        if len(positions) < MAX_CANDIDATES:
+            positions.append(i)
+    return index
+
+
+def relocate(new, p, old, end, index, current):
+    best, best_length = None, 0
+    for candidate in index.get(new[p:p + KEY_SIZE], []):
+        length = match_length(new, p, old, candidate, end)
+        if length > best_length or (length == best_length and best is not None
+                                    and abs(candidate - current) <
+                                    abs(best - current)):
+            best, best_length = candidate, length
+    return best if best_length >= KEY_SIZE else None
+
+
+def diff_block(old, new, start, end, index, position):
+    """Operations producing new[start:end]; returns (ops, base position)."""
+    ops = []
+
+    def emit(op, length, data=b""):
+        base = position if op in (COPY, MODIFY) else None
+        last = ops[-1] if ops else None
+        if last and last[0] == op and (op == INSERT or
+                                       last[3] + last[1] == base):
+            last[1] += length
+            last[2] = last[2] + data
+        else:
+            ops.append([op, length, data, base])
+
+    p = start
+    while p < end:
+        length = match_length(new, p, old, position, end)
+
+        if length >= MIN_COPY or (length > 0 and p + length == end):
+            emit(COPY, length)
+            p += length
+            position += length
+            continue
+
+        bridged = None
+        for m in range(1, MAX_MODIFY + 1):
+            if p + m >= end or position + m >= len(old):
+                break
+            resync = match_length(new, p + m, old, position + m, end)
+            if resync >= min(KEY_SIZE, end - (p + m)):
+                bridged = m
+                break
+
+        if bridged:
+            emit(MODIFY, bridged, new[p:p + bridged])
+            p += bridged
+            position += bridged
+            continue
+
+        candidate = relocate(new, p, old, end, index, position)
+        if candidate is not None:
+            position = candidate
+            continue
+
+        emit(INSERT, 1, new[p:p + 1])
+        p += 1
+
+    return ops, position
+
+
+def serialize(ops):
+    out = bytearray()
+    position = None  # Unknown at the start of every block
+
+    for op, length, data, base in ops:
+        if op in (COPY, MODIFY) and base != position:
+            out += struct.pack("<BI", SEEK, base)
+        out += struct.pack("<BH", op, length) + data
+        if op in (COPY, MODIFY):
+            position = base + length
+
+    return out
+
+
+def make_patch(old, new):
+    header = MAGIC + struct.pack("<IHHII", len(new), BLOCK_SIZE, VERSION,
+                                 len(old), zlib.crc32(old) & 0xFFFFFFFF)
+    out = bytearray(header)
+    offsets = []
+    index = build_index(old)
+    position = 0
+
+    for start in range(0, len(new), BLOCK_SIZE):
+        offsets.append(len(out))
+        ops, position = diff_block(old, new, start,
+                                   min(start + BLOCK_SIZE, len(new)), index,
+                                   position)
+        out += serialize(ops)
+
+    return bytes(out), offsets
+
+
+def apply_patch(old, patch, chunk=244, offset=HEADER_SIZE, staged=b""):
+    """Streaming patcher mirroring src/utilities/delta_patch.hpp.
+
+    A resumed download continues from patch offset with the new image
+    bytes already staged.
+    """
+    if patch[:4] != MAGIC:
+        raise ValueError("missing DLTA magic")
+
+    total, block_size, version, base_size, base_crc = \
+        struct.unpack("<IHHII", patch[4:HEADER_SIZE])
+
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+    if base_size != len(old) or zlib.crc32(old) & 0xFFFFFFFF != base_crc:
+        raise ValueError("patch was made against a different base image")
+
+    out = bytearray(staged)
+    header = bytearray()
+    operation, data_remaining, position = None, 0, None
+    sizes = {COPY: 3, MODIFY: 3, INSERT: 3, SEEK: 5}
+
+    # Feed the patch in characteristic-sized pieces like the peer would
+    for piece_start in range(offset, len(patch), chunk):
+        piece = patch[piece_start:piece_start + chunk]
+        i = 0
+
+        while i < len(piece) and len(out) < total:
+            if data_remaining:
+                count = min(data_remaining, len(piece) - i)
+                out += piece[i:i + count]
+                if operation == MODIFY:
+                    position += count
+                i += count
+                data_remaining -= count
+                continue
+
+            header.append(piece[i])
+            i += 1
+
+            if header[0] not in sizes:
+                raise ValueError("unknown opcode %d" % header[0])
+            if len(header) < sizes[header[0]]:
+                continue
+
+            operation, header = header[0], header[1:]
+
+            if operation == SEEK:
+                position = struct.unpack("<I", header)[0]
+                header = bytearray()
+                continue
+
+            length = struct.unpack("<H", header)[0]
+            header = bytearray()
+            in_block = block_size - len(out) % block_size
+
+            if length == 0 or length > min(in_block, total - len(out)):
+                raise ValueError("operation crosses a block at %d" % len(out))
+
+            if operation == INSERT:
+                data_remaining = length
+            elif position is None or position + length > len(old):
+                raise ValueError("base range out of bounds at %d" % len(out))
+            elif operation == MODIFY:
+                data_remaining = length
+            else:
+                out += old[position:position + length]
+                position += length
+
+            if len(out) % block_size == 0 and not data_remaining:
+                position = None
+
+    return bytes(out)
+
+
+def lzss_size(image):
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                        "compress-ota-image.py")
+    spec = importlib.util.spec_from_file_location("compress_ota_image", path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return len(module.compress(image)[0])
+
+
+def synthetic_images(size=384 * 1024, seed=2025):
+    """Old and new images resembling a small firmware change."""
+    rng = random.Random(seed)
+
+    # Code-like content: a limited vocabulary of 4-byte words
+    words = [rng.getrandbits(32).to_bytes(4, "little") for _ in range(4096)]
+    old = bytearray(b"".join(rng.choice(words) for _ in range(size // 4)))
+
+    new = bytearray(old)
+    # A function grows by 1 KB in the middle of the image...
+    middle = size // 2
+    new[middle:middle] = bytes(rng.getrandbits(8) for _ in range(1024))
+    # ...which moves every address after it (sparse pointer updates)
+    for offset in range(middle + 1024, len(new) - 4, 512):
+        new[offset:offset + 4] = (struct.unpack_from("<I", new, offset)[0] +
+                                  1024 & 0xFFFFFFFF).to_bytes(4, "little")
+    # ...and a few KB of rewritten code and data
+    for offset in (0x1000, 0x2A000, 0x4F000):
+        new[offset:offset + 1024] = bytes(rng.getrandbits(8)
+                                          for _ in range(1024))
+
+    return bytes(old), bytes(new[:size])
+
+
+def report(old, new, patch, offsets, kbps):
+    compressed = lzss_size(new)
+
+    print("base (old):       %d bytes, CRC-32 0x%08x" %
+          (len(old), zlib.crc32(old) & 0xFFFFFFFF))
+    print("new:              %d bytes, CRC-32 0x%08x" %
+          (len(new), zlib.crc32(new) & 0xFFFFFFFF))
+    print("bytes on air:")
+    for name, size in (("raw", len(new)), ("lzss", compressed),
+                       ("delta", len(patch))):
+        print("  %-6s %8d bytes (%5.1f%%) %7.1f s at %.1f KB/s" %
+              (name, size, 100.0 * size / max(len(new), 1),
+               size / (kbps * 1000), kbps))
+    print("download size:    %d (new image)" % len(new))
+    print("block offsets:    %s" % " ".join("%d" % o for o in offsets))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Make a delta OTA image against the running image")
+    parser.add_argument("old", nargs="?", help="image in the primary slot")
+    parser.add_argument("new", nargs="?", help="new (signed) OTA image")
+    parser.add_argument("-o", "--output",
+                        help="delta image (default: <new>.dlta)")
+    parser.add_argument("--kbps", type=float, default=6.0,
+                        help="OTA throughput in KB/s for the estimate")
+    parser.add_argument("--self-test", action="store_true",
+                        help="use synthetic images instead of files")
+    args = parser.parse_args()
+
+    if args.self_test:
+        old, new = synthetic_images()
+    elif args.old and args.new:
+        with open(args.old, "rb") as f:
+            old = f.read()
+        with open(args.new, "rb") as f:
+            new = f.read()
+    else:
+        parser.error("old and new images are required without --self-test")
+
+    patch, offsets = make_patch(old, new)
+
+    if apply_patch(old, patch) != new:
+        sys.exit("round trip through the streaming patcher failed")
+
+    # A block must also apply on its own, as after a resume
+    for block in (len(offsets) // 2, len(offsets) - 1):
+        staged = new[:block * BLOCK_SIZE]
+        if apply_patch(old, patch, offset=offsets[block],
+                       staged=staged) != new:
+            sys.exit("resume at block %d failed" % block)
+
+    report(old, new, patch, offsets, args.kbps)
+
+    if args.self_test:
+        print("self test:        passed")
+        return
+
+    output = args.output or args.new + ".dlta"
+
+    with open(output, "wb") as f:
+        f.write(patch)
+
+    print("written:          %s" % output)
+
+
+if __name__ == "__main__":
+    main()
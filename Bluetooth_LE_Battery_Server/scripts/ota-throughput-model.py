@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+
+##
+## USAGE:
+## Invoke while in the Bluetooth_LE_Battery_Server directory.
+##
+## % pwd
+## /path/to/mtb-bluetooth-le-battery-server/Bluetooth_LE_Battery_Server
+##
+## # Compare the GATT and L2CAP OTA data paths for a 384 KiB image
+## % ./scripts/ota-throughput-model.py
+##
+## # Use a real image and the link parameters negotiated by the peer
+## % ./scripts/ota-throughput-model.py --image image.bin --interval-ms 15 \
+##       --packets-per-event 4 --phy 1M
+##
+## Simulates the link layer of a download packet by packet. The GATT path
+## sends one Write Without Response per ATT MTU - 3 image bytes; the L2CAP
+## path sends SDUs sized to fill whole K-frames of the MPS
+## (src/bluetooth/ota_l2cap_channel.hpp), i.e. n * MPS - 2 image bytes for
+## the largest n that fits the channel MTU. Every L2CAP PDU is
+## fragmented into LL data packets of at most --ll-payload bytes, and each
+## connection event carries as many packets as fit in the connection
+## interval, up to --packets-per-event. Credits and flash writes are assumed
+## never to stall the peer; compare the result with the "effective_kbps" of
+## the ota_staging and ota_l2cap JSON lines printed on the device.
+##
+
+import argparse
+import os
+import sys
+
+L2CAP_HEADER = 4  # Length + channel ID
+ATT_WRITE_HEADER = 3  # Opcode + handle
+SDU_LENGTH_FIELD = 2  # First K-frame of each SDU
+OTA_L2CAP_MPS = 247
+
+T_IFS_US = 150
+LL_OVERHEAD = {"1M": 1 + 4 + 2 + 3, "2M": 2 + 4 + 2 + 3}  # Preamble..CRC
+US_PER_BYTE = {"1M": 8, "2M": 4}
+MIC = 4
+
+
+def sdu_size(mtu):
+    """Largest SDU within the channel MTU that fills whole K-frames."""
+    frames = max(1, (mtu + SDU_LENGTH_FIELD) // OTA_L2CAP_MPS)
+
+    return min(mtu, frames * OTA_L2CAP_MPS - SDU_LENGTH_FIELD)
+
+
+def l2cap_pdus(path, image_size, mtu):
+    """Yield the payload length of every L2CAP PDU (K-frame) of a download."""
+    remaining = image_size
+
+    while remaining > 0:
+        if path == "gatt":
+            data = min(mtu - ATT_WRITE_HEADER, remaining)
+            yield ATT_WRITE_HEADER + data
+        else:
+            data = min(sdu_size(mtu), remaining)
+            sdu = SDU_LENGTH_FIELD + data
+
+            while sdu > 0:
+                frame = min(OTA_L2CAP_MPS, sdu)
+                yield frame
+                sdu -= frame
+
+        remaining -= data
+
+
+def simulate(path, image_size, mtu, args):
+    """Return (LL packets, connection events, seconds) for one download."""
+    per_byte = US_PER_BYTE[args.phy]
+    overhead = LL_OVERHEAD[args.phy]
+    mic = MIC if args.encrypted else 0
+    empty_us = overhead * per_byte  # Acknowledging empty packet
+    interval_us = args.interval_ms * 1000
+
+    packets = []
+
+    for pdu in l2cap_pdus(path, image_size, mtu):
+        pdu += L2CAP_HEADER
+
+        while pdu > 0:
+            payload = min(args.ll_payload, pdu)
+            packets.append(payload)
+            pdu -= payload
+
+    events = 0
+    index = 0
+
+    while index < len(packets):
+        events += 1
+        used_us = 0
+        sent = 0
+
+        while index < len(packets) and sent < args.packets_per_event:
+            exchange_us = ((overhead + packets[index] + mic) * per_byte +
+                           T_IFS_US + empty_us + T_IFS_US)
+
+            if sent > 0 and used_us + exchange_us > interval_us:
+                break
+
+            used_us += exchange_us
+            sent += 1
+            index += 1
+
+    return len(packets), events, events * interval_us / 1e6
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Model OTA throughput of the GATT and L2CAP data paths")
+    parser.add_argument("--image", help="image file (default: --size bytes)")
+    parser.add_argument("--size", type=int, default=384 * 1024,
+                        help="image size in bytes without --image")
+    parser.add_argument("--mtu", type=int, nargs="+", default=[247, 517],
+                        help="ATT MTU and L2CAP channel MTU to compare")
+    parser.add_argument("--interval-ms", type=float, default=7.5,
+                        help="connection interval in milliseconds")
+    parser.add_argument("--packets-per-event", type=int, default=6,
+                        help="LL data packets the peer sends per event")
+    parser.add_argument("--ll-payload", type=int, default=251,
+                        help="LL data length (27 without DLE, 251 with)")
+    parser.add_argument("--phy", choices=("1M", "2M"), default="2M")
+    parser.add_argument("--encrypted", action="store_true",
+                        help="add the 4-byte MIC to every data packet")
+    args = parser.parse_args()
+
+    image_size = os.path.getsize(args.image) if args.image else args.size
+
+    if image_size <= 0:
+        sys.exit("image is empty")
+
+    print(f"image {image_size} bytes, {args.phy} PHY, interval "
+          f"{args.interval_ms} ms, {args.packets_per_event} packets/event, "
+          f"LL payload {args.ll_payload}")
+    print(f"{'path':<6} {'mtu':>4} {'packets':>8} {'events':>7} "
+          f"{'seconds':>8} {'KB/s':>7} {'payload %':>9}")
+
+    for mtu in args.mtu:
+        for path in ("gatt", "l2cap"):
+            packets, events, seconds = simulate(path, image_size, mtu, args)
+            on_air = sum(
+                pdu + L2CAP_HEADER
+                for pdu in l2cap_pdus(path, image_size, mtu))
+
+            print(f"{path:<6} {mtu:>4} {packets:>8} {events:>7} "
+                  f"{seconds:>8.2f} {image_size / seconds / 1000:>7.1f} "
+                  f"{100 * image_size / on_air:>9.1f}")
+
+
+if __name__ == "__main__":
+    main()
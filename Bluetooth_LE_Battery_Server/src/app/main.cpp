@@ -40,7 +40,9 @@ extern "C" {
 #pragma GCC diagnostic pop
 
 ///< Tasks
+#include "app_event_task.hpp"
 #include "battery_service_task.hpp"
+#include "ota_writer_task.hpp"
 
 ///< Utilities
 #include "utilities.hpp"
@@ -65,6 +67,18 @@ static inline void create_tasks() {
     if (rtos_result != pdPASS) {
         cy_log_msg(CYLF_DEF, CY_LOG_ERR, "BAS task creation failed\n");
     }
+
+    rtos_result = app_event_task_create();
+
+    if (rtos_result != pdPASS) {
+        cy_log_msg(CYLF_DEF, CY_LOG_ERR, "App event task creation failed\n");
+    }
+
+    rtos_result = ota_writer_task_create();
+
+    if (rtos_result != pdPASS) {
+        cy_log_msg(CYLF_DEF, CY_LOG_ERR, "OTA writer task creation failed\n");
+    }
 }
 
 ///
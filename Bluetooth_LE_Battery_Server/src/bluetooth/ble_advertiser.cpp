@@ -0,0 +1,255 @@
+///
+/// \file    ble_advertiser.cpp
+/// \brief   Advertising scheduler implementation
+///
+/// \details This file implements the advertising scheduler: the step timer,
+///          the user button, the advertising mode of each step and the JSON
+///          report of the schedule.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Advertising scheduler
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyabs_rtos.h"
+#include "cybsp.h"
+#include "cyhal.h"
+#include "cyhal_gpio.h"
+
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+}
+#pragma GCC diagnostic pop
+
+#include "app_event_task.hpp"
+#include "ble_advertiser.hpp"
+#include "ble_context.hpp"
+#include "utilities.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+///
+/// \brief Interrupt priority of the user button
+///
+constexpr auto BLE_ADVERTISER_BUTTON_PRIORITY = uint8_t{7};
+
+///
+/// \brief Delay before posting a step again when the event queue was full
+///
+constexpr auto BLE_ADVERTISER_POST_RETRY_MS = uint32_t{10};
+
+///
+/// \brief Get the JSON name of an advertising mode
+///
+static const char *advertising_mode_name(ble_advertising_mode mode) {
+    switch (mode) {
+    case ble_advertising_mode::directed:
+        return "directed";
+    case ble_advertising_mode::fast:
+        return "fast";
+    case ble_advertising_mode::slow:
+        return "slow";
+    default:
+        return "off";
+    }
+}
+
+cy_rslt_t ble_advertiser::initialize() noexcept {
+    auto result = cy_rtos_init_timer(
+        &m_timer, cy_timer_trigger_type_t::CY_TIMER_TYPE_ONCE, timer_callback,
+        this);
+
+    if (result != CY_RSLT_SUCCESS) {
+        return result;
+    }
+
+    result = cyhal_gpio_init(CYBSP_USER_BTN, CYHAL_GPIO_DIR_INPUT,
+                             CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF);
+
+    if (result != CY_RSLT_SUCCESS) {
+        return result;
+    }
+
+    m_button_callback.callback = button_callback;
+    m_button_callback.callback_arg = this;
+
+    cyhal_gpio_register_callback(CYBSP_USER_BTN, &m_button_callback);
+    cyhal_gpio_enable_event(CYBSP_USER_BTN, CYHAL_GPIO_IRQ_FALL,
+                            BLE_ADVERTISER_BUTTON_PRIORITY, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+wiced_result_t ble_advertiser::restart() noexcept {
+    if (ble_context_object.connection_count() >= BLE_MAX_CONNECTIONS) {
+        // A new peer would be refused anyway
+        stop();
+        return wiced_result_t::WICED_BT_SUCCESS;
+    }
+
+    // A bonded peer still connected needs no directed advertising
+    const auto connected = ble_context_object.connected();
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    m_directed = m_peer_known && !connected;
+    m_step = ble_advertising_first_step(m_directed);
+    ++m_restarts;
+
+    const auto step = m_step;
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    print_json();
+
+    return enter(step);
+}
+
+void ble_advertiser::stop() noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    m_step = STOPPED;
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    cy_rtos_stop_timer(&m_timer);
+    wiced_bt_start_advertisements(
+        wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_OFF, 0, nullptr);
+}
+
+void ble_advertiser::timer_expired() noexcept {
+    auto step = STOPPED;
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    // A restart or stop since the timer was started leaves the expiry stale
+    if (m_step != STOPPED && now_ms() - m_step_started_ms >=
+                                 BLE_ADVERTISING_SCHEDULE[m_step].duration_ms) {
+        m_step = ble_advertising_next_step(m_step);
+        step = m_step;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (step != STOPPED) {
+        enter(step);
+    }
+}
+
+void ble_advertiser::paired(
+    const wiced_bt_dev_pairing_cplt_t &pairing) noexcept {
+    const auto &info = pairing.pairing_complete_info.ble;
+
+    if (info.status != wiced_result_t::WICED_BT_SUCCESS) {
+        return;
+    }
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    // Directed advertising goes to the identity address; the controller
+    // resolves the peer's private addresses
+    m_peer_known = true;
+    m_peer_address_type = info.resolved_bd_addr_type;
+    std::copy_n(info.resolved_bd_addr, BD_ADDR_LEN, m_peer_address);
+
+    cyhal_system_critical_section_exit(interrupt_status);
+}
+
+void ble_advertiser::print_json() const noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    const auto step = m_step;
+    const auto directed = m_directed;
+    const auto restarts = m_restarts;
+    const auto steps = m_steps;
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    const auto mode = (step != STOPPED) ? BLE_ADVERTISING_SCHEDULE[step].mode
+                                        : ble_advertising_mode::off;
+
+    std::printf("{\"ble_advertising\":{\"step\":%u,\"mode\":\"%s\","
+                "\"directed\":%s,\"restarts\":%lu,\"steps\":%lu,"
+                "\"radio_on_ms_per_hour\":%lu}}\n",
+                static_cast<unsigned>(step), advertising_mode_name(mode),
+                directed ? "true" : "false",
+                static_cast<unsigned long>(restarts),
+                static_cast<unsigned long>(steps),
+                static_cast<unsigned long>(ble_advertising_radio_on_ms(
+                    directed, BLE_ADVERTISING_HOUR_MS)));
+}
+
+wiced_result_t ble_advertiser::enter(std::size_t step) noexcept {
+    const auto &entry = BLE_ADVERTISING_SCHEDULE[step];
+    wiced_bt_device_address_t peer_address{};
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    m_step_started_ms = now_ms();
+    ++m_steps;
+
+    const auto peer_address_type = m_peer_address_type;
+    std::copy_n(m_peer_address, BD_ADDR_LEN, peer_address);
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    auto result = wiced_result_t::WICED_BT_SUCCESS;
+
+    switch (entry.mode) {
+    case ble_advertising_mode::directed:
+        result = wiced_bt_start_advertisements(
+            wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_DIRECTED_HIGH,
+            peer_address_type, peer_address);
+        break;
+
+    case ble_advertising_mode::fast:
+        result = wiced_bt_start_advertisements(
+            wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0,
+            nullptr);
+        break;
+
+    case ble_advertising_mode::slow:
+        result = wiced_bt_start_advertisements(
+            wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_UNDIRECTED_LOW, 0,
+            nullptr);
+        break;
+
+    default:
+        result = wiced_bt_start_advertisements(
+            wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_OFF, 0, nullptr);
+        break;
+    }
+
+    // Restarts the timer if it is already running
+    cy_rtos_start_timer(&m_timer, entry.duration_ms);
+
+    return result;
+}
+
+uint32_t ble_advertiser::now_ms() noexcept {
+    auto time_ms = cy_time_t{};
+    cy_rtos_get_time(&time_ms);
+
+    return static_cast<uint32_t>(time_ms);
+}
+
+void ble_advertiser::timer_callback(cy_timer_callback_arg_t argument) {
+    auto *advertiser = static_cast<ble_advertiser *>(argument);
+
+    if (!app_event_post({app_event_type::advertising_step, 0})) {
+        // A lost step would leave the current mode running forever
+        cy_rtos_start_timer(&advertiser->m_timer,
+                            BLE_ADVERTISER_POST_RETRY_MS);
+    }
+}
+
+void ble_advertiser::button_callback(void *argument,
+                                     cyhal_gpio_event_t event) {
+    util::unused(argument);
+    util::unused(event);
+
+    // Bounces post a few restarts; each starts the same schedule
+    app_event_post_from_isr({app_event_type::advertising_restart, 0});
+}
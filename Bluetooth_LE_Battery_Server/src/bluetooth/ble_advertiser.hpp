@@ -0,0 +1,139 @@
+///
+/// \file    ble_advertiser.hpp
+/// \brief   Advertising backoff scheduler
+///
+/// \details This header provides the advertiser, which walks through
+///          BLE_ADVERTISING_SCHEDULE (see ble_advertising_schedule.hpp)
+///          instead of advertising at the high duty cycle until somebody
+///          connects. The schedule restarts on disconnection, on a new
+///          connection while the connection table has room, on a press of
+///          the user button and when an OTA download is aborted, and stops
+///          while the connection table is full.
+///
+///          The stack's own advertising timeouts are disabled in design.cybt
+///          so that the schedule alone decides when to step down. The last
+///          bonded peer is remembered until reset only, since bonding keys
+///          are not stored.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Advertising scheduler
+///
+
+#ifndef BLE_ADVERTISER_HPP
+#define BLE_ADVERTISER_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyabs_rtos.h"
+#include "cyhal_gpio.h"
+
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_advertising_schedule.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Advertising scheduler
+///
+/// restart() and stop() are called on the Bluetooth stack thread and on the
+/// application event task; the state is only touched inside critical
+/// sections.
+///
+class ble_advertiser final {
+public:
+    ///
+    /// \brief Create the step timer and enable the user button
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or the RTOS abstraction or GPIO
+    ///         error
+    ///
+    cy_rslt_t initialize() noexcept;
+
+    ///
+    /// \brief Start the schedule from its first step
+    ///
+    /// Starts with directed advertising if a bonded peer is known and
+    /// nothing is connected.
+    ///
+    /// \return wiced_result_t Result of starting the first step
+    ///
+    wiced_result_t restart() noexcept;
+
+    ///
+    /// \brief Stop advertising until the next restart()
+    ///
+    void stop() noexcept;
+
+    ///
+    /// \brief Move to the next step when the step timer expires
+    ///
+    /// Called on the application event task.
+    ///
+    void timer_expired() noexcept;
+
+    ///
+    /// \brief Remember the peer of a completed pairing (stack thread)
+    ///
+    /// \param pairing Pairing outcome reported by the stack
+    ///
+    void paired(const wiced_bt_dev_pairing_cplt_t &pairing) noexcept;
+
+    ///
+    /// \brief Print the schedule state and estimated radio-on time per hour
+    ///        as one JSON object on the debug UART
+    ///
+    void print_json() const noexcept;
+
+private:
+    ///
+    /// \brief Start advertising as a step requires, and its timer
+    ///
+    wiced_result_t enter(std::size_t step) noexcept;
+
+    ///
+    /// \brief Read the RTOS time in milliseconds
+    ///
+    static uint32_t now_ms() noexcept;
+
+    ///
+    /// \brief Step timer callback (RTOS timer task)
+    ///
+    static void timer_callback(cy_timer_callback_arg_t argument);
+
+    ///
+    /// \brief User button callback (interrupt)
+    ///
+    static void button_callback(void *argument, cyhal_gpio_event_t event);
+
+    /// Step index while the schedule is stopped
+    static constexpr auto STOPPED = BLE_ADVERTISING_SCHEDULE.size();
+
+    std::size_t m_step{STOPPED}; ///< Current step, or STOPPED
+    uint32_t m_step_started_ms{}; ///< Time the current step started
+    bool m_directed{};            ///< Schedule started with directed
+
+    bool m_peer_known{}; ///< A bonded peer address is recorded
+    wiced_bt_ble_address_type_t m_peer_address_type{}; ///< Peer address type
+    wiced_bt_device_address_t m_peer_address{};        ///< Peer identity
+
+    uint32_t m_restarts{}; ///< Schedule restarts
+    uint32_t m_steps{};    ///< Steps entered
+
+    cy_timer_t m_timer{}; ///< One-shot timer of the current step
+
+    cyhal_gpio_callback_data_t m_button_callback{}; ///< User button handler
+};
+
+///
+/// \brief Global advertiser instance
+///
+inline auto ble_advertiser_object = ble_advertiser{};
+
+#endif /* BLE_ADVERTISER_HPP */
@@ -0,0 +1,224 @@
+///
+/// \file    ble_advertising_schedule.hpp
+/// \brief   Advertising backoff schedule and radio-on time estimate
+///
+/// \details This header provides the schedule the advertiser walks through
+///          after every restart: high duty cycle directed advertising to the
+///          last bonded peer (when known), fast undirected advertising, slow
+///          undirected advertising, then short slow bursts separated by
+///          pauses for as long as nobody connects. The fast and slow
+///          intervals are those of design.cybt; the step durations and the
+///          repeating tail are set here.
+///
+///          The schedule is plain constexpr data, as is the estimate of the
+///          radio-on time it costs per hour, so both can be checked on a
+///          host and the estimate is checked against permanent fast
+///          advertising at compile time.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Advertising schedule
+///
+
+#ifndef BLE_ADVERTISING_SCHEDULE_HPP
+#define BLE_ADVERTISING_SCHEDULE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief How the device advertises during one step
+///
+enum class ble_advertising_mode : uint8_t {
+    off,      ///< Not advertising
+    directed, ///< High duty cycle directed to the last bonded peer
+    fast,     ///< Undirected, high duty cycle interval
+    slow      ///< Undirected, low duty cycle interval
+};
+
+///
+/// \brief One step of the schedule
+///
+struct ble_advertising_step {
+    ble_advertising_mode mode; ///< Advertising during the step
+    uint32_t duration_ms;      ///< Time until the next step
+};
+
+///
+/// \brief Longest high duty cycle directed advertising allowed by the spec
+///
+constexpr auto BLE_ADVERTISING_DIRECTED_MAX_MS = uint32_t{1280};
+
+///
+/// \brief Steps taken after a restart, in order
+///
+/// Step 0 is skipped when no bonded peer is known. After the last step the
+/// schedule continues at BLE_ADVERTISING_REPEAT_STEP.
+///
+constexpr auto BLE_ADVERTISING_SCHEDULE = std::array<ble_advertising_step, 5>{{
+    {ble_advertising_mode::directed, BLE_ADVERTISING_DIRECTED_MAX_MS},
+    {ble_advertising_mode::fast, 30 * 1000},
+    {ble_advertising_mode::slow, 5 * 60 * 1000},
+    {ble_advertising_mode::slow, 10 * 1000},
+    {ble_advertising_mode::off, 50 * 1000},
+}};
+
+///
+/// \brief First step of the repeating tail of the schedule
+///
+constexpr auto BLE_ADVERTISING_REPEAT_STEP = std::size_t{3};
+
+///
+/// \brief Get the first step after a restart
+///
+/// \param directed true if a bonded peer is known and nothing is connected
+///
+constexpr std::size_t ble_advertising_first_step(bool directed) noexcept {
+    return (directed || BLE_ADVERTISING_SCHEDULE[0].mode !=
+                            ble_advertising_mode::directed)
+               ? 0
+               : 1;
+}
+
+///
+/// \brief Get the step that follows another
+///
+constexpr std::size_t ble_advertising_next_step(std::size_t step) noexcept {
+    return (step + 1 < BLE_ADVERTISING_SCHEDULE.size())
+               ? step + 1
+               : BLE_ADVERTISING_REPEAT_STEP;
+}
+
+///
+/// \brief Advertising interval of the fast mode (HostHighAdvInterval)
+///
+constexpr auto BLE_ADVERTISING_FAST_INTERVAL_US = uint32_t{30 * 1000};
+
+///
+/// \brief Advertising interval of the slow mode (HostLowAdvInterval)
+///
+constexpr auto BLE_ADVERTISING_SLOW_INTERVAL_US = uint32_t{1280 * 1000};
+
+///
+/// \brief Longest event spacing of high duty cycle directed advertising
+///
+constexpr auto BLE_ADVERTISING_DIRECTED_INTERVAL_US = uint32_t{3750};
+
+///
+/// \brief Mean random delay the link layer adds to undirected intervals
+///
+constexpr auto BLE_ADVERTISING_MEAN_DELAY_US = uint32_t{5000};
+
+///
+/// \brief Estimated radio-on time of one advertising event on 1M PHY
+///
+/// Three channels, each costing radio start-up (about 130 us), the PDU on
+/// air (8 us per byte of preamble, access address, header, payload and
+/// CRC), the inter-frame space and the start of a listen for a scan or
+/// connect request.
+///
+/// \param pdu_payload Bytes after the PDU header (ADV_IND: 6-byte address
+///        plus advertising data; ADV_DIRECT_IND: 12)
+///
+constexpr uint32_t ble_advertising_event_us(uint32_t pdu_payload) noexcept {
+    return 3 * (130 + (1 + 4 + 2 + pdu_payload + 3) * 8 + 150 + 50);
+}
+
+///
+/// \brief Estimated radio-on time of one step in microseconds
+///
+/// Undirected events assume a full 31-byte advertising data payload.
+///
+/// \param step Schedule step
+/// \param duration_ms Part of the step to count
+///
+constexpr uint64_t ble_advertising_step_radio_on_us(
+    const ble_advertising_step &step, uint32_t duration_ms) noexcept {
+    const auto duration_us = uint64_t{duration_ms} * 1000;
+
+    switch (step.mode) {
+    case ble_advertising_mode::directed:
+        return duration_us / BLE_ADVERTISING_DIRECTED_INTERVAL_US *
+               ble_advertising_event_us(12);
+    case ble_advertising_mode::fast:
+        return duration_us /
+               (BLE_ADVERTISING_FAST_INTERVAL_US +
+                BLE_ADVERTISING_MEAN_DELAY_US) *
+               ble_advertising_event_us(6 + 31);
+    case ble_advertising_mode::slow:
+        return duration_us /
+               (BLE_ADVERTISING_SLOW_INTERVAL_US +
+                BLE_ADVERTISING_MEAN_DELAY_US) *
+               ble_advertising_event_us(6 + 31);
+    default:
+        return 0;
+    }
+}
+
+///
+/// \brief Estimated radio-on time spent advertising after a restart
+///
+/// \param directed true if the schedule starts with directed advertising
+/// \param window_ms Time after the restart to count (nobody connects)
+///
+/// \return uint32_t Radio-on time in milliseconds
+///
+constexpr uint32_t ble_advertising_radio_on_ms(bool directed,
+                                               uint32_t window_ms) noexcept {
+    auto radio_on_us = uint64_t{};
+    auto step = ble_advertising_first_step(directed);
+
+    while (window_ms > 0) {
+        const auto &entry = BLE_ADVERTISING_SCHEDULE[step];
+        const auto duration_ms =
+            (entry.duration_ms < window_ms) ? entry.duration_ms : window_ms;
+
+        radio_on_us += ble_advertising_step_radio_on_us(entry, duration_ms);
+        window_ms -= duration_ms;
+        step = ble_advertising_next_step(step);
+    }
+
+    return static_cast<uint32_t>(radio_on_us / 1000);
+}
+
+///
+/// \brief One hour in milliseconds
+///
+constexpr auto BLE_ADVERTISING_HOUR_MS = uint32_t{60 * 60 * 1000};
+
+///
+/// \brief Check the schedule: non-empty steps, directed advertising only
+///        first and within the spec limit, and an advertising repeating tail
+///
+constexpr bool ble_advertising_schedule_valid() noexcept {
+    auto advertises = false;
+
+    for (auto i = std::size_t{}; i < BLE_ADVERTISING_SCHEDULE.size(); i++) {
+        const auto &step = BLE_ADVERTISING_SCHEDULE[i];
+
+        if (step.duration_ms == 0 ||
+            (step.mode == ble_advertising_mode::directed &&
+             (i != 0 || step.duration_ms > BLE_ADVERTISING_DIRECTED_MAX_MS))) {
+            return false;
+        }
+
+        advertises = advertises || (i >= BLE_ADVERTISING_REPEAT_STEP &&
+                                    step.mode != ble_advertising_mode::off);
+    }
+
+    return BLE_ADVERTISING_REPEAT_STEP < BLE_ADVERTISING_SCHEDULE.size() &&
+           advertises;
+}
+
+static_assert(ble_advertising_schedule_valid(),
+              "Invalid advertising schedule");
+
+static_assert(ble_advertising_radio_on_ms(true, BLE_ADVERTISING_HOUR_MS) * 10 <
+                  ble_advertising_step_radio_on_us(
+                      {ble_advertising_mode::fast, BLE_ADVERTISING_HOUR_MS},
+                      BLE_ADVERTISING_HOUR_MS) /
+                      1000,
+              "Advertising schedule saves less than 90% of fast advertising");
+
+#endif /* BLE_ADVERTISING_SCHEDULE_HPP */
@@ -0,0 +1,102 @@
+///
+/// \file    ble_battery_broadcast.cpp
+/// \brief   Battery broadcast implementation
+///
+/// \details This file implements the battery broadcast: packing the static
+///          advertising data of design.cybt around the Battery Service data,
+///          rewriting the advertising data when the level changes and the
+///          JSON report of the payload.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Battery broadcast
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gap.h"
+
+#include "wiced_bt_ble.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_battery_broadcast.hpp"
+
+#include <cstdio>
+
+wiced_result_t ble_battery_broadcast::start(uint8_t level) noexcept {
+    if (!BLE_BATTERY_BROADCAST) {
+        return wiced_bt_ble_set_raw_advertisement_data(
+            CY_BT_ADV_PACKET_DATA_SIZE, cy_bt_adv_packet_data);
+    }
+
+    m_service_data = ble_battery_service_data_encode(level, m_sequence);
+
+    auto service_data = wiced_bt_ble_advert_elem_t{};
+    service_data.advert_type = static_cast<wiced_bt_ble_advert_type_t>(
+        BLE_AD_TYPE_SERVICE_DATA_16);
+    service_data.len = static_cast<uint16_t>(m_service_data.size());
+    service_data.p_data = m_service_data.data();
+
+    // Every copy of the service data element points at m_service_data, so
+    // later updates only rewrite those bytes
+    m_payload = ble_advertising_pack<CAPACITY>(
+        cy_bt_adv_packet_data, CY_BT_ADV_PACKET_DATA_SIZE, service_data);
+
+    if (m_payload.scan_response_count != 0) {
+        wiced_bt_ble_set_raw_scan_response_data(
+            static_cast<uint8_t>(m_payload.scan_response_count),
+            m_payload.scan_response.data());
+    }
+
+    const auto result = wiced_bt_ble_set_raw_advertisement_data(
+        static_cast<uint8_t>(m_payload.advertising_count),
+        m_payload.advertising.data());
+
+    m_level = level;
+    m_started.store(true, std::memory_order_release);
+
+    print_json();
+
+    return result;
+}
+
+void ble_battery_broadcast::update(uint8_t level) noexcept {
+    if (!BLE_BATTERY_BROADCAST ||
+        !m_started.load(std::memory_order_acquire) || level == m_level) {
+        return;
+    }
+
+    ++m_sequence;
+
+    if (publish(level) == wiced_result_t::WICED_BT_SUCCESS) {
+        ++m_updates;
+    } else {
+        ++m_failures;
+    }
+}
+
+void ble_battery_broadcast::print_json() const noexcept {
+    std::printf("{\"ble_broadcast\":{\"level\":%u,\"sequence\":%u,"
+                "\"advertising_bytes\":%u,\"scan_response_bytes\":%u,"
+                "\"dropped\":%u,\"updates\":%lu,\"failures\":%lu}}\n",
+                static_cast<unsigned>(m_level),
+                static_cast<unsigned>(m_sequence),
+                static_cast<unsigned>(m_payload.advertising_bytes),
+                static_cast<unsigned>(m_payload.scan_response_bytes),
+                static_cast<unsigned>(m_payload.dropped),
+                static_cast<unsigned long>(m_updates),
+                static_cast<unsigned long>(m_failures));
+}
+
+wiced_result_t ble_battery_broadcast::publish(uint8_t level) noexcept {
+    m_service_data = ble_battery_service_data_encode(level, m_sequence);
+    m_level = level;
+
+    // Takes effect with the next advertising event; advertising keeps
+    // running
+    return wiced_bt_ble_set_raw_advertisement_data(
+        static_cast<uint8_t>(m_payload.advertising_count),
+        m_payload.advertising.data());
+}
@@ -0,0 +1,102 @@
+///
+/// \file    ble_battery_broadcast.hpp
+/// \brief   Connectionless battery level broadcast
+///
+/// \details This header provides the battery broadcast, which carries the
+///          battery level as Battery Service data in every advertisement
+///          (see ble_broadcast_payload.hpp), so gateways can monitor the
+///          device by passive scanning without connecting. When the level
+///          changes the advertising data is rewritten in place; advertising
+///          keeps running on its schedule.
+///
+///          The static AD structures of design.cybt move to the scan
+///          response once the service data leaves too little room in the
+///          advertising data.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Battery broadcast
+///
+
+#ifndef BLE_BATTERY_BROADCAST_HPP
+#define BLE_BATTERY_BROADCAST_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gap.h"
+
+#include "wiced_bt_ble.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_broadcast_payload.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Battery level broadcast in the advertising data
+///
+/// start() runs on the Bluetooth stack thread once the stack is enabled;
+/// update() runs on the battery service task.
+///
+class ble_battery_broadcast final {
+public:
+    ///
+    /// \brief Set the advertising data and scan response
+    ///
+    /// Without BLE_BATTERY_BROADCAST, sets the static advertising data of
+    /// design.cybt only.
+    ///
+    /// \param level Battery level in percent
+    ///
+    /// \return wiced_result_t Result of setting the advertising data
+    ///
+    wiced_result_t start(uint8_t level) noexcept;
+
+    ///
+    /// \brief Rewrite the advertising data if the level changed
+    ///
+    /// Does nothing before start().
+    ///
+    /// \param level Battery level in percent
+    ///
+    void update(uint8_t level) noexcept;
+
+    ///
+    /// \brief Print the payload layout and update counters as one JSON
+    ///        object on the debug UART
+    ///
+    void print_json() const noexcept;
+
+private:
+    /// Static AD structures plus the service data
+    static constexpr auto CAPACITY =
+        std::size_t{CY_BT_ADV_PACKET_DATA_SIZE + 1};
+
+    ///
+    /// \brief Encode the service data and set the advertising data
+    ///
+    wiced_result_t publish(uint8_t level) noexcept;
+
+    ble_advertising_payload<wiced_bt_ble_advert_elem_t, CAPACITY>
+        m_payload{}; ///< Packed AD structures
+
+    ble_battery_service_data m_service_data{}; ///< Service data of m_payload
+
+    std::atomic<bool> m_started{false}; ///< start() completed
+    uint8_t m_level{};                  ///< Level last advertised
+    uint8_t m_sequence{};               ///< Sequence number last advertised
+
+    uint32_t m_updates{};  ///< Advertising data rewrites
+    uint32_t m_failures{}; ///< Rewrites the stack refused
+};
+
+///
+/// \brief Global battery broadcast instance
+///
+inline auto ble_battery_broadcast_object = ble_battery_broadcast{};
+
+#endif /* BLE_BATTERY_BROADCAST_HPP */
@@ -0,0 +1,182 @@
+///
+/// \file    ble_broadcast_payload.hpp
+/// \brief   Battery Service data encoding and advertising payload packing
+///
+/// \details This header provides the pure part of the battery broadcast:
+///          the Battery Service data carried in every advertisement (16-bit
+///          UUID 0x180F, battery level and an optional sequence number) and
+///          the packing of AD structures into the 31-byte advertising data
+///          and scan response. Flags stay first and the service data second,
+///          so passive scanners see the level without a scan request; the
+///          remaining structures keep their order and move to the scan
+///          response once the advertising data is full.
+///
+///          Both work on any element type with wiced_bt_ble_advert_elem_t's
+///          len and advert_type members and are constexpr, so they can be
+///          checked on a host.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Broadcast payload
+///
+
+#ifndef BLE_BROADCAST_PAYLOAD_HPP
+#define BLE_BROADCAST_PAYLOAD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BLE_BATTERY_BROADCAST_ENABLED
+#define BLE_BATTERY_BROADCAST_ENABLED 0
+#endif
+
+///
+/// \brief Broadcast the battery level in the advertising data
+///
+/// Off unless the build sets BATTERY_BROADCAST=1: broadcasting keeps the
+/// battery timer running without subscribers.
+///
+constexpr auto BLE_BATTERY_BROADCAST = (BLE_BATTERY_BROADCAST_ENABLED != 0);
+
+///
+/// \brief Append a sequence number to the battery level
+///
+/// Lets a scanner tell a new measurement from a repeated advertisement.
+///
+constexpr auto BLE_BATTERY_BROADCAST_SEQUENCE = true;
+
+///
+/// \brief Largest legacy advertising data or scan response, in bytes
+///
+constexpr auto BLE_ADVERTISING_DATA_MAX = std::size_t{31};
+
+///
+/// \brief AD type of flags
+///
+constexpr auto BLE_AD_TYPE_FLAGS = uint8_t{0x01};
+
+///
+/// \brief AD type of service data with a 16-bit UUID
+///
+constexpr auto BLE_AD_TYPE_SERVICE_DATA_16 = uint8_t{0x16};
+
+///
+/// \brief Battery Service UUID
+///
+constexpr auto BLE_BATTERY_SERVICE_UUID = uint16_t{0x180F};
+
+///
+/// \brief Battery Service data: UUID, level and optional sequence number
+///
+template <bool Sequence>
+using ble_battery_service_data_of = std::array<uint8_t, Sequence ? 4 : 3>;
+
+///
+/// \brief Battery Service data as configured
+///
+using ble_battery_service_data =
+    ble_battery_service_data_of<BLE_BATTERY_BROADCAST_SEQUENCE>;
+
+///
+/// \brief Encode the Battery Service data of an advertisement
+///
+/// \tparam Sequence Append the sequence number
+///
+/// \param level Battery level in percent (clamped to 100)
+/// \param sequence Sequence number (ignored without \p Sequence)
+///
+/// \return ble_battery_service_data_of UUID (little endian), then the level,
+///         then the sequence number
+///
+template <bool Sequence = BLE_BATTERY_BROADCAST_SEQUENCE>
+constexpr ble_battery_service_data_of<Sequence>
+ble_battery_service_data_encode(uint8_t level, uint8_t sequence) noexcept {
+    auto data = ble_battery_service_data_of<Sequence>{};
+
+    data[0] = static_cast<uint8_t>(BLE_BATTERY_SERVICE_UUID & 0xFF);
+    data[1] = static_cast<uint8_t>(BLE_BATTERY_SERVICE_UUID >> 8);
+    data[2] = (level < 100) ? level : uint8_t{100};
+
+    if constexpr (Sequence) {
+        data[3] = sequence;
+    }
+
+    return data;
+}
+
+///
+/// \brief Bytes an AD structure takes on air (length, type and data)
+///
+/// \param data_length Length of the AD data
+///
+constexpr std::size_t ble_ad_structure_size(std::size_t data_length) noexcept {
+    return data_length + 2;
+}
+
+///
+/// \brief AD structures split between advertising data and scan response
+///
+template <typename Element, std::size_t Capacity>
+struct ble_advertising_payload {
+    std::array<Element, Capacity> advertising;   ///< Advertising data
+    std::size_t advertising_count;               ///< Used advertising
+    std::size_t advertising_bytes;               ///< Advertising data size
+    std::array<Element, Capacity> scan_response; ///< Scan response data
+    std::size_t scan_response_count;             ///< Used scan_response
+    std::size_t scan_response_bytes;             ///< Scan response size
+    std::size_t dropped;                         ///< Fit in neither
+};
+
+///
+/// \brief Pack AD structures with the service data right after the flags
+///
+/// \tparam Capacity Room for \p count elements plus the service data
+///
+/// \param elements Static AD structures, in order
+/// \param count Number of \p elements (at most Capacity - 1)
+/// \param service_data AD structure of the service data
+///
+/// \return ble_advertising_payload Advertising data and scan response
+///
+template <std::size_t Capacity, typename Element>
+constexpr ble_advertising_payload<Element, Capacity>
+ble_advertising_pack(const Element *elements, std::size_t count,
+                     const Element &service_data) noexcept {
+    auto payload = ble_advertising_payload<Element, Capacity>{};
+
+    const auto place = [&payload](const Element &element) {
+        const auto size = ble_ad_structure_size(element.len);
+
+        if (payload.advertising_bytes + size <= BLE_ADVERTISING_DATA_MAX) {
+            payload.advertising[payload.advertising_count++] = element;
+            payload.advertising_bytes += size;
+        } else if (payload.scan_response_bytes + size <=
+                   BLE_ADVERTISING_DATA_MAX) {
+            payload.scan_response[payload.scan_response_count++] = element;
+            payload.scan_response_bytes += size;
+        } else {
+            ++payload.dropped;
+        }
+    };
+
+    for (auto i = std::size_t{}; i < count; i++) {
+        if (static_cast<uint8_t>(elements[i].advert_type) ==
+            BLE_AD_TYPE_FLAGS) {
+            place(elements[i]);
+        }
+    }
+
+    place(service_data);
+
+    for (auto i = std::size_t{}; i < count; i++) {
+        if (static_cast<uint8_t>(elements[i].advert_type) !=
+            BLE_AD_TYPE_FLAGS) {
+            place(elements[i]);
+        }
+    }
+
+    return payload;
+}
+
+#endif /* BLE_BROADCAST_PAYLOAD_HPP */
@@ -13,6 +13,7 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 extern "C" {
+#include "bootutil/bootutil.h"
 #include "cycfg_bt_settings.h"
 #include "cycfg_gap.h"
 #include "cycfg_gatt_db.h"
@@ -47,11 +48,20 @@ extern "C" {
 }
 #pragma GCC diagnostic pop
 
+#include "app_event_task.hpp"
 #include "battery_service_task.hpp"
+#include "ble_advertiser.hpp"
+#include "ble_battery_broadcast.hpp"
 #include "ble_context.hpp"
 #include "ble_gatt.hpp"
+#include "ble_gatt_db.hpp"
+#include "ble_gatt_statistics.hpp"
+#include "ble_link_optimizer.hpp"
 #include "cyhal_pwm_signal.hpp"
 #include "led_pwm.hpp"
+#include "ota_image_decoder.hpp"
+#include "ota_l2cap_channel.hpp"
+#include "ota_staging.hpp"
 #include "pwm_signal.hpp"
 #include "resource.hpp"
 #include "utilities.hpp"
@@ -68,8 +78,9 @@ static auto led_pwm_block = Signal(&resource::led3);
 ///
 /// Initializes the advertising LED PWM, enables pairable mode, configures
 /// advertisement packet data, registers the GATT event callback, initializes
-/// the GATT database, and starts undirected high-duty cycle advertising.
-/// Triggers assertions on failure of critical operations.
+/// the GATT database, registers the OTA L2CAP channel, creates the link
+/// optimizer's policy timer and the advertiser, and starts the advertising
+/// schedule. Triggers assertions on failure of critical operations.
 ///
 /// \return wiced_bt_gatt_status_t GATT status from database initialization,
 ///         typically WICED_BT_GATT_SUCCESS. Critical failures trigger
@@ -77,6 +88,20 @@ static auto led_pwm_block = Signal(&resource::led3);
 ///
 static wiced_bt_gatt_status_t ble_start_advertising();
 
+///
+/// \brief Read a little-endian 32-bit value from an OTA command payload
+///
+/// \param bytes Pointer to the first (least significant) byte
+///
+/// \return uint32_t Decoded value
+///
+static uint32_t read_le32(const uint8_t *bytes) {
+    return static_cast<uint32_t>(bytes[0]) |
+           (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) |
+           (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
 wiced_result_t ble_context::stack_initialize() noexcept {
     default_value_initialize();
 
@@ -102,32 +127,196 @@ wiced_bt_gatt_status_t ble_context::connection_event_handler(
     }
 
     if (connection_status->connected) {
-        m_connection_id = connection_status->conn_id;
+        auto *connection = find_connection(0);
+
+        if (connection == nullptr) {
+            // Connection table full, refuse the peer
+            wiced_bt_gatt_disconnect(connection_status->conn_id);
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        }
+
+        auto interrupt_status = cyhal_system_critical_section_enter();
+
+        *connection = ble_connection{};
+        connection->connection_id = connection_status->conn_id;
+        connection->mtu = BLE_DEFAULT_ATT_MTU;
 
         std::copy_n(connection_status->bd_addr, BD_ADDR_LEN,
-                    m_peer_address.begin());
+                    connection->peer_address.begin());
 
+        cyhal_system_critical_section_exit(interrupt_status);
+
+        m_connection_id = connection_status->conn_id;
         m_connection_state = state::connected;
+
+        // 2M PHY, long LL packets and a short interval for discovery
+        ble_link_optimizer_object.connected(connection_status->conn_id,
+                                            connection_status->bd_addr);
+
+        // Keep accepting peers while the table has room; stops otherwise
+        ble_advertiser_object.restart();
     } else {
-        m_connection_id = 0;
+        // Keep a download interrupted by this disconnect resumable, by any
+        // connection
+        ota_connection_lost(connection_status->conn_id);
+
+        if (m_ota_connection_id == connection_status->conn_id) {
+            m_ota_connection_id = 0;
+        }
+
+        ble_link_optimizer_object.disconnected(connection_status->conn_id);
+
+        if (auto *connection = find_connection(connection_status->conn_id);
+            connection != nullptr) {
+            auto interrupt_status = cyhal_system_critical_section_enter();
+            *connection = ble_connection{};
+            cyhal_system_critical_section_exit(interrupt_status);
+
+            // The peer may have been the last subscriber
+            battery_service_subscription_changed();
+        }
 
-        result = wiced_bt_start_advertisements(
-            wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0,
-            nullptr);
+        if (m_connection_id == connection_status->conn_id) {
+            m_connection_id = 0;
+
+            // Fall back to any peer still connected
+            for (const auto &connection : m_connections) {
+                if (connection.connection_id != 0) {
+                    m_connection_id = connection.connection_id;
+                    break;
+                }
+            }
+        }
+
+        if (!connected()) {
+            // Report the GATT statistics of the finished session
+            ble_gatt_statistics_object.print_json();
+            ble_gatt_statistics_object.reset();
+            app_event_print_json();
+            battery_service_print_json();
+            ble_battery_broadcast_object.print_json();
+        }
+
+        result = ble_advertiser_object.restart();
 
         if (result != wiced_result_t::WICED_BT_SUCCESS) {
             CY_ASSERT(false);
         }
 
-        m_connection_state = state::disconnected_and_advertising;
+        m_connection_state = connected() ? state::connected
+                                         : state::disconnected_and_advertising;
     }
 
-    update_advertising_led();
+    // Reconfiguring the PWM is slow; leave it to the application event task
+    app_event_post({app_event_type::advertising_led_update,
+                    connection_status->conn_id});
     status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
 
     return status;
 }
 
+std::size_t ble_context::connection_count() const noexcept {
+    return static_cast<std::size_t>(
+        std::count_if(m_connections.begin(), m_connections.end(),
+                      [](const ble_connection &connection) {
+                          return connection.connection_id != 0;
+                      }));
+}
+
+ble_connection *ble_context::find_connection(uint16_t connection_id) noexcept {
+    auto it = std::find_if(m_connections.begin(), m_connections.end(),
+                           [connection_id](const ble_connection &connection) {
+                               return connection.connection_id ==
+                                      connection_id;
+                           });
+
+    return (it != m_connections.end()) ? &*it : nullptr;
+}
+
+void ble_context::set_connection_mtu(uint16_t connection_id,
+                                     uint16_t mtu) noexcept {
+    if (auto *connection = find_connection(connection_id);
+        connection != nullptr) {
+        connection->mtu = mtu;
+    }
+}
+
+wiced_bt_gatt_status_t ble_context::set_bas_cccd(uint16_t connection_id,
+                                                 const uint8_t *value,
+                                                 uint16_t length) noexcept {
+    const auto status = check_bas_cccd(connection_id, value, length);
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        return status;
+    }
+
+    auto *connection = find_connection(connection_id);
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    std::copy_n(value, connection->bas_cccd.size(),
+                connection->bas_cccd.begin());
+    ++connection->bas_subscription;
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t
+ble_context::check_bas_cccd(uint16_t connection_id, const uint8_t *value,
+                            uint16_t length) const noexcept {
+    const auto known = std::any_of(
+        m_connections.begin(), m_connections.end(),
+        [connection_id](const ble_connection &connection) {
+            return connection.connection_id == connection_id;
+        });
+
+    if (!known) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    if (value == nullptr || length != sizeof(ble_connection::bas_cccd)) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+std::size_t ble_context::bas_notification_subscribers(
+    std::array<ble_bas_subscriber, BLE_MAX_CONNECTIONS> &subscribers)
+    const noexcept {
+    auto count = std::size_t{};
+
+    // The table is written from the Bluetooth stack thread
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (const auto &connection : m_connections) {
+        if (connection.connection_id != 0 &&
+            (connection.bas_cccd[0] & wiced_bt_gatt_client_char_config_e::
+                                          GATT_CLIENT_CONFIG_NOTIFICATION)) {
+            subscribers[count++] = {
+                connection.connection_id, connection.bas_subscription,
+                connection.bas_first_sent != connection.bas_subscription};
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    return count;
+}
+
+void ble_context::bas_first_value_sent(
+    const ble_bas_subscriber &subscriber) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (auto &connection : m_connections) {
+        if (connection.connection_id == subscriber.connection_id &&
+            connection.bas_subscription == subscriber.subscription) {
+            connection.bas_first_sent = subscriber.subscription;
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+}
+
 cy_rslt_t ble_context::update_advertising_led() noexcept {
     using FrontLED = led_pwm<Signal>;
     using DutyCycle = FrontLED::duty_cycle;
@@ -180,94 +369,404 @@ cy_rslt_t ble_context::ota_agent_initialize() noexcept {
     return result;
 }
 
+wiced_bt_gatt_status_t ble_context::ota_config_descriptor_write_handler(
+    wiced_bt_gatt_event_data_t *event_data, uint16_t *error_handle) noexcept {
+    auto *write_request = &event_data->attribute_request.data.write_req;
+
+    *error_handle = write_request->handle;
+
+    const auto status =
+        check_ota_cccd(write_request->p_val, write_request->val_len);
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        return status;
+    }
+
+    // Save configuration descriptor (Notify & Indicate flags)
+    m_ota_config_descriptor = write_request->p_val[0];
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
 wiced_bt_gatt_status_t
-ble_context::ota_agent_write_handler(wiced_bt_gatt_event_data_t *event_data,
-                                     uint16_t *error_handle) noexcept {
+ble_context::check_ota_cccd(const uint8_t *value,
+                            uint16_t length) const noexcept {
+    if (value == nullptr || length != 2) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t ble_context::ota_control_point_write_handler(
+    wiced_bt_gatt_event_data_t *event_data, uint16_t *error_handle) noexcept {
     auto *write_request = &event_data->attribute_request.data.write_req;
+    const auto connection_id = event_data->attribute_request.conn_id;
 
     cy_rslt_t result = cy_en_rslt_type_t::CY_RSLT_TYPE_ERROR;
 
-    auto gatt_status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
-
     *error_handle = write_request->handle;
 
     CY_ASSERT((event_data != nullptr) && (write_request != nullptr));
 
-    switch (write_request->handle) {
-    case HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG:
-        // Save configuration descriptor (Notify & Indicate flags)
-        m_ota_config_descriptor = write_request->p_val[0];
+    const auto check_status = check_ota_control_point(
+        connection_id, write_request->p_val, write_request->val_len);
 
-        return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+    if (check_status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        return check_status;
+    }
+
+    switch (write_request->p_val[0]) {
+    case CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD:
+        m_ota_connection_id = connection_id;
+
+        // Fastest link for the image; stays so until verify or abort
+        ble_link_optimizer_object.bulk_begin(connection_id);
 
-    case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE:
-        switch (write_request->p_val[0]) {
-        case CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD:
+        // A suspended download keeps its agent and written chunks
+        if (!ota_staging_object.suspended()) {
             // Call application-level OTA initialization
             result = ota_agent_initialize();
 
             if (result != CY_RSLT_SUCCESS) {
                 return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
             }
+        }
 
-            result = cy_ota_ble_download_prepare(m_ota_context, m_connection_id,
-                                                 m_ota_config_descriptor);
+        result = cy_ota_ble_download_prepare(m_ota_context, connection_id,
+                                             m_ota_config_descriptor);
 
-            if (result != CY_RSLT_SUCCESS) {
-                return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
-            }
+        if (result != CY_RSLT_SUCCESS) {
+            m_ota_connection_id = 0;
+            ble_link_optimizer_object.bulk_end(connection_id);
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+        }
 
-            return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
 
-        case CY_OTA_UPGRADE_COMMAND_DOWNLOAD:
-            // Let OTA library know download is starting
-            result =
-                cy_ota_ble_download(m_ota_context, event_data, m_connection_id,
-                                    m_ota_config_descriptor);
+    case CY_OTA_UPGRADE_COMMAND_DOWNLOAD: {
+        // The command carries the total image size (little endian)
+        const auto image_size = (write_request->val_len >= 5)
+                                    ? read_le32(&write_request->p_val[1])
+                                    : uint32_t{};
 
-            if (result != CY_RSLT_SUCCESS) {
-                return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
-            }
+        // The size is that of the complete new image, whatever the format
+        // sent over the air
+        if (image_size != 0 && ota_staging_object.resumable(image_size)) {
+            const auto offset = ota_staging_object.resume(connection_id);
 
-            return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+            ota_image_decoder_object.resume(offset);
 
-        case CY_OTA_UPGRADE_COMMAND_VERIFY:
-            result = cy_ota_ble_download_verify(m_ota_context, event_data,
-                                                m_connection_id);
+            return ota_agent_send_resume_offset(connection_id, offset);
+        }
 
-            if (result != CY_RSLT_SUCCESS) {
-                return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
-            }
+        if (!ota_staging_object.start(m_ota_context, connection_id,
+                                      image_size)) {
+            // Buffers of an aborted image are still being dropped; the peer
+            // retries the command
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_BUSY;
+        }
 
-            return gatt_status;
+        ota_image_decoder_object.reset(image_size);
+        m_ota_image_pending = false;
 
-        case CY_OTA_UPGRADE_COMMAND_ABORT:
-            result = cy_ota_ble_download_abort(m_ota_context);
+        // Let OTA library know download is starting
+        result = cy_ota_ble_download(m_ota_context, event_data, connection_id,
+                                     m_ota_config_descriptor);
 
-            return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        if (result != CY_RSLT_SUCCESS) {
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
         }
 
-        break;
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+    }
 
-    case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE:
-        result = cy_ota_ble_download_write(m_ota_context, event_data);
-        return (result == CY_RSLT_SUCCESS)
-                   ? wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS
-                   : wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    case CY_OTA_UPGRADE_COMMAND_VERIFY:
+        // The session ends here, whatever the outcome
+        m_ota_connection_id = 0;
+        ble_link_optimizer_object.bulk_end(connection_id);
 
-    default:
-        break;
+        // Every staged byte must reach flash before the image is checked;
+        // answer once the writer is done rather than wait for it here
+        ota_staging_object.flush();
+
+        if (!ota_staging_object.idle()) {
+            std::copy_n(write_request->p_val, m_ota_verify_command.size(),
+                        m_ota_verify_command.begin());
+
+            return ota_defer(connection_id,
+                             event_data->attribute_request.opcode,
+                             write_request->handle, OTA_DEFERRED_VERIFY);
+        }
+
+        return ota_verify(event_data);
+
+    case CY_OTA_UPGRADE_COMMAND_ABORT:
+        m_ota_connection_id = 0;
+        ble_link_optimizer_object.bulk_end(connection_id);
+        ota_staging_object.abort();
+        result = cy_ota_ble_download_abort(m_ota_context);
+
+        // The peer usually reconnects to retry; be quick to find
+        ble_advertiser_object.restart();
+
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
     }
 
     return wiced_bt_gatt_status_e::WICED_BT_GATT_REQ_NOT_SUPPORTED;
 }
 
-void ble_context::ota_agent_confirmation_handler() noexcept {
-    auto ota_lib_state = cy_ota_agent_state_t::CY_OTA_STATE_NOT_INITIALIZED;
-    cy_ota_get_state(m_ota_context, &ota_lib_state);
+wiced_bt_gatt_status_t
+ble_context::check_ota_control_point(uint16_t connection_id,
+                                     const uint8_t *value,
+                                     uint16_t length) const noexcept {
+    if (value == nullptr || length == 0) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    if (ota_deferred()) {
+        // The application event task owns the session until it answers
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_BUSY;
+    }
+
+    switch (value[0]) {
+    case CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD:
+    case CY_OTA_UPGRADE_COMMAND_DOWNLOAD:
+    case CY_OTA_UPGRADE_COMMAND_VERIFY:
+    case CY_OTA_UPGRADE_COMMAND_ABORT:
+        break;
+
+    default:
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_REQ_NOT_SUPPORTED;
+    }
+
+    // The image is only accepted against the CRC-32 the peer computed
+    if (value[0] == CY_OTA_UPGRADE_COMMAND_VERIFY && length < 5) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    // One session at a time: only prepare may claim a session nobody owns
+    const auto owner = (value[0] == CY_OTA_UPGRADE_COMMAND_PREPARE_DOWNLOAD &&
+                        m_ota_connection_id == 0)
+                           ? connection_id
+                           : m_ota_connection_id;
+
+    return (connection_id == owner)
+               ? wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS
+               : wiced_bt_gatt_status_e::WICED_BT_GATT_PRC_IN_PROGRESS;
+}
+
+wiced_bt_gatt_status_t
+ble_context::ota_data_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                                    uint16_t *error_handle) noexcept {
+    auto *write_request = &event_data->attribute_request.data.write_req;
+
+    *error_handle = write_request->handle;
+
+    const auto connection_id = event_data->attribute_request.conn_id;
+    const auto status = check_ota_data(connection_id);
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        return status;
+    }
+
+    return ota_stage(connection_id, event_data->attribute_request.opcode,
+                     write_request->handle, write_request->p_val,
+                     write_request->val_len);
+}
+
+wiced_bt_gatt_status_t
+ble_context::check_ota_data(uint16_t connection_id) const noexcept {
+    if (connection_id != m_ota_connection_id) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_PRC_IN_PROGRESS;
+    }
+
+    return ota_deferred() ? wiced_bt_gatt_status_e::WICED_BT_GATT_BUSY
+                          : wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t
+ble_context::ota_data_received(const uint8_t *data,
+                               uint16_t length) noexcept {
+    if (ota_deferred()) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_BUSY;
+    }
+
+    // No ATT request to answer
+    return ota_stage(m_ota_connection_id, wiced_bt_gatt_opcode_t{}, 0, data,
+                     length);
+}
+
+void ble_context::ota_staging_ready_handler() noexcept {
+    const auto work = m_ota_deferred.load();
+
+    if ((work & (OTA_DEFERRED_DATA | OTA_DEFERRED_VERIFY)) == 0) {
+        // Nothing is held back (the writer freed a buffer after the held
+        // data was staged)
+        return;
+    }
+
+    auto status = wiced_bt_gatt_status_t{
+        wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS};
+
+    if (work & OTA_DEFERRED_VERIFY) {
+        if (!ota_staging_object.idle()) {
+            return;
+        }
+
+        auto event_data = wiced_bt_gatt_event_data_t{};
+        auto &request = event_data.attribute_request;
+
+        request.conn_id = m_ota_deferred_connection_id;
+        request.opcode = m_ota_deferred_opcode;
+        request.data.write_req.handle = m_ota_deferred_handle;
+        request.data.write_req.p_val = m_ota_verify_command.data();
+        request.data.write_req.val_len =
+            static_cast<uint16_t>(m_ota_verify_command.size());
+
+        status = ota_verify(&event_data);
+    } else if ((work & OTA_DEFERRED_LOST) == 0) {
+        const auto result = ota_image_decoder_object.retry();
+
+        if (result == CY_RSLT_SUCCESS && ota_image_decoder_object.holding()) {
+            // Still no room; the writer posts again
+            return;
+        }
+
+        status = (result == CY_RSLT_SUCCESS)
+                     ? wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS
+                     : wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    if ((work & OTA_DEFERRED_LOST) == 0 &&
+        m_ota_deferred_opcode == wiced_bt_gatt_opcode_e::GATT_REQ_WRITE) {
+        if (status == wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+            wiced_bt_gatt_server_send_write_rsp(m_ota_deferred_connection_id,
+                                                m_ota_deferred_opcode,
+                                                m_ota_deferred_handle);
+        } else {
+            wiced_bt_gatt_server_send_error_rsp(
+                m_ota_deferred_connection_id, m_ota_deferred_opcode,
+                m_ota_deferred_handle, status);
+        }
+    }
+
+    // Hand the session back to the stack thread, after the disconnect it
+    // left here, however late that came
+    auto state = work;
+    auto lost_handled = false;
+
+    do {
+        if ((state & OTA_DEFERRED_LOST) != 0 && !lost_handled) {
+            ota_staging_object.connection_lost(m_ota_deferred_connection_id);
+            lost_handled = true;
+        }
+    } while (!m_ota_deferred.compare_exchange_weak(state, 0));
+}
+
+wiced_bt_gatt_status_t
+ble_context::ota_defer(uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
+                       uint16_t handle, uint8_t work) noexcept {
+    m_ota_deferred_connection_id = connection_id;
+    m_ota_deferred_opcode = opcode;
+    m_ota_deferred_handle = handle;
 
-    if (ota_lib_state == cy_ota_agent_state_t::CY_OTA_STATE_OTA_COMPLETE &&
-        m_reboot_at_end) {
+    m_ota_deferred.store(work);
+
+    // The writer may have freed a buffer before the work was published
+    app_event_post({app_event_type::ota_staging_ready, connection_id});
+
+    return (opcode == wiced_bt_gatt_opcode_e::GATT_REQ_WRITE)
+               ? wiced_bt_gatt_status_e::WICED_BT_GATT_PENDING
+               : wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t ble_context::ota_stage(uint16_t connection_id,
+                                              wiced_bt_gatt_opcode_t opcode,
+                                              uint16_t handle,
+                                              const uint8_t *data,
+                                              uint16_t length) noexcept {
+    // Acknowledged once decoded and staged; the OTA writer task programs
+    // flash
+    const auto result = ota_image_decoder_object.write(data, length);
+
+    if (result != CY_RSLT_SUCCESS) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    if (ota_image_decoder_object.holding()) {
+        // Every staging buffer is queued for flash: answer once the writer
+        // frees one, which holds the peer back meanwhile
+        return ota_defer(connection_id, opcode, handle, OTA_DEFERRED_DATA);
+    }
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t
+ble_context::ota_verify(wiced_bt_gatt_event_data_t *event_data) noexcept {
+    auto *write_request = &event_data->attribute_request.data.write_req;
+
+    ota_staging_object.print_json();
+    ota_image_decoder_object.print_json();
+    ota_l2cap_channel_object.print_json();
+
+    if (ota_staging_object.result() != CY_RSLT_SUCCESS) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    // The command carries the image CRC-32 (little endian); compare it with
+    // the digest streamed during download
+    if (read_le32(&write_request->p_val[1]) != ota_staging_object.digest()) {
+        cy_ota_ble_download_abort(m_ota_context);
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    // A match already proves every byte in the slot, so the library's
+    // verify would only read the slot back to reach the same answer
+    m_ota_image_pending = (boot_set_pending(0) == 0);
+
+    return m_ota_image_pending ? wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS
+                               : wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+}
+
+void ble_context::ota_connection_lost(uint16_t connection_id) noexcept {
+    auto state = m_ota_deferred.load();
+
+    // While the application event task owns the session it handles the
+    // disconnect of the connection it answers
+    while (state != 0 && connection_id == m_ota_deferred_connection_id) {
+        if (m_ota_deferred.compare_exchange_weak(state,
+                                                 state | OTA_DEFERRED_LOST)) {
+            app_event_post({app_event_type::ota_staging_ready, connection_id});
+            return;
+        }
+    }
+
+    ota_staging_object.connection_lost(connection_id);
+}
+
+wiced_bt_gatt_status_t
+ble_context::ota_agent_send_resume_offset(uint16_t connection_id,
+                                          uint32_t offset) noexcept {
+    // Must stay valid until the stack has transmitted the notification
+    static auto resume_notification = std::array<uint8_t, 5>{};
+
+    resume_notification = {OTA_UPGRADE_STATUS_RESUME,
+                           static_cast<uint8_t>(offset),
+                           static_cast<uint8_t>(offset >> 8),
+                           static_cast<uint8_t>(offset >> 16),
+                           static_cast<uint8_t>(offset >> 24)};
+
+    return wiced_bt_gatt_server_send_notification(
+        connection_id,
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+        static_cast<uint16_t>(resume_notification.size()),
+        resume_notification.data(), nullptr);
+}
+
+void ble_context::ota_agent_confirmation_handler() noexcept {
+    if (m_ota_image_pending && m_reboot_at_end) {
         cy_rtos_delay_milliseconds(1000);
         NVIC_SystemReset();
     } else {
@@ -283,6 +782,8 @@ wiced_bt_dev_status_t ble_context::stack_management_callback(
     wiced_bt_ble_advert_mode_t *advertisement_mode = nullptr;
     wiced_bt_dev_encryption_status_t *encryption_status = nullptr;
 
+    const auto start_cycles = ble_gatt_statistics::cycles();
+
     switch (event) {
     case wiced_bt_management_evt_e::BTM_ENABLED_EVT:
         if (event_data->enabled.status == wiced_result_t::WICED_BT_SUCCESS) {
@@ -331,6 +832,8 @@ wiced_bt_dev_status_t ble_context::stack_management_callback(
         break;
 
     case wiced_bt_management_evt_e::BTM_PAIRING_COMPLETE_EVT:
+        // Target of directed advertising after the next disconnect
+        ble_advertiser_object.paired(event_data->pairing_complete);
         result = wiced_result_t::WICED_BT_SUCCESS;
         break;
 
@@ -363,6 +866,20 @@ wiced_bt_dev_status_t ble_context::stack_management_callback(
         break;
 
     case wiced_bt_management_evt_e::BTM_BLE_CONNECTION_PARAM_UPDATE:
+        ble_link_optimizer_object.parameters_updated(
+            event_data->ble_connection_param_update);
+        result = wiced_result_t::WICED_BT_SUCCESS;
+        break;
+
+    case wiced_bt_management_evt_e::BTM_BLE_PHY_UPDATE_EVT:
+        ble_link_optimizer_object.phy_updated(
+            event_data->ble_phy_update_event);
+        result = wiced_result_t::WICED_BT_SUCCESS;
+        break;
+
+    case wiced_bt_management_evt_e::BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+        ble_link_optimizer_object.data_length_updated(
+            event_data->ble_data_length_update_event);
         result = wiced_result_t::WICED_BT_SUCCESS;
         break;
 
@@ -370,7 +887,7 @@ wiced_bt_dev_status_t ble_context::stack_management_callback(
         advertisement_mode = &event_data->ble_advert_state_changed;
 
         ble_context_object.set_advertising_mode(advertisement_mode);
-        ble_context_object.update_advertising_led();
+        app_event_post({app_event_type::advertising_led_update, 0});
 
         result = wiced_result_t::WICED_BT_SUCCESS;
         break;
@@ -379,6 +896,9 @@ wiced_bt_dev_status_t ble_context::stack_management_callback(
         break;
     }
 
+    app_event_record_callback_cycles(ble_gatt_statistics::cycles() -
+                                     start_cycles);
+
     return result;
 }
 
@@ -387,15 +907,40 @@ static wiced_bt_gatt_status_t ble_start_advertising() {
     auto wiced_result = wiced_result_t::WICED_BT_ERROR;
 
     wiced_bt_set_pairable_mode(true, 0);
-    wiced_bt_ble_set_raw_advertisement_data(CY_BT_ADV_PACKET_DATA_SIZE,
-                                            cy_bt_adv_packet_data);
+
+    // Static advertising data plus the battery level as service data
+    if (ble_battery_broadcast_object.start(app_bas_battery_level[0]) !=
+        wiced_result_t::WICED_BT_SUCCESS) {
+        CY_ASSERT(false);
+    }
+
+    // The value capacities must agree with design.cybt. Checked in every
+    // build, not just under CY_ASSERT: a database whose bounds disagree with
+    // its storage is never served.
+    if (!ble_gatt_db_matches_configurator()) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_ERROR;
+    }
+
+    ble_gatt_statistics_object.initialize();
 
     gatt_status = wiced_bt_gatt_register(ble_gatt_event_callback);
-    gatt_status =
-        wiced_bt_gatt_db_init(gatt_database, gatt_database_len, nullptr);
+    gatt_status = wiced_bt_gatt_db_init(gatt_db::database,
+                                        gatt_db::database_size, nullptr);
+
+    // Optional OTA data path; the OTA data characteristic keeps working
+    if (!ota_l2cap_channel_object.initialize()) {
+        CY_ASSERT(false);
+    }
+
+    if (ble_link_optimizer_object.initialize() != CY_RSLT_SUCCESS) {
+        CY_ASSERT(false);
+    }
+
+    if (ble_advertiser_object.initialize() != CY_RSLT_SUCCESS) {
+        CY_ASSERT(false);
+    }
 
-    wiced_result = wiced_bt_start_advertisements(
-        wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, nullptr);
+    wiced_result = ble_advertiser_object.restart();
 
     if (wiced_result != wiced_result_t::WICED_BT_SUCCESS) {
         CY_ASSERT(false);
@@ -27,6 +27,46 @@ extern "C" {
 #pragma GCC diagnostic pop
 
 #include <array>
+#include <atomic>
+#include <cstddef>
+
+///
+/// \brief Maximum number of simultaneous Bluetooth LE connections
+///
+/// Matches MaxRemoteClientsConnections in design.cybt.
+///
+constexpr auto BLE_MAX_CONNECTIONS = std::size_t{4};
+
+///
+/// \brief Default ATT MTU, in effect until a client exchanges MTU
+///
+constexpr auto BLE_DEFAULT_ATT_MTU = uint16_t{23};
+
+///
+/// \brief State kept for each connected peer
+///
+struct ble_connection {
+    uint16_t connection_id; ///< Connection ID (0 if the entry is free)
+    uint16_t mtu;           ///< Negotiated ATT MTU
+
+    std::array<uint8_t, BD_ADDR_LEN> peer_address; ///< Peer Bluetooth address
+
+    std::array<uint8_t, 2>
+        bas_cccd; ///< Battery Level CCCD written by this peer
+
+    uint8_t bas_subscription; ///< Bumped on every write of bas_cccd
+    uint8_t bas_first_sent;   ///< bas_subscription the first value was sent
+                              ///< for
+};
+
+///
+/// \brief A connection subscribed to battery notifications
+///
+struct ble_bas_subscriber {
+    uint16_t connection_id; ///< Connection ID
+    uint8_t subscription;   ///< Its bas_subscription when collected
+    bool first_pending;     ///< No value sent since it subscribed
+};
 
 ///
 /// \brief Application context structure for BLE/OTA operations
@@ -67,14 +107,95 @@ public:
     ///
     uint16_t connection_id() const noexcept { return m_connection_id; }
 
-    bool connected() const noexcept { return m_connection_id > 0; }
+    bool connected() const noexcept { return connection_count() > 0; }
+
+    ///
+    /// \brief Get number of connected peers
+    ///
+    /// \return std::size_t Number of occupied connection table entries
+    ///
+    std::size_t connection_count() const noexcept;
+
+    ///
+    /// \brief Find the connection table entry of a connection
+    ///
+    /// \param connection_id Connection ID
+    ///
+    /// \return ble_connection* Entry of \p connection_id, or nullptr if the
+    ///         connection is unknown
+    ///
+    ble_connection *find_connection(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Record the ATT MTU negotiated on a connection
+    ///
+    /// \param connection_id Connection ID
+    /// \param mtu Negotiated ATT MTU
+    ///
+    void set_connection_mtu(uint16_t connection_id, uint16_t mtu) noexcept;
+
+    ///
+    /// \brief Store the Battery Level CCCD written by a peer
+    ///
+    /// \param connection_id Connection ID of the writer
+    /// \param value CCCD value (2 bytes, little endian)
+    /// \param length Length of \p value in bytes
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if stored,
+    ///         WICED_BT_GATT_INVALID_ATTR_LEN if \p length is not 2,
+    ///         WICED_BT_GATT_ERROR if the connection is unknown
+    ///
+    wiced_bt_gatt_status_t set_bas_cccd(uint16_t connection_id,
+                                        const uint8_t *value,
+                                        uint16_t length) noexcept;
+
+    ///
+    /// \brief Check a Battery Level CCCD write without storing it
+    ///
+    /// \param connection_id Connection ID of the writer
+    /// \param value CCCD value
+    /// \param length Length of \p value in bytes
+    ///
+    /// \return wiced_bt_gatt_status_t What set_bas_cccd() would return
+    ///
+    wiced_bt_gatt_status_t check_bas_cccd(uint16_t connection_id,
+                                          const uint8_t *value,
+                                          uint16_t length) const noexcept;
+
+    ///
+    /// \brief Collect the connections subscribed to battery notifications
+    ///
+    /// Takes a consistent snapshot of the connection table, so the caller can
+    /// send to every subscriber without holding a lock. A subscriber is
+    /// first_pending from every CCCD write until bas_first_value_sent(), so
+    /// a peer that unsubscribes and subscribes again between two snapshots
+    /// is still seen as new.
+    ///
+    /// \param subscribers Receives the subscribed connections
+    ///
+    /// \return std::size_t Number of entries written to \p subscribers
+    ///
+    std::size_t bas_notification_subscribers(
+        std::array<ble_bas_subscriber, BLE_MAX_CONNECTIONS> &subscribers)
+        const noexcept;
+
+    ///
+    /// \brief Record that a subscriber was sent its first value
+    ///
+    /// Ignored if the peer wrote its CCCD again since \p subscriber was
+    /// collected; that subscription still gets a first value.
+    ///
+    /// \param subscriber Entry returned by bas_notification_subscribers()
+    ///
+    void bas_first_value_sent(const ble_bas_subscriber &subscriber) noexcept;
 
     ///
     /// \brief Handle BLE connection and disconnection events
     ///
-    /// Updates connection state, stores peer address on connection, and
-    /// restarts advertising on disconnection. Updates the advertising LED to
-    /// reflect the current state.
+    /// Adds the peer to the connection table on connection (refusing it if the
+    /// table is full) and removes it on disconnection. Advertising continues
+    /// while the table has room. Updates the advertising LED to reflect the
+    /// current state.
     ///
     /// \param connection_status Pointer to connection status structure
     /// containing
@@ -109,11 +230,16 @@ public:
     ///
     void set_advertising_mode(
         wiced_bt_ble_advert_mode_t *advertisement_mode) noexcept {
+        if (connected()) {
+            // Advertising continues while connected if the table has room
+            m_connection_state = state::connected;
+            return;
+        }
+
         m_connection_state =
             *advertisement_mode ==
                     wiced_bt_ble_advert_mode_e::BTM_BLE_ADVERT_OFF
-                ? (m_connection_id == 0 ? state::disconnected_not_advertising
-                                        : state::connected)
+                ? state::disconnected_not_advertising
                 : state::disconnected_and_advertising;
     }
 
@@ -131,37 +257,235 @@ public:
     cy_rslt_t ota_agent_initialize() noexcept;
 
     ///
-    /// \brief Handle GATT write requests for OTA operations
+    /// \brief Handle a write to the OTA control point
     ///
-    /// Processes GATT write requests for OTA control point, data transfer, and
-    /// client characteristic configuration. Supports OTA commands including
-    /// prepare download, download, verify, and abort operations.
+    /// Runs the OTA command carried by the write: prepare download, download
+    /// (fresh or resumed), verify, and abort. Prepare makes the writer's
+    /// connection the owner of the session; commands from any other
+    /// connection are refused until the session ends or its owner
+    /// disconnects.
     ///
     /// \param event_data Pointer to GATT event data containing write request
     /// details
     /// \param error_handle Pointer to error handle, set to the attribute handle
     ///        that caused an error for error reporting
     ///
+    /// Verify answers a write request only once the OTA writer task has
+    /// committed the whole image; until then it returns
+    /// WICED_BT_GATT_PENDING and ota_staging_ready_handler() sends the
+    /// response.
+    ///
     /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if handled
     /// successfully,
+    ///         WICED_BT_GATT_PENDING if the response is sent later,
     ///         WICED_BT_GATT_ERROR if operation failed,
-    ///         WICED_BT_GATT_REQ_NOT_SUPPORTED for unsupported operations
+    ///         WICED_BT_GATT_PRC_IN_PROGRESS if another connection owns the
+    ///         session,
+    ///         WICED_BT_GATT_BUSY while held OTA data or a verify is pending,
+    ///         WICED_BT_GATT_REQ_NOT_SUPPORTED for unknown commands
     ///
     wiced_bt_gatt_status_t
-    ota_agent_write_handler(wiced_bt_gatt_event_data_t *event_data,
-                            uint16_t *error_handle) noexcept;
+    ota_control_point_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                                    uint16_t *error_handle) noexcept;
+
+    ///
+    /// \brief Check an OTA control point write without running it
+    ///
+    /// \param connection_id Connection ID of the writer
+    /// \param value Command and its arguments
+    /// \param length Length of \p value in bytes
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if the command
+    ///         may run, WICED_BT_GATT_INVALID_ATTR_LEN if \p value is empty
+    ///         or a verify command carries no CRC-32,
+    ///         WICED_BT_GATT_REQ_NOT_SUPPORTED for unknown commands,
+    ///         WICED_BT_GATT_PRC_IN_PROGRESS if another connection owns the
+    ///         session, WICED_BT_GATT_BUSY while held OTA data or a verify
+    ///         is pending
+    ///
+    wiced_bt_gatt_status_t
+    check_ota_control_point(uint16_t connection_id, const uint8_t *value,
+                            uint16_t length) const noexcept;
+
+    ///
+    /// \brief Handle a write to the OTA control point configuration
+    ///
+    /// Saves the notify/indicate flags used for OTA status updates.
+    ///
+    /// \param event_data Pointer to GATT event data containing write request
+    /// details
+    /// \param error_handle Pointer to error handle, set to the attribute handle
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if saved,
+    ///         WICED_BT_GATT_INVALID_ATTR_LEN if the value is not 2 bytes
+    ///
+    wiced_bt_gatt_status_t
+    ota_config_descriptor_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                                        uint16_t *error_handle) noexcept;
+
+    ///
+    /// \brief Check an OTA control point CCCD write without saving it
+    ///
+    /// \param value CCCD value
+    /// \param length Length of \p value in bytes
+    ///
+    /// \return wiced_bt_gatt_status_t What
+    ///         ota_config_descriptor_write_handler() would return
+    ///
+    wiced_bt_gatt_status_t check_ota_cccd(const uint8_t *value,
+                                          uint16_t length) const noexcept;
+
+    ///
+    /// \brief Handle a write to the OTA data characteristic
+    ///
+    /// Decodes the image piece and stages it for the OTA writer task. If the
+    /// staging buffers are all queued for flash, the rest of the piece is
+    /// held and a write request is answered once it is staged: the peer
+    /// waits for the response instead of the stack thread waiting for the
+    /// writer. Write commands have no response to hold back; their peer
+    /// must pace itself.
+    ///
+    /// \param event_data Pointer to GATT event data containing write request
+    /// details
+    /// \param error_handle Pointer to error handle, set to the attribute handle
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if staged,
+    ///         WICED_BT_GATT_PENDING if the response is sent later,
+    ///         WICED_BT_GATT_PRC_IN_PROGRESS if another connection owns the
+    ///         session, WICED_BT_GATT_BUSY while earlier data is held,
+    ///         WICED_BT_GATT_ERROR otherwise
+    ///
+    wiced_bt_gatt_status_t
+    ota_data_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                           uint16_t *error_handle) noexcept;
+
+    ///
+    /// \brief Check that a connection may send OTA image data
+    ///
+    /// \param connection_id Connection ID of the writer
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if it owns the
+    ///         session, WICED_BT_GATT_BUSY while earlier data is held,
+    ///         WICED_BT_GATT_PRC_IN_PROGRESS otherwise
+    ///
+    wiced_bt_gatt_status_t
+    check_ota_data(uint16_t connection_id) const noexcept;
+
+    ///
+    /// \brief Stage OTA image data received outside ATT
+    ///
+    /// Used by the OTA L2CAP channel. Data that does not fit is held as for
+    /// ota_data_write_handler(), with no response to send.
+    ///
+    /// \param data Image data
+    /// \param length Length of \p data in bytes
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if staged or
+    ///         held, WICED_BT_GATT_BUSY while earlier data is held,
+    ///         WICED_BT_GATT_ERROR otherwise
+    ///
+    wiced_bt_gatt_status_t ota_data_received(const uint8_t *data,
+                                             uint16_t length) noexcept;
+
+    ///
+    /// \brief Whether held OTA data or a verify waits for the OTA writer
+    ///
+    bool ota_deferred() const noexcept { return m_ota_deferred.load() != 0; }
+
+    ///
+    /// \brief Finish OTA work deferred until a staging buffer is free
+    ///
+    /// Runs on the application event task when the OTA writer task has
+    /// released a buffer: stages held data or completes a verify, then sends
+    /// the write response the stack thread held back. The stack thread
+    /// leaves the OTA session to this handler until it is done.
+    ///
+    void ota_staging_ready_handler() noexcept;
+
+    ///
+    /// \brief Tell the peer where to continue a resumed OTA download
+    ///
+    /// Sends a control point notification of OTA_UPGRADE_STATUS_RESUME
+    /// followed by the 32-bit little-endian image offset. The peer sends
+    /// image data from that offset and skips the chunks already in flash.
+    ///
+    /// \param connection_id Connection that resumed the download
+    /// \param offset Image offset of the first chunk not yet committed
+    ///
+    /// \return wiced_bt_gatt_status_t Result of sending the notification
+    ///
+    wiced_bt_gatt_status_t
+    ota_agent_send_resume_offset(uint16_t connection_id,
+                                 uint32_t offset) noexcept;
 
     ///
     /// \brief Handle OTA operation confirmation
     ///
-    /// Called after an OTA operation completes. Checks the OTA library state
-    /// and either reboots the device (if configured and OTA is complete) or
-    /// stops the OTA agent. Provides a 1-second delay before reboot to allow
+    /// Called after an OTA operation completes. Either reboots the device (if
+    /// configured and the image is pending for the bootloader) or stops the
+    /// OTA agent. Provides a 1-second delay before reboot to allow
     /// final operations to complete.
     ///
     void ota_agent_confirmation_handler() noexcept;
 
 private:
+    /// Deferred work: held data is waiting to be staged
+    static constexpr auto OTA_DEFERRED_DATA = uint8_t{0x01};
+
+    /// Deferred work: a verify waits for the writer to finish
+    static constexpr auto OTA_DEFERRED_VERIFY = uint8_t{0x02};
+
+    /// The connection of the deferred work closed meanwhile
+    static constexpr auto OTA_DEFERRED_LOST = uint8_t{0x04};
+
+    ///
+    /// \brief Leave OTA work to ota_staging_ready_handler()
+    ///
+    /// \param connection_id Connection the work came from
+    /// \param opcode ATT opcode to answer, if a request
+    /// \param handle Attribute handle written
+    /// \param work OTA_DEFERRED_DATA or OTA_DEFERRED_VERIFY
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_PENDING for a write
+    ///         request, WICED_BT_GATT_SUCCESS otherwise
+    ///
+    wiced_bt_gatt_status_t ota_defer(uint16_t connection_id,
+                                     wiced_bt_gatt_opcode_t opcode,
+                                     uint16_t handle, uint8_t work) noexcept;
+
+    ///
+    /// \brief Decode and stage image data, holding what does not fit
+    ///
+    /// \return wiced_bt_gatt_status_t As ota_data_write_handler()
+    ///
+    wiced_bt_gatt_status_t ota_stage(uint16_t connection_id,
+                                     wiced_bt_gatt_opcode_t opcode,
+                                     uint16_t handle, const uint8_t *data,
+                                     uint16_t length) noexcept;
+
+    ///
+    /// \brief Check a flushed and idle image and mark it pending
+    ///
+    /// The digest streamed during download is the whole check, so the OTA
+    /// library's own verify, and its pass over the secondary slot, is
+    /// skipped; the slot is marked pending for MCUboot directly.
+    ///
+    /// \param event_data Verify command, with the image CRC-32
+    ///
+    /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS, or
+    ///         WICED_BT_GATT_ERROR if the image is not the one announced or
+    ///         could not be marked
+    ///
+    wiced_bt_gatt_status_t
+    ota_verify(wiced_bt_gatt_event_data_t *event_data) noexcept;
+
+    ///
+    /// \brief Handle a closed connection for the OTA session
+    ///
+    /// Left to ota_staging_ready_handler() while it owns the session.
+    ///
+    void ota_connection_lost(uint16_t connection_id) noexcept;
+
     ///
     /// \brief Advertising and connection state enumeration
     ///
@@ -176,10 +500,14 @@ private:
 
     uint32_t m_tag; ///< Context validity tag for integrity checking
 
-    uint16_t m_connection_id; ///< Current BLE connection ID (0 if disconnected)
+    uint16_t m_connection_id; ///< Most recent connection ID
+                              ///< (0 if disconnected)
+
+    uint16_t m_ota_connection_id; ///< Connection that owns the OTA session
+                                  ///< (0 if none)
 
-    std::array<uint8_t, BD_ADDR_LEN>
-        m_peer_address; ///< Bluetooth address of connected peer
+    std::array<ble_connection, BLE_MAX_CONNECTIONS>
+        m_connections; ///< Connected peers (free entries have ID 0)
 
     wiced_bt_ble_conn_params_t
         m_connection_parameters; ///< BLE connection parameters
@@ -193,9 +521,22 @@ private:
                           ///< false = no reboot,
                           ///< true = reboot after successful OTA
 
+    bool m_ota_image_pending; ///< Verified image marked pending for MCUboot
+
     uint16_t m_ota_config_descriptor; ///< OTA config descriptor for
                                       ///< notifications/indications
 
+    std::atomic<uint8_t> m_ota_deferred; ///< OTA_DEFERRED_* bits; set while
+                                         ///< the application event task owns
+                                         ///< the OTA session
+
+    uint16_t m_ota_deferred_connection_id;  ///< Connection to answer
+    wiced_bt_gatt_opcode_t m_ota_deferred_opcode; ///< Opcode to answer
+    uint16_t m_ota_deferred_handle;         ///< Handle to answer
+
+    std::array<uint8_t, 5>
+        m_ota_verify_command; ///< Deferred verify command and CRC-32
+
     cy_ota_agent_params_t
         m_ota_agent_params; ///< OTA agent configuration parameters
     cy_ota_network_params_t
@@ -213,6 +554,8 @@ private:
         m_tag = BLE_CONTEXT_TAG_VALID;
 
         m_connection_id = 0;
+        m_ota_connection_id = 0;
+        m_connections = {};
         m_connection_parameters = {};
         m_connection_state = state::disconnected_not_advertising;
     }
@@ -223,9 +566,16 @@ private:
 
         m_connection_type = cy_ota_connection_t::CY_OTA_CONNECTION_BLE;
         m_reboot_at_end = true;
+        m_ota_image_pending = false;
 
         m_ota_config_descriptor = {};
 
+        m_ota_deferred.store(0);
+        m_ota_deferred_connection_id = 0;
+        m_ota_deferred_opcode = {};
+        m_ota_deferred_handle = 0;
+        m_ota_verify_command = {};
+
         // OTA Agent parameters - used for ALL transport types
         m_ota_agent_params = {
             true,    // Reboot after finishing OTA update
@@ -259,6 +609,9 @@ private:
         wiced_bt_management_evt_t event,
         wiced_bt_management_evt_data_t *event_data) noexcept;
 
+    /// Control point status announcing a resumed download (vendor extension)
+    static constexpr auto OTA_UPGRADE_STATUS_RESUME = uint8_t{0x80};
+
     /// Magic number indicating valid/initialized context
     static constexpr auto OTA_APP_TAG_VALID = uint32_t{0x51EDBA15};
 
@@ -47,79 +47,461 @@ extern "C" {
 }
 #pragma GCC diagnostic pop
 
+#include "app_event_task.hpp"
 #include "battery_service_task.hpp"
 #include "ble_context.hpp"
 #include "ble_gatt.hpp"
+#include "ble_gatt_db.hpp"
+#include "ble_gatt_statistics.hpp"
+#include "ble_link_optimizer.hpp"
+#include "connection_buffers.hpp"
 #include "led_pwm.hpp"
 #include "utilities.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 
-wiced_bt_gatt_status_t ble_gatt_db_set_value(uint16_t attr_handle,
-                                             uint8_t *value, uint16_t length) {
-    auto status = wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+///
+/// \brief Statically reserved buffers for GATT responses
+///
+static auto gatt_response_pool = ble_gatt_response_pool{};
 
-    // Input guards (choose the status that matches your stack’s expectations)
-    if (length > 0 && value == nullptr) {
-        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_PDU;
+uint8_t *ble_gatt_response_buffer_allocate(uint16_t length) {
+    return gatt_response_pool.allocate(length);
+}
+
+void ble_gatt_response_buffer_release(uint8_t *buffer) {
+    gatt_response_pool.deallocate(buffer);
+}
+
+ble_gatt_response_pool::statistics ble_gatt_response_pool_stats() {
+    return gatt_response_pool.stats();
+}
+
+///
+/// \brief Read-multiple response buffers, one per simultaneous connection
+///
+/// Every Read Multiple (Variable Length) response that cannot go out in
+/// place is built in the requesting connection's buffer, without touching
+/// the heap or the shared response pool.
+///
+static auto read_multi_scratch =
+    connection_buffers<BLE_GATT_RESPONSE_BLOCK_SIZE, BLE_MAX_CONNECTIONS>{};
+
+///
+/// \brief Mark a read-multiple scratch buffer as reusable
+///
+/// Passed to the stack as the application context of read-multiple responses
+/// and invoked on GATT_APP_BUFFER_TRANSMITTED_EVT.
+///
+/// \param buffer Scratch buffer previously passed to the stack
+///
+static void read_multi_scratch_release(uint8_t *buffer) {
+    read_multi_scratch.release(buffer);
+}
+
+///
+/// \brief Prepared-write queue owned by one connection
+///
+struct prepare_queue_slot {
+    ble_gatt_prepare_queue queue; ///< Fragments awaiting Execute Write
+    uint16_t connection_id;       ///< Owning connection (0 if unassigned)
+};
+
+///
+/// \brief Prepared-write queues, one per simultaneous connection
+///
+static std::array<prepare_queue_slot, BLE_MAX_CONNECTIONS>
+    prepare_queue_table{};
+
+///
+/// \brief Staging area for the final value of one handle during execution
+///
+/// Execution runs on the Bluetooth stack thread only, one handle at a time.
+///
+static std::array<uint8_t, BLE_GATT_PREPARE_ARENA_SIZE> prepare_execute_value{};
+
+static_assert(gatt_db::max_value_length() <= BLE_GATT_PREPARE_ARENA_SIZE,
+              "Every attribute value must fit the execute staging area");
+
+///
+/// \brief Find the prepared-write queue of a connection
+///
+/// \param connection_id Connection issuing the request
+/// \param bind Bind an unassigned queue if the connection has none
+///
+/// \return ble_gatt_prepare_queue* Queue of \p connection_id, or nullptr if
+///         it has none (and none could be bound)
+///
+static ble_gatt_prepare_queue *prepare_queue_find(uint16_t connection_id,
+                                                  bool bind) {
+    auto *unassigned = static_cast<prepare_queue_slot *>(nullptr);
+
+    for (auto &slot : prepare_queue_table) {
+        if (slot.connection_id == connection_id) {
+            return &slot.queue;
+        }
+
+        if (slot.connection_id == 0 && unassigned == nullptr) {
+            unassigned = &slot;
+        }
     }
 
-    for (auto i = uint16_t{}; i < app_gatt_db_ext_attr_tbl_size; i++) {
-        auto &entry = app_gatt_db_ext_attr_tbl[i];
+    if (!bind || unassigned == nullptr) {
+        return nullptr;
+    }
 
-        if (entry.handle != attr_handle) {
-            continue;
+    unassigned->connection_id = connection_id;
+    unassigned->queue.clear();
+
+    return &unassigned->queue;
+}
+
+///
+/// \brief Drop the prepared writes of a closed connection
+///
+/// \param connection_id Connection that was closed
+///
+static void prepare_queue_unbind(uint16_t connection_id) {
+    for (auto &slot : prepare_queue_table) {
+        if (slot.connection_id == connection_id) {
+            slot.connection_id = 0;
+            slot.queue.clear();
         }
+    }
+}
+
+static_assert(gatt_db::attribute_count <= 32,
+              "Pinned attribute sets are 32-bit masks indexed by slot");
+
+///
+/// \brief Read response sent straight from GATT database storage
+///
+struct pinned_response {
+    const uint8_t *data; ///< Pointer handed to the stack (nullptr if free)
+    uint32_t slots;      ///< Attributes referenced, one bit per slot
+};
+
+///
+/// \brief In-place read responses awaiting transmission
+///
+/// ATT allows a single outstanding request per bearer, so one record per
+/// connection is enough; when none is free the response is copied instead.
+///
+static std::array<pinned_response, BLE_MAX_CONNECTIONS> pinned_responses{};
+
+///
+/// \brief In-flight responses referencing each attribute, indexed by slot
+///
+static std::array<uint8_t, gatt_db::attribute_count> pin_counts{};
+
+///
+/// \brief Writes held back until their attribute is unpinned
+///
+/// One value per slot, laid out by gatt_db::value_offsets, so holding back
+/// a write never needs more than the attribute's own capacity.
+///
+static std::array<uint8_t, gatt_db::value_storage_size> deferred_values{};
+static std::array<uint16_t, gatt_db::attribute_count> deferred_lengths{};
+static auto deferred_slots = uint32_t{}; ///< Slots with a held-back write
 
-        if (entry.max_len < length) {
-            status = wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+///
+/// \brief Scatter-gather builder for multi-attribute read responses
+///
+/// Only used on the Bluetooth stack thread, one request at a time; header
+/// bytes referenced by a response are flattened before the next request.
+///
+static auto response_builder = ble_gatt_response_builder{};
+
+///
+/// \brief Store a value and its length in the GATT database
+///
+/// \param entry Attribute to update
+/// \param value New value
+/// \param length Length of \p value, at most entry.max_len
+///
+static void ble_gatt_db_store(const gatt_db::attribute &entry,
+                              const uint8_t *value, uint16_t length) {
+    // Storage is guaranteed non-null by the static_asserts in ble_gatt_db.hpp
+    gatt_db::current_length(entry) = length;
+
+    // If you require deterministic zeroed tail (good for BLE reads of
+    // variable-length chars): Copy then zero the tail instead of blanking
+    // the whole buffer.
+    std::memcpy(entry.p_data, value, static_cast<size_t>(length));
+
+    if (entry.max_len > length) {
+        std::memset(entry.p_data + length, 0,
+                    static_cast<size_t>(entry.max_len - length));
+    }
+}
+
+///
+/// \brief Pin attributes referenced by a response sent in place
+///
+/// \param data Pointer handed to the stack
+/// \param slots Attributes referenced, one bit per slot
+///
+/// \return true if pinned, false if every record is in use
+///
+static bool ble_gatt_pin(const uint8_t *data, uint32_t slots) {
+    auto pinned = false;
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (auto &response : pinned_responses) {
+        if (response.data == nullptr) {
+            response = {data, slots};
+            pinned = true;
             break;
         }
+    }
 
-        if (entry.p_data == nullptr) {
-            status = wiced_bt_gatt_status_e::
-                WICED_BT_GATT_ERROR; // or INVALID_HANDLE if that’s your
-                                     // convention
-            break;
+    for (auto i = std::size_t{}; pinned && i < pin_counts.size(); i++) {
+        if ((slots & (uint32_t{1} << i)) != 0) {
+            ++pin_counts[i];
         }
+    }
 
-        entry.cur_len = length;
+    cyhal_system_critical_section_exit(interrupt_status);
 
-        // If you require deterministic zeroed tail (good for BLE reads of
-        // variable-length chars): Copy then zero the tail instead of blanking
-        // the whole buffer.
-        std::memcpy(entry.p_data, value, static_cast<size_t>(entry.cur_len));
+    return pinned;
+}
 
-        if (entry.max_len > entry.cur_len) {
-            std::memset(entry.p_data + entry.cur_len, 0,
-                        static_cast<size_t>(entry.max_len - entry.cur_len));
+///
+/// \brief Unpin the attributes of a transmitted in-place response
+///
+/// Passed to the stack as the application context of in-place responses and
+/// invoked on GATT_APP_BUFFER_TRANSMITTED_EVT. Writes held back while an
+/// attribute was pinned are applied when its last response is released.
+///
+/// \param data Pointer previously handed to the stack
+///
+static void ble_gatt_pinned_release(uint8_t *data) {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (auto &response : pinned_responses) {
+        if (response.data != data) {
+            continue;
         }
 
-        status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        for (auto i = std::size_t{}; i < pin_counts.size(); i++) {
+            const auto bit = uint32_t{1} << i;
+
+            if ((response.slots & bit) == 0 || --pin_counts[i] != 0 ||
+                (deferred_slots & bit) == 0) {
+                continue;
+            }
+
+            ble_gatt_db_store(gatt_db::attributes[i],
+                              deferred_values.data() +
+                                  gatt_db::value_offsets[i],
+                              deferred_lengths[i]);
+            deferred_slots &= ~bit;
+        }
+
+        response = pinned_response{};
+        break;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+}
+
+wiced_bt_gatt_status_t ble_gatt_db_set_value(uint16_t attr_handle,
+                                             uint8_t *value, uint16_t length) {
+    // Input guards (choose the status that matches your stack’s expectations)
+    if (length > 0 && value == nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_PDU;
+    }
+
+    const auto *entry = ble_gatt_db_find_by_handle(attr_handle);
 
-        if (entry.handle == HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG) {
-            // Toggle notifications enabled/disabled here if you need to react
-            // to CCCD changes.
+    if (entry == nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+    }
+
+    if (entry->max_len < length) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+    }
+
+    const auto slot = gatt_db::slot_index(*entry);
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (pin_counts[slot] != 0) {
+        // A response in flight still points at the value; the last release
+        // applies the newest write
+        std::memcpy(deferred_values.data() + gatt_db::value_offsets[slot],
+                    value, static_cast<size_t>(length));
+        deferred_lengths[slot] = length;
+        deferred_slots |= uint32_t{1} << slot;
+    } else {
+        ble_gatt_db_store(*entry, value, length);
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+}
+
+const gatt_db::attribute *ble_gatt_db_find_by_handle(uint16_t handle) {
+    const auto slot = gatt_db::slot_of(handle);
+
+    return (slot != gatt_db::no_slot) ? &gatt_db::attributes[slot] : nullptr;
+}
+
+bool ble_gatt_db_matches_configurator() {
+    if (app_gatt_db_ext_attr_tbl_size != gatt_db::attribute_count) {
+        return false;
+    }
+
+    for (auto i = std::size_t{}; i < gatt_db::attribute_count; i++) {
+        const auto &generated = app_gatt_db_ext_attr_tbl[i];
+        const auto *entry = ble_gatt_db_find_by_handle(generated.handle);
+
+        if (entry == nullptr || entry->max_len != generated.max_len ||
+            entry->initial_len != generated.cur_len ||
+            entry->p_data != generated.p_data) {
+            return false;
         }
+    }
+
+    return true;
+}
 
-        break; // handled the matching handle; exit the loop
+wiced_bt_gatt_status_t
+gatt_db::write_value(wiced_bt_gatt_event_data_t *event_data,
+                     uint16_t *error_handle) {
+    auto *write_request = &event_data->attribute_request.data.write_req;
+
+    *error_handle = write_request->handle;
+
+    return ble_gatt_db_set_value(write_request->handle, write_request->p_val,
+                                 write_request->val_len);
+}
+
+wiced_bt_gatt_status_t
+gatt_db::write_bas_cccd(wiced_bt_gatt_event_data_t *event_data,
+                        uint16_t *error_handle) {
+    auto *write_request = &event_data->attribute_request.data.write_req;
+
+    *error_handle = write_request->handle;
+
+    const auto status = ble_context_object.set_bas_cccd(
+        event_data->attribute_request.conn_id, write_request->p_val,
+        write_request->val_len);
+
+    if (status == wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        // Serve a new subscriber now rather than on the next timer tick
+        battery_service_subscription_changed();
+
+        ble_link_optimizer_object.subscription_changed(
+            event_data->attribute_request.conn_id,
+            (write_request->p_val[0] &
+             wiced_bt_gatt_client_char_config_e::
+                 GATT_CLIENT_CONFIG_NOTIFICATION) != 0);
+    }
+
+    return status;
+}
+
+wiced_bt_gatt_status_t
+gatt_db::write_ota_control_point(wiced_bt_gatt_event_data_t *event_data,
+                                 uint16_t *error_handle) {
+    return ble_context_object.ota_control_point_write_handler(event_data,
+                                                              error_handle);
+}
+
+wiced_bt_gatt_status_t
+gatt_db::write_ota_cccd(wiced_bt_gatt_event_data_t *event_data,
+                        uint16_t *error_handle) {
+    return ble_context_object.ota_config_descriptor_write_handler(
+        event_data, error_handle);
+}
+
+wiced_bt_gatt_status_t
+gatt_db::write_ota_data(wiced_bt_gatt_event_data_t *event_data,
+                        uint16_t *error_handle) {
+    return ble_context_object.ota_data_write_handler(event_data, error_handle);
+}
+
+uint8_t *gatt_db::read_value(uint16_t connection_id,
+                             const attribute &entry) {
+    util::unused(connection_id);
+
+    return entry.p_data;
+}
+
+uint8_t *gatt_db::read_bas_cccd(uint16_t connection_id,
+                                const attribute &entry) {
+    auto *connection = ble_context_object.find_connection(connection_id);
+
+    return (connection != nullptr) ? connection->bas_cccd.data()
+                                   : entry.p_data;
+}
+
+uint8_t *gatt_db::read_not_permitted(uint16_t connection_id,
+                                     const attribute &entry) {
+    util::unused(connection_id);
+    util::unused(&entry);
+
+    return nullptr;
+}
+
+wiced_bt_gatt_status_t gatt_db::check_value(uint16_t connection_id,
+                                            const attribute &entry,
+                                            const uint8_t *value,
+                                            uint16_t length) {
+    util::unused(connection_id);
+
+    if (length > 0 && value == nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_PDU;
     }
 
-    return util::to_underlying(status);
+    return (length <= entry.max_len)
+               ? wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS
+               : wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN;
+}
+
+wiced_bt_gatt_status_t gatt_db::check_bas_cccd(uint16_t connection_id,
+                                               const attribute &entry,
+                                               const uint8_t *value,
+                                               uint16_t length) {
+    util::unused(&entry);
+
+    return ble_context_object.check_bas_cccd(connection_id, value, length);
+}
+
+wiced_bt_gatt_status_t
+gatt_db::check_ota_control_point(uint16_t connection_id,
+                                 const attribute &entry, const uint8_t *value,
+                                 uint16_t length) {
+    util::unused(&entry);
+
+    return ble_context_object.check_ota_control_point(connection_id, value,
+                                                      length);
+}
+
+wiced_bt_gatt_status_t gatt_db::check_ota_cccd(uint16_t connection_id,
+                                               const attribute &entry,
+                                               const uint8_t *value,
+                                               uint16_t length) {
+    util::unused(connection_id);
+    util::unused(&entry);
+
+    return ble_context_object.check_ota_cccd(value, length);
 }
 
-gatt_db_lookup_table_t *ble_gatt_db_find_by_handle(uint16_t handle) {
-    auto it =
-        std::find_if(app_gatt_db_ext_attr_tbl,
-                     app_gatt_db_ext_attr_tbl + app_gatt_db_ext_attr_tbl_size,
-                     [handle](const gatt_db_lookup_table_t &entry) {
-                         return entry.handle == handle;
-                     });
+wiced_bt_gatt_status_t gatt_db::check_ota_data(uint16_t connection_id,
+                                               const attribute &entry,
+                                               const uint8_t *value,
+                                               uint16_t length) {
+    util::unused(&entry);
+    util::unused(value);
+    util::unused(length);
 
-    return (it != app_gatt_db_ext_attr_tbl + app_gatt_db_ext_attr_tbl_size)
-               ? &(*it)
-               : nullptr;
+    return ble_context_object.check_ota_data(connection_id);
 }
 
 wiced_bt_gatt_status_t
@@ -131,8 +513,15 @@ ble_gatt_event_callback(wiced_bt_gatt_evt_t event,
 
     using free_fn_t = void (*)(uint8_t *);
 
+    const auto start_cycles = ble_gatt_statistics::cycles();
+
     switch (event) {
     case wiced_bt_gatt_evt_t::GATT_CONNECTION_STATUS_EVT:
+        if (!event_data->connection_status.connected) {
+            read_multi_scratch.unbind(event_data->connection_status.conn_id);
+            prepare_queue_unbind(event_data->connection_status.conn_id);
+        }
+
         status = ble_context_object.connection_event_handler(
             &event_data->connection_status);
         break;
@@ -140,7 +529,9 @@ ble_gatt_event_callback(wiced_bt_gatt_evt_t event,
     case wiced_bt_gatt_evt_t::GATT_ATTRIBUTE_REQUEST_EVT:
         status = ble_gatt_event_handler(event_data, &error_handle);
 
-        if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        // A pending request is answered later by whoever finishes it
+        if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS &&
+            status != wiced_bt_gatt_status_e::WICED_BT_GATT_PENDING) {
             wiced_bt_gatt_server_send_error_rsp(attr_request->conn_id,
                                                 attr_request->opcode,
                                                 error_handle, status);
@@ -150,11 +541,22 @@ ble_gatt_event_callback(wiced_bt_gatt_evt_t event,
 
     case wiced_bt_gatt_evt_t::GATT_GET_RESPONSE_BUFFER_EVT:
         event_data->buffer_request.buffer.p_app_rsp_buffer =
-            static_cast<uint8_t *>(
-                std::malloc(event_data->buffer_request.len_requested));
+            ble_gatt_response_buffer_allocate(
+                event_data->buffer_request.len_requested);
 
         event_data->buffer_request.buffer.p_app_ctxt =
-            reinterpret_cast<void *>(std::free);
+            reinterpret_cast<void *>(ble_gatt_response_buffer_release);
+
+        if (event_data->buffer_request.buffer.p_app_rsp_buffer == nullptr) {
+            ble_gatt_statistics_object.add_allocation_failure(
+                gatt_operation::other);
+
+            status = wiced_bt_gatt_status_e::WICED_BT_GATT_INSUF_RESOURCE;
+            break;
+        }
+
+        ble_gatt_statistics_object.add_allocated_bytes(
+            gatt_operation::other, event_data->buffer_request.len_requested);
 
         status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
 
@@ -176,6 +578,9 @@ ble_gatt_event_callback(wiced_bt_gatt_evt_t event,
         break;
     }
 
+    app_event_record_callback_cycles(ble_gatt_statistics::cycles() -
+                                     start_cycles);
+
     return status;
 }
 
@@ -185,6 +590,8 @@ ble_gatt_event_handler(wiced_bt_gatt_event_data_t *event_data,
     auto status = wiced_bt_gatt_status_t{};
     auto *attr_request = &event_data->attribute_request;
 
+    const auto start_cycles = ble_gatt_statistics::cycles();
+
     switch (attr_request->opcode) {
     case wiced_bt_gatt_opcode_e::GATT_REQ_READ:
     case wiced_bt_gatt_opcode_e::GATT_REQ_READ_BLOB:
@@ -225,23 +632,32 @@ ble_gatt_event_handler(wiced_bt_gatt_event_data_t *event_data,
         break;
 
     case wiced_bt_gatt_opcode_e::GATT_REQ_PREPARE_WRITE:
-        status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        status = ble_gatt_request_prepare_write_handler(
+            attr_request->conn_id, attr_request->opcode,
+            &attr_request->data.write_req, error_handle);
         break;
 
     case wiced_bt_gatt_opcode_e::GATT_REQ_EXECUTE_WRITE:
-        wiced_bt_gatt_server_send_execute_write_rsp(attr_request->conn_id,
-                                                    attr_request->opcode);
-        status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        status = ble_gatt_request_execute_write_handler(event_data,
+                                                        error_handle);
         break;
 
     case wiced_bt_gatt_opcode_e::GATT_REQ_MTU:
+        ble_context_object.set_connection_mtu(
+            attr_request->conn_id,
+            std::min<uint16_t>(
+                attr_request->data.remote_mtu,
+                wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size));
+
         status = wiced_bt_gatt_server_send_mtu_rsp(
             attr_request->conn_id, attr_request->data.remote_mtu,
             wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
         break;
 
     case wiced_bt_gatt_opcode_e::GATT_HANDLE_VALUE_CONF:
-        ble_context_object.ota_agent_confirmation_handler();
+        // May stop the OTA agent or reboot; never do that on the stack thread
+        app_event_post(
+            {app_event_type::ota_confirmation, attr_request->conn_id});
         status = wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
         break;
 
@@ -253,6 +669,10 @@ ble_gatt_event_handler(wiced_bt_gatt_event_data_t *event_data,
         break;
     }
 
+    ble_gatt_statistics_object.record(
+        ble_gatt_statistics::classify(attr_request->opcode),
+        ble_gatt_statistics::cycles() - start_cycles);
+
     return status;
 }
 
@@ -260,7 +680,7 @@ wiced_bt_gatt_status_t ble_gatt_request_read_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
     wiced_bt_gatt_read_t *read_request, uint16_t length_requested,
     uint16_t *error_handle) {
-    auto *attribute = static_cast<gatt_db_lookup_table_t *>(nullptr);
+    auto *attribute = static_cast<const gatt_db::attribute *>(nullptr);
     auto attr_length_to_copy = uint16_t{};
     auto length_to_send = uint16_t{};
     auto *attribute_data = static_cast<uint8_t *>(nullptr);
@@ -272,101 +692,202 @@ wiced_bt_gatt_status_t ble_gatt_request_read_handler(
         return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
     }
 
-    attr_length_to_copy = attribute->cur_len;
+    if ((attribute_data = attribute->on_read(connection_id, *attribute)) ==
+        nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_READ_NOT_PERMIT;
+    }
+
+    attr_length_to_copy = gatt_db::current_length(*attribute);
 
-    if (read_request->offset >= attribute->cur_len) {
+    if (read_request->offset >= attr_length_to_copy) {
         return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_OFFSET;
     }
 
     length_to_send =
         MIN(length_requested, attr_length_to_copy - read_request->offset);
-    attribute_data = attribute->p_data + read_request->offset;
+    attribute_data += read_request->offset;
+
+    // Database values go out in place, pinned until transmitted
+    if (attribute_data == attribute->p_data + read_request->offset &&
+        ble_gatt_pin(attribute_data,
+                     uint32_t{1} << gatt_db::slot_index(*attribute))) {
+        const auto status = wiced_bt_gatt_server_send_read_handle_rsp(
+            connection_id, opcode, length_to_send, attribute_data,
+            reinterpret_cast<void *>(ble_gatt_pinned_release));
+
+        if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+            ble_gatt_pinned_release(attribute_data);
+        }
+
+        return status;
+    }
+
+    // Per-connection values (or no free pin record): send a copy
+    auto *response = ble_gatt_response_buffer_allocate(length_to_send);
+
+    if (response == nullptr) {
+        ble_gatt_statistics_object.add_allocation_failure(
+            ble_gatt_statistics::classify(opcode));
 
-    return wiced_bt_gatt_server_send_read_handle_rsp(
-        connection_id, opcode, length_to_send, attribute_data, nullptr);
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INSUF_RESOURCE;
+    }
+
+    std::memcpy(response, attribute_data, length_to_send);
+
+    ble_gatt_statistics_object.add_copied_bytes(
+        ble_gatt_statistics::classify(opcode), length_to_send);
+
+    const auto status = wiced_bt_gatt_server_send_read_handle_rsp(
+        connection_id, opcode, length_to_send, response,
+        reinterpret_cast<void *>(ble_gatt_response_buffer_release));
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        ble_gatt_response_buffer_release(response);
+    }
+
+    return status;
 }
 
 wiced_bt_gatt_status_t ble_gatt_request_read_by_type_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
     wiced_bt_gatt_read_by_type_t *read_request, uint16_t length_requested,
     uint16_t *error_handle) {
-    gatt_db_lookup_table_t *attribute = nullptr;
+    const gatt_db::attribute *attribute = nullptr;
 
-    auto last_handle = uint16_t{};
     auto attr_handle = read_request->s_handle;
 
-    auto *response = static_cast<uint8_t *>(std::malloc(length_requested));
+    // Every pair has the length of the first; values are truncated to what
+    // the one-byte pair length and the response can carry
+    const auto value_limit = std::min<uint16_t>(
+        UINT8_MAX - 2,
+        static_cast<uint16_t>(std::max<uint16_t>(length_requested, 2) - 2));
+    auto value_length = uint16_t{};
     auto pair_length = uint8_t{};
 
-    auto used = 0;
+    // 16-bit types with application storage come from the type index: one
+    // binary search, then a walk over adjacent entries. Anything else falls
+    // back to the stack's linear search of the flat database.
+    const auto uuid16 = read_request->uuid.uu.uuid16;
+    const auto indexed =
+        (read_request->uuid.len == LEN_UUID_16) && gatt_db::has_type(uuid16);
+    const auto *cursor =
+        indexed ? gatt_db::find_type(uuid16, read_request->s_handle) : nullptr;
 
-    util::unused(last_handle);
+    auto &builder = response_builder;
 
-    if (response == nullptr) {
-        return wiced_bt_gatt_status_e::WICED_BT_GATT_INSUF_RESOURCE;
-    }
+    builder.clear();
 
     while (true) {
         *error_handle = attr_handle;
-        last_handle = attr_handle;
 
-        attr_handle = wiced_bt_gatt_find_handle_by_type(
-            attr_handle, read_request->e_handle, &read_request->uuid);
+        if (indexed) {
+            if (cursor == gatt_db::type_index.end() ||
+                cursor->uuid16 != uuid16 ||
+                cursor->handle > read_request->e_handle) {
+                break;
+            }
+
+            attr_handle = cursor->handle;
+            attribute = &gatt_db::attributes[cursor->slot];
+            ++cursor;
+        } else {
+            attr_handle = wiced_bt_gatt_find_handle_by_type(
+                attr_handle, read_request->e_handle, &read_request->uuid);
 
-        if (attr_handle == 0) {
-            break;
+            if (attr_handle == 0) {
+                break;
+            }
+
+            attribute = ble_gatt_db_find_by_handle(attr_handle);
+
+            if (attribute == nullptr) {
+                return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+            }
         }
 
-        if ((attribute = ble_gatt_db_find_by_handle(attr_handle)) == nullptr) {
-            std::free(response);
-            return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+        const auto *value = attribute->on_read(connection_id, *attribute);
+
+        if (value == nullptr) {
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_READ_NOT_PERMIT;
         }
 
-        {
-            auto filled = wiced_bt_gatt_put_read_by_type_rsp_in_stream(
-                response + used, length_requested - used, &pair_length,
-                attr_handle, attribute->cur_len, attribute->p_data);
+        const auto length = std::min<uint16_t>(
+            gatt_db::current_length(*attribute), value_limit);
 
-            if (filled == 0) {
-                break;
-            }
+        if (builder.size() == 0) {
+            value_length = length;
+            pair_length = static_cast<uint8_t>(value_length + 2);
+        } else if (length != value_length ||
+                   builder.size() + pair_length > length_requested) {
+            break;
+        }
 
-            used += filled;
+        if (!builder.has_room(2, 2)) {
+            break;
         }
 
+        const uint8_t handle_bytes[] = {
+            static_cast<uint8_t>(attr_handle & 0xFF),
+            static_cast<uint8_t>(attr_handle >> 8)};
+
+        builder.add_header(handle_bytes, sizeof(handle_bytes));
+        builder.add_reference(value, value_length);
+
         ++attr_handle;
     }
 
-    if (used == 0) {
-        std::free(response);
+    if (builder.size() == 0) {
         return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
     }
 
-    wiced_bt_gatt_server_send_read_by_type_rsp(
-        connection_id, opcode, pair_length, used, response,
-        reinterpret_cast<void *>(std::free));
+    // Never sent in place: each value follows its handle, which is not in
+    // attribute storage, so a response is always more than one run
+    auto *response = ble_gatt_response_buffer_allocate(builder.size());
 
-    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+    if (response == nullptr) {
+        ble_gatt_statistics_object.add_allocation_failure(
+            gatt_operation::read_by_type);
+
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INSUF_RESOURCE;
+    }
+
+    ble_gatt_statistics_object.add_allocated_bytes(gatt_operation::read_by_type,
+                                                   builder.size());
+    ble_gatt_statistics_object.add_copied_bytes(gatt_operation::read_by_type,
+                                                builder.flatten(response));
+
+    const auto status = wiced_bt_gatt_server_send_read_by_type_rsp(
+        connection_id, opcode, pair_length, builder.size(), response,
+        reinterpret_cast<void *>(ble_gatt_response_buffer_release));
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        ble_gatt_response_buffer_release(response);
+    }
+
+    return status;
 }
 
 wiced_bt_gatt_status_t ble_gatt_request_read_multi_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
     wiced_bt_gatt_read_multiple_req_t *read_multiple_request,
     uint16_t length_requested, uint16_t *error_handle) {
-    auto *attribute = static_cast<gatt_db_lookup_table_t *>(nullptr);
-
-    auto *response = static_cast<uint8_t *>(std::malloc(length_requested));
+    auto *attribute = static_cast<const gatt_db::attribute *>(nullptr);
 
     auto handle = wiced_bt_gatt_get_handle_from_stream(
         read_multiple_request->p_handle_stream, 0);
 
-    auto used = 0;
-
     *error_handle = handle;
 
-    if (response == nullptr) {
-        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
-    }
+    const auto variable_length =
+        (opcode == wiced_bt_gatt_opcode_e::GATT_REQ_READ_MULTI_VAR_LENGTH);
+    const auto capacity = std::min<uint16_t>(
+        length_requested, static_cast<uint16_t>(BLE_GATT_RESPONSE_BLOCK_SIZE));
+
+    auto &builder = response_builder;
+    auto slots = uint32_t{};
+    auto in_place = !variable_length;
+
+    builder.clear();
 
     for (auto i = 0; i < read_multiple_request->num_handles; i++) {
         handle = wiced_bt_gatt_get_handle_from_stream(
@@ -374,32 +895,84 @@ wiced_bt_gatt_status_t ble_gatt_request_read_multi_handler(
         *error_handle = handle;
 
         if ((attribute = ble_gatt_db_find_by_handle(handle)) == nullptr) {
-            std::free(response);
-            return wiced_bt_gatt_status_e::WICED_BT_GATT_ERR_UNLIKELY;
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
         }
 
-        {
-            auto filled = wiced_bt_gatt_put_read_multi_rsp_in_stream(
-                opcode, response + used, length_requested - used,
-                attribute->handle, attribute->cur_len, attribute->p_data);
+        const auto *value = attribute->on_read(connection_id, *attribute);
 
-            if (!filled) {
-                break;
-            }
+        if (value == nullptr) {
+            return wiced_bt_gatt_status_e::WICED_BT_GATT_READ_NOT_PERMIT;
+        }
+
+        const auto length = gatt_db::current_length(*attribute);
+        auto room = static_cast<uint16_t>(capacity - builder.size());
 
-            used += filled;
+        if (room == 0 || (variable_length && room <= 2) ||
+            !builder.has_room(2, 2)) {
+            break;
+        }
+
+        if (variable_length) {
+            // Length tuples carry the full value length, even if truncated
+            const uint8_t length_bytes[] = {
+                static_cast<uint8_t>(length & 0xFF),
+                static_cast<uint8_t>(length >> 8)};
+
+            builder.add_header(length_bytes, sizeof(length_bytes));
+            room = static_cast<uint16_t>(room - sizeof(length_bytes));
+        }
+
+        builder.add_reference(value, std::min(length, room));
+
+        if (value == attribute->p_data) {
+            slots |= uint32_t{1} << gatt_db::slot_index(*attribute);
+        } else {
+            in_place = false;
         }
     }
 
-    if (used == 0) {
+    if (builder.size() == 0) {
         return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
     }
 
-    wiced_bt_gatt_server_send_read_multiple_rsp(
-        connection_id, opcode, used, response,
-        reinterpret_cast<void *>(std::free));
+    // One run of database storage goes out as is, pinned until transmitted
+    if (in_place && builder.segment_count() == 1) {
+        auto *data = const_cast<uint8_t *>(builder[0].data);
 
-    return wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS;
+        if (ble_gatt_pin(data, slots)) {
+            const auto status = wiced_bt_gatt_server_send_read_multiple_rsp(
+                connection_id, opcode, builder.size(), data,
+                reinterpret_cast<void *>(ble_gatt_pinned_release));
+
+            if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+                ble_gatt_pinned_release(data);
+            }
+
+            return status;
+        }
+    }
+
+    auto *response = read_multi_scratch.acquire(connection_id);
+
+    if (response == nullptr) {
+        ble_gatt_statistics_object.add_allocation_failure(
+            gatt_operation::read_multi);
+
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INSUF_RESOURCE;
+    }
+
+    ble_gatt_statistics_object.add_copied_bytes(gatt_operation::read_multi,
+                                                builder.flatten(response));
+
+    const auto status = wiced_bt_gatt_server_send_read_multiple_rsp(
+        connection_id, opcode, builder.size(), response,
+        reinterpret_cast<void *>(read_multi_scratch_release));
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        read_multi_scratch_release(response);
+    }
+
+    return status;
 }
 
 wiced_bt_gatt_status_t
@@ -409,18 +982,167 @@ ble_gatt_command_write_handler(wiced_bt_gatt_event_data_t *event_data,
 
     *error_handle = write_request->handle;
 
-    CY_ASSERT((p_data != nullptr) && (p_write_req != nullptr));
+    const auto *attribute = ble_gatt_db_find_by_handle(write_request->handle);
+
+    if (attribute == nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+    }
 
-    switch (write_request->handle) {
-    case HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG:
-    case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE:
-    case HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE:
-        return ble_context_object.ota_agent_write_handler(event_data,
-                                                          error_handle);
+    return attribute->on_write(event_data, error_handle);
+}
 
-    default:
-        return ble_gatt_db_set_value(write_request->handle,
-                                     write_request->p_val,
-                                     write_request->val_len);
+wiced_bt_gatt_status_t ble_gatt_request_prepare_write_handler(
+    uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
+    wiced_bt_gatt_write_req_t *write_request, uint16_t *error_handle) {
+    *error_handle = write_request->handle;
+
+    if (ble_gatt_db_find_by_handle(write_request->handle) == nullptr) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_HANDLE;
+    }
+
+    auto *queue = prepare_queue_find(connection_id, true);
+
+    if (queue == nullptr ||
+        !queue->push(write_request->handle, write_request->offset,
+                     write_request->p_val, write_request->val_len)) {
+        return wiced_bt_gatt_status_e::WICED_BT_GATT_PREPARE_Q_FULL;
+    }
+
+    ble_gatt_statistics_object.add_payload_bytes(gatt_operation::prepare_write,
+                                                 write_request->val_len);
+
+    return wiced_bt_gatt_server_send_prepare_write_rsp(connection_id, opcode,
+                                                       write_request);
+}
+
+wiced_bt_gatt_status_t
+ble_gatt_request_execute_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                                       uint16_t *error_handle) {
+    using check = ble_gatt_prepare_queue::check;
+
+    auto *attr_request = &event_data->attribute_request;
+    auto *queue = prepare_queue_find(attr_request->conn_id, false);
+
+    if (queue == nullptr || attr_request->data.exec_write_req.exec_write ==
+                                GATT_PREPARE_WRITE_CANCEL) {
+        if (queue != nullptr) {
+            queue->clear();
+        }
+
+        return wiced_bt_gatt_server_send_execute_write_rsp(
+            attr_request->conn_id, attr_request->opcode);
+    }
+
+    // Readable values are extended in place; write-only values forwarded
+    // elsewhere (OTA) are rebuilt from the fragments alone
+    const auto bounds = [connection_id = attr_request->conn_id](
+                            const gatt_db::attribute &attribute,
+                            uint16_t &current_length, uint16_t &capacity) {
+        const auto *value = attribute.on_read(connection_id, attribute);
+
+        if (value == nullptr) {
+            current_length = 0;
+            capacity = static_cast<uint16_t>(prepare_execute_value.size());
+        } else {
+            current_length = gatt_db::current_length(attribute);
+            capacity = attribute.max_len;
+        }
+
+        return value;
+    };
+
+    // Final value of a handle, in prepare_execute_value
+    const auto assemble = [&bounds,
+                           queue](const gatt_db::attribute &attribute) {
+        auto current_length = uint16_t{};
+        auto capacity = uint16_t{};
+
+        const auto *value = bounds(attribute, current_length, capacity);
+
+        if (value != nullptr) {
+            std::memcpy(prepare_execute_value.data(), value, current_length);
+        }
+
+        return queue->assemble(attribute.handle, prepare_execute_value.data(),
+                               current_length);
+    };
+
+    // First pass: every final value must be accepted, by the length bounds
+    // and by the attribute's own checks, before any is written, so the
+    // queue applies all-or-nothing
+    for (auto i = std::size_t{}; i < queue->size(); i++) {
+        if (!queue->first_of_handle(i)) {
+            continue;
+        }
+
+        const auto handle = (*queue)[i].handle;
+        const auto *attribute = ble_gatt_db_find_by_handle(handle);
+
+        auto current_length = uint16_t{};
+        auto capacity = uint16_t{};
+
+        bounds(*attribute, current_length, capacity);
+
+        const auto result = queue->validate(handle, current_length, capacity);
+
+        auto status = wiced_bt_gatt_status_t{
+            wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_ATTR_LEN};
+
+        if (result == check::ok) {
+            const auto length = assemble(*attribute);
+
+            status = attribute->on_check(attr_request->conn_id, *attribute,
+                                         prepare_execute_value.data(), length);
+        } else if (result == check::invalid_offset) {
+            status = wiced_bt_gatt_status_e::WICED_BT_GATT_INVALID_OFFSET;
+        }
+
+        if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+            *error_handle = handle;
+            queue->clear();
+
+            return status;
+        }
+    }
+
+    auto status = wiced_bt_gatt_status_t{
+        wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS};
+
+    // Second pass: build each final value and apply it like a write request
+    for (auto i = std::size_t{}; i < queue->size(); i++) {
+        if (!queue->first_of_handle(i)) {
+            continue;
+        }
+
+        const auto handle = (*queue)[i].handle;
+        const auto length = assemble(*ble_gatt_db_find_by_handle(handle));
+
+        auto write_event = wiced_bt_gatt_event_data_t{};
+        auto &request = write_event.attribute_request;
+
+        request.conn_id = attr_request->conn_id;
+        request.opcode = attr_request->opcode;
+        request.data.write_req.handle = handle;
+        request.data.write_req.offset = 0;
+        request.data.write_req.p_val = prepare_execute_value.data();
+        request.data.write_req.val_len = length;
+
+        ble_gatt_statistics_object.add_payload_bytes(
+            gatt_operation::execute_write, request.data.write_req.val_len);
+
+        status = ble_gatt_command_write_handler(&write_event, error_handle);
+
+        if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+            break;
+        }
     }
+
+    queue->clear();
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        return status;
+    }
+
+    return wiced_bt_gatt_server_send_execute_write_rsp(attr_request->conn_id,
+                                                       attr_request->opcode);
 }
@@ -25,12 +25,107 @@ extern "C" {
 }
 #pragma GCC diagnostic pop
 
+#include "ble_gatt_db.hpp"
+#include "ble_gatt_prepare_queue.hpp"
+#include "ble_gatt_response_builder.hpp"
+#include "block_pool.hpp"
+
+///
+/// \brief Size of each GATT response buffer in bytes
+///
+/// Matches the largest ATT MTU configured in design.cybt, so a single block
+/// holds any response the stack can request.
+///
+constexpr auto BLE_GATT_RESPONSE_BLOCK_SIZE = std::size_t{517};
+
+///
+/// \brief Number of GATT response buffers reserved at startup
+///
+constexpr auto BLE_GATT_RESPONSE_BLOCK_COUNT = std::size_t{4};
+
+///
+/// \brief Pool serving every GATT response buffer handed to the stack
+///
+using ble_gatt_response_pool =
+    block_pool<BLE_GATT_RESPONSE_BLOCK_SIZE, BLE_GATT_RESPONSE_BLOCK_COUNT>;
+
+///
+/// \brief Bytes of prepared-write payload queued per connection
+///
+/// The longest attribute value ATT allows, so one long write of any
+/// attribute fits.
+///
+constexpr auto BLE_GATT_PREPARE_ARENA_SIZE = std::size_t{512};
+
+///
+/// \brief Prepared-write fragments queued per connection
+///
+constexpr auto BLE_GATT_PREPARE_MAX_FRAGMENTS = std::size_t{16};
+
+///
+/// \brief Per-connection queue behind Prepare Write and Execute Write
+///
+using ble_gatt_prepare_queue =
+    prepare_write_queue<BLE_GATT_PREPARE_ARENA_SIZE,
+                        BLE_GATT_PREPARE_MAX_FRAGMENTS>;
+
+///
+/// \brief Segments a multi-attribute read response can be made of
+///
+/// A handle (or length) header and a value per attribute; the database
+/// holds far fewer attributes, but Read Multiple may repeat handles.
+///
+constexpr auto BLE_GATT_RESPONSE_MAX_SEGMENTS = std::size_t{64};
+
+///
+/// \brief Bytes of PDU headers a multi-attribute read response can hold
+///
+constexpr auto BLE_GATT_RESPONSE_HEADER_CAPACITY = std::size_t{128};
+
+///
+/// \brief Scatter-gather builder behind Read By Type and Read Multiple
+///
+using ble_gatt_response_builder =
+    gatt_response_builder<BLE_GATT_RESPONSE_MAX_SEGMENTS,
+                          BLE_GATT_RESPONSE_HEADER_CAPACITY>;
+
+///
+/// \brief Allocate a GATT response buffer
+///
+/// \param length Number of bytes required
+///
+/// \return uint8_t* Pointer to a pool block, or nullptr if \p length exceeds
+///         BLE_GATT_RESPONSE_BLOCK_SIZE or every block is in flight
+///
+uint8_t *ble_gatt_response_buffer_allocate(uint16_t length);
+
+///
+/// \brief Release a GATT response buffer
+///
+/// Passed to the stack as the application context of every pooled response,
+/// and invoked on GATT_APP_BUFFER_TRANSMITTED_EVT.
+///
+/// \param buffer Buffer returned by ble_gatt_response_buffer_allocate()
+///
+void ble_gatt_response_buffer_release(uint8_t *buffer);
+
+///
+/// \brief Get GATT response pool usage counters
+///
+/// \return ble_gatt_response_pool::statistics Blocks in use, high-water mark,
+///         allocation and exhaustion counts
+///
+ble_gatt_response_pool::statistics ble_gatt_response_pool_stats();
+
 ///
 /// \brief Set value in GATT database
 ///
 /// Updates the value and current length of an attribute in the GATT database.
 /// If the new length is smaller than the maximum length, the remaining buffer
 /// is zeroed for deterministic BLE reads of variable-length characteristics.
+/// While a read response sent straight from the value storage is still in
+/// flight, the update is held back and applied once the stack has
+/// transmitted the response. Safe to call from any task.
 ///
 /// \param attr_handle Attribute handle to update
 /// \param value Pointer to new value data (must not be NULL if length > 0)
@@ -39,8 +134,7 @@ extern "C" {
 /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if value set
 ///         successfully, WICED_BT_GATT_INVALID_HANDLE if handle not found,
 ///         WICED_BT_GATT_INVALID_ATTR_LEN if length exceeds maximum,
-///         WICED_BT_GATT_INVALID_PDU if value is NULL when length > 0,
-///         WICED_BT_GATT_ERROR if attribute data pointer is NULL
+///         WICED_BT_GATT_INVALID_PDU if value is NULL when length > 0
 ///
 wiced_bt_gatt_status_t ble_gatt_db_set_value(uint16_t attr_handle,
                                              uint8_t *value, uint16_t length);
@@ -48,15 +142,27 @@ wiced_bt_gatt_status_t ble_gatt_db_set_value(uint16_t attr_handle,
 ///
 /// \brief Find GATT attribute by handle
 ///
-/// Searches the GATT database lookup table for an entry matching the specified
-/// attribute handle using a linear search algorithm.
+/// Resolves the attribute handle through the compile-time slot map in
+/// ble_gatt_db.hpp with a single array index.
 ///
 /// \param handle Attribute handle to search for
 ///
-/// \return gatt_db_lookup_table_t* Pointer to matching attribute entry,
-///         or NULL if handle not found in database
+/// \return const gatt_db::attribute* Pointer to the attribute metadata, or
+///         NULL if the handle has no application storage
+///
+const gatt_db::attribute *ble_gatt_db_find_by_handle(uint16_t handle);
+
+///
+/// \brief Check the attribute description against the configurator output
 ///
-gatt_db_lookup_table_t *ble_gatt_db_find_by_handle(uint16_t handle);
+/// The value arrays in cycfg_gatt_db.h are declared without a size, so
+/// their capacities cannot be checked at compile time. The lookup table
+/// generated next to them carries the handle, capacity, initial length and
+/// storage of every value; each must match \ref gatt_db::attributes.
+///
+/// \return true if the configurator table describes the same attributes
+///
+bool ble_gatt_db_matches_configurator();
 
 ///
 /// \brief Main GATT event callback
@@ -102,7 +208,9 @@ ble_gatt_event_handler(wiced_bt_gatt_event_data_t *event_data,
 /// Processes GATT_REQ_READ and GATT_REQ_READ_BLOB operations. Validates the
 /// requested attribute handle, checks offset bounds, and sends the requested
 /// attribute data back to the client. Supports partial reads via offset
-/// parameter.
+/// parameter. Values in the shared GATT database are sent straight from their
+/// storage, which stays pinned until the stack has transmitted the response;
+/// per-connection values are copied into a pooled response buffer.
 ///
 /// \param connection_id BLE connection identifier
 /// \param opcode GATT operation code (GATT_REQ_READ or GATT_REQ_READ_BLOB)
@@ -114,7 +222,10 @@ ble_gatt_event_handler(wiced_bt_gatt_event_data_t *event_data,
 ///
 /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if read successful,
 ///         WICED_BT_GATT_INVALID_HANDLE if attribute not found,
-///         WICED_BT_GATT_INVALID_OFFSET if offset exceeds attribute length
+///         WICED_BT_GATT_READ_NOT_PERMIT if the attribute is write-only,
+///         WICED_BT_GATT_INVALID_OFFSET if offset exceeds attribute length,
+///         WICED_BT_GATT_INSUF_RESOURCE if the value must be copied and no
+///         response buffer is available
 ///
 wiced_bt_gatt_status_t ble_gatt_request_read_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
@@ -127,7 +238,12 @@ wiced_bt_gatt_status_t ble_gatt_request_read_handler(
 /// Processes GATT_REQ_READ_BY_TYPE operations. Searches for all attributes
 /// within the specified handle range that match the requested UUID type,
 /// constructs a response containing handle-value pairs, and sends it to the
-/// client. Allocates dynamic memory for response buffer.
+/// client. 16-bit types are looked up in the compile-time type index of
+/// ble_gatt_db.hpp (a binary search, then a walk over adjacent entries);
+/// other types through the stack's search of the flat database. The pairs
+/// are collected with a scatter-gather builder that copies only the handles
+/// and references the values in place, then flattened once into a buffer
+/// from the GATT response pool sized to the response.
 ///
 /// \param connection_id BLE connection identifier
 /// \param opcode GATT operation code (GATT_REQ_READ_BY_TYPE)
@@ -139,7 +255,8 @@ wiced_bt_gatt_status_t ble_gatt_request_read_handler(
 ///
 /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if read successful,
 ///         WICED_BT_GATT_INVALID_HANDLE if no matching attributes found,
-///         WICED_BT_GATT_INSUF_RESOURCE if memory allocation fails
+///         WICED_BT_GATT_READ_NOT_PERMIT if a match is write-only,
+///         WICED_BT_GATT_INSUF_RESOURCE if no response buffer is available
 ///
 wiced_bt_gatt_status_t ble_gatt_request_read_by_type_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
@@ -151,8 +268,13 @@ wiced_bt_gatt_status_t ble_gatt_request_read_by_type_handler(
 ///
 /// Processes GATT_REQ_READ_MULTI and GATT_REQ_READ_MULTI_VAR_LENGTH operations.
 /// Reads multiple attributes in a single request by iterating through the
-/// provided handle list and concatenating their values into a single response
-/// buffer. Allocates dynamic memory for response.
+/// provided handle list and concatenating their values into a single response.
+/// The response is first described with a scatter-gather builder. When it is
+/// a single run of database storage (one handle, or values stored back to
+/// back) it is sent in place and the attributes stay pinned until
+/// transmitted; otherwise it is flattened once into a scratch buffer owned by
+/// the requesting connection and reused once the stack has transmitted it.
+/// This path performs no heap allocation.
 ///
 /// \param connection_id BLE connection identifier
 /// \param opcode GATT operation code (GATT_REQ_READ_MULTI or
@@ -164,9 +286,10 @@ wiced_bt_gatt_status_t ble_gatt_request_read_by_type_handler(
 ///        error for error response generation
 ///
 /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if read successful,
-///         WICED_BT_GATT_INVALID_HANDLE if any handle not found or memory
-///         allocation fails, WICED_BT_GATT_ERR_UNLIKELY if attribute lookup
-///         fails
+///         WICED_BT_GATT_INVALID_HANDLE if any handle is not found or no
+///         value fits in the response, WICED_BT_GATT_READ_NOT_PERMIT if any
+///         handle is write-only, WICED_BT_GATT_INSUF_RESOURCE if the
+///         connection's scratch buffer is unavailable
 ///
 wiced_bt_gatt_status_t ble_gatt_request_read_multi_handler(
     uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
@@ -177,9 +300,12 @@ wiced_bt_gatt_status_t ble_gatt_request_read_multi_handler(
 /// \brief Handle GATT write request
 ///
 /// Processes GATT_REQ_WRITE, GATT_CMD_WRITE, and GATT_CMD_SIGNED_WRITE
-/// operations. Routes OTA-specific writes to the OTA handler, and all other
-/// writes to the database update function. Automatically sends write response
-/// for GATT_REQ_WRITE operations on success.
+/// operations. Dispatches the write to the attribute's write hook from the
+/// compile-time table in ble_gatt_db.hpp with a single indexed call: OTA
+/// attributes go to the OTA handlers, per-connection descriptors (the Battery
+/// Level CCCD) to the writer's connection table entry, and all other writes
+/// to the database update function. Automatically sends write response for
+/// GATT_REQ_WRITE operations on success.
 ///
 /// \param event_data Pointer to GATT event data containing write request with
 ///        handle, value, and length information
@@ -187,10 +313,56 @@ wiced_bt_gatt_status_t ble_gatt_request_read_multi_handler(
 ///        error for error response generation
 ///
 /// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if write successful,
-///         or error code from OTA handler or database update function
+///         WICED_BT_GATT_INVALID_HANDLE if the handle has no application
+///         storage, or error code from OTA handler or database update function
 ///
 wiced_bt_gatt_status_t
 ble_gatt_command_write_handler(wiced_bt_gatt_event_data_t *event_data,
                                uint16_t *error_handle);
 
+///
+/// \brief Handle GATT prepare write request
+///
+/// Processes GATT_REQ_PREPARE_WRITE operations. Queues the fragment in the
+/// requesting connection's prepared-write queue and echoes it back to the
+/// client. Offsets and lengths are checked when the queue is executed.
+///
+/// \param connection_id BLE connection identifier
+/// \param opcode GATT operation code (GATT_REQ_PREPARE_WRITE)
+/// \param write_request Pointer to the fragment (handle, offset and value)
+/// \param error_handle Pointer to variable that receives the handle causing an
+///        error for error response generation
+///
+/// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if queued,
+///         WICED_BT_GATT_INVALID_HANDLE if the handle has no application
+///         storage, WICED_BT_GATT_PREPARE_Q_FULL if the queue has no room
+///
+wiced_bt_gatt_status_t ble_gatt_request_prepare_write_handler(
+    uint16_t connection_id, wiced_bt_gatt_opcode_t opcode,
+    wiced_bt_gatt_write_req_t *write_request, uint16_t *error_handle);
+
+///
+/// \brief Handle GATT execute write request
+///
+/// Processes GATT_REQ_EXECUTE_WRITE operations. On cancel the queue is
+/// discarded. On execute the final value of every queued handle is first
+/// checked against its length bounds and by the attribute's check hook; only
+/// if all pass is each value applied through the same write hook as a write
+/// request (ble_gatt_db_set_value() for database attributes). The queue is
+/// empty afterwards in every case.
+///
+/// \param event_data Pointer to GATT event data containing the execute write
+///        request
+/// \param error_handle Pointer to variable that receives the handle causing an
+///        error for error response generation
+///
+/// \return wiced_bt_gatt_status_t WICED_BT_GATT_SUCCESS if executed or
+///         cancelled, WICED_BT_GATT_INVALID_OFFSET or
+///         WICED_BT_GATT_INVALID_ATTR_LEN if a fragment does not fit its
+///         attribute, or the error of the check or write hook
+///
+wiced_bt_gatt_status_t
+ble_gatt_request_execute_write_handler(wiced_bt_gatt_event_data_t *event_data,
+                                       uint16_t *error_handle);
+
 #endif /* BLE_GATT_HPP */
@@ -0,0 +1,506 @@
+///
+/// \file    ble_gatt_db.hpp
+/// \brief   Compile-time description of the GATT database
+///
+/// \details This header describes the services, characteristics and
+///          descriptors served by the application as constexpr data. From
+///          that description it emits, at compile time, the flat GATT
+///          database handed to wiced_bt_gatt_db_init(), a dense handle to
+///          slot map and per-attribute metadata. Attribute lookups are a
+///          single array index and only the current value lengths live in
+///          RAM next to the value storage itself. Every attribute carries
+///          its read and write hooks, so serving a request is one indexed
+///          call whatever the attribute. A type index sorted by
+///          16-bit UUID and handle serves Read By Type with a binary search
+///          and a walk over adjacent entries.
+///
+///          Handle constants, UUIDs and value storage still come from the
+///          Bluetooth Configurator output (cycfg_gatt_db.h), so design.cybt
+///          remains the reference for the layout; static_asserts below keep
+///          this description consistent with it.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Compile-time GATT database
+///
+
+#ifndef BLE_GATT_DB_HPP
+#define BLE_GATT_DB_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gatt_db.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_uuid.h"
+}
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gatt_db {
+
+///
+/// \brief Flat GATT database in the WICED stack format
+///
+/// Built entirely from the stack's constexpr-friendly attribute macros, so the
+/// array is placed in flash and costs no RAM.
+///
+inline constexpr uint8_t database[] = {
+    // Generic Access
+    PRIMARY_SERVICE_UUID16(HDLS_GAP, UUID_SERVICE_GAP),
+    CHARACTERISTIC_UUID16(HDLC_GAP_DEVICE_NAME, HDLC_GAP_DEVICE_NAME_VALUE,
+                          UUID_CHARACTERISTIC_DEVICE_NAME,
+                          GATTDB_CHAR_PROP_READ, GATTDB_PERM_READABLE),
+    CHARACTERISTIC_UUID16(HDLC_GAP_APPEARANCE, HDLC_GAP_APPEARANCE_VALUE,
+                          UUID_CHARACTERISTIC_APPEARANCE, GATTDB_CHAR_PROP_READ,
+                          GATTDB_PERM_READABLE),
+
+    // Generic Attribute
+    PRIMARY_SERVICE_UUID16(HDLS_GATT, UUID_SERVICE_GATT),
+
+    // Battery Service
+    PRIMARY_SERVICE_UUID16(HDLS_BAS, UUID_SERVICE_BATTERY),
+    CHARACTERISTIC_UUID16(HDLC_BAS_BATTERY_LEVEL, HDLC_BAS_BATTERY_LEVEL_VALUE,
+                          UUID_CHARACTERISTIC_BATTERY_LEVEL,
+                          GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+                          GATTDB_PERM_READABLE),
+    CHAR_DESCRIPTOR_UUID16(HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT,
+                           UUID_DESCRIPTOR_CHARACTERISTIC_PRESENTATION_FORMAT,
+                           GATTDB_PERM_READABLE),
+    CHAR_DESCRIPTOR_UUID16_WRITABLE(
+        HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+        UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+        GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+
+    // OTA FW Upgrade Service
+    PRIMARY_SERVICE_UUID128(HDLS_OTA_FW_UPGRADE_SERVICE,
+                            __UUID_SERVICE_OTA_FW_UPGRADE_SERVICE),
+    CHARACTERISTIC_UUID128_WRITABLE(
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT,
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE,
+        __UUID_CHARACTERISTIC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT,
+        GATTDB_CHAR_PROP_WRITE | GATTDB_CHAR_PROP_NOTIFY |
+            GATTDB_CHAR_PROP_INDICATE,
+        GATTDB_PERM_WRITE_REQ),
+    CHAR_DESCRIPTOR_UUID16_WRITABLE(
+        HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG,
+        UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+        GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ |
+            GATTDB_PERM_VARIABLE_LENGTH),
+    CHARACTERISTIC_UUID128_WRITABLE(
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA,
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE,
+        __UUID_CHARACTERISTIC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA,
+        GATTDB_CHAR_PROP_WRITE,
+        GATTDB_PERM_VARIABLE_LENGTH | GATTDB_PERM_WRITE_REQ |
+            GATTDB_PERM_RELIABLE_WRITE),
+};
+
+///
+/// \brief Size of the flat GATT database in bytes
+///
+inline constexpr auto database_size = static_cast<uint16_t>(sizeof(database));
+
+struct attribute;
+
+///
+/// \brief Consumer of client writes to an attribute
+///
+/// Called for write requests and commands, and for each value of an
+/// executed prepared write, with the handle, value and length in
+/// event_data->attribute_request.data.write_req.
+///
+using write_hook = wiced_bt_gatt_status_t (*)(
+    wiced_bt_gatt_event_data_t *event_data, uint16_t *error_handle);
+
+///
+/// \brief Source of the value a connection reads from an attribute
+///
+/// Returns storage holding at least the attribute's current length, or
+/// nullptr if the attribute cannot be read.
+///
+using read_hook = uint8_t *(*)(uint16_t connection_id,
+                               const attribute &entry);
+
+///
+/// \brief Check of a value an executed prepared write is about to apply
+///
+/// Returns the status the attribute's write hook would return for the value,
+/// without applying it, so a queue is only applied once every value passes.
+///
+using check_hook = wiced_bt_gatt_status_t (*)(uint16_t connection_id,
+                                              const attribute &entry,
+                                              const uint8_t *value,
+                                              uint16_t length);
+
+// Hooks shared by the attributes below, defined in ble_gatt.cpp
+
+/// Stores the value through ble_gatt_db_set_value()
+wiced_bt_gatt_status_t write_value(wiced_bt_gatt_event_data_t *event_data,
+                                   uint16_t *error_handle);
+
+/// Stores the Battery Level CCCD in the writer's connection table entry
+wiced_bt_gatt_status_t write_bas_cccd(wiced_bt_gatt_event_data_t *event_data,
+                                      uint16_t *error_handle);
+
+/// Runs an OTA upgrade command
+wiced_bt_gatt_status_t
+write_ota_control_point(wiced_bt_gatt_event_data_t *event_data,
+                        uint16_t *error_handle);
+
+/// Saves the OTA control point notify/indicate configuration
+wiced_bt_gatt_status_t write_ota_cccd(wiced_bt_gatt_event_data_t *event_data,
+                                      uint16_t *error_handle);
+
+/// Decodes and stages a piece of the OTA image
+wiced_bt_gatt_status_t write_ota_data(wiced_bt_gatt_event_data_t *event_data,
+                                      uint16_t *error_handle);
+
+/// Reads the shared GATT database storage
+uint8_t *read_value(uint16_t connection_id, const attribute &entry);
+
+/// Reads the Battery Level CCCD of the reading connection
+uint8_t *read_bas_cccd(uint16_t connection_id, const attribute &entry);
+
+/// Refuses the read of a write-only attribute
+uint8_t *read_not_permitted(uint16_t connection_id, const attribute &entry);
+
+/// Accepts any value that fits the storage
+wiced_bt_gatt_status_t check_value(uint16_t connection_id,
+                                   const attribute &entry,
+                                   const uint8_t *value, uint16_t length);
+
+/// Accepts what write_bas_cccd() stores
+wiced_bt_gatt_status_t check_bas_cccd(uint16_t connection_id,
+                                      const attribute &entry,
+                                      const uint8_t *value, uint16_t length);
+
+/// Accepts a known OTA command from the connection that may send it
+wiced_bt_gatt_status_t check_ota_control_point(uint16_t connection_id,
+                                               const attribute &entry,
+                                               const uint8_t *value,
+                                               uint16_t length);
+
+/// Accepts what write_ota_cccd() saves
+wiced_bt_gatt_status_t check_ota_cccd(uint16_t connection_id,
+                                      const attribute &entry,
+                                      const uint8_t *value, uint16_t length);
+
+/// Accepts image data from the connection that owns the OTA session
+wiced_bt_gatt_status_t check_ota_data(uint16_t connection_id,
+                                      const attribute &entry,
+                                      const uint8_t *value, uint16_t length);
+
+/// Type of an attribute whose UUID is 128-bit (not in the type index)
+inline constexpr auto no_uuid16 = uint16_t{};
+
+///
+/// \brief Per-attribute metadata for attributes with application storage
+///
+struct attribute {
+    uint16_t handle;      ///< Attribute handle
+    uint16_t uuid16;      ///< Attribute type, or no_uuid16 if 128-bit
+    uint16_t max_len;     ///< Capacity of the value storage in bytes
+    uint16_t initial_len; ///< Length of the configured initial value
+    uint8_t *p_data;      ///< Value storage (owned by cycfg_gatt_db.c)
+    write_hook on_write;  ///< Consumer of client writes
+    read_hook on_read;    ///< Source of client reads
+    check_hook on_check;  ///< Check of an executed prepared write
+};
+
+///
+/// \brief Attributes backed by application storage, ordered by handle
+///
+inline constexpr auto attributes = std::array<attribute, 8>{{
+    {HDLC_GAP_DEVICE_NAME_VALUE, UUID_CHARACTERISTIC_DEVICE_NAME, 14, 14,
+     app_gap_device_name, write_value, read_value, check_value},
+    {HDLC_GAP_APPEARANCE_VALUE, UUID_CHARACTERISTIC_APPEARANCE, 2, 2,
+     app_gap_appearance, write_value, read_value, check_value},
+    {HDLC_BAS_BATTERY_LEVEL_VALUE, UUID_CHARACTERISTIC_BATTERY_LEVEL, 1, 1,
+     app_bas_battery_level, write_value, read_value, check_value},
+    {HDLD_BAS_BATTERY_LEVEL_CHAR_PRESENTATION_FORMAT,
+     UUID_DESCRIPTOR_CHARACTERISTIC_PRESENTATION_FORMAT, 7, 7,
+     app_bas_battery_level_char_presentation_format, write_value, read_value,
+     check_value},
+    {HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG,
+     UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION, 2, 2,
+     app_bas_battery_level_client_char_config, write_bas_cccd, read_bas_cccd,
+     check_bas_cccd},
+    {HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_VALUE, no_uuid16,
+     1, 0, app_ota_fw_upgrade_service_ota_upgrade_control_point,
+     write_ota_control_point, read_not_permitted, check_ota_control_point},
+    {HDLD_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_CONTROL_POINT_CLIENT_CHAR_CONFIG,
+     UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION, 2, 2,
+     app_ota_fw_upgrade_service_ota_upgrade_control_point_client_char_config,
+     write_ota_cccd, read_value, check_ota_cccd},
+    {HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE, no_uuid16, 1, 0,
+     app_ota_fw_upgrade_service_ota_upgrade_data, write_ota_data,
+     read_not_permitted, check_ota_data},
+}};
+
+/// Number of attributes backed by application storage
+inline constexpr auto attribute_count = attributes.size();
+
+/// Largest handle with application storage
+inline constexpr auto max_handle = attributes[attribute_count - 1].handle;
+
+/// Slot value marking a handle without application storage
+inline constexpr auto no_slot = uint8_t{0xFF};
+
+///
+/// \brief Validate the attribute description
+///
+/// \return true if handles are non-zero and strictly ascending, and every
+///         attribute has storage whose length bounds are consistent and
+///         all its hooks
+///
+constexpr bool attributes_valid() noexcept {
+    auto previous = uint16_t{};
+
+    for (const auto &entry : attributes) {
+        if (entry.handle == 0 || entry.handle <= previous) {
+            return false;
+        }
+
+        if (entry.max_len == 0 || entry.initial_len > entry.max_len ||
+            entry.p_data == nullptr || entry.on_write == nullptr ||
+            entry.on_read == nullptr || entry.on_check == nullptr) {
+            return false;
+        }
+
+        previous = entry.handle;
+    }
+
+    return true;
+}
+
+static_assert(attributes_valid(),
+              "GATT attributes must have non-zero, strictly ascending handles, "
+              "consistent storage bounds and all hooks");
+static_assert(attribute_count < no_slot,
+              "GATT attribute count exceeds the slot map range");
+static_assert(sizeof(database) <= UINT16_MAX,
+              "GATT database exceeds the stack's 16-bit size");
+
+///
+/// \brief Get the largest value capacity of any attribute
+///
+constexpr uint16_t max_value_length() noexcept {
+    auto length = uint16_t{};
+
+    for (const auto &entry : attributes) {
+        length = std::max(length, entry.max_len);
+    }
+
+    return length;
+}
+
+///
+/// \brief Build the dense handle to slot map
+///
+/// \return Array indexed by handle holding the attribute slot, or no_slot
+///
+constexpr auto make_slot_map() noexcept {
+    auto map = std::array<uint8_t, max_handle + 1>{};
+
+    for (auto &slot : map) {
+        slot = no_slot;
+    }
+
+    for (auto i = std::size_t{}; i < attribute_count; i++) {
+        map[attributes[i].handle] = static_cast<uint8_t>(i);
+    }
+
+    return map;
+}
+
+///
+/// \brief Dense handle to slot map, resolved at compile time
+///
+inline constexpr auto slot_map = make_slot_map();
+
+///
+/// \brief Resolve an attribute handle to its slot
+///
+/// \param handle Attribute handle
+///
+/// \return std::size_t Index into \ref attributes, or no_slot if the handle
+///         has no application storage
+///
+constexpr std::size_t slot_of(uint16_t handle) noexcept {
+    return (handle <= max_handle) ? slot_map[handle] : no_slot;
+}
+
+static_assert(slot_of(HDLC_BAS_BATTERY_LEVEL_VALUE) != no_slot &&
+                  slot_of(HDLD_BAS_BATTERY_LEVEL_CLIENT_CHAR_CONFIG) !=
+                      no_slot,
+              "Battery Service attributes must have application storage");
+
+///
+/// \brief Entry of the type index
+///
+struct type_entry {
+    uint16_t uuid16; ///< Attribute type
+    uint16_t handle; ///< Attribute handle
+    uint8_t slot;    ///< Index into \ref attributes
+};
+
+///
+/// \brief Count the attributes whose type is a 16-bit UUID
+///
+constexpr std::size_t count_uuid16_types() noexcept {
+    auto count = std::size_t{};
+
+    for (const auto &entry : attributes) {
+        count += (entry.uuid16 != no_uuid16) ? 1 : 0;
+    }
+
+    return count;
+}
+
+/// Number of attributes in the type index
+inline constexpr auto type_count = count_uuid16_types();
+
+///
+/// \brief Build the type index
+///
+/// \return Attributes with a 16-bit type, sorted by type then handle
+///
+constexpr auto make_type_index() noexcept {
+    auto index = std::array<type_entry, type_count>{};
+    auto size = std::size_t{};
+
+    // Insertion sort; attributes are already ordered by handle, so equal
+    // types stay in handle order
+    for (auto i = std::size_t{}; i < attribute_count; i++) {
+        if (attributes[i].uuid16 == no_uuid16) {
+            continue;
+        }
+
+        auto position = size++;
+
+        while (position > 0 &&
+               index[position - 1].uuid16 > attributes[i].uuid16) {
+            index[position] = index[position - 1];
+            --position;
+        }
+
+        index[position] = {attributes[i].uuid16, attributes[i].handle,
+                           static_cast<uint8_t>(i)};
+    }
+
+    return index;
+}
+
+///
+/// \brief Type index, resolved at compile time
+///
+inline constexpr auto type_index = make_type_index();
+
+///
+/// \brief Find the first attribute of a type at or after a handle
+///
+/// \param uuid16 Attribute type
+/// \param start_handle First handle of the search range
+///
+/// \return const type_entry* First matching entry; walk forward while the
+///         type matches and the handle is in range. type_index.end() if
+///         there is none.
+///
+inline const type_entry *find_type(uint16_t uuid16,
+                                   uint16_t start_handle) noexcept {
+    return std::lower_bound(type_index.begin(), type_index.end(),
+                            type_entry{uuid16, start_handle, 0},
+                            [](const type_entry &lhs, const type_entry &rhs) {
+                                return (lhs.uuid16 != rhs.uuid16)
+                                           ? lhs.uuid16 < rhs.uuid16
+                                           : lhs.handle < rhs.handle;
+                            });
+}
+
+///
+/// \brief Whether any attribute with application storage has a type
+///
+/// \param uuid16 Attribute type
+///
+inline bool has_type(uint16_t uuid16) noexcept {
+    const auto *entry = find_type(uuid16, 0);
+
+    return entry != type_index.end() && entry->uuid16 == uuid16;
+}
+
+///
+/// \brief Build the initial current-length table
+///
+/// \return Array of the configured initial value lengths, indexed by slot
+///
+constexpr auto make_initial_lengths() noexcept {
+    auto lengths = std::array<uint16_t, attribute_count>{};
+
+    for (auto i = std::size_t{}; i < attribute_count; i++) {
+        lengths[i] = attributes[i].initial_len;
+    }
+
+    return lengths;
+}
+
+///
+/// \brief Current value length of every attribute, indexed by slot
+///
+/// The only per-attribute state kept in RAM besides the values themselves.
+///
+inline auto current_lengths = make_initial_lengths();
+
+///
+/// \brief Get the slot of an attribute
+///
+/// \param entry Attribute from \ref attributes
+///
+/// \return std::size_t Index of \p entry in \ref attributes
+///
+inline std::size_t slot_index(const attribute &entry) noexcept {
+    return static_cast<std::size_t>(&entry - attributes.data());
+}
+
+///
+/// \brief Access the current value length of an attribute
+///
+/// \param entry Attribute from \ref attributes
+///
+/// \return uint16_t& Current length of the attribute's value
+///
+inline uint16_t &current_length(const attribute &entry) noexcept {
+    return current_lengths[slot_index(entry)];
+}
+
+///
+/// \brief Build the per-slot offsets into a buffer of one value per attribute
+///
+/// \return Array of prefix sums of max_len; the last entry is the total size
+///
+constexpr auto make_value_offsets() noexcept {
+    auto offsets = std::array<uint16_t, attribute_count + 1>{};
+
+    for (auto i = std::size_t{}; i < attribute_count; i++) {
+        offsets[i + 1] =
+            static_cast<uint16_t>(offsets[i] + attributes[i].max_len);
+    }
+
+    return offsets;
+}
+
+///
+/// \brief Offset of each slot's value in a buffer holding every attribute
+///
+inline constexpr auto value_offsets = make_value_offsets();
+
+/// Bytes needed to hold the largest value of every attribute
+inline constexpr auto value_storage_size = value_offsets[attribute_count];
+
+} // namespace gatt_db
+
+#endif /* BLE_GATT_DB_HPP */
@@ -0,0 +1,212 @@
+///
+/// \file    ble_gatt_prepare_queue.hpp
+/// \brief   Fixed-size queue of prepared (long and reliable) writes
+///
+/// \details This header provides the per-connection queue behind ATT
+///          Prepare Write and Execute Write. Fragment payloads are packed
+///          into a statically sized arena and described by a fixed array of
+///          fragment records, so a queue never touches the heap and its
+///          capacity is known at compile time. A fragment that does not fit
+///          is refused, which the server reports as Prepare Queue Full.
+///
+///          Execution is split in two passes so a long write is applied
+///          all-or-nothing: validate() replays the fragments of one handle
+///          against its length bounds without touching any value, and
+///          assemble() then produces the final value once every handle has
+///          passed.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Prepared write queue
+///
+
+#ifndef BLE_GATT_PREPARE_QUEUE_HPP
+#define BLE_GATT_PREPARE_QUEUE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+///
+/// \brief Queue of prepared writes for one connection
+///
+/// \tparam ArenaSize    Bytes of fragment payload the queue can hold
+/// \tparam MaxFragments Number of fragments the queue can hold
+///
+template <std::size_t ArenaSize, std::size_t MaxFragments>
+class prepare_write_queue final {
+public:
+    static_assert(ArenaSize > 0 && ArenaSize <= UINT16_MAX,
+                  "prepare_write_queue arena must be addressable in 16 bits");
+    static_assert(MaxFragments > 0,
+                  "prepare_write_queue requires at least one fragment");
+
+    ///
+    /// \brief One queued Prepare Write request
+    ///
+    struct fragment {
+        uint16_t handle;   ///< Attribute handle
+        uint16_t offset;   ///< Value offset requested by the client
+        uint16_t length;   ///< Payload length
+        uint16_t position; ///< Payload location in the arena
+    };
+
+    ///
+    /// \brief Outcome of replaying the fragments of one handle
+    ///
+    enum class check : uint8_t {
+        ok,             ///< Every fragment applies
+        invalid_offset, ///< A fragment starts past the end of the value
+        invalid_length  ///< A fragment ends past the attribute's capacity
+    };
+
+    ///
+    /// \brief Queue a fragment
+    ///
+    /// \param handle Attribute handle
+    /// \param offset Value offset requested by the client
+    /// \param data Fragment payload
+    /// \param length Length of \p data in bytes
+    ///
+    /// \return true if queued, false if the arena or the fragment table is
+    ///         full
+    ///
+    bool push(uint16_t handle, uint16_t offset, const uint8_t *data,
+              uint16_t length) noexcept {
+        if (m_count == MaxFragments || length > ArenaSize - m_used) {
+            return false;
+        }
+
+        m_fragments[m_count++] = {handle, offset, length,
+                                  static_cast<uint16_t>(m_used)};
+
+        std::memcpy(m_arena.data() + m_used, data, length);
+        m_used += length;
+
+        return true;
+    }
+
+    ///
+    /// \brief Discard every queued fragment
+    ///
+    void clear() noexcept {
+        m_count = 0;
+        m_used = 0;
+    }
+
+    ///
+    /// \brief Get the number of queued fragments
+    ///
+    std::size_t size() const noexcept { return m_count; }
+
+    ///
+    /// \brief Get the number of arena bytes in use
+    ///
+    std::size_t bytes_used() const noexcept { return m_used; }
+
+    ///
+    /// \brief Access a queued fragment
+    ///
+    /// \param index Fragment index, in arrival order
+    ///
+    const fragment &operator[](std::size_t index) const noexcept {
+        return m_fragments[index];
+    }
+
+    ///
+    /// \brief Whether a fragment is the first one queued for its handle
+    ///
+    /// Lets the caller visit every distinct handle exactly once.
+    ///
+    /// \param index Fragment index, in arrival order
+    ///
+    bool first_of_handle(std::size_t index) const noexcept {
+        for (auto i = std::size_t{}; i < index; i++) {
+            if (m_fragments[i].handle == m_fragments[index].handle) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    ///
+    /// \brief Replay the fragments of a handle against its length bounds
+    ///
+    /// Fragments apply in arrival order, later ones overwriting earlier ones
+    /// where they overlap. Each behaves as a write at its offset, so the
+    /// value ends where the last fragment ends.
+    ///
+    /// \param handle Attribute handle
+    /// \param current_length Length of the value before execution
+    /// \param capacity Largest value the attribute accepts
+    ///
+    /// \return check check::ok, or the first violation
+    ///
+    check validate(uint16_t handle, uint16_t current_length,
+                   uint16_t capacity) const noexcept {
+        auto length = std::size_t{current_length};
+
+        for (auto i = std::size_t{}; i < m_count; i++) {
+            const auto &entry = m_fragments[i];
+
+            if (entry.handle != handle) {
+                continue;
+            }
+
+            if (entry.offset > length) {
+                return check::invalid_offset;
+            }
+
+            length = std::size_t{entry.offset} + entry.length;
+
+            if (length > capacity) {
+                return check::invalid_length;
+            }
+        }
+
+        return check::ok;
+    }
+
+    ///
+    /// \brief Build the final value of a handle
+    ///
+    /// Must only be called after validate() returned check::ok for the same
+    /// bounds.
+    ///
+    /// \param handle Attribute handle
+    /// \param value Holds the current value on entry and the final value on
+    ///        return; at least the capacity passed to validate()
+    /// \param current_length Length of the value before execution
+    ///
+    /// \return uint16_t Length of the final value
+    ///
+    uint16_t assemble(uint16_t handle, uint8_t *value,
+                      uint16_t current_length) const noexcept {
+        auto length = current_length;
+
+        for (auto i = std::size_t{}; i < m_count; i++) {
+            const auto &entry = m_fragments[i];
+
+            if (entry.handle != handle) {
+                continue;
+            }
+
+            std::memcpy(value + entry.offset, m_arena.data() + entry.position,
+                        entry.length);
+
+            length = static_cast<uint16_t>(entry.offset + entry.length);
+        }
+
+        return length;
+    }
+
+private:
+    std::array<uint8_t, ArenaSize> m_arena{};         ///< Packed payloads
+    std::array<fragment, MaxFragments> m_fragments{}; ///< In arrival order
+    std::size_t m_count{};                            ///< Queued fragments
+    std::size_t m_used{};                             ///< Arena bytes used
+};
+
+#endif /* BLE_GATT_PREPARE_QUEUE_HPP */
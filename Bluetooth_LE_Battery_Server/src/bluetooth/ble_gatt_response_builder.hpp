@@ -0,0 +1,184 @@
+///
+/// \file    ble_gatt_response_builder.hpp
+/// \brief   Scatter-gather builder for multi-attribute GATT responses
+///
+/// \details This header provides a response builder that describes a PDU
+///          payload as a list of segments instead of writing it into a
+///          buffer. PDU headers (handles, length prefixes) are copied into a
+///          small header area; attribute values are only referenced where
+///          they are stored. Segments that happen to be contiguous in memory
+///          are merged, so a response made of one value (or of values stored
+///          back to back) collapses to a single segment that can be handed to
+///          the stack in place. Anything else is flattened into a response
+///          buffer with exactly one copy per byte.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Scatter-gather response builder
+///
+
+#ifndef BLE_GATT_RESPONSE_BUILDER_HPP
+#define BLE_GATT_RESPONSE_BUILDER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+///
+/// \brief Scatter-gather GATT response builder
+///
+/// \tparam MaxSegments    Number of segments a response can hold
+/// \tparam HeaderCapacity Bytes of PDU headers a response can hold
+///
+template <std::size_t MaxSegments, std::size_t HeaderCapacity>
+class gatt_response_builder final {
+public:
+    static_assert(MaxSegments > 0 && HeaderCapacity > 0,
+                  "gatt_response_builder requires room for segments");
+
+    ///
+    /// \brief Contiguous piece of the response
+    ///
+    struct segment {
+        const uint8_t *data; ///< First byte (header area or value storage)
+        uint16_t length;     ///< Number of bytes
+    };
+
+    ///
+    /// \brief Start a new response
+    ///
+    void clear() noexcept {
+        m_segment_count = 0;
+        m_header_length = 0;
+        m_size = 0;
+    }
+
+    ///
+    /// \brief Append PDU header bytes (copied into the builder)
+    ///
+    /// \param bytes Header bytes
+    /// \param length Length of \p bytes
+    ///
+    /// \return true if appended, false if the header area or the segment
+    ///         list is full (the response is left unchanged)
+    ///
+    bool add_header(const uint8_t *bytes, uint16_t length) noexcept {
+        if (length > HeaderCapacity - m_header_length) {
+            return false;
+        }
+
+        auto *destination = m_headers.data() + m_header_length;
+
+        if (!append(destination, length)) {
+            return false;
+        }
+
+        std::memcpy(destination, bytes, length);
+        m_header_length += length;
+
+        return true;
+    }
+
+    ///
+    /// \brief Append a reference to a value in place
+    ///
+    /// The value must stay unchanged until the response has been flattened
+    /// or, when sent in place, transmitted.
+    ///
+    /// \param data First byte of the value
+    /// \param length Number of bytes to include
+    ///
+    /// \return true if appended, false if the segment list is full
+    ///
+    bool add_reference(const uint8_t *data, uint16_t length) noexcept {
+        return append(data, length);
+    }
+
+    ///
+    /// \brief Whether the builder can take more segments and header bytes
+    ///
+    /// Lets the caller add a header and its value together or not at all.
+    ///
+    /// \param segments Segments about to be added
+    /// \param header_bytes Header bytes about to be added
+    ///
+    bool has_room(std::size_t segments,
+                  std::size_t header_bytes) const noexcept {
+        return segments <= MaxSegments - m_segment_count &&
+               header_bytes <= HeaderCapacity - m_header_length;
+    }
+
+    ///
+    /// \brief Get the response length in bytes
+    ///
+    uint16_t size() const noexcept { return m_size; }
+
+    ///
+    /// \brief Get the number of segments after merging
+    ///
+    std::size_t segment_count() const noexcept { return m_segment_count; }
+
+    ///
+    /// \brief Access a segment
+    ///
+    /// \param index Segment index, in response order
+    ///
+    const segment &operator[](std::size_t index) const noexcept {
+        return m_segments[index];
+    }
+
+    ///
+    /// \brief Copy the response into a contiguous buffer
+    ///
+    /// \param output Buffer of at least size() bytes
+    ///
+    /// \return uint16_t Number of bytes copied (size())
+    ///
+    uint16_t flatten(uint8_t *output) const noexcept {
+        for (auto i = std::size_t{}; i < m_segment_count; i++) {
+            std::memcpy(output, m_segments[i].data, m_segments[i].length);
+            output += m_segments[i].length;
+        }
+
+        return m_size;
+    }
+
+private:
+    ///
+    /// \brief Add a segment, merging it with the previous one if contiguous
+    ///
+    bool append(const uint8_t *data, uint16_t length) noexcept {
+        if (length == 0) {
+            return true;
+        }
+
+        if (m_segment_count > 0) {
+            auto &last = m_segments[m_segment_count - 1];
+
+            if (last.data + last.length == data) {
+                last.length = static_cast<uint16_t>(last.length + length);
+                m_size = static_cast<uint16_t>(m_size + length);
+
+                return true;
+            }
+        }
+
+        if (m_segment_count == MaxSegments) {
+            return false;
+        }
+
+        m_segments[m_segment_count++] = {data, length};
+        m_size = static_cast<uint16_t>(m_size + length);
+
+        return true;
+    }
+
+    std::array<segment, MaxSegments> m_segments{}; ///< Response layout
+    std::array<uint8_t, HeaderCapacity> m_headers{}; ///< Copied PDU headers
+    std::size_t m_segment_count{};                   ///< Segments in use
+    std::size_t m_header_length{};                   ///< Header bytes in use
+    uint16_t m_size{};                               ///< Response length
+};
+
+#endif /* BLE_GATT_RESPONSE_BUILDER_HPP */
@@ -0,0 +1,151 @@
+///
+/// \file    ble_gatt_statistics.cpp
+/// \brief   GATT server throughput and latency statistics implementation
+///
+/// \details This file implements cycle-accurate per-operation statistics for
+///          the GATT server and their JSON report.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - GATT statistics
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cybsp.h"
+
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_gatt.hpp"
+#include "ble_gatt_statistics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+///
+/// \brief JSON names of the operation classes, indexed by gatt_operation
+///
+static constexpr const char
+    *operation_names[static_cast<std::size_t>(gatt_operation::count)] = {
+        "read",          "read_blob",     "read_by_type",  "read_multi",
+        "write_request", "write_command", "mtu_exchange",  "prepare_write",
+        "execute_write", "other"};
+
+void ble_gatt_statistics::initialize() noexcept {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    reset();
+}
+
+uint32_t ble_gatt_statistics::cycles() noexcept { return DWT->CYCCNT; }
+
+gatt_operation
+ble_gatt_statistics::classify(wiced_bt_gatt_opcode_t opcode) noexcept {
+    switch (opcode) {
+    case wiced_bt_gatt_opcode_e::GATT_REQ_READ:
+        return gatt_operation::read;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_READ_BLOB:
+        return gatt_operation::read_blob;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_READ_BY_TYPE:
+        return gatt_operation::read_by_type;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_READ_MULTI:
+    case wiced_bt_gatt_opcode_e::GATT_REQ_READ_MULTI_VAR_LENGTH:
+        return gatt_operation::read_multi;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_WRITE:
+        return gatt_operation::write_request;
+    case wiced_bt_gatt_opcode_e::GATT_CMD_WRITE:
+    case wiced_bt_gatt_opcode_e::GATT_CMD_SIGNED_WRITE:
+        return gatt_operation::write_command;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_MTU:
+        return gatt_operation::mtu_exchange;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_PREPARE_WRITE:
+        return gatt_operation::prepare_write;
+    case wiced_bt_gatt_opcode_e::GATT_REQ_EXECUTE_WRITE:
+        return gatt_operation::execute_write;
+    default:
+        return gatt_operation::other;
+    }
+}
+
+void ble_gatt_statistics::record(gatt_operation operation,
+                                 uint32_t elapsed_cycles) noexcept {
+    auto &entry = at(operation);
+
+    ++entry.count;
+    ++entry.histogram[latency_bucket(elapsed_cycles)];
+    entry.total_cycles += elapsed_cycles;
+
+    if (elapsed_cycles > entry.max_cycles) {
+        entry.max_cycles = elapsed_cycles;
+    }
+}
+
+void ble_gatt_statistics::print_json() const noexcept {
+    const auto pool = ble_gatt_response_pool_stats();
+
+    std::printf("{\"gatt_statistics\":{\"cpu_hz\":%lu,\"operations\":[",
+                static_cast<unsigned long>(SystemCoreClock));
+
+    for (auto i = std::size_t{}; i < m_operations.size(); i++) {
+        const auto &entry = m_operations[i];
+
+        const auto mean_cycles =
+            (entry.count != 0)
+                ? static_cast<uint32_t>(entry.total_cycles / entry.count)
+                : uint32_t{};
+
+        // Sustainable dispatch rate if the CPU did nothing but this operation
+        const auto operations_per_second =
+            (mean_cycles != 0) ? SystemCoreClock / mean_cycles : uint32_t{};
+
+        // Value bytes the CPU could move per second through this operation
+        const auto payload_bytes_per_second =
+            (entry.total_cycles != 0)
+                ? static_cast<uint32_t>(uint64_t{entry.payload_bytes} *
+                                        SystemCoreClock / entry.total_cycles)
+                : uint32_t{};
+
+        // Interpolated within a bucket, so never past the slowest sample
+        const auto percentile = [&entry](uint32_t per_mille) {
+            return std::min(
+                latency_percentile(entry.histogram, entry.count, per_mille),
+                entry.max_cycles);
+        };
+
+        const auto p50_cycles = percentile(500);
+        const auto p99_cycles = percentile(990);
+        const auto p999_cycles = percentile(999);
+
+        std::printf("%s{\"op\":\"%s\",\"count\":%lu,\"mean_cycles\":%lu,"
+                    "\"p50_cycles\":%lu,\"p99_cycles\":%lu,"
+                    "\"p999_cycles\":%lu,\"max_cycles\":%lu,"
+                    "\"ops_per_sec\":%lu,\"bytes_allocated\":%lu,"
+                    "\"payload_bytes\":%lu,\"payload_bytes_per_sec\":%lu,"
+                    "\"bytes_copied\":%lu,\"allocation_failures\":%lu}",
+                    (i == 0) ? "" : ",", operation_names[i],
+                    static_cast<unsigned long>(entry.count),
+                    static_cast<unsigned long>(mean_cycles),
+                    static_cast<unsigned long>(p50_cycles),
+                    static_cast<unsigned long>(p99_cycles),
+                    static_cast<unsigned long>(p999_cycles),
+                    static_cast<unsigned long>(entry.max_cycles),
+                    static_cast<unsigned long>(operations_per_second),
+                    static_cast<unsigned long>(entry.allocated_bytes),
+                    static_cast<unsigned long>(entry.payload_bytes),
+                    static_cast<unsigned long>(payload_bytes_per_second),
+                    static_cast<unsigned long>(entry.copied_bytes),
+                    static_cast<unsigned long>(entry.allocation_failures));
+    }
+
+    std::printf("],\"response_pool\":{\"in_use\":%lu,\"high_water_mark\":%lu,"
+                "\"allocations\":%lu,\"exhaustions\":%lu}}}\n",
+                static_cast<unsigned long>(pool.in_use),
+                static_cast<unsigned long>(pool.high_water_mark),
+                static_cast<unsigned long>(pool.allocations),
+                static_cast<unsigned long>(pool.exhaustions));
+}
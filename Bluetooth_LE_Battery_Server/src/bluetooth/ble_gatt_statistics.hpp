@@ -0,0 +1,250 @@
+///
+/// \file    ble_gatt_statistics.hpp
+/// \brief   GATT server throughput and latency statistics
+///
+/// \details This header provides per-operation counters for the GATT server:
+///          dispatch count, latency distribution in CPU cycles (read from the
+///          Cortex-M DWT cycle counter), derived operations per second and
+///          response bytes allocated. The counters are kept in a fixed
+///          log2-bucketed histogram, so recording is allocation-free and
+///          constant time, and are reported as a single JSON line on the
+///          debug UART so runs can be diffed across releases.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - GATT statistics
+///
+
+#ifndef BLE_GATT_STATISTICS_HPP
+#define BLE_GATT_STATISTICS_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief GATT operation classes tracked by \ref ble_gatt_statistics
+///
+enum class gatt_operation : uint8_t {
+    read,          ///< GATT_REQ_READ
+    read_blob,     ///< GATT_REQ_READ_BLOB
+    read_by_type,  ///< GATT_REQ_READ_BY_TYPE
+    read_multi,    ///< GATT_REQ_READ_MULTI(_VAR_LENGTH)
+    write_request, ///< GATT_REQ_WRITE
+    write_command, ///< GATT_CMD_WRITE and GATT_CMD_SIGNED_WRITE
+    mtu_exchange,  ///< GATT_REQ_MTU
+    prepare_write, ///< GATT_REQ_PREPARE_WRITE
+    execute_write, ///< GATT_REQ_EXECUTE_WRITE
+    other,         ///< Any other opcode
+    count          ///< Number of classes (not a class)
+};
+
+///
+/// \brief Per-operation GATT server statistics
+///
+/// Latencies are recorded in CPU cycles. Percentiles are interpolated
+/// within the power-of-two bucket that contains them, as if its samples
+/// were spread evenly, so they are estimates within the bucket's bounds.
+///
+class ble_gatt_statistics final {
+public:
+    /// Number of power-of-two latency buckets (covers up to 2^32 cycles)
+    static constexpr auto LATENCY_BUCKETS = std::size_t{32};
+
+    /// Count per bucket, bucket n holds [2^n, 2^(n+1)) cycles
+    using latency_histogram = std::array<uint32_t, LATENCY_BUCKETS>;
+
+    ///
+    /// \brief Get the histogram bucket of a latency
+    ///
+    /// \param elapsed_cycles Latency in cycles
+    ///
+    /// \return std::size_t Bucket index; 0 and 1 cycle share bucket 0
+    ///
+    static constexpr std::size_t
+    latency_bucket(uint32_t elapsed_cycles) noexcept {
+        return (elapsed_cycles == 0) ? std::size_t{0}
+                                     : static_cast<std::size_t>(
+                                           31 - __builtin_clz(elapsed_cycles));
+    }
+
+    ///
+    /// \brief Estimate a latency percentile from a histogram
+    ///
+    /// \param histogram Latencies recorded with latency_bucket()
+    /// \param count Number of latencies in \p histogram
+    /// \param per_mille Percentile in thousandths (500 = p50, 999 = p99.9)
+    ///
+    /// \return uint32_t Latency of the percentile sample, placing the k-th
+    ///         of n samples in a bucket at the middle of the k-th of n equal
+    ///         slices of it, or 0 if \p count is 0
+    ///
+    static constexpr uint32_t latency_percentile(
+        const latency_histogram &histogram, uint32_t count,
+        uint32_t per_mille) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+
+        // Rank of the percentile sample, rounded up
+        const auto rank = static_cast<uint32_t>(
+            (static_cast<uint64_t>(count) * per_mille + 999) / 1000);
+
+        auto seen = uint32_t{};
+        auto bucket = std::size_t{};
+
+        while (bucket < LATENCY_BUCKETS - 1 &&
+               seen + histogram[bucket] < rank) {
+            seen += histogram[bucket++];
+        }
+
+        // Bucket 0 also holds 0 cycles
+        const auto low = (bucket == 0) ? uint64_t{} : uint64_t{1} << bucket;
+        const auto width = (uint64_t{2} << bucket) - low;
+        const auto samples = uint64_t{histogram[bucket]};
+
+        if (samples == 0) {
+            return UINT32_MAX;
+        }
+
+        const auto position = uint64_t{rank - seen};
+
+        return static_cast<uint32_t>(low + width * (2 * position - 1) /
+                                               (2 * samples));
+    }
+
+    ///
+    /// \brief Enable the DWT cycle counter and clear all counters
+    ///
+    void initialize() noexcept;
+
+    ///
+    /// \brief Clear all counters
+    ///
+    void reset() noexcept { m_operations = {}; }
+
+    ///
+    /// \brief Read the free-running CPU cycle counter
+    ///
+    /// \return uint32_t Current cycle count (wraps every 2^32 cycles)
+    ///
+    static uint32_t cycles() noexcept;
+
+    ///
+    /// \brief Map a GATT opcode to its statistics class
+    ///
+    /// \param opcode GATT operation code
+    ///
+    /// \return gatt_operation Class the opcode is accounted under
+    ///
+    static gatt_operation classify(wiced_bt_gatt_opcode_t opcode) noexcept;
+
+    ///
+    /// \brief Record one dispatched operation
+    ///
+    /// \param operation Operation class
+    /// \param elapsed_cycles Cycles spent handling the operation
+    ///
+    void record(gatt_operation operation, uint32_t elapsed_cycles) noexcept;
+
+    ///
+    /// \brief Account bytes allocated while handling an operation
+    ///
+    /// \param operation Operation class
+    /// \param bytes Number of bytes allocated
+    ///
+    void add_allocated_bytes(gatt_operation operation,
+                             uint32_t bytes) noexcept {
+        at(operation).allocated_bytes += bytes;
+    }
+
+    ///
+    /// \brief Account a response buffer that could not be allocated
+    ///
+    /// \param operation Operation class
+    ///
+    void add_allocation_failure(gatt_operation operation) noexcept {
+        ++at(operation).allocation_failures;
+    }
+
+    ///
+    /// \brief Account attribute value bytes carried by an operation
+    ///
+    /// \param operation Operation class
+    /// \param bytes Number of value bytes queued or written
+    ///
+    void add_payload_bytes(gatt_operation operation,
+                           uint32_t bytes) noexcept {
+        at(operation).payload_bytes += bytes;
+    }
+
+    ///
+    /// \brief Account value bytes copied into a response buffer
+    ///
+    /// Responses sent straight from attribute storage copy nothing.
+    ///
+    /// \param operation Operation class
+    /// \param bytes Number of bytes copied
+    ///
+    void add_copied_bytes(gatt_operation operation, uint32_t bytes) noexcept {
+        at(operation).copied_bytes += bytes;
+    }
+
+    ///
+    /// \brief Get the bytes copied into response buffers so far
+    ///
+    /// \param operation Operation class
+    ///
+    /// \return uint32_t Bytes copied while handling \p operation
+    ///
+    uint32_t copied_bytes(gatt_operation operation) const noexcept {
+        return m_operations[static_cast<std::size_t>(operation)].copied_bytes;
+    }
+
+    ///
+    /// \brief Print all counters as one JSON object on the debug UART
+    ///
+    void print_json() const noexcept;
+
+private:
+    ///
+    /// \brief Counters for one operation class
+    ///
+    struct operation_statistics {
+        uint32_t count;               ///< Operations dispatched
+        uint32_t max_cycles;          ///< Slowest operation
+        uint64_t total_cycles;        ///< Sum of all latencies
+        uint32_t allocated_bytes;     ///< Response bytes allocated
+        uint32_t payload_bytes;       ///< Attribute value bytes carried
+        uint32_t copied_bytes;        ///< Bytes copied into response buffers
+        uint32_t allocation_failures; ///< Response buffers refused
+        latency_histogram histogram; ///< Latency distribution
+    };
+
+    ///
+    /// \brief Access the counters of an operation class
+    ///
+    operation_statistics &at(gatt_operation operation) noexcept {
+        return m_operations[static_cast<std::size_t>(operation)];
+    }
+
+    std::array<operation_statistics,
+               static_cast<std::size_t>(gatt_operation::count)>
+        m_operations{}; ///< Counters indexed by gatt_operation
+};
+
+///
+/// \brief Global GATT statistics instance
+///
+/// Updated from the Bluetooth stack thread only.
+///
+inline auto ble_gatt_statistics_object = ble_gatt_statistics{};
+
+#endif /* BLE_GATT_STATISTICS_HPP */
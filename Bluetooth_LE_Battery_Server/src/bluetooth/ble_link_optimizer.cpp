@@ -0,0 +1,450 @@
+///
+/// \file    ble_link_optimizer.cpp
+/// \brief   Link optimizer implementation
+///
+/// \details This file implements the link optimizer: the connection table,
+///          the policy timer, the requests sent to the controller and the
+///          central, and the JSON log of what was negotiated, printed on
+///          the application event task.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.1 - Traffic-class connection parameters
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_l2c.h"
+}
+#pragma GCC diagnostic pop
+
+#include "app_event_task.hpp"
+#include "ble_link_optimizer.hpp"
+#include "utilities.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+///
+/// \brief Get the JSON name of a traffic class
+///
+static const char *traffic_class_name(ble_traffic_class traffic_class) {
+    switch (traffic_class) {
+    case ble_traffic_class::idle:
+        return "idle";
+    case ble_traffic_class::notify:
+        return "notify";
+    case ble_traffic_class::bulk:
+        return "bulk";
+    default:
+        return "none";
+    }
+}
+
+cy_rslt_t ble_link_optimizer::initialize() noexcept {
+    return cy_rtos_init_timer(&m_timer,
+                              cy_timer_trigger_type_t::CY_TIMER_TYPE_ONCE,
+                              timer_callback, this);
+}
+
+void ble_link_optimizer::connected(uint16_t connection_id,
+                                   const uint8_t *peer_address) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (auto *link = find(0); link != nullptr) {
+        *link = ble_link{};
+        link->connection_id = connection_id;
+        link->connected_ms = now_ms();
+        link->discovering = true;
+
+        std::copy_n(peer_address, BD_ADDR_LEN, link->peer_address.begin());
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    evaluate(connection_id);
+}
+
+void ble_link_optimizer::disconnected(uint16_t connection_id) noexcept {
+    auto closed = false;
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (auto *link = find(connection_id);
+        link != nullptr && connection_id != 0) {
+        // Held by slot, so a new connection can take the entry at once
+        m_closed[link - m_links.data()] = *link;
+        *link = ble_link{};
+        closed = true;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (closed) {
+        post_log();
+    }
+}
+
+void ble_link_optimizer::bulk_begin(uint16_t connection_id) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (auto *link = find(connection_id); link != nullptr) {
+        link->held = true;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    evaluate(connection_id);
+}
+
+void ble_link_optimizer::bulk_end(uint16_t connection_id) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (auto *link = find(connection_id); link != nullptr) {
+        link->held = false;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    evaluate(connection_id);
+}
+
+void ble_link_optimizer::subscription_changed(uint16_t connection_id,
+                                              bool subscribed) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    if (auto *link = find(connection_id); link != nullptr) {
+        link->subscribed = subscribed;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    evaluate(connection_id);
+}
+
+void ble_link_optimizer::timer_expired() noexcept {
+    auto connection_ids = std::array<uint16_t, BLE_MAX_CONNECTIONS>{};
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (auto i = std::size_t{}; i < m_links.size(); i++) {
+        connection_ids[i] = m_links[i].connection_id;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    for (const auto connection_id : connection_ids) {
+        if (connection_id != 0) {
+            evaluate(connection_id);
+        }
+    }
+}
+
+void ble_link_optimizer::phy_updated(
+    const wiced_bt_ble_phy_update_t &update) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    auto *link = find_address(update.bd_address);
+
+    if (link != nullptr) {
+        link->phy_status = update.status;
+        link->log_pending |= BLE_LINK_LOG_PHY;
+
+        if (update.status == 0) {
+            link->tx_phy = update.tx_phy;
+            link->rx_phy = update.rx_phy;
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (link != nullptr) {
+        post_log();
+    }
+}
+
+void ble_link_optimizer::data_length_updated(
+    const wiced_bt_ble_data_length_update_t &update) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    auto *link = find_address(update.bd_address);
+
+    if (link != nullptr) {
+        link->tx_octets = update.max_tx_octets;
+        link->tx_time_us = update.max_tx_time;
+        link->rx_octets = update.max_rx_octets;
+        link->rx_time_us = update.max_rx_time;
+        link->log_pending |= BLE_LINK_LOG_DATA_LENGTH;
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (link != nullptr) {
+        post_log();
+    }
+}
+
+void ble_link_optimizer::parameters_updated(
+    const wiced_bt_ble_connection_param_update_t &update) noexcept {
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    auto *link = find_address(update.bd_addr);
+
+    if (link != nullptr) {
+        link->parameter_status = update.status;
+        link->log_pending |= BLE_LINK_LOG_PARAMETERS;
+
+        if (update.status == 0) {
+            link->interval = update.conn_interval;
+            link->latency = update.conn_latency;
+            link->supervision_timeout = update.supervision_timeout;
+            ++link->parameter_updates;
+        } else {
+            ++link->parameter_failures;
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (link != nullptr) {
+        post_log();
+    }
+}
+
+void ble_link_optimizer::log_pending() noexcept {
+    for (auto i = std::size_t{}; i < m_links.size(); i++) {
+        auto link = ble_link{};
+        auto closed = ble_link{};
+
+        // Copied out, so the UART is not written inside the critical section
+        auto interrupt_status = cyhal_system_critical_section_enter();
+
+        link = m_links[i];
+        m_links[i].log_pending = 0;
+
+        closed = m_closed[i];
+        m_closed[i] = ble_link{};
+
+        cyhal_system_critical_section_exit(interrupt_status);
+
+        // A closed link's outcomes come first; the slot may be reused since
+        print_outcomes(closed, closed.log_pending);
+
+        if (closed.connection_id != 0) {
+            print_json(closed);
+        }
+
+        print_outcomes(link, link.log_pending);
+    }
+}
+
+ble_link ble_link_optimizer::link(uint16_t connection_id) const noexcept {
+    auto result = ble_link{};
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+
+    for (const auto &entry : m_links) {
+        if (entry.connection_id != 0 && entry.connection_id == connection_id) {
+            result = entry;
+            break;
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    return result;
+}
+
+ble_link *ble_link_optimizer::find(uint16_t connection_id) noexcept {
+    auto it = std::find_if(m_links.begin(), m_links.end(),
+                           [connection_id](const ble_link &link) {
+                               return link.connection_id == connection_id;
+                           });
+
+    return (it != m_links.end()) ? &*it : nullptr;
+}
+
+ble_link *
+ble_link_optimizer::find_address(const uint8_t *peer_address) noexcept {
+    auto it = std::find_if(
+        m_links.begin(), m_links.end(), [peer_address](const ble_link &link) {
+            return link.connection_id != 0 &&
+                   std::equal(link.peer_address.begin(),
+                              link.peer_address.end(), peer_address);
+        });
+
+    return (it != m_links.end()) ? &*it : nullptr;
+}
+
+void ble_link_optimizer::evaluate(uint16_t connection_id) noexcept {
+    auto requests = ble_link_requests{};
+    auto traffic_class = ble_traffic_class::none;
+    wiced_bt_device_address_t peer_address{};
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    auto *link = find(connection_id);
+
+    if (link != nullptr && connection_id != 0) {
+        const auto now = now_ms();
+
+        link->discovering = link->discovering &&
+                            now - link->connected_ms < BLE_TRAFFIC_DISCOVERY_MS;
+        link->policy.update({link->held || link->discovering, link->subscribed},
+                            now);
+
+        traffic_class = link->policy.current();
+        requests = ble_link_plan(*link);
+
+        // Recorded before sending, so a racing caller plans without them
+        link->phy_requested |= requests.phy;
+        link->data_length_requested |= requests.data_length;
+
+        if (requests.parameters) {
+            link->requested = traffic_class;
+            ++link->parameter_requests;
+        }
+
+        std::copy_n(link->peer_address.begin(), BD_ADDR_LEN, peer_address);
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (link == nullptr || connection_id == 0) {
+        return;
+    }
+
+    if (requests.phy) {
+        auto preferences = wiced_bt_ble_phy_preferences_t{};
+
+        std::copy_n(peer_address, BD_ADDR_LEN, preferences.remote_bd_addr);
+        preferences.tx_phys = BTM_BLE_PREFER_2M_PHY;
+        preferences.rx_phys = BTM_BLE_PREFER_2M_PHY;
+
+        wiced_bt_ble_set_phy(&preferences);
+    }
+
+    if (requests.data_length) {
+        wiced_bt_ble_set_data_packet_length(
+            peer_address, BLE_LINK_MAX_TX_OCTETS, BLE_LINK_MAX_TX_TIME_US);
+    }
+
+    if (requests.parameters) {
+        const auto &parameters = ble_traffic_parameters(traffic_class);
+
+        // Asks the central over L2CAP signaling; the outcome arrives as
+        // BTM_BLE_CONNECTION_PARAM_UPDATE
+        wiced_bt_l2cap_update_ble_conn_params(
+            peer_address, parameters.min_interval, parameters.max_interval,
+            parameters.latency, parameters.supervision_timeout);
+    }
+
+    schedule();
+}
+
+void ble_link_optimizer::schedule() noexcept {
+    auto next_ms = uint32_t{};
+
+    auto interrupt_status = cyhal_system_critical_section_enter();
+    const auto now = now_ms();
+
+    for (const auto &link : m_links) {
+        if (link.connection_id == 0) {
+            continue;
+        }
+
+        auto due_ms = link.policy.pending_ms(now);
+
+        if (link.discovering) {
+            const auto elapsed = now - link.connected_ms;
+            const auto discovery_ms = (elapsed < BLE_TRAFFIC_DISCOVERY_MS)
+                                          ? BLE_TRAFFIC_DISCOVERY_MS - elapsed
+                                          : 1;
+
+            due_ms = (due_ms == 0) ? discovery_ms
+                                   : std::min(due_ms, discovery_ms);
+        }
+
+        if (due_ms != 0 && (next_ms == 0 || due_ms < next_ms)) {
+            next_ms = due_ms;
+        }
+    }
+
+    cyhal_system_critical_section_exit(interrupt_status);
+
+    if (next_ms != 0) {
+        // Restarts the timer if it is already running; an expiry with
+        // nothing due re-evaluates to the same classes
+        cy_rtos_start_timer(&m_timer, next_ms);
+    }
+}
+
+void ble_link_optimizer::post_log() noexcept {
+    // A full queue only delays the lines: the next log event prints them
+    app_event_post({app_event_type::link_log, 0});
+}
+
+void ble_link_optimizer::print_outcomes(const ble_link &link,
+                                        uint8_t bits) noexcept {
+    if ((bits & BLE_LINK_LOG_PHY) != 0) {
+        std::printf("{\"ble_link\":{\"connection_id\":%u,\"phy\":{"
+                    "\"status\":%u,\"tx\":%u,\"rx\":%u}}}\n",
+                    static_cast<unsigned>(link.connection_id),
+                    static_cast<unsigned>(link.phy_status),
+                    static_cast<unsigned>(link.tx_phy),
+                    static_cast<unsigned>(link.rx_phy));
+    }
+
+    if ((bits & BLE_LINK_LOG_DATA_LENGTH) != 0) {
+        std::printf("{\"ble_link\":{\"connection_id\":%u,\"data_length\":{"
+                    "\"tx_octets\":%u,\"tx_time_us\":%u,\"rx_octets\":%u,"
+                    "\"rx_time_us\":%u}}}\n",
+                    static_cast<unsigned>(link.connection_id),
+                    static_cast<unsigned>(link.tx_octets),
+                    static_cast<unsigned>(link.tx_time_us),
+                    static_cast<unsigned>(link.rx_octets),
+                    static_cast<unsigned>(link.rx_time_us));
+    }
+
+    if ((bits & BLE_LINK_LOG_PARAMETERS) != 0) {
+        std::printf("{\"ble_link\":{\"connection_id\":%u,\"parameters\":{"
+                    "\"status\":%u,\"interval\":%u,\"latency\":%u,"
+                    "\"supervision_timeout\":%u}}}\n",
+                    static_cast<unsigned>(link.connection_id),
+                    static_cast<unsigned>(link.parameter_status),
+                    static_cast<unsigned>(link.interval),
+                    static_cast<unsigned>(link.latency),
+                    static_cast<unsigned>(link.supervision_timeout));
+    }
+}
+
+void ble_link_optimizer::print_json(const ble_link &link) noexcept {
+    std::printf("{\"ble_link\":{\"connection_id\":%u,\"closed\":{"
+                "\"class\":\"%s\",\"transitions\":%lu,\"interval\":%u,"
+                "\"latency\":%u,\"supervision_timeout\":%u,"
+                "\"requests\":%lu,\"updates\":%lu,\"failures\":%lu}}}\n",
+                static_cast<unsigned>(link.connection_id),
+                traffic_class_name(link.policy.current()),
+                static_cast<unsigned long>(link.policy.transitions()),
+                static_cast<unsigned>(link.interval),
+                static_cast<unsigned>(link.latency),
+                static_cast<unsigned>(link.supervision_timeout),
+                static_cast<unsigned long>(link.parameter_requests),
+                static_cast<unsigned long>(link.parameter_updates),
+                static_cast<unsigned long>(link.parameter_failures));
+}
+
+uint32_t ble_link_optimizer::now_ms() noexcept {
+    auto time_ms = cy_time_t{};
+    cy_rtos_get_time(&time_ms);
+
+    return static_cast<uint32_t>(time_ms);
+}
+
+void ble_link_optimizer::timer_callback(cy_timer_callback_arg_t argument) {
+    util::unused(argument);
+
+    app_event_post({app_event_type::link_policy, 0});
+}
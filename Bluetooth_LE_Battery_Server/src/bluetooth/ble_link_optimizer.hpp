@@ -0,0 +1,301 @@
+///
+/// \file    ble_link_optimizer.hpp
+/// \brief   Connection parameters, PHY and data length management per link
+///
+/// \details This header provides the link optimizer, which keeps every
+///          link in the connection parameters of its traffic class (see
+///          ble_traffic_policy.hpp): a short interval while discovering or
+///          downloading, a longer interval with peripheral latency while
+///          only battery notifications flow, and the longest interval when
+///          idle. Bulk traffic also gets LE 2M PHY and the largest LL data
+///          length; both are left as negotiated afterwards, since they also
+///          shorten the radio-on time of small packets.
+///
+///          Which requests to send is decided by ble_link_plan() from the
+///          link state alone, so the sequence can be checked without a
+///          radio. Every negotiated outcome is logged as one JSON line on
+///          the debug UART, and each link's counters when it closes. The
+///          lines are printed on the application event task, so the
+///          Bluetooth stack thread never waits on the UART.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.1 - Traffic-class connection parameters
+///
+
+#ifndef BLE_LINK_OPTIMIZER_HPP
+#define BLE_LINK_OPTIMIZER_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyabs_rtos.h"
+
+#include "wiced_bt_dev.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_context.hpp"
+#include "ble_traffic_policy.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Largest LL data length (octets of payload per packet)
+///
+constexpr auto BLE_LINK_MAX_TX_OCTETS = uint16_t{251};
+
+///
+/// \brief Air time of BLE_LINK_MAX_TX_OCTETS on the 1M PHY in microseconds
+///
+constexpr auto BLE_LINK_MAX_TX_TIME_US = uint16_t{2120};
+
+///
+/// \brief PHY value reported for LE 2M
+///
+constexpr auto BLE_LINK_PHY_2M = uint8_t{2};
+
+constexpr auto BLE_LINK_LOG_PHY =
+    uint8_t{1u << 0}; ///< ble_link::log_pending bit: PHY update
+constexpr auto BLE_LINK_LOG_DATA_LENGTH =
+    uint8_t{1u << 1}; ///< ble_link::log_pending bit: data length change
+constexpr auto BLE_LINK_LOG_PARAMETERS =
+    uint8_t{1u << 2}; ///< ble_link::log_pending bit: parameter update
+
+///
+/// \brief Negotiated and requested state of one link
+///
+struct ble_link {
+    uint16_t connection_id; ///< Connection ID (0 if the entry is free)
+
+    std::array<uint8_t, BD_ADDR_LEN> peer_address; ///< Peer Bluetooth address
+
+    ble_traffic_policy policy;   ///< Traffic class, with hysteresis
+    ble_traffic_class requested; ///< Class whose parameters were requested
+    uint32_t connected_ms;       ///< Time of connection
+
+    bool discovering;           ///< Within BLE_TRAFFIC_DISCOVERY_MS of connect
+    bool held;                  ///< OTA download in progress
+    bool subscribed;            ///< Battery notifications enabled
+    bool phy_requested;         ///< 2M PHY already requested
+    bool data_length_requested; ///< Maximum data length already requested
+
+    uint8_t tx_phy;               ///< Negotiated transmit PHY (0 unknown)
+    uint8_t rx_phy;               ///< Negotiated receive PHY (0 unknown)
+    uint8_t phy_status;           ///< Status of the latest PHY update
+    uint16_t tx_octets;           ///< Negotiated LL transmit data length
+    uint16_t tx_time_us;          ///< Negotiated LL transmit time
+    uint16_t rx_octets;           ///< Negotiated LL receive data length
+    uint16_t rx_time_us;          ///< Negotiated LL receive time
+    uint16_t interval;            ///< Connection interval, 1.25 ms units
+    uint16_t latency;             ///< Peripheral latency
+    uint16_t supervision_timeout; ///< Supervision timeout, 10 ms units
+    uint8_t parameter_status;     ///< Status of the latest parameter update
+
+    uint8_t log_pending; ///< Outcomes not yet logged (BLE_LINK_LOG_* bits)
+
+    uint32_t parameter_requests; ///< Parameter update requests sent
+    uint32_t parameter_updates;  ///< Parameter updates applied
+    uint32_t parameter_failures; ///< Parameter updates that failed
+};
+
+///
+/// \brief Requests that bring a link to its traffic class
+///
+struct ble_link_requests {
+    bool phy;         ///< Request LE 2M PHY
+    bool data_length; ///< Request BLE_LINK_MAX_TX_OCTETS
+    bool parameters;  ///< Request the parameters of the class
+};
+
+///
+/// \brief Decide which requests bring a link to its traffic class
+///
+/// PHY and data length are requested for bulk traffic, at most once per
+/// connection whether or not the peer accepts, so a peer without 2M support
+/// is not asked again. Parameters are requested whenever the class differs
+/// from the one last requested.
+///
+/// \param link Link state
+///
+/// \return ble_link_requests Requests to send, in PHY, data length,
+///         parameters order
+///
+constexpr ble_link_requests ble_link_plan(const ble_link &link) noexcept {
+    const auto traffic_class = link.policy.current();
+    const auto bulk = traffic_class == ble_traffic_class::bulk;
+
+    return {bulk && !link.phy_requested &&
+                (link.tx_phy != BLE_LINK_PHY_2M ||
+                 link.rx_phy != BLE_LINK_PHY_2M),
+            bulk && !link.data_length_requested &&
+                link.tx_octets < BLE_LINK_MAX_TX_OCTETS,
+            traffic_class != ble_traffic_class::none &&
+                traffic_class != link.requested};
+}
+
+///
+/// \brief Link optimizer for every connection
+///
+/// Connection, subscription, OTA and controller events arrive on the
+/// Bluetooth stack thread; timer_expired() and log_pending() run on the
+/// application event task. The table is only touched inside critical
+/// sections.
+///
+class ble_link_optimizer final {
+public:
+    ///
+    /// \brief Create the policy timer
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or the RTOS abstraction error
+    ///
+    cy_rslt_t initialize() noexcept;
+
+    ///
+    /// \brief Start tracking a new connection
+    ///
+    /// Service discovery follows every connection, so the link starts as
+    /// bulk for BLE_TRAFFIC_DISCOVERY_MS.
+    ///
+    /// \param connection_id Connection ID
+    /// \param peer_address Peer Bluetooth address
+    ///
+    void connected(uint16_t connection_id,
+                   const uint8_t *peer_address) noexcept;
+
+    ///
+    /// \brief Stop tracking a connection; its counters are logged later
+    ///
+    /// \param connection_id Connection ID
+    ///
+    void disconnected(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Keep a link bulk until bulk_end() (OTA download)
+    ///
+    /// \param connection_id Connection ID
+    ///
+    void bulk_begin(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief End the bulk transfer started by bulk_begin()
+    ///
+    /// \param connection_id Connection ID
+    ///
+    void bulk_end(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Record whether a peer has battery notifications enabled
+    ///
+    /// \param connection_id Connection ID
+    /// \param subscribed true if notifications are enabled
+    ///
+    void subscription_changed(uint16_t connection_id,
+                              bool subscribed) noexcept;
+
+    ///
+    /// \brief Re-evaluate every link when the policy timer expires
+    ///
+    /// Called on the application event task.
+    ///
+    void timer_expired() noexcept;
+
+    ///
+    /// \brief Print the outcomes and closed links not yet logged
+    ///
+    /// Called on the application event task. Outcomes of the same kind
+    /// that arrive in between are logged once, with the latest values.
+    ///
+    void log_pending() noexcept;
+
+    ///
+    /// \brief Record a PHY update and queue its log line (stack thread)
+    ///
+    void phy_updated(const wiced_bt_ble_phy_update_t &update) noexcept;
+
+    ///
+    /// \brief Record a data length change and queue its log line (stack
+    ///        thread)
+    ///
+    void data_length_updated(
+        const wiced_bt_ble_data_length_update_t &update) noexcept;
+
+    ///
+    /// \brief Record a connection parameter update and queue its log line
+    ///        (stack thread)
+    ///
+    void parameters_updated(
+        const wiced_bt_ble_connection_param_update_t &update) noexcept;
+
+    ///
+    /// \brief Get a copy of the state of a link
+    ///
+    /// \param connection_id Connection ID
+    ///
+    /// \return ble_link State of the link, or an entry with connection ID 0
+    ///         if the connection is unknown
+    ///
+    ble_link link(uint16_t connection_id) const noexcept;
+
+private:
+    ///
+    /// \brief Find the entry of a connection (caller holds the lock)
+    ///
+    ble_link *find(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Find the entry of a peer address (caller holds the lock)
+    ///
+    ble_link *find_address(const uint8_t *peer_address) noexcept;
+
+    ///
+    /// \brief Re-evaluate the traffic class of a link and send the requests
+    ///        it needs, then reschedule the policy timer
+    ///
+    void evaluate(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Start the policy timer for the earliest pending deadline
+    ///
+    void schedule() noexcept;
+
+    ///
+    /// \brief Ask the application event task to call log_pending()
+    ///
+    static void post_log() noexcept;
+
+    ///
+    /// \brief Print the outcomes marked in a link, one JSON object each
+    ///
+    static void print_outcomes(const ble_link &link, uint8_t bits) noexcept;
+
+    ///
+    /// \brief Print the state and counters of a link as one JSON object
+    ///
+    static void print_json(const ble_link &link) noexcept;
+
+    ///
+    /// \brief Read the RTOS time in milliseconds
+    ///
+    static uint32_t now_ms() noexcept;
+
+    ///
+    /// \brief Policy timer callback (RTOS timer task)
+    ///
+    static void timer_callback(cy_timer_callback_arg_t argument);
+
+    std::array<ble_link, BLE_MAX_CONNECTIONS> m_links{}; ///< Tracked links
+    std::array<ble_link, BLE_MAX_CONNECTIONS>
+        m_closed{}; ///< Closed links not yet logged, by slot of m_links
+
+    cy_timer_t m_timer{}; ///< One-shot timer of the next policy deadline
+};
+
+///
+/// \brief Global link optimizer instance
+///
+inline auto ble_link_optimizer_object = ble_link_optimizer{};
+
+#endif /* BLE_LINK_OPTIMIZER_HPP */
@@ -0,0 +1,216 @@
+///
+/// \file    ble_traffic_policy.hpp
+/// \brief   Traffic classes and connection parameter hysteresis
+///
+/// \details This header provides the policy that picks the connection
+///          parameters of a link from what the link is used for. Each link
+///          is in one of three traffic classes, from least to most
+///          demanding: idle (connected, nothing subscribed), periodic
+///          notify (battery notifications enabled) and bulk OTA (discovery
+///          right after connecting, or an OTA download). A link moves to a
+///          more demanding class at once, but only moves to a less demanding
+///          one after that class has been wanted for BLE_TRAFFIC_DWELL_MS, so
+///          short gaps do not make the central renegotiate back and forth.
+///
+///          The policy is plain data driven by explicit timestamps, so its
+///          transitions can be checked without a radio or an RTOS.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Traffic class policy
+///
+
+#ifndef BLE_TRAFFIC_POLICY_HPP
+#define BLE_TRAFFIC_POLICY_HPP
+
+#include <cstdint>
+
+///
+/// \brief Connection parameters requested from the central
+///
+struct ble_link_parameters {
+    uint16_t min_interval;        ///< Minimum interval, 1.25 ms units
+    uint16_t max_interval;        ///< Maximum interval, 1.25 ms units
+    uint16_t latency;             ///< Peripheral latency, in events
+    uint16_t supervision_timeout; ///< Supervision timeout, 10 ms units
+};
+
+///
+/// \brief Bulk OTA: 7.5-15 ms interval, no latency, 3 s supervision timeout
+///
+constexpr auto BLE_LINK_BULK_PARAMETERS = ble_link_parameters{6, 12, 0, 300};
+
+///
+/// \brief Periodic notify: 100-200 ms interval, latency 4, 6 s supervision
+///        timeout
+///
+/// The peripheral may sleep through 4 of 5 events, yet a notification still
+/// leaves at the next event it chooses to attend.
+///
+constexpr auto BLE_LINK_NOTIFY_PARAMETERS =
+    ble_link_parameters{80, 160, 4, 600};
+
+///
+/// \brief Idle: 400-500 ms interval, latency 2, 6 s supervision timeout
+///
+constexpr auto BLE_LINK_IDLE_PARAMETERS =
+    ble_link_parameters{320, 400, 2, 600};
+
+///
+/// \brief Check that parameters stay within the limits centrals accept
+///
+/// Interval within 7.5 ms to 4 s, an effective interval (interval times
+/// latency + 1) of at most 2 s, and a supervision timeout of at most 6 s and
+/// more than three effective intervals.
+///
+constexpr bool ble_link_parameters_valid(const ble_link_parameters &p) {
+    const auto effective_ms =
+        uint32_t{p.max_interval} * 5 / 4 * (uint32_t{p.latency} + 1);
+    const auto timeout_ms = uint32_t{p.supervision_timeout} * 10;
+
+    return p.min_interval >= 6 && p.min_interval <= p.max_interval &&
+           p.max_interval <= 3200 && effective_ms <= 2000 &&
+           timeout_ms <= 6000 && timeout_ms > effective_ms * 3;
+}
+
+static_assert(ble_link_parameters_valid(BLE_LINK_BULK_PARAMETERS) &&
+                  ble_link_parameters_valid(BLE_LINK_NOTIFY_PARAMETERS) &&
+                  ble_link_parameters_valid(BLE_LINK_IDLE_PARAMETERS),
+              "Connection parameters outside the accepted limits");
+
+///
+/// \brief Time a less demanding class must be wanted before moving to it
+///
+constexpr auto BLE_TRAFFIC_DWELL_MS = uint32_t{5000};
+
+///
+/// \brief Time after connecting that counts as bulk (service discovery)
+///
+constexpr auto BLE_TRAFFIC_DISCOVERY_MS = uint32_t{3000};
+
+///
+/// \brief What a link is used for, from least to most demanding
+///
+enum class ble_traffic_class : uint8_t {
+    none,   ///< Not evaluated yet
+    idle,   ///< Connected, nothing subscribed
+    notify, ///< Periodic notifications
+    bulk    ///< Discovery or OTA download
+};
+
+///
+/// \brief Get the connection parameters of a traffic class
+///
+/// \param traffic_class Traffic class other than none
+///
+constexpr const ble_link_parameters &
+ble_traffic_parameters(ble_traffic_class traffic_class) noexcept {
+    return (traffic_class == ble_traffic_class::bulk)
+               ? BLE_LINK_BULK_PARAMETERS
+           : (traffic_class == ble_traffic_class::notify)
+               ? BLE_LINK_NOTIFY_PARAMETERS
+               : BLE_LINK_IDLE_PARAMETERS;
+}
+
+///
+/// \brief What is currently happening on a link
+///
+struct ble_traffic_inputs {
+    bool bulk;       ///< Discovering or downloading
+    bool subscribed; ///< Battery notifications enabled
+};
+
+///
+/// \brief Traffic class of one link, with hysteresis
+///
+class ble_traffic_policy final {
+public:
+    ///
+    /// \brief Re-evaluate the class
+    ///
+    /// \param inputs What is currently happening on the link
+    /// \param now_ms Current time in milliseconds (wraps)
+    ///
+    /// \return true if the class changed
+    ///
+    constexpr bool update(ble_traffic_inputs inputs, uint32_t now_ms) noexcept {
+        const auto wanted = inputs.bulk         ? ble_traffic_class::bulk
+                            : inputs.subscribed ? ble_traffic_class::notify
+                                                : ble_traffic_class::idle;
+
+        if (wanted >= m_class) {
+            // Never make a busier link wait
+            m_pending = false;
+
+            return change(wanted);
+        }
+
+        if (!m_pending || wanted != m_pending_class) {
+            m_pending = true;
+            m_pending_class = wanted;
+            m_pending_since_ms = now_ms;
+
+            return false;
+        }
+
+        if (now_ms - m_pending_since_ms < BLE_TRAFFIC_DWELL_MS) {
+            return false;
+        }
+
+        m_pending = false;
+
+        return change(wanted);
+    }
+
+    ///
+    /// \brief Get the current class
+    ///
+    constexpr ble_traffic_class current() const noexcept { return m_class; }
+
+    ///
+    /// \brief Get the time left before a pending move takes effect
+    ///
+    /// \param now_ms Current time in milliseconds (wraps)
+    ///
+    /// \return uint32_t Milliseconds until update() should be called again
+    ///         (at least 1), or 0 if no move is pending
+    ///
+    constexpr uint32_t pending_ms(uint32_t now_ms) const noexcept {
+        if (!m_pending) {
+            return 0;
+        }
+
+        const auto elapsed = now_ms - m_pending_since_ms;
+
+        return (elapsed < BLE_TRAFFIC_DWELL_MS) ? BLE_TRAFFIC_DWELL_MS - elapsed
+                                                : 1;
+    }
+
+    ///
+    /// \brief Get the number of class changes
+    ///
+    constexpr uint32_t transitions() const noexcept { return m_transitions; }
+
+private:
+    ///
+    /// \brief Move to a class, counting real changes
+    ///
+    constexpr bool change(ble_traffic_class traffic_class) noexcept {
+        if (traffic_class == m_class) {
+            return false;
+        }
+
+        m_class = traffic_class;
+        ++m_transitions;
+
+        return true;
+    }
+
+    ble_traffic_class m_class{ble_traffic_class::none}; ///< Current class
+    ble_traffic_class m_pending_class{ble_traffic_class::none}; ///< Wanted
+    bool m_pending{false};         ///< A less demanding class is wanted
+    uint32_t m_pending_since_ms{}; ///< When it was first wanted
+    uint32_t m_transitions{};      ///< Class changes
+};
+
+#endif /* BLE_TRAFFIC_POLICY_HPP */
@@ -0,0 +1,311 @@
+///
+/// \file    ota_image_decoder.cpp
+/// \brief   Decoding of compressed OTA images implementation
+///
+/// \details This file implements format detection of incoming OTA data and
+///          the streaming decompression of compressed images into the
+///          staging buffers.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Compressed OTA images
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_ota_api.h"
+#include "cy_result.h"
+
+#include "cybsp.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ota_image_decoder.hpp"
+#include "ota_staging.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+///
+/// \brief Get the image running from the primary slot
+///
+/// Internal flash is memory mapped, so the base of a delta is read in place.
+///
+static const uint8_t *primary_slot() {
+    return reinterpret_cast<const uint8_t *>(CY_FLASH_BASE +
+                                             FLASH_AREA_IMG_1_PRIMARY_START);
+}
+
+///
+/// \brief Read a little-endian 32-bit value
+///
+static uint32_t read_le32(const uint8_t *bytes) {
+    return static_cast<uint32_t>(bytes[0]) |
+           (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) |
+           (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+void ota_image_decoder::reset(uint32_t image_size) noexcept {
+    m_format = format::undetermined;
+    m_header_length = 0;
+    m_image_size = image_size;
+
+    m_received = 0;
+    m_staged = 0;
+
+    m_held_length = 0;
+    m_holding = false;
+}
+
+void ota_image_decoder::resume(uint32_t offset) noexcept {
+    if (m_format == format::undetermined) {
+        // Nothing reached flash yet; the peer starts over with the header
+        m_header_length = 0;
+    } else {
+        start_decoder(offset);
+    }
+
+    if (m_format == format::raw) {
+        // Held-back header bytes are resent with the rest from the offset
+        m_header_length = 0;
+    }
+
+    m_staged = offset;
+
+    // The peer resends whatever was held when the link dropped
+    m_held_length = 0;
+    m_holding = false;
+}
+
+cy_rslt_t ota_image_decoder::write(const uint8_t *data,
+                                   uint16_t length) noexcept {
+    if (m_holding || length > OTA_IMAGE_MAX_CHUNK) {
+        // The caller retries the held data before it accepts more
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    m_received += length;
+
+    if (m_format == format::undetermined) {
+        const auto result = detect(data, length);
+
+        if (result != CY_RSLT_SUCCESS || m_format == format::undetermined) {
+            return result;
+        }
+    }
+
+    return stage(data, length);
+}
+
+cy_rslt_t ota_image_decoder::retry() noexcept {
+    if (!m_holding) {
+        return CY_RSLT_SUCCESS;
+    }
+
+    m_holding = false;
+
+    // stage() may hold part of m_held again, in place
+    return stage(m_held.data(), static_cast<uint16_t>(m_held_length));
+}
+
+void ota_image_decoder::print_json() const noexcept {
+    // Bytes on air as a percentage of the new image size
+    const auto ratio_percent =
+        (m_staged != 0) ? static_cast<uint32_t>(uint64_t{m_received} * 100 /
+                                                m_staged)
+                        : uint32_t{};
+
+    const char *name = "raw";
+
+    if (m_format == format::lzss) {
+        name = "lzss";
+    } else if (m_format == format::delta) {
+        name = "delta";
+    }
+
+    std::printf("{\"ota_image\":{\"format\":\"%s\",\"received\":%lu,"
+                "\"staged\":%lu,\"ratio_percent\":%lu}}\n",
+                name, static_cast<unsigned long>(m_received),
+                static_cast<unsigned long>(m_staged),
+                static_cast<unsigned long>(ratio_percent));
+}
+
+cy_rslt_t ota_image_decoder::detect(const uint8_t *&data,
+                                    uint16_t &length) noexcept {
+    // Collect the magic first, then the rest of the header it announces
+    while (true) {
+        auto wanted = OTA_IMAGE_LZSS_MAGIC.size();
+
+        if (m_header_length >= wanted) {
+            if (std::equal(OTA_IMAGE_LZSS_MAGIC.begin(),
+                           OTA_IMAGE_LZSS_MAGIC.end(), m_header.begin())) {
+                wanted = OTA_IMAGE_LZSS_HEADER_SIZE;
+            } else if (std::equal(OTA_IMAGE_DELTA_MAGIC.begin(),
+                                  OTA_IMAGE_DELTA_MAGIC.end(),
+                                  m_header.begin())) {
+                wanted = OTA_IMAGE_DELTA_HEADER_SIZE;
+            } else {
+                // Not encoded: stage() passes on what was held back first,
+                // then carries on raw
+                m_format = format::raw;
+                return CY_RSLT_SUCCESS;
+            }
+
+            if (m_header_length == wanted) {
+                return accept_header();
+            }
+        }
+
+        const auto count = std::min(static_cast<std::size_t>(length),
+                                    wanted - m_header_length);
+
+        std::memcpy(m_header.data() + m_header_length, data, count);
+
+        m_header_length += count;
+        data += count;
+        length = static_cast<uint16_t>(length - count);
+
+        if (m_header_length < wanted) {
+            return CY_RSLT_SUCCESS;
+        }
+    }
+}
+
+cy_rslt_t ota_image_decoder::accept_header() noexcept {
+    const auto image_size = read_le32(&m_header[4]);
+    const auto block_size =
+        static_cast<uint16_t>(m_header[8] | (m_header[9] << 8));
+    const auto version =
+        static_cast<uint16_t>(m_header[10] | (m_header[11] << 8));
+
+    if (version != OTA_IMAGE_FORMAT_VERSION ||
+        block_size != OTA_STAGING_BUFFER_SIZE ||
+        image_size > OTA_SECONDARY_SLOT_SIZE ||
+        (m_image_size != 0 && image_size != m_image_size)) {
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    if (m_header_length == OTA_IMAGE_DELTA_HEADER_SIZE) {
+        const auto base_size = read_le32(&m_header[12]);
+        const auto base_crc = read_le32(&m_header[16]);
+
+        if (base_size > FLASH_AREA_IMG_1_PRIMARY_SIZE) {
+            return CY_RSLT_OTA_ERROR_BADARG;
+        }
+
+        // A patch applied to any other image would produce garbage. Reading
+        // the whole slot takes too long for the stack thread, so the writer
+        // task checks it before the first patched block reaches flash
+        ota_staging_object.expect_crc(primary_slot(), base_size, base_crc);
+
+        m_format = format::delta;
+        m_base_size = base_size;
+    } else {
+        m_format = format::lzss;
+    }
+
+    m_image_size = image_size;
+    start_decoder(0);
+
+    return CY_RSLT_SUCCESS;
+}
+
+void ota_image_decoder::start_decoder(uint32_t produced) noexcept {
+    if (m_format == format::lzss) {
+        m_lzss.reset(OTA_STAGING_BUFFER_SIZE, m_image_size, produced);
+    } else if (m_format == format::delta) {
+        m_delta.reset(primary_slot(), m_base_size, OTA_STAGING_BUFFER_SIZE,
+                      m_image_size, produced);
+    }
+}
+
+cy_rslt_t ota_image_decoder::stage(const uint8_t *data,
+                                   uint16_t length) noexcept {
+    if (m_format != format::raw) {
+        return decode(data, length);
+    }
+
+    if (!ota_staging_object.fits(m_header_length + length)) {
+        return hold(data, length);
+    }
+
+    if (m_header_length > 0) {
+        m_staged += static_cast<uint32_t>(m_header_length);
+
+        const auto result = ota_staging_object.append(
+            m_header.data(), static_cast<uint16_t>(m_header_length));
+        m_header_length = 0;
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+    }
+
+    m_staged += length;
+
+    return ota_staging_object.append(data, length);
+}
+
+cy_rslt_t ota_image_decoder::decode(const uint8_t *data,
+                                    uint16_t length) noexcept {
+    auto result = cy_rslt_t{CY_RSLT_SUCCESS};
+    auto full = false;
+
+    const auto stage = [&result, &full](const uint8_t *output,
+                                        std::size_t count) {
+        if (!ota_staging_object.fits(count)) {
+            full = true;
+            return false;
+        }
+
+        result =
+            ota_staging_object.append(output, static_cast<uint16_t>(count));
+        return result == CY_RSLT_SUCCESS;
+    };
+
+    auto ok = false;
+    auto rejected = false;
+    auto consumed = std::size_t{};
+
+    if (m_format == format::delta) {
+        const auto status = m_delta.decode(data, length, stage);
+
+        ok = (status == util::delta_patcher::status::ok);
+        rejected = (status == util::delta_patcher::status::sink);
+        consumed = m_delta.consumed();
+        m_staged = m_delta.produced();
+    } else {
+        const auto status = m_lzss.decode(data, length, stage);
+
+        ok = (status == util::lzss_decoder::status::ok);
+        rejected = (status == util::lzss_decoder::status::sink);
+        consumed = m_lzss.consumed();
+        m_staged = m_lzss.produced();
+    }
+
+    if (ok) {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (rejected && full) {
+        // The decoder keeps its refused output; the input it did not reach
+        // is passed again by retry()
+        return hold(data + consumed, length - consumed);
+    }
+
+    return rejected ? result : CY_RSLT_OTA_ERROR_BADARG;
+}
+
+cy_rslt_t ota_image_decoder::hold(const uint8_t *data,
+                                  std::size_t length) noexcept {
+    // May overlap when retry() holds part of m_held again
+    std::memmove(m_held.data(), data, length);
+
+    m_held_length = length;
+    m_holding = true;
+
+    return CY_RSLT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+///
+/// \file    ota_image_decoder.hpp
+/// \brief   Decoding of compressed and delta OTA images ahead of staging
+///
+/// \details This header provides the layer between the OTA data
+///          characteristic and the staging buffers. The first bytes of a
+///          download identify its format:
+///          - A compressed image is expanded on the fly by a small-window
+///            LZSS decoder.
+///          - A delta image is a patch against the image running from the
+///            primary slot, which is read in place to rebuild the new image.
+///          - Anything else (an MCUboot image starts with 0x96f3b83d) is
+///            staged unchanged.
+///
+///          Either way the OTA library and the secondary slot only ever see
+///          the complete new image.
+///
+///          Header (little endian):
+///          - "LZSS" or "DLTA" magic (4 bytes)
+///          - New image size (4 bytes); must match the size announced by the
+///            download command
+///          - Block size (2 bytes); must equal OTA_STAGING_BUFFER_SIZE
+///          - Format version (2 bytes); OTA_IMAGE_FORMAT_VERSION
+///          - Delta only: size and CRC-32 of the primary slot image the patch
+///            was made against (4 bytes each), checked by the OTA writer
+///            task before the first patched block is committed
+///
+///          Every block restarts the decoder, so an interrupted download
+///          resumes at a staging chunk boundary just like a raw image; the
+///          peer resends from the start of the matching encoded block.
+///          Images are produced by scripts/compress-ota-image.py and
+///          scripts/make-ota-delta.py.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Compressed OTA images
+///
+
+#ifndef OTA_IMAGE_DECODER_HPP
+#define OTA_IMAGE_DECODER_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_result.h"
+}
+#pragma GCC diagnostic pop
+
+#include "delta_patch.hpp"
+#include "lzss_decoder.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Size of the compressed image header in bytes
+///
+constexpr auto OTA_IMAGE_LZSS_HEADER_SIZE = std::size_t{12};
+
+///
+/// \brief Size of the delta image header in bytes
+///
+constexpr auto OTA_IMAGE_DELTA_HEADER_SIZE = std::size_t{20};
+
+///
+/// \brief Compressed and delta image format understood by this firmware
+///
+constexpr auto OTA_IMAGE_FORMAT_VERSION = uint16_t{1};
+
+///
+/// \brief Longest chunk a peer sends at once
+///
+/// An SDU of the OTA L2CAP channel (OTA_L2CAP_MTU), which is also longer
+/// than any single write of the OTA data characteristic.
+///
+constexpr auto OTA_IMAGE_MAX_CHUNK = std::size_t{517};
+
+///
+/// \brief Magic number at the start of a compressed image
+///
+constexpr auto OTA_IMAGE_LZSS_MAGIC =
+    std::array<uint8_t, 4>{'L', 'Z', 'S', 'S'};
+
+///
+/// \brief Magic number at the start of a delta image
+///
+constexpr auto OTA_IMAGE_DELTA_MAGIC =
+    std::array<uint8_t, 4>{'D', 'L', 'T', 'A'};
+
+///
+/// \brief Format detection and decoding of incoming OTA data
+///
+/// Used from the Bluetooth stack thread, and from the application event task
+/// while it retries held data (the stack thread leaves the decoder alone
+/// meanwhile).
+///
+/// When the staging ring has no room, what is left of a chunk is held
+/// instead of waiting: write() succeeds with holding() set, and retry()
+/// stages the rest once the OTA writer has freed a buffer.
+///
+class ota_image_decoder final {
+public:
+    ///
+    /// \brief Prepare for a new download
+    ///
+    /// \param image_size New image size announced by the peer
+    ///
+    void reset(uint32_t image_size) noexcept;
+
+    ///
+    /// \brief Continue a suspended download
+    ///
+    /// The format detected before the interruption is kept.
+    ///
+    /// \param offset Offset in the new image the peer continues from (a
+    ///        multiple of the block size)
+    ///
+    void resume(uint32_t offset) noexcept;
+
+    ///
+    /// \brief Decode a chunk received from the peer and stage the result
+    ///
+    /// A delta that does not match the primary slot is only found by the
+    /// OTA writer task; the writes after that, and the verify, fail.
+    ///
+    /// \param data Chunk received from the peer
+    /// \param length Length of \p data in bytes
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS if staged or held (see holding()),
+    ///         CY_RSLT_OTA_ERROR_BADARG if the header or the encoded stream is
+    ///         invalid, the chunk is too long or an earlier one is still held,
+    ///         or the error returned by ota_staging::append()
+    ///
+    cy_rslt_t write(const uint8_t *data, uint16_t length) noexcept;
+
+    ///
+    /// \brief Whether part of the last chunk waits for a staging buffer
+    ///
+    bool holding() const noexcept { return m_holding; }
+
+    ///
+    /// \brief Stage what the last chunk left held
+    ///
+    /// \return cy_rslt_t As write(); holding() stays set if the staging
+    ///         ring is still full
+    ///
+    cy_rslt_t retry() noexcept;
+
+    ///
+    /// \brief Print the detected format and bytes-on-air ratio as one JSON
+    ///        object on the debug UART
+    ///
+    void print_json() const noexcept;
+
+private:
+    ///
+    /// \brief Format of the image being received
+    ///
+    enum class format : uint8_t {
+        undetermined, ///< Header not complete yet
+        raw,          ///< Staged unchanged
+        lzss,         ///< Decompressed before staging
+        delta         ///< Patched against the primary slot before staging
+    };
+
+    ///
+    /// \brief Collect and check the header of a new download
+    ///
+    /// \param data Chunk received from the peer; advanced past the bytes
+    ///        consumed
+    /// \param length Length of \p data; reduced by the bytes consumed
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or CY_RSLT_OTA_ERROR_BADARG if
+    ///         the header is not acceptable
+    ///
+    cy_rslt_t detect(const uint8_t *&data, uint16_t &length) noexcept;
+
+    ///
+    /// \brief Check a complete header and set up its decoder
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or CY_RSLT_OTA_ERROR_BADARG if
+    ///         the header is not acceptable
+    ///
+    cy_rslt_t accept_header() noexcept;
+
+    ///
+    /// \brief Start (or restart) the decoder of the detected format
+    ///
+    /// \param produced Bytes of the new image already staged
+    ///
+    void start_decoder(uint32_t produced) noexcept;
+
+    ///
+    /// \brief Stage data of the detected format, holding what does not fit
+    ///
+    cy_rslt_t stage(const uint8_t *data, uint16_t length) noexcept;
+
+    ///
+    /// \brief Expand encoded data into the staging buffers
+    ///
+    cy_rslt_t decode(const uint8_t *data, uint16_t length) noexcept;
+
+    ///
+    /// \brief Keep data that could not be staged yet for retry()
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS
+    ///
+    cy_rslt_t hold(const uint8_t *data, std::size_t length) noexcept;
+
+    util::lzss_decoder m_lzss{};   ///< Decoder state (window and output)
+    util::delta_patcher m_delta{}; ///< Patcher state
+    uint32_t m_base_size{};        ///< Primary slot bytes the delta uses
+
+    std::array<uint8_t, OTA_IMAGE_DELTA_HEADER_SIZE>
+        m_header{}; ///< Bytes collected while undetermined
+    std::size_t m_header_length{}; ///< Valid bytes in m_header
+
+    format m_format{format::undetermined}; ///< Detected image format
+    uint32_t m_image_size{};               ///< Announced new image size
+
+    uint32_t m_received{}; ///< Bytes received from the peer
+    uint32_t m_staged{};   ///< Bytes handed to the staging buffers
+
+    std::array<uint8_t, OTA_IMAGE_MAX_CHUNK>
+        m_held{};                ///< Rest of a chunk awaiting a buffer
+    std::size_t m_held_length{}; ///< Valid bytes in m_held
+    bool m_holding{false};       ///< Set while retry() has work to do
+};
+
+///
+/// \brief Global OTA image decoder instance
+///
+inline auto ota_image_decoder_object = ota_image_decoder{};
+
+#endif /* OTA_IMAGE_DECODER_HPP */
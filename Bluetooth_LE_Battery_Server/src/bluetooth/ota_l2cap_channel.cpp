@@ -0,0 +1,175 @@
+///
+/// \file    ota_l2cap_channel.cpp
+/// \brief   LE credit-based L2CAP channel for OTA image data implementation
+///
+/// \details This file implements the OTA data channel callbacks registered
+///          with the Bluetooth stack. They all run on the stack thread.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA L2CAP channel
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+
+#include "wiced_bt_l2c.h"
+}
+#pragma GCC diagnostic pop
+
+#include "ble_context.hpp"
+#include "ota_image_decoder.hpp"
+#include "ota_l2cap_channel.hpp"
+#include "utilities.hpp"
+
+#include <cstdio>
+
+static_assert(OTA_L2CAP_MTU <= OTA_IMAGE_MAX_CHUNK,
+              "The OTA image decoder must be able to hold a whole SDU");
+
+///
+/// \brief Callbacks registered for OTA_L2CAP_PSM
+///
+/// Must outlive the registration, which lasts as long as the stack.
+///
+static auto ota_l2cap_callbacks = wiced_bt_l2cap_le_appl_information_t{};
+
+bool ota_l2cap_channel::initialize() noexcept {
+    ota_l2cap_callbacks = wiced_bt_l2cap_le_appl_information_t{};
+    ota_l2cap_callbacks.le_connected_indication_cback = connected_indication;
+    ota_l2cap_callbacks.le_disconnect_indication_cback =
+        disconnect_indication;
+    ota_l2cap_callbacks.le_disconnect_confirm_cback = disconnect_confirm;
+    ota_l2cap_callbacks.le_data_indication_cback = data_indication;
+    ota_l2cap_callbacks.le_mps = OTA_L2CAP_MPS;
+
+    return wiced_bt_l2cap_le_register(OTA_L2CAP_PSM, &ota_l2cap_callbacks,
+                                      this) == OTA_L2CAP_PSM;
+}
+
+ota_l2cap_channel::statistics ota_l2cap_channel::stats() const noexcept {
+    return {m_bytes, m_sdus, m_rejected, m_last_ms - m_first_ms};
+}
+
+void ota_l2cap_channel::print_json() const noexcept {
+    const auto counters = stats();
+
+    if (counters.sdus == 0) {
+        return;
+    }
+
+    // Bytes per millisecond is (decimal) kilobytes per second
+    const auto effective_kbps =
+        (counters.elapsed_ms != 0) ? counters.bytes / counters.elapsed_ms
+                                   : uint32_t{};
+
+    std::printf("{\"ota_l2cap\":{\"bytes\":%lu,\"sdus\":%lu,"
+                "\"rejected\":%lu,\"elapsed_ms\":%lu,"
+                "\"effective_kbps\":%lu}}\n",
+                static_cast<unsigned long>(counters.bytes),
+                static_cast<unsigned long>(counters.sdus),
+                static_cast<unsigned long>(counters.rejected),
+                static_cast<unsigned long>(counters.elapsed_ms),
+                static_cast<unsigned long>(effective_kbps));
+}
+
+void ota_l2cap_channel::connected_indication(
+    void *context, wiced_bt_device_address_t address, uint16_t local_cid,
+    uint16_t psm, uint8_t identifier, uint16_t peer_mtu) {
+    util::unused(psm);
+    util::unused(peer_mtu);
+
+    auto *self = static_cast<ota_l2cap_channel *>(context);
+
+    if (self->open()) {
+        // One image, one channel
+        wiced_bt_l2cap_le_connect_rsp(address, identifier, local_cid,
+                                      L2CAP_LE_RESULT_NO_RESOURCES,
+                                      OTA_L2CAP_MTU);
+        return;
+    }
+
+    self->m_local_cid = local_cid;
+    self->m_bytes = 0;
+    self->m_sdus = 0;
+    self->m_rejected = 0;
+    self->m_first_ms = 0;
+    self->m_last_ms = 0;
+
+    wiced_bt_l2cap_le_connect_rsp(address, identifier, local_cid,
+                                  L2CAP_LE_RESULT_CONN_OK, OTA_L2CAP_MTU);
+}
+
+void ota_l2cap_channel::disconnect_indication(void *context,
+                                              uint16_t local_cid,
+                                              wiced_bool_t ack_needed) {
+    auto *self = static_cast<ota_l2cap_channel *>(context);
+
+    if (ack_needed) {
+        wiced_bt_l2cap_le_disconnect_rsp(local_cid);
+    }
+
+    if (self->m_local_cid == local_cid) {
+        self->m_local_cid = 0;
+    }
+}
+
+void ota_l2cap_channel::disconnect_confirm(void *context, uint16_t local_cid,
+                                           uint16_t result) {
+    util::unused(result);
+
+    auto *self = static_cast<ota_l2cap_channel *>(context);
+
+    if (self->m_local_cid == local_cid) {
+        self->m_local_cid = 0;
+    }
+}
+
+void ota_l2cap_channel::data_indication(void *context, uint16_t local_cid,
+                                        uint8_t *data, uint16_t length) {
+    auto *self = static_cast<ota_l2cap_channel *>(context);
+
+    if (self->m_local_cid != local_cid) {
+        return;
+    }
+
+    const auto now = now_ms();
+
+    if (self->m_sdus == 0) {
+        self->m_first_ms = now;
+    }
+
+    // Held if the staging ring is full; the next SDU is refused until the
+    // OTA writer has made room for it
+    const auto status = ble_context_object.ota_data_received(data, length);
+
+    self->m_last_ms = now_ms();
+    ++self->m_sdus;
+
+    if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+        // No download announced on the control point, staging failed, or
+        // the peer outran the flash; closing tells the peer to stop and to
+        // ask the control point why
+        ++self->m_rejected;
+        self->close();
+        return;
+    }
+
+    self->m_bytes += length;
+}
+
+void ota_l2cap_channel::close() noexcept {
+    if (open()) {
+        wiced_bt_l2cap_le_disconnect_req(m_local_cid);
+    }
+}
+
+uint32_t ota_l2cap_channel::now_ms() noexcept {
+    auto time_ms = cy_time_t{};
+    cy_rtos_get_time(&time_ms);
+
+    return static_cast<uint32_t>(time_ms);
+}
@@ -0,0 +1,160 @@
+///
+/// \file    ota_l2cap_channel.hpp
+/// \brief   LE credit-based L2CAP channel for OTA image data
+///
+/// \details This header provides an optional data path for OTA image bytes
+///          that bypasses ATT. A peer that supports LE credit-based
+///          connection-oriented channels (CoC) opens a channel on
+///          OTA_L2CAP_PSM and streams the image as L2CAP SDUs instead of
+///          writing the OTA data characteristic. Commands (prepare, download,
+///          verify, abort) still go through the GATT control point, so the
+///          session, resume and verification logic is shared with the GATT
+///          path; the two paths differ only in how image bytes arrive.
+///
+///          Each SDU is handed to the OTA image decoder on the Bluetooth
+///          stack thread as it arrives, and the stack returns its credit as
+///          soon as the callback does. The stack thread never waits for the
+///          flash: an SDU that finds the staging ring full is held until the
+///          OTA writer frees a buffer, and one arriving while another is held
+///          closes the channel. A peer that streams faster than flash is
+///          programmed must pace itself, or use write requests on the OTA
+///          data characteristic, whose responses are held back instead.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA L2CAP channel
+///
+
+#ifndef OTA_L2CAP_CHANNEL_HPP
+#define OTA_L2CAP_CHANNEL_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "wiced_bt_l2c.h"
+}
+#pragma GCC diagnostic pop
+
+#include <cstdint>
+
+///
+/// \brief LE PSM of the OTA data channel (dynamic range 0x0080-0x00FF)
+///
+constexpr auto OTA_L2CAP_PSM = uint16_t{0x0081};
+
+///
+/// \brief Largest SDU accepted on the channel
+///
+/// Matches L2capMtuSize in design.cybt. Peers get the most out of each LL
+/// packet with SDUs that fill whole K-frames: n * OTA_L2CAP_MPS - 2 bytes
+/// (the first K-frame carries a 2-byte SDU length), i.e. 492 bytes here.
+///
+constexpr auto OTA_L2CAP_MTU = uint16_t{517};
+
+///
+/// \brief Largest K-frame payload (MPS)
+///
+/// 247 bytes plus the 4-byte L2CAP header fill one 251-byte LL data packet
+/// when data length extension is in use.
+///
+constexpr auto OTA_L2CAP_MPS = uint16_t{247};
+
+///
+/// \brief OTA image data channel (Bluetooth stack thread only)
+///
+/// At most one channel is open at a time; it is tied to the download in
+/// progress, not to a particular connection.
+///
+class ota_l2cap_channel final {
+public:
+    ///
+    /// \brief Channel throughput counters
+    ///
+    struct statistics {
+        uint32_t bytes;      ///< Image bytes received over the channel
+        uint32_t sdus;       ///< SDUs received
+        uint32_t rejected;   ///< SDUs the download path refused
+        uint32_t elapsed_ms; ///< Time from the first to the last SDU
+    };
+
+    ///
+    /// \brief Register OTA_L2CAP_PSM with the stack
+    ///
+    /// Must be called once the stack is enabled.
+    ///
+    /// \return true if registered
+    ///
+    bool initialize() noexcept;
+
+    ///
+    /// \brief Whether a peer has the channel open
+    ///
+    bool open() const noexcept { return m_local_cid != 0; }
+
+    ///
+    /// \brief Get the channel throughput counters
+    ///
+    /// \return statistics Snapshot of the counters
+    ///
+    statistics stats() const noexcept;
+
+    ///
+    /// \brief Print the counters and effective KB/s as one JSON object on
+    ///        the debug UART
+    ///
+    /// Prints nothing if no SDU was received since the channel opened.
+    ///
+    void print_json() const noexcept;
+
+private:
+    ///
+    /// \brief Accept the peer's channel if none is open (stack callback)
+    ///
+    static void connected_indication(void *context,
+                                     wiced_bt_device_address_t address,
+                                     uint16_t local_cid, uint16_t psm,
+                                     uint8_t identifier, uint16_t peer_mtu);
+
+    ///
+    /// \brief Forget the channel closed by the peer (stack callback)
+    ///
+    static void disconnect_indication(void *context, uint16_t local_cid,
+                                      wiced_bool_t ack_needed);
+
+    ///
+    /// \brief Forget the channel closed by close() (stack callback)
+    ///
+    static void disconnect_confirm(void *context, uint16_t local_cid,
+                                   uint16_t result);
+
+    ///
+    /// \brief Pass one SDU to the OTA image decoder (stack callback)
+    ///
+    static void data_indication(void *context, uint16_t local_cid,
+                                uint8_t *data, uint16_t length);
+
+    ///
+    /// \brief Close the channel after a download-path error
+    ///
+    void close() noexcept;
+
+    ///
+    /// \brief Read the RTOS time in milliseconds
+    ///
+    static uint32_t now_ms() noexcept;
+
+    uint16_t m_local_cid{}; ///< Open channel, or 0
+
+    uint32_t m_bytes{};    ///< See statistics
+    uint32_t m_sdus{};     ///< See statistics
+    uint32_t m_rejected{}; ///< See statistics
+    uint32_t m_first_ms{}; ///< Time of the first SDU
+    uint32_t m_last_ms{};  ///< Time of the latest SDU
+};
+
+///
+/// \brief Global OTA L2CAP channel instance
+///
+inline auto ota_l2cap_channel_object = ota_l2cap_channel{};
+
+#endif /* OTA_L2CAP_CHANNEL_HPP */
@@ -0,0 +1,350 @@
+///
+/// \file    ota_staging.cpp
+/// \brief   Buffered staging of OTA image data implementation
+///
+/// \details This file implements the ring of OTA staging buffers shared by
+///          the Bluetooth stack thread and the OTA writer task.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA staging
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cycfg_gatt_db.h"
+
+#include "cy_ota_api.h"
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+
+#include "wiced_bt_gatt.h"
+}
+#pragma GCC diagnostic pop
+
+#include "app_event_task.hpp"
+#include "ota_staging.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+cy_rslt_t ota_staging::initialize() noexcept {
+    auto result = cy_rtos_init_semaphore(
+        &m_free, OTA_STAGING_BUFFER_COUNT, OTA_STAGING_BUFFER_COUNT);
+
+    if (result != CY_RSLT_SUCCESS) {
+        return result;
+    }
+
+    return cy_rtos_init_semaphore(&m_ready, OTA_STAGING_BUFFER_COUNT, 0);
+}
+
+bool ota_staging::start(cy_ota_context_ptr ota_context,
+                        uint16_t connection_id, uint32_t image_size) noexcept {
+    // A previous download may have been abandoned mid-stream
+    abort();
+
+    if (m_in_flight.load() != 0) {
+        // The writer is still dropping, or committing, older buffers
+        return false;
+    }
+
+    m_ota_context = ota_context;
+    m_connection_id.store(connection_id);
+    m_image_size = image_size;
+    m_session = session::receiving;
+
+    m_result.store(CY_RSLT_SUCCESS);
+    m_digest.reset();
+    m_check_pending.store(false);
+
+    m_start_ms = now_ms();
+    m_bytes_committed.store(0);
+    m_commits.store(0);
+    m_write_ms.store(0);
+    m_stalls = 0;
+
+    return true;
+}
+
+void ota_staging::connection_lost(uint16_t connection_id) noexcept {
+    if (m_session != session::receiving ||
+        connection_id != m_connection_id.load()) {
+        return;
+    }
+
+    // Buffers already handed over are committed as the writer gets to them
+    drop_partial();
+
+    m_session = session::suspended;
+}
+
+uint32_t ota_staging::resume(uint16_t connection_id) noexcept {
+    m_connection_id.store(connection_id);
+    m_session = session::receiving;
+
+    return resume_offset();
+}
+
+bool ota_staging::fits(std::size_t length) noexcept {
+    if (m_session != session::receiving ||
+        m_result.load() != CY_RSLT_SUCCESS || free_bytes() >= length) {
+        return true;
+    }
+
+    ++m_stalls;
+
+    // Ask the writer for a wake-up, then look again: it may have freed a
+    // buffer before it could see the request
+    m_waiting.store(true);
+
+    if (free_bytes() < length) {
+        return false;
+    }
+
+    m_waiting.store(false);
+
+    return true;
+}
+
+cy_rslt_t ota_staging::append(const uint8_t *data, uint16_t length) noexcept {
+    auto remaining = static_cast<std::size_t>(length);
+
+    if (m_session != session::receiving) {
+        // Data without a download, or before a suspended one was resumed
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    while (remaining > 0) {
+        const auto result = m_result.load();
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        if (!m_filling) {
+            // Free whenever fits() said so
+            const auto free_result = cy_rtos_get_semaphore(&m_free, 0, false);
+
+            if (free_result != CY_RSLT_SUCCESS) {
+                return free_result;
+            }
+
+            m_filling = true;
+            m_fill_length = 0;
+        }
+
+        const auto count =
+            std::min(remaining, OTA_STAGING_BUFFER_SIZE - m_fill_length);
+
+        std::memcpy(m_buffers[m_fill_index].data() + m_fill_length, data,
+                    count);
+
+        data += count;
+        remaining -= count;
+        m_fill_length += count;
+
+        if (m_fill_length == OTA_STAGING_BUFFER_SIZE) {
+            submit();
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+void ota_staging::expect_crc(const uint8_t *data, uint32_t length,
+                             uint32_t crc) noexcept {
+    m_check_data = data;
+    m_check_length = length;
+    m_check_crc = crc;
+
+    // Published to the writer with the next buffer handed over
+    m_check_pending.store(true);
+}
+
+void ota_staging::flush() noexcept {
+    if (m_filling && m_fill_length > 0) {
+        submit();
+    } else {
+        drop_partial();
+    }
+
+    m_session = session::idle;
+}
+
+bool ota_staging::idle() noexcept {
+    if (m_in_flight.load() == 0) {
+        return true;
+    }
+
+    // As in fits(): request the wake-up before looking again
+    m_waiting.store(true);
+
+    if (m_in_flight.load() != 0) {
+        return false;
+    }
+
+    m_waiting.store(false);
+
+    return true;
+}
+
+cy_rslt_t ota_staging::result() const noexcept {
+    if (m_check_pending.load()) {
+        // Nothing was handed over that would have run the check
+        return CY_RSLT_OTA_ERROR_BADARG;
+    }
+
+    return m_result.load();
+}
+
+void ota_staging::abort() noexcept {
+    // Queued buffers now belong to an older generation; the writer drops
+    // them without committing
+    m_generation.fetch_add(1);
+
+    drop_partial();
+
+    m_session = session::idle;
+    m_submitted_bytes = 0;
+}
+
+void ota_staging::run_writer() noexcept {
+    while (true) {
+        cy_rtos_get_semaphore(&m_ready, CY_RTOS_NEVER_TIMEOUT, false);
+
+        auto &buffer = m_buffers[m_write_index];
+        const auto length = m_lengths[m_write_index];
+        const auto current =
+            (m_generations[m_write_index] == m_generation.load());
+
+        if (current && m_result.load() == CY_RSLT_SUCCESS && run_check()) {
+            const auto start_ms = now_ms();
+            const auto result = commit(buffer.data(), length);
+
+            m_write_ms.fetch_add(now_ms() - start_ms);
+
+            if (result == CY_RSLT_SUCCESS) {
+                m_digest.update(buffer.data(), length);
+                m_bytes_committed.fetch_add(length);
+                m_commits.fetch_add(1);
+            } else {
+                m_result.store(result);
+            }
+        }
+
+        m_write_index = (m_write_index + 1) % OTA_STAGING_BUFFER_COUNT;
+
+        // The buffer is free before fits() and idle() can count it
+        cy_rtos_set_semaphore(&m_free, false);
+        m_in_flight.fetch_sub(1);
+
+        if (m_waiting.exchange(false)) {
+            app_event_post({app_event_type::ota_staging_ready,
+                            m_connection_id.load()});
+        }
+    }
+}
+
+ota_staging::statistics ota_staging::stats() const noexcept {
+    return {m_bytes_committed.load(), m_commits.load(), m_write_ms.load(),
+            now_ms() - m_start_ms, m_stalls};
+}
+
+void ota_staging::print_json() const noexcept {
+    const auto counters = stats();
+
+    // Bytes per millisecond is (decimal) kilobytes per second
+    const auto effective_kbps =
+        (counters.elapsed_ms != 0)
+            ? counters.bytes_committed / counters.elapsed_ms
+            : uint32_t{};
+
+    std::printf("{\"ota_staging\":{\"bytes\":%lu,\"commits\":%lu,"
+                "\"write_ms\":%lu,\"elapsed_ms\":%lu,\"stalls\":%lu,"
+                "\"effective_kbps\":%lu}}\n",
+                static_cast<unsigned long>(counters.bytes_committed),
+                static_cast<unsigned long>(counters.commits),
+                static_cast<unsigned long>(counters.write_ms),
+                static_cast<unsigned long>(counters.elapsed_ms),
+                static_cast<unsigned long>(counters.stalls),
+                static_cast<unsigned long>(effective_kbps));
+}
+
+bool ota_staging::run_check() noexcept {
+    if (!m_check_pending.load()) {
+        return true;
+    }
+
+    const auto matches =
+        (util::crc32::of(m_check_data, m_check_length) == m_check_crc);
+
+    m_check_pending.store(false);
+
+    if (!matches) {
+        m_result.store(CY_RSLT_OTA_ERROR_BADARG);
+    }
+
+    return matches;
+}
+
+void ota_staging::drop_partial() noexcept {
+    if (!m_filling) {
+        return;
+    }
+
+    m_filling = false;
+    m_fill_length = 0;
+
+    cy_rtos_set_semaphore(&m_free, false);
+}
+
+void ota_staging::submit() noexcept {
+    m_lengths[m_fill_index] = static_cast<uint16_t>(m_fill_length);
+    m_generations[m_fill_index] = m_generation.load();
+    m_submitted_bytes += static_cast<uint32_t>(m_fill_length);
+    m_in_flight.fetch_add(1);
+
+    m_fill_index = (m_fill_index + 1) % OTA_STAGING_BUFFER_COUNT;
+    m_fill_length = 0;
+    m_filling = false;
+
+    cy_rtos_set_semaphore(&m_ready, false);
+}
+
+std::size_t ota_staging::free_bytes() const noexcept {
+    const auto claimed =
+        std::size_t{m_in_flight.load()} + (m_filling ? 1u : 0u);
+    auto bytes = (OTA_STAGING_BUFFER_COUNT - claimed) * OTA_STAGING_BUFFER_SIZE;
+
+    if (m_filling) {
+        bytes += OTA_STAGING_BUFFER_SIZE - m_fill_length;
+    }
+
+    return bytes;
+}
+
+cy_rslt_t ota_staging::commit(uint8_t *data, uint16_t length) noexcept {
+    // Present the buffer to the OTA library as one large data write
+    auto event_data = wiced_bt_gatt_event_data_t{};
+    auto &request = event_data.attribute_request;
+
+    request.conn_id = m_connection_id.load();
+    request.opcode = wiced_bt_gatt_opcode_e::GATT_REQ_WRITE;
+    request.data.write_req.handle =
+        HDLC_OTA_FW_UPGRADE_SERVICE_OTA_UPGRADE_DATA_VALUE;
+    request.data.write_req.offset = 0;
+    request.data.write_req.val_len = length;
+    request.data.write_req.p_val = data;
+
+    return cy_ota_ble_download_write(m_ota_context, &event_data);
+}
+
+uint32_t ota_staging::now_ms() noexcept {
+    auto time_ms = cy_time_t{};
+    cy_rtos_get_time(&time_ms);
+
+    return static_cast<uint32_t>(time_ms);
+}
@@ -0,0 +1,389 @@
+///
+/// \file    ota_staging.hpp
+/// \brief   Buffered staging of OTA image data ahead of flash writes
+///
+/// \details This header provides the staging layer between the OTA data
+///          characteristic and the OTA library. Incoming chunks are copied
+///          into a ring of flash-row-aligned RAM buffers on the Bluetooth
+///          stack thread and acknowledged immediately; full buffers are
+///          committed to flash through cy_ota_ble_download_write() by the OTA
+///          writer task. The peer therefore keeps streaming while the previous
+///          buffer is being programmed.
+///
+///          The stack thread never waits for the writer. When every buffer is
+///          queued for flash, fits() says so and the caller holds the chunk
+///          back; the writer posts app_event_type::ota_staging_ready as soon
+///          as it frees a buffer, and the held chunk is staged from the
+///          application event task. The end of an image works the same way
+///          with flush() and idle().
+///
+///          The writer commits buffers in the order they were handed over,
+///          so the bytes handed over mark where the image continues. If the
+///          link drops mid-transfer the session is suspended rather than
+///          discarded, and a peer that reconnects and announces the same
+///          image resumes from the first buffer not handed over instead of
+///          byte zero.
+///
+///          Suspending and aborting never wait for the writer on the stack
+///          thread: buffers of an aborted image are tagged with an old
+///          generation and dropped by the writer, and a new image is refused
+///          until they are gone.
+///
+///          Long checks of the image being received run on the writer task
+///          too: the writer checks a CRC-32 requested with expect_crc() before
+///          it commits the next buffer, and a mismatch fails the image like a
+///          failed commit.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA staging
+///
+
+#ifndef OTA_STAGING_HPP
+#define OTA_STAGING_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_ota_api.h"
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+}
+#pragma GCC diagnostic pop
+
+#include "crc32.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Size of one staging buffer in bytes
+///
+/// A multiple of the 512-byte PSoC 6 flash row, so every commit except the
+/// last programs whole rows.
+///
+constexpr auto OTA_STAGING_BUFFER_SIZE = std::size_t{4096};
+
+///
+/// \brief Number of staging buffers (3 = triple buffering)
+///
+constexpr auto OTA_STAGING_BUFFER_COUNT = std::size_t{3};
+
+///
+/// \brief Size of the secondary (upgrade) slot in bytes
+///
+/// Matches FLASH_AREA_IMG_1_SECONDARY_SIZE in flashmap.mk.
+///
+constexpr auto OTA_SECONDARY_SLOT_SIZE = std::size_t{0x060000};
+
+static_assert(OTA_STAGING_BUFFER_SIZE % 512 == 0,
+              "OTA staging buffers must hold whole flash rows");
+static_assert(OTA_SECONDARY_SLOT_SIZE % OTA_STAGING_BUFFER_SIZE == 0,
+              "The secondary slot must hold a whole number of chunks");
+
+///
+/// \brief Ring of staging buffers feeding the OTA writer task
+///
+/// Buffers are filled by one producer (the Bluetooth stack thread, or the
+/// application event task while it stages held data) and committed in the
+/// same order by one consumer (the OTA writer task).
+///
+class ota_staging final {
+public:
+    ///
+    /// \brief Staging and flash throughput counters
+    ///
+    struct statistics {
+        uint32_t bytes_committed; ///< Image bytes handed to the OTA library
+        uint32_t commits;         ///< Buffers committed
+        uint32_t write_ms;        ///< Time spent inside flash commits
+        uint32_t elapsed_ms;      ///< Time since start()
+        uint32_t stalls;          ///< Times data was held back for a free
+                                  ///< buffer
+    };
+
+    ///
+    /// \brief Create the synchronization objects
+    ///
+    /// Must be called once before the scheduler starts.
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or the RTOS abstraction error
+    ///
+    cy_rslt_t initialize() noexcept;
+
+    ///
+    /// \brief Begin staging a new image
+    ///
+    /// Discards any suspended session. Refused while the writer still
+    /// holds buffers of a discarded image, so the OTA library never sees
+    /// writes of two images at once; the peer retries the command.
+    ///
+    /// \param ota_context OTA library context of the download
+    /// \param connection_id Connection the image is received on
+    /// \param image_size Total image size announced by the peer
+    ///
+    /// \return true if started, false if the writer is still busy
+    ///
+    bool start(cy_ota_context_ptr ota_context, uint16_t connection_id,
+               uint32_t image_size) noexcept;
+
+    ///
+    /// \brief Suspend the session if its connection was lost
+    ///
+    /// The partial buffer is dropped (the peer resends it on resume); full
+    /// buffers already handed over are still committed by the writer. Does
+    /// not wait for them.
+    ///
+    /// \param connection_id Connection that was closed
+    ///
+    void connection_lost(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Check whether a suspended session can continue
+    ///
+    /// \param image_size Total image size announced by the reconnected peer
+    ///
+    /// \return true if a session is suspended for an image of that size and
+    ///         no commit has failed
+    ///
+    bool resumable(uint32_t image_size) const noexcept {
+        return m_session == session::suspended &&
+               m_image_size == image_size &&
+               m_result.load() == CY_RSLT_SUCCESS;
+    }
+
+    ///
+    /// \brief Whether a session is suspended awaiting its peer
+    ///
+    bool suspended() const noexcept {
+        return m_session == session::suspended;
+    }
+
+    ///
+    /// \brief Continue a suspended session on a new connection
+    ///
+    /// \param connection_id Connection the rest of the image arrives on
+    ///
+    /// \return uint32_t Image offset the peer must continue from
+    ///
+    uint32_t resume(uint16_t connection_id) noexcept;
+
+    ///
+    /// \brief Get the image offset of the first buffer not handed over
+    ///
+    /// \return uint32_t Offset in bytes (a multiple of the buffer size while
+    ///         suspended)
+    ///
+    uint32_t resume_offset() const noexcept { return m_submitted_bytes; }
+
+    ///
+    /// \brief Check whether a chunk can be staged without waiting
+    ///
+    /// If it cannot, the writer posts app_event_type::ota_staging_ready once
+    /// it frees a buffer. Also true when append() would fail anyway, so the
+    /// caller gets its error.
+    ///
+    /// \param length Length of the chunk in bytes
+    ///
+    /// \return true if append() takes \p length bytes at once
+    ///
+    bool fits(std::size_t length) noexcept;
+
+    ///
+    /// \brief Stage a chunk of image data
+    ///
+    /// Copies \p data into the current buffer, handing each full buffer to
+    /// the writer task. Never waits; check fits() first.
+    ///
+    /// \param data Chunk received from the peer
+    /// \param length Length of \p data in bytes
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS if staged, CY_RSLT_OTA_ERROR_BADARG
+    ///         if no download is being received, the error of an earlier
+    ///         failed commit, or the RTOS abstraction error if no buffer was
+    ///         free
+    ///
+    cy_rslt_t append(const uint8_t *data, uint16_t length) noexcept;
+
+    ///
+    /// \brief Have the writer check a CRC-32 before it commits more data
+    ///
+    /// Returns at once. The writer computes the CRC-32 of \p data before it
+    /// commits the next buffer of this image; on a mismatch nothing more is
+    /// committed, and append() and result() return
+    /// CY_RSLT_OTA_ERROR_BADARG.
+    ///
+    /// \param data Bytes to check; must stay readable until the image ends
+    /// \param length Length of \p data in bytes
+    /// \param crc Expected CRC-32 of \p data
+    ///
+    void expect_crc(const uint8_t *data, uint32_t length,
+                    uint32_t crc) noexcept;
+
+    ///
+    /// \brief Hand the partial buffer to the writer and end the session
+    ///
+    /// Does not wait; the image is complete once idle() is true.
+    ///
+    void flush() noexcept;
+
+    ///
+    /// \brief Check whether the writer has released every buffer
+    ///
+    /// If not, the writer posts app_event_type::ota_staging_ready once it
+    /// has.
+    ///
+    /// \return true if nothing is left to commit
+    ///
+    bool idle() noexcept;
+
+    ///
+    /// \brief Get the outcome of the image once flushed and idle
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS if the whole image reached the OTA
+    ///         library, otherwise the first commit or check error
+    ///
+    cy_rslt_t result() const noexcept;
+
+    ///
+    /// \brief Discard staged data and any suspended session
+    ///
+    /// Does not wait: the writer drops the buffers still queued.
+    ///
+    void abort() noexcept;
+
+    ///
+    /// \brief Commit buffers as they become ready (OTA writer task)
+    ///
+    /// Never returns.
+    ///
+    [[noreturn]] void run_writer() noexcept;
+
+    ///
+    /// \brief Get staging and flash throughput counters
+    ///
+    /// \return statistics Snapshot of the counters
+    ///
+    statistics stats() const noexcept;
+
+    ///
+    /// \brief Get the CRC-32 of every byte committed since start()
+    ///
+    /// Updated buffer by buffer as the writer commits them, so once the
+    /// flushed image is idle the digest of the whole image is available
+    /// without reading the image back from flash.
+    ///
+    /// \return uint32_t CRC-32 of the committed image
+    ///
+    uint32_t digest() const noexcept { return m_digest.value(); }
+
+    ///
+    /// \brief Print the counters and effective KB/s as one JSON object on
+    ///        the debug UART
+    ///
+    void print_json() const noexcept;
+
+private:
+    ///
+    /// \brief Lifecycle of the image being staged
+    ///
+    enum class session : uint8_t {
+        idle,      ///< No download in progress
+        receiving, ///< Peer is streaming image data
+        suspended  ///< Link lost mid-transfer; committed chunks are kept
+    };
+
+    ///
+    /// \brief Release the partially filled buffer without committing it
+    ///
+    void drop_partial() noexcept;
+
+    ///
+    /// \brief Hand the buffer being filled to the writer task
+    ///
+    void submit() noexcept;
+
+    ///
+    /// \brief Run the check requested by expect_crc(), if any (writer task)
+    ///
+    /// \return true unless the check failed
+    ///
+    bool run_check() noexcept;
+
+    ///
+    /// \brief Bytes append() can take before a buffer must be freed
+    ///
+    std::size_t free_bytes() const noexcept;
+
+    ///
+    /// \brief Pass one buffer to the OTA library
+    ///
+    /// \param data Buffer contents
+    /// \param length Number of valid bytes
+    ///
+    /// \return cy_rslt_t Result of cy_ota_ble_download_write()
+    ///
+    cy_rslt_t commit(uint8_t *data, uint16_t length) noexcept;
+
+    ///
+    /// \brief Read the RTOS time in milliseconds
+    ///
+    static uint32_t now_ms() noexcept;
+
+    std::array<std::array<uint8_t, OTA_STAGING_BUFFER_SIZE>,
+               OTA_STAGING_BUFFER_COUNT>
+        m_buffers{}; ///< Staging buffers, filled and committed in ring order
+    std::array<uint16_t, OTA_STAGING_BUFFER_COUNT>
+        m_lengths{}; ///< Valid bytes of each submitted buffer
+    std::array<uint32_t, OTA_STAGING_BUFFER_COUNT>
+        m_generations{}; ///< Image generation of each submitted buffer
+
+    cy_semaphore_t m_free{};  ///< Counts buffers available for filling
+    cy_semaphore_t m_ready{}; ///< Counts buffers waiting for the writer
+
+    std::size_t m_fill_index{};  ///< Buffer being filled (stack thread)
+    std::size_t m_fill_length{}; ///< Bytes in the buffer being filled
+    bool m_filling{false};       ///< true while a buffer is claimed
+
+    std::size_t m_write_index{}; ///< Next buffer to commit (writer task)
+
+    cy_ota_context_ptr m_ota_context{nullptr}; ///< OTA library context
+    uint32_t m_image_size{};                   ///< Announced image size
+    uint32_t m_submitted_bytes{};              ///< Bytes handed over
+    session m_session{session::idle};          ///< Stack-thread state
+
+    std::atomic<uint16_t> m_connection_id{}; ///< Connection of the image;
+                                             ///< changed by resume() while
+                                             ///< the writer commits
+
+    std::atomic<cy_rslt_t> m_result{CY_RSLT_SUCCESS}; ///< First commit error
+    std::atomic<uint32_t> m_generation{}; ///< Bumped by abort(); older
+                                          ///< buffers are dropped
+    std::atomic<uint32_t> m_in_flight{};  ///< Buffers the writer has yet
+                                          ///< to release
+    std::atomic<bool> m_waiting{};        ///< Data is held back; the writer
+                                          ///< posts when it frees a buffer
+
+    util::crc32 m_digest{}; ///< Running digest of committed data (writer)
+
+    const uint8_t *m_check_data{nullptr}; ///< See expect_crc()
+    uint32_t m_check_length{};            ///< See expect_crc()
+    uint32_t m_check_crc{};               ///< See expect_crc()
+    std::atomic<bool> m_check_pending{};  ///< Set by expect_crc(), cleared
+                                          ///< once the writer ran the check
+
+    uint32_t m_start_ms{};                     ///< Time of start()
+    std::atomic<uint32_t> m_bytes_committed{}; ///< See statistics
+    std::atomic<uint32_t> m_commits{};         ///< See statistics
+    std::atomic<uint32_t> m_write_ms{};        ///< See statistics
+    uint32_t m_stalls{};                       ///< See statistics
+};
+
+///
+/// \brief Global OTA staging instance
+///
+inline auto ota_staging_object = ota_staging{};
+
+#endif /* OTA_STAGING_HPP */
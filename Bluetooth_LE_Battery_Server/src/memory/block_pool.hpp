@@ -0,0 +1,180 @@
+///
+/// \file    block_pool.hpp
+/// \brief   Fixed-block, statically reserved memory pool
+///
+/// \details This header provides a lock-free pool of equally sized blocks
+///          backed by static storage. Allocation and release are a single
+///          compare-and-swap on an occupancy bitmap, so both are safe to call
+///          from tasks, the Bluetooth stack thread and interrupt handlers, and
+///          take the same time regardless of pool state.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Fixed-block pool
+///
+
+#ifndef BLOCK_POOL_HPP
+#define BLOCK_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Fixed-block memory pool
+///
+/// \details Blocks are tracked by a 32-bit occupancy bitmap, limiting a pool
+///          to 32 blocks. Requests larger than \p BlockSize and requests made
+///          while every block is in use fail with nullptr and are counted as
+///          exhaustions; the pool never falls back to the heap.
+///
+/// \tparam BlockSize  Size of each block in bytes
+/// \tparam BlockCount Number of blocks (1..32)
+///
+template <std::size_t BlockSize, std::size_t BlockCount>
+class block_pool final {
+public:
+    static_assert(BlockSize > 0, "block_pool requires a non-zero BlockSize");
+    static_assert(BlockCount > 0 && BlockCount <= 32,
+                  "block_pool supports between 1 and 32 blocks");
+
+    ///
+    /// \brief Pool usage counters
+    ///
+    struct statistics {
+        uint32_t in_use;          ///< Blocks currently allocated
+        uint32_t high_water_mark; ///< Largest number of blocks ever in use
+        uint32_t allocations;     ///< Successful allocations since reset
+        uint32_t exhaustions;     ///< Failed allocations since reset
+    };
+
+    ///
+    /// \brief Allocate one block
+    ///
+    /// \param size Number of bytes required (must not exceed BlockSize)
+    /// \return uint8_t* Pointer to the block, or nullptr if \p size is too
+    ///         large or no block is free
+    ///
+    uint8_t *allocate(std::size_t size) noexcept {
+        if (size > BlockSize) {
+            m_exhaustions.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto used = m_used.load(std::memory_order_relaxed);
+
+        while (true) {
+            const auto free = ~used & ALL_BLOCKS;
+
+            if (free == 0) {
+                m_exhaustions.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            const auto index = static_cast<std::size_t>(__builtin_ctz(free));
+            const auto claimed = used | (uint32_t{1} << index);
+
+            if (m_used.compare_exchange_weak(used, claimed,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                record_allocation(claimed);
+                return m_blocks[index].data();
+            }
+        }
+    }
+
+    ///
+    /// \brief Return a block to the pool
+    ///
+    /// \param block Pointer previously returned by allocate(); nullptr and
+    ///        pointers not owned by this pool are ignored
+    ///
+    void deallocate(uint8_t *block) noexcept {
+        if (!owns(block)) {
+            return;
+        }
+
+        const auto index =
+            static_cast<std::size_t>(block - m_blocks[0].data()) / BlockSize;
+
+        m_used.fetch_and(~(uint32_t{1} << index), std::memory_order_release);
+    }
+
+    ///
+    /// \brief Check whether a pointer is the start of a block of this pool
+    ///
+    /// \param block Pointer to test
+    /// \return true if \p block was (or could be) returned by allocate()
+    ///
+    bool owns(const uint8_t *block) const noexcept {
+        const auto *first = m_blocks[0].data();
+
+        if (block < first || block >= first + BlockSize * BlockCount) {
+            return false;
+        }
+
+        return static_cast<std::size_t>(block - first) % BlockSize == 0;
+    }
+
+    ///
+    /// \brief Snapshot the pool usage counters
+    ///
+    /// \return statistics Current counter values
+    ///
+    statistics stats() const noexcept {
+        return {static_cast<uint32_t>(
+                    __builtin_popcount(m_used.load(std::memory_order_relaxed))),
+                m_high_water_mark.load(std::memory_order_relaxed),
+                m_allocations.load(std::memory_order_relaxed),
+                m_exhaustions.load(std::memory_order_relaxed)};
+    }
+
+    ///
+    /// \brief Clear the allocation, exhaustion and high-water-mark counters
+    ///
+    void reset_stats() noexcept {
+        m_high_water_mark.store(0, std::memory_order_relaxed);
+        m_allocations.store(0, std::memory_order_relaxed);
+        m_exhaustions.store(0, std::memory_order_relaxed);
+    }
+
+    /// Size of each block in bytes
+    static constexpr auto block_size = BlockSize;
+
+    /// Number of blocks in the pool
+    static constexpr auto block_count = BlockCount;
+
+private:
+    ///
+    /// \brief Update counters after a successful allocation
+    ///
+    /// \param used Occupancy bitmap installed by the allocation
+    ///
+    void record_allocation(uint32_t used) noexcept {
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+
+        const auto in_use = static_cast<uint32_t>(__builtin_popcount(used));
+        auto peak = m_high_water_mark.load(std::memory_order_relaxed);
+
+        while (in_use > peak &&
+               !m_high_water_mark.compare_exchange_weak(
+                   peak, in_use, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Occupancy mask with one bit set per block
+    static constexpr auto ALL_BLOCKS = static_cast<uint32_t>(
+        (BlockCount == 32) ? ~uint32_t{} : ((uint32_t{1} << BlockCount) - 1));
+
+    alignas(std::max_align_t)
+        std::array<std::array<uint8_t, BlockSize>, BlockCount> m_blocks{};
+
+    std::atomic<uint32_t> m_used{0}; ///< Occupancy bitmap, bit set = in use
+
+    std::atomic<uint32_t> m_high_water_mark{0}; ///< Peak blocks in use
+    std::atomic<uint32_t> m_allocations{0};     ///< Successful allocations
+    std::atomic<uint32_t> m_exhaustions{0};     ///< Failed allocations
+};
+
+#endif /* BLOCK_POOL_HPP */
@@ -0,0 +1,130 @@
+///
+/// \file    connection_buffers.hpp
+/// \brief   Statically reserved buffers bound to connections
+///
+/// \details This header provides a table of equally sized buffers, each
+///          bound to one connection on first use and reused for every later
+///          request of that connection until it closes. A buffer is claimed
+///          while a response built in it is in flight, and released by the
+///          stack's transmit-complete callback.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Per-connection buffers
+///
+
+#ifndef CONNECTION_BUFFERS_HPP
+#define CONNECTION_BUFFERS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Per-connection buffer table
+///
+/// \details ATT allows a single outstanding request per bearer, so one
+///          buffer per connection is enough. Binding and unbinding happen on
+///          the Bluetooth stack thread; the in-flight flag is atomic because
+///          the transmit-complete callback may clear it from elsewhere.
+///
+/// \tparam BufferSize Size of each buffer in bytes
+/// \tparam Count      Number of buffers (simultaneous connections)
+///
+template <std::size_t BufferSize, std::size_t Count>
+class connection_buffers final {
+public:
+    static_assert(BufferSize > 0,
+                  "connection_buffers requires a non-zero BufferSize");
+    static_assert(Count > 0, "connection_buffers requires buffers");
+
+    ///
+    /// \brief Claim the buffer of a connection
+    ///
+    /// Returns the buffer already bound to \p connection_id, or binds an
+    /// unassigned one on first use.
+    ///
+    /// \param connection_id Connection issuing the request (non-zero)
+    ///
+    /// \return uint8_t* Claimed buffer of BufferSize bytes, or nullptr if the
+    ///         connection's buffer is still in flight or none is available
+    ///
+    uint8_t *acquire(uint16_t connection_id) noexcept {
+        auto *unassigned = static_cast<entry *>(nullptr);
+
+        if (connection_id == 0) {
+            return nullptr;
+        }
+
+        for (auto &candidate : m_entries) {
+            if (candidate.connection_id == connection_id) {
+                return candidate.in_flight.exchange(true)
+                           ? nullptr
+                           : candidate.buffer.data();
+            }
+
+            if (candidate.connection_id == 0 && unassigned == nullptr) {
+                unassigned = &candidate;
+            }
+        }
+
+        if (unassigned == nullptr) {
+            return nullptr;
+        }
+
+        unassigned->connection_id = connection_id;
+        unassigned->in_flight.store(true);
+
+        return unassigned->buffer.data();
+    }
+
+    ///
+    /// \brief Mark a buffer as reusable by its connection
+    ///
+    /// \param buffer Buffer returned by acquire(); others are ignored
+    ///
+    void release(const uint8_t *buffer) noexcept {
+        for (auto &candidate : m_entries) {
+            if (candidate.buffer.data() == buffer) {
+                candidate.in_flight.store(false);
+                return;
+            }
+        }
+    }
+
+    ///
+    /// \brief Unbind the buffer of a closed connection
+    ///
+    /// \param connection_id Connection that was closed
+    ///
+    void unbind(uint16_t connection_id) noexcept {
+        for (auto &candidate : m_entries) {
+            if (candidate.connection_id == connection_id) {
+                candidate.connection_id = 0;
+                candidate.in_flight.store(false);
+            }
+        }
+    }
+
+    /// Size of each buffer in bytes
+    static constexpr auto buffer_size = BufferSize;
+
+    /// Number of buffers
+    static constexpr auto buffer_count = Count;
+
+private:
+    ///
+    /// \brief Buffer and its binding
+    ///
+    struct entry {
+        std::array<uint8_t, BufferSize>
+            buffer;                  ///< Response under construction or sent
+        uint16_t connection_id;      ///< Owning connection (0 if unassigned)
+        std::atomic<bool> in_flight; ///< Set until the stack transmits it
+    };
+
+    std::array<entry, Count> m_entries{}; ///< Buffers, by first use
+};
+
+#endif /* CONNECTION_BUFFERS_HPP */
@@ -0,0 +1,179 @@
+///
+/// \file    mpsc_queue.hpp
+/// \brief   Bounded lock-free multi-producer, single-consumer queue
+///
+/// \details This header provides a fixed-capacity FIFO of trivially copyable
+///          elements backed by static storage. Each slot carries a sequence
+///          number, so producers claim a slot with one compare-and-swap on the
+///          tail and publish it with a release store, and the single consumer
+///          never contends with them. Pushing never blocks: when the queue is
+///          full the element is dropped and counted.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - MPSC queue
+///
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+///
+/// \brief Bounded lock-free MPSC queue
+///
+/// \tparam T        Element type (trivially copyable)
+/// \tparam Capacity Number of slots (power of two)
+///
+template <typename T, std::size_t Capacity>
+class mpsc_queue final {
+public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "mpsc_queue elements must be trivially copyable");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "mpsc_queue capacity must be a power of two");
+
+    ///
+    /// \brief Queue usage counters
+    ///
+    struct statistics {
+        uint32_t depth;           ///< Elements currently queued
+        uint32_t high_water_mark; ///< Largest depth ever observed
+        uint32_t pushed;          ///< Elements accepted since reset
+        uint32_t dropped;         ///< Elements rejected because queue was full
+    };
+
+    mpsc_queue() noexcept {
+        for (auto i = std::size_t{}; i < Capacity; i++) {
+            m_slots[i].sequence.store(static_cast<uint32_t>(i),
+                                      std::memory_order_relaxed);
+        }
+    }
+
+    mpsc_queue(const mpsc_queue &) = delete;
+    mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+    ///
+    /// \brief Append an element (any number of producers)
+    ///
+    /// \param value Element to append
+    /// \return true if queued, false if the queue was full
+    ///
+    bool try_push(const T &value) noexcept {
+        auto position = m_tail.load(std::memory_order_relaxed);
+        auto *slot = static_cast<queue_slot *>(nullptr);
+
+        while (true) {
+            slot = &m_slots[position & MASK];
+
+            const auto sequence =
+                slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int32_t>(sequence - position);
+
+            if (difference == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = value;
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        update_high_water_mark(position + 1 -
+                               m_head.load(std::memory_order_relaxed));
+
+        return true;
+    }
+
+    ///
+    /// \brief Remove the oldest element (single consumer only)
+    ///
+    /// \param value Receives the element
+    /// \return true if an element was removed, false if the queue was empty
+    ///
+    bool try_pop(T &value) noexcept {
+        const auto position = m_head.load(std::memory_order_relaxed);
+        auto &slot = m_slots[position & MASK];
+
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<int32_t>(sequence - (position + 1)) < 0) {
+            return false;
+        }
+
+        value = slot.value;
+        slot.sequence.store(position + static_cast<uint32_t>(Capacity),
+                            std::memory_order_release);
+        m_head.store(position + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    ///
+    /// \brief Get queue usage counters
+    ///
+    /// \return statistics Snapshot of the counters
+    ///
+    statistics stats() const noexcept {
+        return {m_tail.load(std::memory_order_relaxed) -
+                    m_head.load(std::memory_order_relaxed),
+                m_high_water_mark.load(std::memory_order_relaxed),
+                m_pushed.load(std::memory_order_relaxed),
+                m_dropped.load(std::memory_order_relaxed)};
+    }
+
+    ///
+    /// \brief Reset the push, drop and high-water counters
+    ///
+    void reset_stats() noexcept {
+        m_high_water_mark.store(0, std::memory_order_relaxed);
+        m_pushed.store(0, std::memory_order_relaxed);
+        m_dropped.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr auto MASK = static_cast<uint32_t>(Capacity - 1);
+
+    ///
+    /// \brief One element slot and its publication sequence number
+    ///
+    struct queue_slot {
+        std::atomic<uint32_t> sequence; ///< Position the slot is ready for
+        T value;                        ///< Stored element
+    };
+
+    ///
+    /// \brief Raise the high-water mark to \p depth if it is larger
+    ///
+    void update_high_water_mark(uint32_t depth) noexcept {
+        auto current = m_high_water_mark.load(std::memory_order_relaxed);
+
+        while (depth > current &&
+               !m_high_water_mark.compare_exchange_weak(
+                   current, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::array<queue_slot, Capacity> m_slots{}; ///< Element storage
+
+    std::atomic<uint32_t> m_tail{0}; ///< Next position to claim (producers)
+    std::atomic<uint32_t> m_head{0}; ///< Next position to read (consumer)
+
+    std::atomic<uint32_t> m_high_water_mark{0}; ///< Largest observed depth
+    std::atomic<uint32_t> m_pushed{0};          ///< Accepted elements
+    std::atomic<uint32_t> m_dropped{0};         ///< Rejected elements
+};
+
+#endif /* MPSC_QUEUE_HPP */
@@ -0,0 +1,176 @@
+///
+/// \file    app_event_task.cpp
+/// \brief   Application event task implementation
+///
+/// \details This file implements the application event queue and the
+///          FreeRTOS task that services it, along with the instrumentation
+///          of queue depth and Bluetooth stack callback duration.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Application event task implementation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include <FreeRTOS.h>
+#include <task.h>
+}
+#pragma GCC diagnostic pop
+
+#include "app_event_task.hpp"
+#include "ble_advertiser.hpp"
+#include "ble_context.hpp"
+#include "ble_link_optimizer.hpp"
+#include "utilities.hpp"
+
+#include <cstdio>
+
+///
+/// \brief Queue of events deferred from the Bluetooth stack thread
+///
+static auto app_event_queue = app_event_queue_type{};
+
+///
+/// \brief Bluetooth stack callback duration counters
+///
+/// Updated from the Bluetooth stack thread only.
+///
+static struct {
+    uint32_t count;        ///< Callbacks measured
+    uint32_t max_cycles;   ///< Longest callback
+    uint64_t total_cycles; ///< Sum of all callback durations
+} callback_statistics{};
+
+///
+/// \brief Perform the work described by one event
+///
+/// \param event Event removed from the queue
+///
+static void app_event_dispatch(const app_event &event);
+
+BaseType_t app_event_task_create(void) {
+    auto result =
+        xTaskCreate(app_event_task, "App Event Task",
+                    (configMINIMAL_STACK_SIZE * 4), nullptr,
+                    (configMAX_PRIORITIES - 3), &app_event_task_handle);
+    return result;
+}
+
+void app_event_task(void *task_parameter) {
+    util::unused(task_parameter);
+
+    auto event = app_event{};
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (app_event_queue.try_pop(event)) {
+            app_event_dispatch(event);
+        }
+    }
+}
+
+bool app_event_post(const app_event &event) {
+    if (!app_event_queue.try_push(event)) {
+        return false;
+    }
+
+    if (app_event_task_handle != nullptr) {
+        xTaskNotifyGive(app_event_task_handle);
+    }
+
+    return true;
+}
+
+bool app_event_post_from_isr(const app_event &event) {
+    if (!app_event_queue.try_push(event)) {
+        return false;
+    }
+
+    auto xHigherPriorityTaskWoken = BaseType_t{};
+    xHigherPriorityTaskWoken = pdFALSE;
+
+    if (app_event_task_handle != nullptr) {
+        vTaskNotifyGiveFromISR(app_event_task_handle,
+                               &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+    return true;
+}
+
+void app_event_record_callback_cycles(uint32_t elapsed_cycles) {
+    ++callback_statistics.count;
+    callback_statistics.total_cycles += elapsed_cycles;
+
+    if (elapsed_cycles > callback_statistics.max_cycles) {
+        callback_statistics.max_cycles = elapsed_cycles;
+    }
+}
+
+app_event_queue_type::statistics app_event_queue_stats() {
+    return app_event_queue.stats();
+}
+
+void app_event_print_json() {
+    const auto queue = app_event_queue.stats();
+
+    const auto mean_cycles =
+        (callback_statistics.count != 0)
+            ? static_cast<uint32_t>(callback_statistics.total_cycles /
+                                    callback_statistics.count)
+            : uint32_t{};
+
+    std::printf("{\"app_events\":{\"queue\":{\"depth\":%lu,"
+                "\"high_water_mark\":%lu,\"pushed\":%lu,\"dropped\":%lu},"
+                "\"stack_callbacks\":{\"count\":%lu,\"mean_cycles\":%lu,"
+                "\"max_cycles\":%lu}}}\n",
+                static_cast<unsigned long>(queue.depth),
+                static_cast<unsigned long>(queue.high_water_mark),
+                static_cast<unsigned long>(queue.pushed),
+                static_cast<unsigned long>(queue.dropped),
+                static_cast<unsigned long>(callback_statistics.count),
+                static_cast<unsigned long>(mean_cycles),
+                static_cast<unsigned long>(callback_statistics.max_cycles));
+
+    app_event_queue.reset_stats();
+    callback_statistics = {};
+}
+
+static void app_event_dispatch(const app_event &event) {
+    switch (event.type) {
+    case app_event_type::advertising_led_update:
+        ble_context_object.update_advertising_led();
+        break;
+
+    case app_event_type::ota_confirmation:
+        ble_context_object.ota_agent_confirmation_handler();
+        break;
+
+    case app_event_type::ota_staging_ready:
+        ble_context_object.ota_staging_ready_handler();
+        break;
+
+    case app_event_type::link_policy:
+        ble_link_optimizer_object.timer_expired();
+        break;
+
+    case app_event_type::link_log:
+        ble_link_optimizer_object.log_pending();
+        break;
+
+    case app_event_type::advertising_step:
+        ble_advertiser_object.timer_expired();
+        break;
+
+    case app_event_type::advertising_restart:
+        ble_advertiser_object.restart();
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,130 @@
+///
+/// \file    app_event_task.hpp
+/// \brief   Application event task public interface
+///
+/// \details This header provides the public interface for the application
+///          event task. Bluetooth stack callbacks post small events to a
+///          bounded lock-free queue and return immediately; this task drains
+///          the queue and performs the slow work (PWM reconfiguration, OTA
+///          data held for a staging buffer, OTA completion and reboot, link
+///          traffic policy, advertising schedule) outside the stack thread.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Application event task interface
+///
+
+#ifndef APP_EVENT_TASK_HPP
+#define APP_EVENT_TASK_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include <FreeRTOS.h>
+#include <task.h>
+}
+#pragma GCC diagnostic pop
+
+#include "mpsc_queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+///
+/// \brief Work deferred from the Bluetooth stack thread
+///
+enum class app_event_type : uint8_t {
+    advertising_led_update, ///< Refresh the advertising/connection LED
+    ota_confirmation,       ///< Client confirmed an OTA indication
+    ota_staging_ready,      ///< OTA writer freed a staging buffer
+    link_policy,            ///< Link policy timer expired
+    link_log,               ///< Link outcomes are waiting to be logged
+    advertising_step,       ///< Advertising step timer expired
+    advertising_restart     ///< User button pressed
+};
+
+///
+/// \brief Deferred work item (plain data, copied into the queue)
+///
+struct app_event {
+    app_event_type type;    ///< Work to perform
+    uint16_t connection_id; ///< Connection the event relates to (0 if none)
+};
+
+///
+/// \brief Number of events the queue can hold
+///
+constexpr auto APP_EVENT_QUEUE_CAPACITY = std::size_t{16};
+
+///
+/// \brief Application event queue type
+///
+using app_event_queue_type = mpsc_queue<app_event, APP_EVENT_QUEUE_CAPACITY>;
+
+///
+/// \brief Create and start the application event task
+///
+/// \return BaseType_t pdPASS if task created successfully, pdFAIL otherwise
+///
+BaseType_t app_event_task_create(void);
+
+///
+/// \brief Application event task
+///
+/// Sleeps until events are posted, then drains the queue in FIFO order.
+/// Created in main().
+///
+/// \param task_parameter Task parameter (unused)
+///
+/// \return void
+///
+void app_event_task(void *task_parameter);
+
+///
+/// \brief Post an event to the application event task
+///
+/// Lock-free and non-blocking; safe to call from the Bluetooth stack thread
+/// and from any task.
+///
+/// \param event Event to post
+///
+/// \return true if queued, false if the queue was full (the event is dropped)
+///
+bool app_event_post(const app_event &event);
+
+///
+/// \brief Post an event to the application event task from an interrupt
+///
+/// \param event Event to post
+///
+/// \return true if queued, false if the queue was full (the event is dropped)
+///
+bool app_event_post_from_isr(const app_event &event);
+
+///
+/// \brief Record the time spent in one Bluetooth stack callback
+///
+/// \param elapsed_cycles CPU cycles spent in the callback
+///
+void app_event_record_callback_cycles(uint32_t elapsed_cycles);
+
+///
+/// \brief Get application event queue usage counters
+///
+/// \return app_event_queue_type::statistics Depth, high-water mark, pushed
+///         and dropped counts since the last app_event_print_json()
+///
+app_event_queue_type::statistics app_event_queue_stats();
+
+///
+/// \brief Print queue depth and callback duration counters as one JSON object
+///        on the debug UART, then reset them
+///
+void app_event_print_json();
+
+///
+/// \brief FreeRTOS task handle for application event task
+///
+inline TaskHandle_t app_event_task_handle;
+
+#endif /* APP_EVENT_TASK_HPP */
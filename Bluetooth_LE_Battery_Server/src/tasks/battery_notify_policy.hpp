@@ -0,0 +1,99 @@
+///
+/// \file    battery_notify_policy.hpp
+/// \brief   Change-detection policy for battery level notifications
+///
+/// \details This header provides the policy deciding whether a battery level
+///          sample is worth a notification. A sample is sent when it leaves a
+///          hysteresis band around the last level sent and the minimum
+///          interval has elapsed, or when the maximum interval (heartbeat)
+///          expires. A flat level therefore costs one notification per
+///          heartbeat instead of one per wakeup.
+///
+///          Time is expressed in RTOS ticks and compared with unsigned
+///          subtraction, so tick counter wraparound is harmless.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Battery notification policy
+///
+
+#ifndef BATTERY_NOTIFY_POLICY_HPP
+#define BATTERY_NOTIFY_POLICY_HPP
+
+#include <cstdint>
+
+///
+/// \brief Tunables of \ref battery_notify_policy
+///
+struct battery_notify_policy_config {
+    uint8_t hysteresis_percent;  ///< Change that must be exceeded to notify
+    uint32_t min_interval_ticks; ///< Minimum time between notifications
+    uint32_t max_interval_ticks; ///< Heartbeat: notify at least this often
+};
+
+///
+/// \brief Decides when a battery level change should be notified
+///
+class battery_notify_policy final {
+public:
+    using config = battery_notify_policy_config;
+
+    constexpr explicit battery_notify_policy(const config &configuration)
+        : m_config{configuration} {}
+
+    ///
+    /// \brief Get the policy tunables
+    ///
+    constexpr const config &configuration() const noexcept { return m_config; }
+
+    ///
+    /// \brief Decide whether a sample should be notified
+    ///
+    /// \param level Battery level sample in percent
+    /// \param now_ticks Current RTOS tick count
+    ///
+    /// \return true if \p level should be sent now
+    ///
+    constexpr bool should_notify(uint8_t level,
+                                 uint32_t now_ticks) const noexcept {
+        if (!m_has_sent) {
+            return true;
+        }
+
+        const auto elapsed = now_ticks - m_last_sent_ticks;
+
+        if (elapsed >= m_config.max_interval_ticks) {
+            return true;
+        }
+
+        if (elapsed < m_config.min_interval_ticks) {
+            return false;
+        }
+
+        const auto delta = (level > m_last_sent_level)
+                               ? level - m_last_sent_level
+                               : m_last_sent_level - level;
+
+        return delta > m_config.hysteresis_percent;
+    }
+
+    ///
+    /// \brief Record that a sample was notified
+    ///
+    /// \param level Battery level sent in percent
+    /// \param now_ticks RTOS tick count at which it was sent
+    ///
+    constexpr void mark_sent(uint8_t level, uint32_t now_ticks) noexcept {
+        m_last_sent_level = level;
+        m_last_sent_ticks = now_ticks;
+        m_has_sent = true;
+    }
+
+private:
+    config m_config;              ///< Policy tunables
+    uint32_t m_last_sent_ticks{}; ///< Tick count of the last notification
+    uint8_t m_last_sent_level{};  ///< Level carried by the last notification
+    bool m_has_sent{false};       ///< false until the first notification
+};
+
+#endif /* BATTERY_NOTIFY_POLICY_HPP */
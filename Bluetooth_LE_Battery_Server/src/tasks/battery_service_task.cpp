@@ -3,7 +3,14 @@
 /// \brief   Battery Service Task implementation
 ///
 /// \details This file implements the Battery Service FreeRTOS task that
-///          periodically updates battery levels and sends BLE notifications.
+///          periodically measures the battery and sends BLE notifications.
+///          Each timer tick starts a block of ADC samples that DMA moves into
+///          a ring; the completed block is filtered in fixed point and mapped
+///          to a state of charge through an OCV table. Without the ADC, the
+///          level is simulated as a steady drain instead. The update timer only
+///          runs while at least one peer subscribes or the level is broadcast
+///          in the advertising data, and a new subscriber is sent the current
+///          level right away.
 ///
 /// \author  galudino
 /// \date    2025
@@ -19,45 +26,217 @@ extern "C" {
 #include "wiced_bt_gatt.h"
 
 #include <FreeRTOS.h>
+#include <task.h>
 }
 #pragma GCC diagnostic pop
 
+#include "adc_sampler.hpp"
+#include "battery_gauge.hpp"
+#include "battery_notify_policy.hpp"
 #include "battery_service_task.hpp"
+#include "ble_battery_broadcast.hpp"
 #include "ble_context.hpp"
+#include "ble_gatt.hpp"
+#include "ble_gatt_statistics.hpp"
+#include "cyhal_adc_sampler.hpp"
+#include "cyhal_periodic_timer.hpp"
+#include "periodic_timer.hpp"
 #include "utilities.hpp"
 
-constexpr auto BATTERY_LEVEL_CHANGE =
-    uint32_t(2); ///< Rate of change of battery level
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+
+using Timer = cyhal_periodic_timer;
+
 constexpr auto BATTERY_LEVEL_UPDATE_MS =
     uint32_t(9999u); ///< Update rate of Battery level
 constexpr auto BATTERY_LEVEL_UPDATE_FREQ =
     uint32_t(10000); ///< Update frequency
 
-static auto battery_service_timer = cyhal_timer_t{}; ///< 5 sec timer object
+static auto battery_service_timer = Timer{}; ///< Battery level update timer
+
+constexpr auto BATTERY_LEVEL_CHANGE =
+    uint8_t{2}; ///< Simulated drain per update, without the ADC
+constexpr auto BATTERY_ADC_BLOCK_SIZE =
+    std::size_t{16}; ///< Samples per measurement
+constexpr auto BATTERY_ADC_BLOCK_COUNT =
+    std::size_t{2}; ///< Blocks in the DMA ring
+
+///
+/// \brief Battery voltage divider tap
+///
+/// Arduino header A0 on the CYBLE-416045-EVAL (see the kit schematic). The
+/// kit has no battery divider of its own: the pin goes straight to the
+/// module, so the divider below is fitted off-board, between the cell, A0
+/// and GND.
+///
+constexpr auto BATTERY_ADC_PIN = cyhal_gpio_t{CYBSP_A0};
+
+constexpr auto BATTERY_DIVIDER_TOP_OHMS =
+    int64_t{100000}; ///< Cell to BATTERY_ADC_PIN
+constexpr auto BATTERY_DIVIDER_BOTTOM_OHMS =
+    int64_t{100000}; ///< BATTERY_ADC_PIN to GND
+
+constexpr auto BATTERY_FULL_MICROVOLTS =
+    int64_t{4200000}; ///< Fully charged Li-ion cell
+constexpr auto BATTERY_ADC_VREF_MICROVOLTS =
+    int64_t{3300000}; ///< VDDA, the ADC reference on the kit
+
+static_assert(BATTERY_FULL_MICROVOLTS * BATTERY_DIVIDER_BOTTOM_OHMS /
+                      (BATTERY_DIVIDER_TOP_OHMS +
+                       BATTERY_DIVIDER_BOTTOM_OHMS) <
+                  BATTERY_ADC_VREF_MICROVOLTS,
+              "A full cell must divide below the ADC reference");
+
+///
+/// \brief Scale the voltage at the divider tap back up to the cell
+///
+/// \param pin_microvolts Voltage at BATTERY_ADC_PIN in microvolts
+/// \return int32_t Cell voltage in millivolts
+///
+constexpr int32_t battery_cell_millivolts(int32_t pin_microvolts) {
+    return static_cast<int32_t>(
+        pin_microvolts *
+        (BATTERY_DIVIDER_TOP_OHMS + BATTERY_DIVIDER_BOTTOM_OHMS) /
+        (BATTERY_DIVIDER_BOTTOM_OHMS * 1000));
+}
+
+using BatteryAdc =
+    cyhal_adc_sampler<BATTERY_ADC_BLOCK_SIZE, BATTERY_ADC_BLOCK_COUNT>;
+
+static auto battery_adc = BatteryAdc{BATTERY_ADC_PIN}; ///< Battery ADC
+
+///
+/// \brief Level source
+///
+/// Cleared when the ADC fails to initialize; the level is then simulated,
+/// as it was before the ADC was measured.
+///
+static auto battery_adc_ready = false;
+
+///
+/// \brief Battery voltage filter
+///
+/// Median of 5 rejects isolated spikes (e.g., a radio burst on the supply);
+/// the low-pass averages over about 8 samples.
+///
+static auto battery_filter = util::battery_voltage_filter<5, 3>{};
+
+constexpr auto BATTERY_EVENT_TIMER =
+    uint32_t{1u << 0}; ///< Task notification bit: update period elapsed
+constexpr auto BATTERY_EVENT_SUBSCRIPTION =
+    uint32_t{1u << 1}; ///< Task notification bit: subscribers may have changed
+constexpr auto BATTERY_EVENT_SAMPLES =
+    uint32_t{1u << 2}; ///< Task notification bit: ADC block acquired
+
+///
+/// \brief Default battery notification policy
+///
+/// Notify once the level has moved by more than 5 percent since the last
+/// notification, at most every 5 seconds, and at least every 5 minutes.
+///
+constexpr auto BATTERY_NOTIFY_POLICY = battery_notify_policy_config{
+    5,                    ///< Hysteresis band in percent
+    pdMS_TO_TICKS(5000),  ///< Minimum interval
+    pdMS_TO_TICKS(300000) ///< Maximum interval (heartbeat)
+};
+
+// A minimum interval of a whole update period or more would hold a change
+// back until the period after the one that measured it
+static_assert(BATTERY_NOTIFY_POLICY.min_interval_ticks <
+                  pdMS_TO_TICKS(BATTERY_LEVEL_UPDATE_MS),
+              "The minimum notification interval must be below the update "
+              "period");
+
+static auto battery_notify = battery_notify_policy{BATTERY_NOTIFY_POLICY};
+
+///
+/// \brief Battery level owned by this task
+///
+/// Published through ble_gatt_db_set_value(), which defers the update while
+/// a read response still references the GATT database value.
+///
+static auto battery_level = uint8_t{app_bas_battery_level[0]};
+
+///
+/// \brief Time from a subscription to its first notification
+///
+struct first_notification_statistics {
+    uint32_t count;        ///< First notifications sent
+    uint32_t max_cycles;   ///< Slowest first notification
+    uint64_t total_cycles; ///< Sum of all delays
+};
+
+static auto first_notification = first_notification_statistics{};
+
+///
+/// \brief Cost and result of the battery measurement
+///
+struct measurement_statistics {
+    uint32_t samples;       ///< Samples filtered
+    uint64_t filter_cycles; ///< Cycles spent filtering them
+    int32_t millivolts;     ///< Latest filtered battery voltage
+};
+
+static auto measurement = measurement_statistics{};
+
+///
+/// \brief Cycle count of the latest subscription change
+///
+/// Written on the Bluetooth stack thread, read by the battery task.
+///
+static auto subscription_cycles = std::atomic<uint32_t>{};
 
 ///
 /// \brief Timer callback function
 ///
-/// This callback function is invoked on timeout of 1 second timer.
+/// This callback function is invoked on every expiry of the battery level
+/// update timer.
 ///
 /// \param callback_argument Unused
-/// \param timer_event Unused
 ///
 /// \return void
 ///
-static void battery_service_timer_callback(void *callback_argument,
-                                           cyhal_timer_event_t timer_event);
+static void battery_service_timer_callback(void *callback_argument);
+
+///
+/// \brief ADC block completion callback
+///
+/// Runs in interrupt context once DMA has filled a block of samples.
+///
+/// \param callback_argument Unused
+///
+/// \return void
+///
+static void battery_adc_callback(void *callback_argument);
 
 ///
 /// \brief Update battery percentage
 ///
-/// Simulated battery level updates:
-/// Battery level is read from GATT DB and is reduced by `decrease_interval`
-/// percent by default, and initialized again to 100 once it reaches 0.
+/// Filters the latest ADC block, maps the filtered voltage to a state of
+/// charge and publishes it to the GATT DB.
+///
+static void battery_service_update_percentage(void);
+
+///
+/// \brief Simulate a battery level update
+///
+/// The level is reduced by \p decrease_interval percent, and initialized
+/// again to 100 once it reaches 0, then published to the GATT DB.
 ///
-static void battery_service_update_percentage(
+/// \param decrease_interval Drain per update in percent
+///
+static void battery_service_simulate_percentage(
     uint8_t decrease_interval = BATTERY_LEVEL_CHANGE);
 
+///
+/// \brief Publish battery_level to the GATT DB and the advertising data
+///
+static void battery_service_publish_level(void);
+
 BaseType_t battery_service_task_create(void) {
     auto result =
         xTaskCreate(battery_service_task, "Battery Service Task",
@@ -69,89 +248,224 @@ BaseType_t battery_service_task_create(void) {
 void battery_service_task(void *task_parameter) {
     util::unused(task_parameter);
 
-    // Initialize the HAL timer used to count seconds
-    auto result = cyhal_timer_init(&battery_service_timer, NC, nullptr);
+    // Configure the timer for battery level updates
+    auto result = battery_service_timer.initialize(
+        BATTERY_LEVEL_UPDATE_MS, BATTERY_LEVEL_UPDATE_FREQ,
+        battery_service_timer_callback, nullptr);
 
     if (result != CY_RSLT_SUCCESS) {
         CY_ASSERT(false);
     }
 
-    ///
-    /// \brief Configure timer for 5 sec
-    ///
-    const auto battery_service_timer_config = cyhal_timer_cfg_t{
-        true,                                        ///< Run timer indefinitely
-        cyhal_timer_direction_t::CYHAL_TIMER_DIR_UP, ///< Timer counts up
-        false,                                       ///< Don't use compare mode
-        BATTERY_LEVEL_UPDATE_MS, ///< Timer period in milliseconds
-        0,                       ///< Timer compare value (not used)
-        0                        ///< Initial counter value
-    };
-
-    // Configure the timer for battery level updates (5 seconds)
-    cyhal_timer_configure(&battery_service_timer,
-                          &battery_service_timer_config);
-
-    result = cyhal_timer_set_frequency(&battery_service_timer,
-                                       BATTERY_LEVEL_UPDATE_FREQ);
+    battery_adc_ready =
+        (battery_adc.initialize(battery_adc_callback, nullptr) ==
+         CY_RSLT_SUCCESS);
 
-    if (result != CY_RSLT_SUCCESS) {
-        CY_ASSERT(false);
+    if (battery_adc_ready) {
+        // Measure once now so reads return a real level before anyone
+        // subscribes; the timer starts with the first subscriber, or at once
+        // when broadcasting
+        battery_adc.start();
+    } else {
+        std::printf("Battery ADC unavailable, simulating the battery level\n");
     }
 
-    // Register for a callback whenever timer reaches terminal count
-    cyhal_timer_register_callback(&battery_service_timer,
-                                  battery_service_timer_callback, nullptr);
+    auto subscribers = std::array<ble_bas_subscriber, BLE_MAX_CONNECTIONS>{};
+    auto timer_running = false;
 
-    cyhal_timer_enable_event(
-        &battery_service_timer,
-        cyhal_timer_event_t::CYHAL_TIMER_IRQ_TERMINAL_COUNT, 3, true);
+    while (true) {
+        auto events = uint32_t{};
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
 
-    // Start battery level timer
-    if (cyhal_timer_start(&battery_service_timer) != CY_RSLT_SUCCESS) {
-        CY_ASSERT(false);
-    }
+        if ((events & BATTERY_EVENT_SAMPLES) != 0) {
+            // Keep the GATT DB current even while nobody subscribes
+            battery_service_update_percentage();
+        }
 
-    while (true) {
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if ((events & BATTERY_EVENT_TIMER) != 0) {
+            if (battery_adc_ready) {
+                // Fails only if the previous block is still being acquired
+                battery_adc.start();
+            } else {
+                battery_service_simulate_percentage();
+            }
+        }
 
-        if (!ble_context_object.connection_id()) {
-            // Not connected, skip battery update
-            continue;
+        const auto subscriber_count =
+            ble_context_object.bas_notification_subscribers(subscribers);
+
+        // Passive scanners listen all the time while the level is broadcast
+        const auto listening = BLE_BATTERY_BROADCAST || subscriber_count != 0;
+
+        if (listening != timer_running) {
+            // Only tick while someone listens; a restarted timer runs a full
+            // period from now
+            timer_running = listening;
+            result = timer_running ? battery_service_timer.reset()
+                                   : battery_service_timer.stop();
+
+            if (result == CY_RSLT_SUCCESS && timer_running) {
+                result = battery_service_timer.start();
+            }
+
+            CY_ASSERT(result == CY_RSLT_SUCCESS);
         }
 
-        if (!(app_bas_battery_level_client_char_config[0] &
-              wiced_bt_gatt_client_char_config_e::
-                  GATT_CLIENT_CONFIG_NOTIFICATION)) {
-            // Notifications not enabled, skip battery update
+        if (subscriber_count == 0) {
+            // No connected peer has notifications enabled
             continue;
         }
 
-        battery_service_update_percentage();
+        const auto now = static_cast<uint32_t>(xTaskGetTickCount());
+
+        // Level outside the hysteresis band, or heartbeat due
+        const auto due = battery_notify.should_notify(battery_level, now);
+
+        // Fan the same value out in one pass: to every subscriber when due,
+        // otherwise only to new subscribers, which get the current level
+        // without waiting for a change or the heartbeat
+        auto sent = false;
+
+        for (auto i = std::size_t{}; i < subscriber_count; i++) {
+            const auto &subscriber = subscribers[i];
+
+            if (!due && !subscriber.first_pending) {
+                continue;
+            }
+
+            const auto status = wiced_bt_gatt_server_send_notification(
+                subscriber.connection_id, HDLC_BAS_BATTERY_LEVEL_VALUE,
+                sizeof(battery_level), &battery_level, nullptr);
+
+            if (status != wiced_bt_gatt_status_e::WICED_BT_GATT_SUCCESS) {
+                continue;
+            }
+
+            sent = true;
+
+            if (subscriber.first_pending) {
+                ble_context_object.bas_first_value_sent(subscriber);
+
+                const auto elapsed =
+                    ble_gatt_statistics::cycles() - subscription_cycles.load();
+
+                ++first_notification.count;
+                first_notification.total_cycles += elapsed;
+
+                if (elapsed > first_notification.max_cycles) {
+                    first_notification.max_cycles = elapsed;
+                }
+            }
+        }
+
+        if (sent && due) {
+            battery_notify.mark_sent(battery_level, now);
+        }
+    }
+}
+
+void battery_service_subscription_changed(void) {
+    subscription_cycles.store(ble_gatt_statistics::cycles());
 
-        wiced_bt_gatt_server_send_notification(
-            ble_context_object.connection_id(), HDLC_BAS_BATTERY_LEVEL_VALUE,
-            app_bas_battery_level_len, app_bas_battery_level, nullptr);
+    if (battery_service_task_handle != nullptr) {
+        xTaskNotify(battery_service_task_handle, BATTERY_EVENT_SUBSCRIPTION,
+                    eSetBits);
     }
 }
 
-static void battery_service_timer_callback(void *callback_argument,
-                                           cyhal_timer_event_t timer_event) {
+void battery_service_print_json(void) {
+    const auto mean_cycles =
+        (first_notification.count != 0)
+            ? static_cast<uint32_t>(first_notification.total_cycles /
+                                    first_notification.count)
+            : uint32_t{};
+
+    const auto cycles_per_sample =
+        (measurement.samples != 0)
+            ? static_cast<uint32_t>(measurement.filter_cycles /
+                                    measurement.samples)
+            : uint32_t{};
+
+    std::printf("{\"battery_service\":{\"first_notification\":{"
+                "\"count\":%lu,\"mean_cycles\":%lu,\"max_cycles\":%lu},"
+                "\"measurement\":{\"millivolts\":%ld,\"level\":%u,"
+                "\"samples\":%lu,\"cycles_per_sample\":%lu}}}\n",
+                static_cast<unsigned long>(first_notification.count),
+                static_cast<unsigned long>(mean_cycles),
+                static_cast<unsigned long>(first_notification.max_cycles),
+                static_cast<long>(measurement.millivolts),
+                static_cast<unsigned>(battery_level),
+                static_cast<unsigned long>(measurement.samples),
+                static_cast<unsigned long>(cycles_per_sample));
+
+    first_notification = {};
+    measurement.samples = 0;
+    measurement.filter_cycles = 0;
+}
+
+static void battery_service_timer_callback(void *callback_argument) {
     util::unused(callback_argument);
-    util::unused(timer_event);
 
     auto xHigherPriorityTaskWoken = BaseType_t{};
     xHigherPriorityTaskWoken = pdFALSE;
 
-    vTaskNotifyGiveFromISR(battery_service_task_handle,
-                           &xHigherPriorityTaskWoken);
+    xTaskNotifyFromISR(battery_service_task_handle, BATTERY_EVENT_TIMER,
+                       eSetBits, &xHigherPriorityTaskWoken);
 
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
-static void battery_service_update_percentage(uint8_t decrease_interval) {
-    app_bas_battery_level[0] =
-        app_bas_battery_level[0] == 0
+static void battery_adc_callback(void *callback_argument) {
+    util::unused(callback_argument);
+
+    auto xHigherPriorityTaskWoken = BaseType_t{};
+    xHigherPriorityTaskWoken = pdFALSE;
+
+    xTaskNotifyFromISR(battery_service_task_handle, BATTERY_EVENT_SAMPLES,
+                       eSetBits, &xHigherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void battery_service_update_percentage(void) {
+    const auto *samples = battery_adc.completed();
+
+    if (samples == nullptr) {
+        return;
+    }
+
+    const auto start = ble_gatt_statistics::cycles();
+    auto millivolts = int32_t{};
+
+    for (auto i = std::size_t{}; i < BATTERY_ADC_BLOCK_SIZE; i++) {
+        // Counts to microvolts at the pin, then millivolts at the cell
+        millivolts = battery_filter.update(
+            battery_cell_millivolts(battery_adc.to_microvolts(samples[i])));
+    }
+
+    measurement.filter_cycles += ble_gatt_statistics::cycles() - start;
+    measurement.samples += BATTERY_ADC_BLOCK_SIZE;
+    measurement.millivolts = millivolts;
+
+    battery_level = util::state_of_charge(util::liion_ocv_table, millivolts);
+
+    battery_service_publish_level();
+}
+
+static void battery_service_simulate_percentage(uint8_t decrease_interval) {
+    battery_level =
+        (battery_level == 0)
             ? 100
-            : app_bas_battery_level[0] - decrease_interval;
+            : static_cast<uint8_t>(battery_level -
+                                   std::min(battery_level, decrease_interval));
+
+    battery_service_publish_level();
+}
+
+static void battery_service_publish_level(void) {
+    ble_gatt_db_set_value(HDLC_BAS_BATTERY_LEVEL_VALUE, &battery_level,
+                          sizeof(battery_level));
+
+    // Passive scanners see the new level with the next advertisement
+    ble_battery_broadcast_object.update(battery_level);
 }
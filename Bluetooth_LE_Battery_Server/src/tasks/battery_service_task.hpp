@@ -35,8 +35,12 @@ BaseType_t battery_service_task_create(void);
 /// \brief Battery service task that updates and sends battery level
 /// notifications
 ///
-/// This task updates dummy battery value every time it is notified
-/// and sends a notification to the connected peer. Created in main().
+/// This task measures the battery on every timer tick (ADC block by DMA,
+/// median and IIR filter, OCV lookup) and sends a notification to every
+/// connected peer that enabled them. It also wakes on
+/// subscription changes to serve new subscribers and to start or stop the
+/// timer.
+/// Created in main().
 ///
 /// \param task_parameter Task parameter (unused)
 ///
@@ -44,6 +48,29 @@ BaseType_t battery_service_task_create(void);
 ///
 void battery_service_task(void *task_parameter);
 
+///
+/// \brief Tell the battery service task that subscribers may have changed
+///
+/// Called on the Bluetooth stack thread when a peer writes the Battery Level
+/// CCCD or disconnects. A new subscriber is sent the current level right
+/// away; the update timer runs only while at least one peer is subscribed.
+///
+/// \return void
+///
+void battery_service_subscription_changed(void);
+
+///
+/// \brief Print time-to-first-notification counters on the debug UART
+///
+/// Prints one JSON object with the count, mean and maximum CPU cycles from
+/// a subscription to its first notification, and the latest battery voltage
+/// and level with the mean CPU cycles spent filtering each ADC sample, then
+/// resets the counters.
+///
+/// \return void
+///
+void battery_service_print_json(void);
+
 ///
 /// \brief FreeRTOS task handle for battery service task
 ///
@@ -0,0 +1,44 @@
+///
+/// \file    ota_writer_task.cpp
+/// \brief   OTA Writer Task implementation
+///
+/// \details This file implements the FreeRTOS task that commits staged OTA
+///          image data to flash.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA writer task implementation
+///
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cy_result.h"
+
+#include <FreeRTOS.h>
+#include <task.h>
+}
+#pragma GCC diagnostic pop
+
+#include "ota_staging.hpp"
+#include "ota_writer_task.hpp"
+#include "utilities.hpp"
+
+BaseType_t ota_writer_task_create(void) {
+    if (ota_staging_object.initialize() != CY_RSLT_SUCCESS) {
+        return pdFAIL;
+    }
+
+    // Above the battery service so flash commits keep pace with the peer
+    auto result =
+        xTaskCreate(ota_writer_task, "OTA Writer Task",
+                    (configMINIMAL_STACK_SIZE * 4), nullptr,
+                    (configMAX_PRIORITIES - 2), &ota_writer_task_handle);
+    return result;
+}
+
+void ota_writer_task(void *task_parameter) {
+    util::unused(task_parameter);
+
+    ota_staging_object.run_writer();
+}
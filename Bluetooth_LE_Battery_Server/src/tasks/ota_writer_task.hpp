@@ -0,0 +1,52 @@
+///
+/// \file    ota_writer_task.hpp
+/// \brief   OTA Writer Task public interface
+///
+/// \details This header provides the public interface for the FreeRTOS task
+///          that commits staged OTA image data to flash, off the Bluetooth
+///          stack thread.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - OTA writer task interface
+///
+
+#ifndef OTA_WRITER_TASK_HPP
+#define OTA_WRITER_TASK_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include <FreeRTOS.h>
+#include <task.h>
+}
+#pragma GCC diagnostic pop
+
+///
+/// \brief Create and start the OTA writer task
+///
+/// Initializes the OTA staging buffers, then creates the task that commits
+/// them to flash.
+///
+/// \return BaseType_t pdPASS if task created successfully, pdFAIL otherwise
+///
+BaseType_t ota_writer_task_create(void);
+
+///
+/// \brief OTA writer task
+///
+/// Commits each full staging buffer through the OTA library as soon as the
+/// Bluetooth stack thread hands it over. Created in main().
+///
+/// \param task_parameter Task parameter (unused)
+///
+/// \return void
+///
+void ota_writer_task(void *task_parameter);
+
+///
+/// \brief FreeRTOS task handle for OTA writer task
+///
+inline TaskHandle_t ota_writer_task_handle;
+
+#endif /* OTA_WRITER_TASK_HPP */
@@ -0,0 +1,238 @@
+///
+/// \file    cyhal_adc_sampler.hpp
+/// \brief   CYHAL (Cypress HAL) block ADC sampler implementation
+///
+/// \details Implements the \ref adc_sampler façade over a single-ended SAR
+///          ADC channel. Each block is read asynchronously by DMA straight
+///          into the next slot of a statically sized ring, and the
+///          async-read-complete interrupt is forwarded to the registered
+///          callback. The CPU is not involved between start() and the
+///          callback. DMA moves the raw result registers, so the ring holds
+///          counts; to_microvolts() applies the SAR driver's calibrated
+///          conversion for the channel.
+///
+/// \example
+/// \code
+/// static void on_block(void *argument) { ... }
+///
+/// static auto battery_adc = cyhal_adc_sampler<16, 2>{CYBSP_A0};
+///
+/// battery_adc.initialize(on_block, nullptr);
+/// battery_adc.start();
+/// // ...in the task woken by on_block:
+/// const auto *samples = battery_adc.completed();
+/// const auto microvolts = battery_adc.to_microvolts(samples[0]);
+/// \endcode
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Block ADC sampler implementation
+///
+
+#ifndef CYHAL_ADC_SAMPLER_HPP
+#define CYHAL_ADC_SAMPLER_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyhal.h"
+#include "cyhal_hw_types.h"
+}
+#pragma GCC diagnostic pop
+
+#include "adc_sampler.hpp"
+#include "utilities.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// \ingroup transport
+/// \brief CYHAL-based block ADC sampler implementation
+///
+/// \tparam BlockSize  Samples per block
+/// \tparam BlockCount Blocks in the ring (at least 2, so the completed block
+///         stays intact while the next one is acquired)
+///
+template <std::size_t BlockSize, std::size_t BlockCount>
+class cyhal_adc_sampler
+    : public adc_sampler<cyhal_adc_sampler<BlockSize, BlockCount>> {
+public:
+    static_assert(BlockSize > 0, "cyhal_adc_sampler requires samples");
+    static_assert(BlockCount >= 2,
+                  "cyhal_adc_sampler requires a ring of at least two blocks");
+
+    using callback_t =
+        typename adc_sampler<cyhal_adc_sampler<BlockSize, BlockCount>>::
+            callback_t;
+
+    ///
+    /// \brief Construct a sampler for an analog pin
+    ///
+    /// \param pin Pin carrying the voltage to sample
+    ///
+    explicit cyhal_adc_sampler(cyhal_gpio_t pin) noexcept : m_pin{pin} {}
+
+    ///
+    /// \brief Acquire and configure the ADC channel (does not sample)
+    ///
+    /// \param callback Function invoked on each completed block
+    /// \param argument Opaque argument passed to \p callback
+    /// \return cy_rslt_t
+    ///
+    cy_rslt_t initialize(callback_t callback, void *argument) noexcept {
+        m_callback = callback;
+        m_argument = argument;
+
+        auto result = cyhal_adc_init(&m_adc, m_pin, nullptr);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        // Single conversions on request; the hardware averages each sample
+        auto adc_config = cyhal_adc_config_t{};
+        adc_config.continuous_scanning = false;
+        adc_config.resolution = 12;
+        adc_config.average_count = ADC_HARDWARE_AVERAGE;
+        adc_config.vneg = cyhal_adc_vneg_t::CYHAL_ADC_VNEG_VSSA;
+        adc_config.vref = cyhal_adc_vref_t::CYHAL_ADC_REF_VDDA;
+        adc_config.ext_vref = NC;
+        adc_config.bypass_pin = NC;
+
+        result = cyhal_adc_configure(&m_adc, &adc_config);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        const auto channel_config = cyhal_adc_channel_config_t{
+            true,                   ///< Use the hardware average
+            ADC_MIN_ACQUISITION_NS, ///< Settling time for a divider source
+            true                    ///< Channel enabled
+        };
+
+        result = cyhal_adc_channel_init_diff(&m_channel, &m_adc, m_pin,
+                                             CYHAL_ADC_VNEG, &channel_config);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        result = cyhal_adc_set_async_mode(
+            &m_adc, cyhal_async_mode_t::CYHAL_ASYNC_DMA, ADC_DMA_PRIORITY);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        cyhal_adc_register_callback(&m_adc, on_adc_event, this);
+
+        cyhal_adc_enable_event(
+            &m_adc, cyhal_adc_event_t::CYHAL_ADC_ASYNC_READ_COMPLETE,
+            ADC_INTERRUPT_PRIORITY, true);
+
+        return CY_RSLT_SUCCESS;
+    }
+
+    ///
+    /// \brief Start acquiring the next block of the ring by DMA
+    ///
+    /// \return cy_rslt_t CY_RSLT_SUCCESS, or an error if a block is still
+    ///         being acquired
+    ///
+    cy_rslt_t start() noexcept {
+        if (m_busy.exchange(true)) {
+            return cy_en_rslt_type_t::CY_RSLT_TYPE_ERROR;
+        }
+
+        // Counts: the HAL only scales to microvolts in its interrupt mode
+        const auto result = cyhal_adc_read_async(&m_adc, BlockSize,
+                                                 m_ring[m_acquiring].data());
+
+        if (result != CY_RSLT_SUCCESS) {
+            m_busy.store(false);
+        }
+
+        return result;
+    }
+
+    ///
+    /// \brief Get the most recently completed block
+    ///
+    /// \return const int32_t* BlockSize samples in ADC counts, or nullptr
+    ///         before the first block completes
+    ///
+    const int32_t *completed() const noexcept {
+        const auto index = m_completed.load();
+
+        return (index < BlockCount) ? m_ring[index].data() : nullptr;
+    }
+
+    ///
+    /// \brief Convert a sample to the voltage at the pin
+    ///
+    /// \param counts Sample from completed()
+    /// \return int32_t Pin voltage in microvolts
+    ///
+    int32_t to_microvolts(int32_t counts) const noexcept {
+        return Cy_SAR_CountsTo_uVolts(m_adc.base, m_channel.channel_idx,
+                                      static_cast<int16_t>(counts));
+    }
+
+    ///
+    /// \brief Get the number of samples per block
+    ///
+    std::size_t block_size() const noexcept { return BlockSize; }
+
+private:
+    ///
+    /// \brief CYHAL event trampoline
+    ///
+    /// \param callback_argument Pointer to the owning cyhal_adc_sampler
+    /// \param adc_event Unused (only async read completion is enabled)
+    ///
+    static void on_adc_event(void *callback_argument,
+                             cyhal_adc_event_t adc_event) {
+        util::unused(adc_event);
+
+        auto *self = static_cast<cyhal_adc_sampler *>(callback_argument);
+
+        // Publish the block, then move the next acquisition along the ring
+        self->m_completed.store(self->m_acquiring);
+        self->m_acquiring = (self->m_acquiring + 1) % BlockCount;
+        self->m_busy.store(false);
+
+        if (self->m_callback != nullptr) {
+            self->m_callback(self->m_argument);
+        }
+    }
+
+    /// Conversions averaged by the hardware into each sample
+    static constexpr auto ADC_HARDWARE_AVERAGE = uint16_t{16};
+
+    /// Minimum acquisition time per conversion in nanoseconds
+    static constexpr auto ADC_MIN_ACQUISITION_NS = uint32_t{10000};
+
+    /// Priority of the DMA channel moving results into the ring
+    static constexpr auto ADC_DMA_PRIORITY = uint8_t{3};
+
+    /// Interrupt priority of the async-read-complete event
+    static constexpr auto ADC_INTERRUPT_PRIORITY = uint8_t{3};
+
+    cyhal_gpio_t m_pin;              ///< Sampled pin
+    cyhal_adc_t m_adc{};             ///< CYHAL ADC object
+    cyhal_adc_channel_t m_channel{}; ///< CYHAL ADC channel object
+    callback_t m_callback{nullptr};  ///< Block completion callback
+    void *m_argument{nullptr};       ///< Argument passed to m_callback
+
+    std::array<std::array<int32_t, BlockSize>, BlockCount>
+        m_ring{};              ///< Blocks of samples
+    std::size_t m_acquiring{}; ///< Block the next acquisition writes
+
+    std::atomic<std::size_t> m_completed{BlockCount}; ///< Latest block
+    std::atomic<bool> m_busy{false}; ///< Set while a block is acquired
+};
+
+#endif /* CYHAL_ADC_SAMPLER_HPP */
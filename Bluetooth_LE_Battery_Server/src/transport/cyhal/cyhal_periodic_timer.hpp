@@ -0,0 +1,136 @@
+///
+/// \file    cyhal_periodic_timer.hpp
+/// \brief   CYHAL (Cypress HAL) periodic timer implementation
+///
+/// \details Implements the \ref periodic_timer façade over a CYHAL timer/
+///          counter block. The timer runs continuously, counts up and raises
+///          its terminal-count interrupt once per period, which is forwarded
+///          to the registered callback.
+///
+/// \example
+/// \code
+/// static void on_tick(void *argument) { ... }
+///
+/// static auto tick_timer = cyhal_periodic_timer{};
+///
+/// // 10 kHz counter, terminal count every 10000 ticks (1 s)
+/// tick_timer.initialize(9999, 10000, on_tick, nullptr);
+/// tick_timer.start();
+/// \endcode
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Periodic timer implementation
+///
+
+#ifndef CYHAL_PERIODIC_TIMER_HPP
+#define CYHAL_PERIODIC_TIMER_HPP
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+extern "C" {
+#include "cyhal.h"
+#include "cyhal_hw_types.h"
+}
+#pragma GCC diagnostic pop
+
+#include "periodic_timer.hpp"
+#include "utilities.hpp"
+
+/// \ingroup transport
+/// \brief CYHAL-based periodic timer implementation
+class cyhal_periodic_timer : public periodic_timer<cyhal_periodic_timer> {
+public:
+    ///
+    /// \brief Acquire and configure the timer (does not start it)
+    ///
+    /// \param period_ticks  Timer period in counter ticks
+    /// \param frequency_hz  Counter clock frequency in Hertz
+    /// \param callback      Function invoked on each terminal count
+    /// \param argument      Opaque argument passed to \p callback
+    /// \return cy_rslt_t
+    ///
+    cy_rslt_t initialize(uint32_t period_ticks, uint32_t frequency_hz,
+                         callback_t callback, void *argument) noexcept {
+        m_callback = callback;
+        m_argument = argument;
+
+        auto result = cyhal_timer_init(&m_timer, NC, nullptr);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        const auto timer_config = cyhal_timer_cfg_t{
+            true,                                        ///< Run indefinitely
+            cyhal_timer_direction_t::CYHAL_TIMER_DIR_UP, ///< Count up
+            false,                                       ///< No compare mode
+            period_ticks, ///< Timer period in counter ticks
+            0,            ///< Timer compare value (not used)
+            0             ///< Initial counter value
+        };
+
+        result = cyhal_timer_configure(&m_timer, &timer_config);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        result = cyhal_timer_set_frequency(&m_timer, frequency_hz);
+
+        if (result != CY_RSLT_SUCCESS) {
+            return result;
+        }
+
+        // Register for a callback whenever timer reaches terminal count
+        cyhal_timer_register_callback(&m_timer, on_timer_event, this);
+
+        cyhal_timer_enable_event(
+            &m_timer, cyhal_timer_event_t::CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+            TIMER_INTERRUPT_PRIORITY, true);
+
+        return CY_RSLT_SUCCESS;
+    }
+
+    ///
+    /// \brief Start counting
+    ///
+    cy_rslt_t start() noexcept { return cyhal_timer_start(&m_timer); }
+
+    ///
+    /// \brief Stop counting
+    ///
+    cy_rslt_t stop() noexcept { return cyhal_timer_stop(&m_timer); }
+
+    ///
+    /// \brief Restart the current period from zero
+    ///
+    cy_rslt_t reset() noexcept { return cyhal_timer_reset(&m_timer); }
+
+private:
+    ///
+    /// \brief CYHAL event trampoline
+    ///
+    /// \param callback_argument Pointer to the owning cyhal_periodic_timer
+    /// \param timer_event Unused
+    ///
+    static void on_timer_event(void *callback_argument,
+                               cyhal_timer_event_t timer_event) {
+        util::unused(timer_event);
+
+        auto *self = static_cast<cyhal_periodic_timer *>(callback_argument);
+
+        if (self->m_callback != nullptr) {
+            self->m_callback(self->m_argument);
+        }
+    }
+
+    /// Interrupt priority of the terminal-count event
+    static constexpr auto TIMER_INTERRUPT_PRIORITY = uint8_t{3};
+
+    cyhal_timer_t m_timer{};        ///< CYHAL timer object
+    callback_t m_callback{nullptr}; ///< Period expiry callback
+    void *m_argument{nullptr};      ///< Argument passed to m_callback
+};
+
+#endif /* CYHAL_PERIODIC_TIMER_HPP */
@@ -0,0 +1,100 @@
+///
+/// \file    adc_sampler.hpp
+/// \brief   Platform-agnostic block ADC sampler interface using CRTP
+///
+/// \details This header provides a platform-independent interface for an
+///          ADC channel sampled in blocks using the Curiously Recurring
+///          Template Pattern (CRTP). An implementation class (e.g.,
+///          CYHAL-based) derives from the façade and acquires each block in
+///          the background (typically by DMA) into a ring of blocks, so the
+///          block being processed is never overwritten by the next
+///          acquisition. Samples are raw conversion results, as the DMA
+///          moves them; to_microvolts() converts one to the pin voltage.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Block ADC sampler interface
+///
+
+#ifndef ADC_SAMPLER_HPP
+#define ADC_SAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/// \ingroup transport
+/// \brief Platform-agnostic block ADC sampler façade (CRTP)
+template <typename Implementation>
+class adc_sampler {
+public:
+    ///
+    /// \brief Callback invoked when a block has been acquired
+    ///
+    /// \details May run in interrupt context; keep it short (e.g., notify a
+    ///          task).
+    ///
+    using callback_t = void (*)(void *callback_argument);
+
+    ///
+    /// \brief Acquire and configure the ADC channel (does not sample)
+    ///
+    /// \param callback Function invoked on each completed block
+    /// \param argument Opaque argument passed to \p callback
+    /// \return uint32_t 0 on success
+    ///
+    uint32_t initialize(callback_t callback, void *argument) noexcept {
+        return impl().initialize(callback, argument);
+    }
+
+    ///
+    /// \brief Start acquiring the next block of the ring
+    ///
+    /// \return uint32_t 0 on success, non-zero if a block is still being
+    ///         acquired
+    ///
+    uint32_t start() noexcept { return impl().start(); }
+
+    ///
+    /// \brief Get the most recently completed block
+    ///
+    /// \return const int32_t* block_size() samples in ADC counts, or nullptr
+    ///         before the first block completes
+    ///
+    const int32_t *completed() const noexcept { return impl().completed(); }
+
+    ///
+    /// \brief Convert a sample to the voltage at the pin
+    ///
+    /// \param counts Sample from completed()
+    /// \return int32_t Pin voltage in microvolts
+    ///
+    int32_t to_microvolts(int32_t counts) const noexcept {
+        return impl().to_microvolts(counts);
+    }
+
+    ///
+    /// \brief Get the number of samples per block
+    ///
+    std::size_t block_size() const noexcept { return impl().block_size(); }
+
+private:
+    ///
+    /// \brief Get reference to derived implementation
+    ///
+    /// \return Reference to implementation
+    ///
+    Implementation &impl() noexcept {
+        return static_cast<Implementation &>(*this);
+    }
+
+    ///
+    /// \brief Get const reference to derived implementation
+    ///
+    /// \return Const reference to implementation
+    ///
+    const Implementation &impl() const noexcept {
+        return static_cast<const Implementation &>(*this);
+    }
+};
+
+#endif /* ADC_SAMPLER_HPP */
@@ -0,0 +1,92 @@
+///
+/// \file    periodic_timer.hpp
+/// \brief   Platform-agnostic periodic timer interface using CRTP
+///
+/// \details This header provides a platform-independent interface for a
+///          free-running periodic timer using the Curiously Recurring Template
+///          Pattern (CRTP). An implementation class (e.g., CYHAL-based)
+///          derives from the façade and provides the concrete HAL-backed
+///          functionality. Application code selects the implementation with a
+///          type alias, so the same task logic can be built against another
+///          backend without touching its call sites.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Periodic timer interface
+///
+
+#ifndef PERIODIC_TIMER_HPP
+#define PERIODIC_TIMER_HPP
+
+#include <cstdint>
+
+/// \ingroup transport
+/// \brief Platform-agnostic periodic timer façade (CRTP)
+template <typename Implementation>
+class periodic_timer {
+public:
+    ///
+    /// \brief Callback invoked on every period expiry
+    ///
+    /// \details May run in interrupt context; keep it short (e.g., notify a
+    ///          task).
+    ///
+    using callback_t = void (*)(void *callback_argument);
+
+    ///
+    /// \brief Acquire and configure the timer (does not start it)
+    ///
+    /// \param period_ticks  Timer period in counter ticks
+    /// \param frequency_hz  Counter clock frequency in Hertz
+    /// \param callback      Function invoked on each period expiry
+    /// \param argument      Opaque argument passed to \p callback
+    /// \return uint32_t     0 on success
+    ///
+    uint32_t initialize(uint32_t period_ticks, uint32_t frequency_hz,
+                        callback_t callback, void *argument) noexcept {
+        return impl().initialize(period_ticks, frequency_hz, callback,
+                                 argument);
+    }
+
+    ///
+    /// \brief Start counting
+    ///
+    /// \return uint32_t 0 on success
+    ///
+    uint32_t start() noexcept { return impl().start(); }
+
+    ///
+    /// \brief Stop counting
+    ///
+    /// \return uint32_t 0 on success
+    ///
+    uint32_t stop() noexcept { return impl().stop(); }
+
+    ///
+    /// \brief Restart the current period from zero
+    ///
+    /// \return uint32_t 0 on success
+    ///
+    uint32_t reset() noexcept { return impl().reset(); }
+
+private:
+    ///
+    /// \brief Get reference to derived implementation
+    ///
+    /// \return Reference to implementation
+    ///
+    Implementation &impl() noexcept {
+        return static_cast<Implementation &>(*this);
+    }
+
+    ///
+    /// \brief Get const reference to derived implementation
+    ///
+    /// \return Const reference to implementation
+    ///
+    const Implementation &impl() const noexcept {
+        return static_cast<const Implementation &>(*this);
+    }
+};
+
+#endif /* PERIODIC_TIMER_HPP */
@@ -0,0 +1,213 @@
+///
+/// \file    battery_gauge.hpp
+/// \brief   Fixed-point battery voltage filter and state-of-charge estimate
+///
+/// \details This header provides the integer-only math behind the battery
+///          level: a median-of-N window that rejects single-sample spikes,
+///          followed by a first-order IIR low-pass kept in Q8 millivolts,
+///          and a mapping from cell voltage to state of charge through an
+///          open-circuit-voltage (OCV) table with linear interpolation. The
+///          table is validated at compile time. Nothing here allocates or
+///          touches hardware, so it builds and runs unchanged on a host.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Battery voltage filter and SoC estimate
+///
+
+#ifndef BATTERY_GAUGE_HPP
+#define BATTERY_GAUGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+///
+/// \brief One point of an open-circuit-voltage curve
+///
+struct ocv_point {
+    int32_t millivolts; ///< Cell voltage at rest
+    uint8_t percent;    ///< State of charge at that voltage
+};
+
+///
+/// \brief Typical single-cell Li-ion OCV curve (3.0 V empty, 4.2 V full)
+///
+inline constexpr auto liion_ocv_table = std::array<ocv_point, 13>{{
+    {3000, 0},
+    {3300, 2},
+    {3450, 5},
+    {3600, 10},
+    {3680, 20},
+    {3740, 30},
+    {3780, 40},
+    {3820, 50},
+    {3870, 60},
+    {3930, 70},
+    {4000, 80},
+    {4080, 90},
+    {4200, 100},
+}};
+
+///
+/// \brief Check that an OCV table can be interpolated
+///
+/// \return true if it has at least two points, voltages strictly increase,
+///         and percentages never decrease nor exceed 100
+///
+template <std::size_t N>
+constexpr bool
+ocv_table_valid(const std::array<ocv_point, N> &table) noexcept {
+    if (N < 2) {
+        return false;
+    }
+
+    for (auto i = std::size_t{1}; i < N; i++) {
+        if (table[i].millivolts <= table[i - 1].millivolts ||
+            table[i].percent < table[i - 1].percent ||
+            table[i].percent > 100) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(ocv_table_valid(liion_ocv_table),
+              "liion_ocv_table must be sorted by voltage");
+
+///
+/// \brief Map a cell voltage to a state of charge
+///
+/// Interpolates linearly between the two surrounding points, rounding to the
+/// nearest percent. Voltages outside the table clamp to its first or last
+/// point.
+///
+/// \param table OCV curve (see ocv_table_valid())
+/// \param millivolts Cell voltage
+///
+/// \return uint8_t State of charge in percent
+///
+template <std::size_t N>
+constexpr uint8_t state_of_charge(const std::array<ocv_point, N> &table,
+                                  int32_t millivolts) noexcept {
+    if (millivolts <= table[0].millivolts) {
+        return table[0].percent;
+    }
+
+    for (auto i = std::size_t{1}; i < N; i++) {
+        const auto &upper = table[i];
+
+        if (millivolts >= upper.millivolts) {
+            continue;
+        }
+
+        const auto &lower = table[i - 1];
+        const auto span = upper.millivolts - lower.millivolts;
+        const auto rise = int32_t{upper.percent} - int32_t{lower.percent};
+        const auto offset = millivolts - lower.millivolts;
+
+        return static_cast<uint8_t>(lower.percent +
+                                    (offset * rise + span / 2) / span);
+    }
+
+    return table[N - 1].percent;
+}
+
+///
+/// \brief Median plus IIR filter for battery voltage samples
+///
+/// Each sample first goes through a sliding median of \p MedianWindow
+/// samples, then into a low-pass y += (x - y) / 2^IirShift kept in Q8
+/// millivolts so small steps are not lost to truncation. The first sample
+/// primes the low-pass, so the output starts at the measured voltage rather
+/// than ramping up from zero.
+///
+/// \tparam MedianWindow Odd median window length (1 disables the median)
+/// \tparam IirShift     Low-pass time constant as a power of two, in samples
+///
+template <std::size_t MedianWindow, unsigned IirShift>
+class battery_voltage_filter final {
+public:
+    static_assert(MedianWindow % 2 == 1 && MedianWindow <= 9,
+                  "battery_voltage_filter requires a small odd median window");
+    static_assert(IirShift < 16,
+                  "battery_voltage_filter requires a shorter time constant");
+
+    ///
+    /// \brief Filter one sample
+    ///
+    /// \param millivolts Measured voltage
+    ///
+    /// \return int32_t Filtered voltage in millivolts
+    ///
+    int32_t update(int32_t millivolts) noexcept {
+        m_window[m_next] = millivolts;
+        m_next = (m_next + 1) % MedianWindow;
+
+        if (m_count < MedianWindow) {
+            ++m_count;
+        }
+
+        const auto median = int32_t{this->median() * Q8_ONE};
+
+        if (!m_primed) {
+            m_state = median;
+            m_primed = true;
+        } else {
+            m_state += (median - m_state) >> IirShift;
+        }
+
+        return value();
+    }
+
+    ///
+    /// \brief Get the filtered voltage
+    ///
+    /// \return int32_t Filtered voltage in millivolts (0 before any sample)
+    ///
+    int32_t value() const noexcept { return (m_state + Q8_ONE / 2) >> 8; }
+
+    ///
+    /// \brief Forget all samples
+    ///
+    void reset() noexcept { *this = battery_voltage_filter{}; }
+
+private:
+    ///
+    /// \brief Median of the samples currently in the window
+    ///
+    /// Insertion sort on a copy; the window is at most nine samples. While
+    /// the window fills, an even count takes the lower middle sample.
+    ///
+    int32_t median() const noexcept {
+        auto sorted = m_window;
+
+        for (auto i = std::size_t{1}; i < m_count; i++) {
+            const auto key = sorted[i];
+            auto j = i;
+
+            for (; j > 0 && sorted[j - 1] > key; j--) {
+                sorted[j] = sorted[j - 1];
+            }
+
+            sorted[j] = key;
+        }
+
+        return sorted[(m_count - 1) / 2];
+    }
+
+    static constexpr auto Q8_ONE = int32_t{1 << 8}; ///< 1 mV in Q8
+
+    std::array<int32_t, MedianWindow> m_window{}; ///< Latest raw samples
+    std::size_t m_count{};                        ///< Samples in the window
+    std::size_t m_next{};                         ///< Slot of the next sample
+    int32_t m_state{};                            ///< Low-pass output in Q8
+    bool m_primed{false};                         ///< Low-pass has a sample
+};
+
+} // namespace util
+
+#endif /* BATTERY_GAUGE_HPP */
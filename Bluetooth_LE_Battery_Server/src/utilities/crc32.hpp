@@ -0,0 +1,120 @@
+///
+/// \file    crc32.hpp
+/// \brief   Streaming CRC-32 (IEEE 802.3)
+///
+/// \details This header provides an incremental CRC-32 engine (reflected
+///          polynomial 0xEDB88320, initial value and final XOR 0xFFFFFFFF),
+///          the same digest the OTA host tools send with the verify command.
+///          The lookup table is generated at compile time and placed in
+///          flash. Feeding a stream in any chunking yields the same digest as
+///          a single pass over the whole buffer.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Streaming CRC-32
+///
+
+#ifndef CRC32_HPP
+#define CRC32_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+///
+/// \brief Build the byte-wise CRC-32 lookup table
+///
+/// \return Remainder of every byte value for the reflected polynomial
+///
+constexpr std::array<uint32_t, 256> make_crc32_table() noexcept {
+    constexpr auto polynomial = uint32_t{0xEDB88320};
+
+    auto table = std::array<uint32_t, 256>{};
+
+    for (auto i = uint32_t{}; i < 256; i++) {
+        auto entry = i;
+
+        for (auto bit = 0; bit < 8; bit++) {
+            entry = (entry & 1) ? (entry >> 1) ^ polynomial : entry >> 1;
+        }
+
+        table[i] = entry;
+    }
+
+    return table;
+}
+
+///
+/// \brief Byte-wise CRC-32 lookup table, generated at compile time
+///
+inline constexpr auto crc32_table = make_crc32_table();
+
+///
+/// \brief Incremental CRC-32 engine
+///
+class crc32 final {
+public:
+    ///
+    /// \brief Restart the digest
+    ///
+    constexpr void reset() noexcept { m_state = INITIAL; }
+
+    ///
+    /// \brief Feed the next chunk of the stream
+    ///
+    /// \param data Chunk to add
+    /// \param length Length of \p data in bytes
+    ///
+    constexpr void update(const uint8_t *data, std::size_t length) noexcept {
+        auto state = m_state;
+
+        for (auto i = std::size_t{}; i < length; i++) {
+            state = crc32_table[(state ^ data[i]) & 0xFF] ^ (state >> 8);
+        }
+
+        m_state = state;
+    }
+
+    ///
+    /// \brief Get the digest of everything fed since the last reset
+    ///
+    /// \return uint32_t CRC-32 of the stream so far
+    ///
+    constexpr uint32_t value() const noexcept { return m_state ^ INITIAL; }
+
+    ///
+    /// \brief Compute the CRC-32 of a buffer in one pass
+    ///
+    /// \param data Buffer
+    /// \param length Length of \p data in bytes
+    ///
+    /// \return uint32_t CRC-32 of \p data
+    ///
+    static constexpr uint32_t of(const uint8_t *data,
+                                 std::size_t length) noexcept {
+        auto engine = crc32{};
+        engine.update(data, length);
+
+        return engine.value();
+    }
+
+private:
+    static constexpr auto INITIAL = uint32_t{0xFFFFFFFF};
+
+    uint32_t m_state{INITIAL}; ///< Running (non-finalized) remainder
+};
+
+/// Check value of the CRC-32/ISO-HDLC catalogue entry
+static_assert(
+    [] {
+        constexpr uint8_t check[] = {'1', '2', '3', '4', '5',
+                                     '6', '7', '8', '9'};
+        return crc32::of(check, sizeof(check));
+    }() == 0xCBF43926,
+    "CRC-32 implementation does not match the reference check value");
+
+} // namespace util
+
+#endif /* CRC32_HPP */
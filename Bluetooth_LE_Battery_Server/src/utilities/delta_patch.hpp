@@ -0,0 +1,288 @@
+///
+/// \file    delta_patch.hpp
+/// \brief   Streaming application of sequential binary patches
+///
+/// \details This header provides an incremental patcher that rebuilds a new
+///          image from a base image (read in place, e.g. memory-mapped flash)
+///          and a sequential patch. The patch is a list of operations that
+///          produce the new image front to back while walking the base:
+///          - COPY n:     n bytes from the base at the current position
+///          - MODIFY n d: the n bytes d, skipping n bytes of the base
+///          - INSERT n d: the n bytes d, leaving the base position alone
+///          - SEEK p:     move the base position to p
+///
+///          Lengths are 16-bit and positions 32-bit, little endian, each
+///          after a one-byte opcode. The output is split into blocks of a
+///          fixed size; no operation crosses a block boundary, and each block
+///          starts with a SEEK, so patching can restart at any block.
+///
+///          Decoded bytes are handed to the sink straight from the base or
+///          from the patch input, so RAM use is a few bytes of state no matter
+///          how large the images are. Patches are produced by
+///          scripts/make-ota-delta.py.
+///
+///          A sink that refuses data stops patching without losing anything:
+///          a refused COPY stays pending, and the next decode() call delivers
+///          it before reading more input, starting at the first byte
+///          consumed() left over.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Sequential delta patcher
+///
+
+#ifndef DELTA_PATCH_HPP
+#define DELTA_PATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+///
+/// \brief Incremental sequential patch decoder
+///
+class delta_patcher final {
+public:
+    ///
+    /// \brief Patch operation codes
+    ///
+    enum class opcode : uint8_t {
+        copy = 0x00,   ///< Copy from the base
+        modify = 0x01, ///< Replace base bytes
+        insert = 0x02, ///< Add new bytes
+        seek = 0x03    ///< Move within the base
+    };
+
+    ///
+    /// \brief Decoder result
+    ///
+    enum class status : uint8_t {
+        ok,      ///< Input consumed
+        corrupt, ///< Unknown opcode, or an operation out of range
+        sink     ///< The sink rejected decoded data
+    };
+
+    ///
+    /// \brief Restart patching at the beginning of a block
+    ///
+    /// \param base Image the patch was made against
+    /// \param base_size Size of \p base in bytes
+    /// \param block_size Decoded size of every block
+    /// \param total_size Decoded size of the new image
+    /// \param produced Decoded bytes already delivered (a multiple of
+    ///        \p block_size when resuming)
+    ///
+    void reset(const uint8_t *base, uint32_t base_size, uint32_t block_size,
+               uint32_t total_size, uint32_t produced = 0) noexcept {
+        m_base = base;
+        m_base_size = base_size;
+        m_block_size = block_size;
+        m_total_size = total_size;
+        m_produced = produced;
+
+        m_position = 0;
+        m_positioned = false;
+        m_header_length = 0;
+        m_data_remaining = 0;
+        m_copy_remaining = 0;
+        m_consumed = 0;
+    }
+
+    ///
+    /// \brief Decode the next piece of the patch
+    ///
+    /// \tparam Sink Callable as bool(const uint8_t *data, std::size_t length)
+    ///
+    /// \param input Patch bytes
+    /// \param length Length of \p input in bytes
+    /// \param sink Receives decoded bytes in order; returns false to stop
+    ///
+    /// \return status status::ok, or the reason decoding stopped
+    ///
+    template <typename Sink>
+    status decode(const uint8_t *input, std::size_t length,
+                  Sink &&sink) noexcept {
+        const auto *const begin = input;
+
+        while (m_produced < m_total_size) {
+            if (m_copy_remaining > 0) {
+                // COPY from the base, possibly refused by an earlier call
+                if (!sink(m_base + m_position, m_copy_remaining)) {
+                    m_consumed = static_cast<std::size_t>(input - begin);
+                    return status::sink;
+                }
+
+                m_position += m_copy_remaining;
+                m_produced += m_copy_remaining;
+                m_copy_remaining = 0;
+                continue;
+            }
+
+            if (length == 0) {
+                break;
+            }
+
+            if (m_data_remaining > 0) {
+                // Payload of MODIFY or INSERT, passed through as it arrives
+                const auto count =
+                    (length < m_data_remaining) ? length : m_data_remaining;
+
+                if (!sink(input, count)) {
+                    m_consumed = static_cast<std::size_t>(input - begin);
+                    return status::sink;
+                }
+
+                if (m_operation == opcode::modify) {
+                    m_position += static_cast<uint32_t>(count);
+                }
+
+                input += count;
+                length -= count;
+                m_data_remaining -= count;
+                m_produced += static_cast<uint32_t>(count);
+                continue;
+            }
+
+            m_header[m_header_length++] = *input++;
+            --length;
+
+            if (m_header_length < header_size()) {
+                continue;
+            }
+
+            m_header_length = 0;
+
+            if (execute() != status::ok) {
+                m_consumed = static_cast<std::size_t>(input - begin);
+                return status::corrupt;
+            }
+        }
+
+        m_consumed = static_cast<std::size_t>(input - begin);
+
+        return status::ok;
+    }
+
+    ///
+    /// \brief Get the number of decoded bytes delivered so far
+    ///
+    uint32_t produced() const noexcept { return m_produced; }
+
+    ///
+    /// \brief Get the number of input bytes the last decode() call used
+    ///
+    /// Less than its length if the sink refused data (the rest must be
+    /// passed again) or the image ended.
+    ///
+    std::size_t consumed() const noexcept { return m_consumed; }
+
+private:
+    ///
+    /// \brief Bytes in the header of the operation being read
+    ///
+    /// The first header byte is the opcode; an unknown one is reported by
+    /// execute() once its (one-byte) header is complete.
+    ///
+    std::size_t header_size() const noexcept {
+        switch (static_cast<opcode>(m_header[0])) {
+        case opcode::copy:
+        case opcode::modify:
+        case opcode::insert:
+            return 3;
+
+        case opcode::seek:
+            return 5;
+
+        default:
+            return 1;
+        }
+    }
+
+    ///
+    /// \brief Run the operation whose header was just read
+    ///
+    status execute() noexcept {
+        m_operation = static_cast<opcode>(m_header[0]);
+
+        if (m_operation == opcode::seek) {
+            const auto position = static_cast<uint32_t>(
+                m_header[1] | (m_header[2] << 8) | (m_header[3] << 16) |
+                (static_cast<uint32_t>(m_header[4]) << 24));
+
+            if (position > m_base_size) {
+                return status::corrupt;
+            }
+
+            m_position = position;
+            m_positioned = true;
+
+            return status::ok;
+        }
+
+        if (header_size() != 3) {
+            return status::corrupt;
+        }
+
+        const auto count =
+            static_cast<uint32_t>(m_header[1] | (m_header[2] << 8));
+
+        if (count == 0 || count > block_remaining()) {
+            return status::corrupt;
+        }
+
+        if (m_operation == opcode::insert) {
+            m_data_remaining = count;
+            return status::ok;
+        }
+
+        // COPY and MODIFY walk the base, which a resumed block must locate
+        // first
+        if (!m_positioned || count > m_base_size - m_position) {
+            return status::corrupt;
+        }
+
+        if (m_operation == opcode::modify) {
+            m_data_remaining = count;
+        } else {
+            // Delivered by decode(), which retries it if the sink refuses
+            m_copy_remaining = count;
+        }
+
+        return status::ok;
+    }
+
+    ///
+    /// \brief Decoded bytes left in the current block
+    ///
+    /// The last block ends early at the end of the image.
+    ///
+    uint32_t block_remaining() const noexcept {
+        const auto in_block = m_block_size - (m_produced % m_block_size);
+        const auto in_image = m_total_size - m_produced;
+
+        return (in_block < in_image) ? in_block : in_image;
+    }
+
+    const uint8_t *m_base{nullptr}; ///< Image the patch applies to
+    uint32_t m_base_size{};         ///< Size of m_base in bytes
+
+    uint32_t m_block_size{1}; ///< Decoded size of every block
+    uint32_t m_total_size{};  ///< Decoded size of the new image
+    uint32_t m_produced{};    ///< Decoded bytes delivered to the sink
+
+    uint32_t m_position{};          ///< Current base position
+    bool m_positioned{false};       ///< A SEEK was seen since reset()
+    opcode m_operation{};           ///< Operation being executed
+    std::size_t m_data_remaining{}; ///< Payload bytes still to pass through
+    uint32_t m_copy_remaining{};    ///< COPY bytes not delivered yet
+    std::size_t m_consumed{};       ///< Input used by the last decode()
+
+    std::array<uint8_t, 5> m_header{}; ///< Opcode and argument being read
+    std::size_t m_header_length{};     ///< Valid bytes in m_header
+};
+
+} // namespace util
+
+#endif /* DELTA_PATCH_HPP */
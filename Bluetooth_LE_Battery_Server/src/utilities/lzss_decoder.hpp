@@ -0,0 +1,285 @@
+///
+/// \file    lzss_decoder.hpp
+/// \brief   Streaming LZSS decoder with a fixed-size window
+///
+/// \details This header provides an incremental decoder for a small-window
+///          LZSS format. Input may be fed in arbitrary pieces; decoded bytes
+///          are handed to a sink through a small output buffer, so RAM use is
+///          fixed at the window plus that buffer regardless of image size.
+///
+///          Stream format (produced by scripts/compress-ota-image.py):
+///          - Items are grouped under a flag byte, least significant bit
+///            first: 1 = literal (one byte follows), 0 = reference (two bytes
+///            follow).
+///          - A reference encodes distance - 1 in its upper 10 bits and
+///            length - 3 in its lower 6 bits (big endian), i.e. distances
+///            1..1024 and lengths 3..66.
+///          - The output is split into blocks of a fixed size. Each block
+///            starts with an empty window and a new flag byte, and no item
+///            crosses a block boundary, so decoding can restart at any block.
+///
+///          A sink that refuses data stops decoding without losing anything:
+///          the refused output and the rest of a reference stay in the
+///          decoder, and the next decode() call delivers them before reading
+///          more input, starting at the first byte consumed() left over.
+///
+/// \author  galudino
+/// \date    2025
+/// \version 1.0 - Streaming LZSS decoder
+///
+
+#ifndef LZSS_DECODER_HPP
+#define LZSS_DECODER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+///
+/// \brief Incremental LZSS decoder
+///
+class lzss_decoder final {
+public:
+    /// Window size in bytes (maximum reference distance)
+    static constexpr auto WINDOW_SIZE = std::size_t{1024};
+
+    /// Shortest reference length
+    static constexpr auto MIN_MATCH = std::size_t{3};
+
+    ///
+    /// \brief Decoder result
+    ///
+    enum class status : uint8_t {
+        ok,      ///< Input consumed
+        corrupt, ///< Reference outside the window or across a block
+        sink     ///< The sink rejected decoded data
+    };
+
+    ///
+    /// \brief Restart decoding at the beginning of a block
+    ///
+    /// \param block_size Decoded size of every block
+    /// \param total_size Decoded size of the whole stream; input past it is
+    ///        ignored (it can only be padding of the last flag byte)
+    /// \param produced Decoded bytes already delivered (a multiple of
+    ///        \p block_size when resuming)
+    ///
+    void reset(uint32_t block_size, uint32_t total_size,
+               uint32_t produced = 0) noexcept {
+        m_block_size = block_size;
+        m_total_size = total_size;
+        m_produced = produced;
+
+        // A stream that stopped early left bytes behind
+        m_pending = 0;
+        m_copy_remaining = 0;
+        m_consumed = 0;
+
+        start_block();
+    }
+
+    ///
+    /// \brief Decode the next piece of the stream
+    ///
+    /// \tparam Sink Callable as bool(const uint8_t *data, std::size_t length)
+    ///
+    /// \param input Compressed bytes
+    /// \param length Length of \p input in bytes
+    /// \param sink Receives decoded bytes in order; returns false to stop
+    ///
+    /// \return status status::ok, or the reason decoding stopped
+    ///
+    template <typename Sink>
+    status decode(const uint8_t *input, std::size_t length,
+                  Sink &&sink) noexcept {
+        m_consumed = 0;
+
+        // Output refused by the previous call goes first
+        if (!drain(sink)) {
+            return status::sink;
+        }
+
+        for (auto i = std::size_t{}; i < length && decoded() < m_total_size;
+             i++) {
+            const auto byte = input[i];
+            m_consumed = i + 1;
+
+            if (m_flag_bits == 0) {
+                m_flags = byte;
+                m_flag_bits = 8;
+                continue;
+            }
+
+            if (m_flags & 1) {
+                put(byte);
+            } else if (!m_have_high) {
+                m_high = byte;
+                m_have_high = true;
+                continue;
+            } else {
+                m_have_high = false;
+
+                const auto token = static_cast<uint16_t>((m_high << 8) | byte);
+                const auto distance = std::size_t{token} / 64 + 1;
+                const auto count = std::size_t{token} % 64 + MIN_MATCH;
+
+                if (distance > m_history || count > block_remaining()) {
+                    return status::corrupt;
+                }
+
+                m_copy_distance = distance;
+                m_copy_remaining = count;
+            }
+
+            m_flags >>= 1;
+            --m_flag_bits;
+
+            if (!drain(sink)) {
+                return status::sink;
+            }
+        }
+
+        return flush_output(sink) ? status::ok : status::sink;
+    }
+
+    ///
+    /// \brief Get the number of input bytes the last decode() call used
+    ///
+    /// Less than its length if the sink refused data (the rest must be
+    /// passed again) or the stream ended.
+    ///
+    std::size_t consumed() const noexcept { return m_consumed; }
+
+    ///
+    /// \brief Get the number of decoded bytes delivered so far
+    ///
+    uint32_t produced() const noexcept { return m_produced; }
+
+private:
+    static constexpr auto WINDOW_MASK = WINDOW_SIZE - 1;
+
+    static_assert((WINDOW_SIZE & WINDOW_MASK) == 0,
+                  "The LZSS window must be a power of two");
+
+    ///
+    /// \brief Append one decoded byte to the window and the output buffer
+    ///
+    void put(uint8_t byte) noexcept {
+        m_window[m_position & WINDOW_MASK] = byte;
+        ++m_position;
+
+        if (m_history < WINDOW_SIZE) {
+            ++m_history;
+        }
+
+        m_output[m_pending++] = byte;
+        ++m_block_produced;
+    }
+
+    ///
+    /// \brief Finish the current item: expand the rest of a reference and
+    ///        deliver the output at the end of a block or once it is full
+    ///
+    /// \return true unless the sink refused data
+    ///
+    template <typename Sink>
+    bool drain(Sink &sink) noexcept {
+        for (; m_copy_remaining > 0; --m_copy_remaining) {
+            if (m_pending == m_output.size() && !flush_output(sink)) {
+                return false;
+            }
+
+            put(m_window[(m_position - m_copy_distance) & WINDOW_MASK]);
+        }
+
+        if (block_remaining() == 0) {
+            if (!flush_output(sink)) {
+                return false;
+            }
+
+            start_block();
+        } else if (m_pending == m_output.size() && !flush_output(sink)) {
+            return false;
+        }
+
+        return true;
+    }
+
+    ///
+    /// \brief Deliver the output buffer to the sink
+    ///
+    /// Refused output is kept for the next attempt.
+    ///
+    template <typename Sink>
+    bool flush_output(Sink &sink) noexcept {
+        if (m_pending == 0) {
+            return true;
+        }
+
+        if (!sink(m_output.data(), m_pending)) {
+            return false;
+        }
+
+        m_produced += static_cast<uint32_t>(m_pending);
+        m_pending = 0;
+
+        return true;
+    }
+
+    ///
+    /// \brief Bytes decoded so far, delivered or pending
+    ///
+    std::size_t decoded() const noexcept { return m_produced + m_pending; }
+
+    ///
+    /// \brief Decoded bytes left in the current block
+    ///
+    /// The last block ends early at the end of the stream.
+    ///
+    std::size_t block_remaining() const noexcept {
+        const auto in_block = (m_block_size > m_block_produced)
+                                  ? m_block_size - m_block_produced
+                                  : std::size_t{};
+        const auto in_stream = (m_total_size > decoded())
+                                   ? m_total_size - decoded()
+                                   : std::size_t{};
+
+        return (in_block < in_stream) ? in_block : in_stream;
+    }
+
+    ///
+    /// \brief Empty the window and expect a flag byte
+    ///
+    void start_block() noexcept {
+        m_history = 0;
+        m_block_produced = 0;
+        m_flag_bits = 0;
+        m_have_high = false;
+    }
+
+    std::array<uint8_t, WINDOW_SIZE> m_window{}; ///< Recent output (ring)
+    std::array<uint8_t, 128> m_output{};         ///< Pending sink output
+
+    std::size_t m_position{};       ///< Window write position
+    std::size_t m_history{};        ///< Valid bytes in the window
+    std::size_t m_pending{};        ///< Bytes in m_output
+    std::size_t m_block_produced{}; ///< Bytes decoded in the current block
+    std::size_t m_copy_distance{};  ///< Distance of the reference expanded
+    std::size_t m_copy_remaining{}; ///< Bytes of it still to expand
+    std::size_t m_consumed{};       ///< Input used by the last decode()
+
+    uint32_t m_block_size{}; ///< Decoded size of every block
+    uint32_t m_total_size{}; ///< Decoded size of the stream
+    uint32_t m_produced{};   ///< Decoded bytes delivered to the sink
+
+    uint8_t m_flags{};       ///< Remaining bits of the current flag byte
+    uint8_t m_flag_bits{};   ///< Items left under the current flag byte
+    uint8_t m_high{};        ///< First byte of a reference
+    bool m_have_high{false}; ///< m_high holds a pending reference byte
+};
+
+} // namespace util
+
+#endif /* LZSS_DECODER_HPP */